@@ -103,6 +103,10 @@ namespace HostSys
 	// Unmaps a block allocated by SysMmap
 	extern void Munmap(void* base, size_t size);
 
+	// Asks for a block from Mmap to be backed by huge pages, where the OS supports it.
+	// Returns false if the request wasn't made.
+	extern bool AdviseHugePages(void* base, size_t size);
+
 	extern void MemProtect(void* baseaddr, size_t size, const PageProtectionMode& mode);
 
 	extern std::string GetFileMappingName(const char* prefix);
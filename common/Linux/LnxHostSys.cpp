@@ -233,6 +233,15 @@ void HostSys::Munmap(void* base, size_t size)
 	munmap((void*)base, size);
 }
 
+bool HostSys::AdviseHugePages(void* base, size_t size)
+{
+#ifdef MADV_HUGEPAGE
+	return (madvise(base, size, MADV_HUGEPAGE) == 0);
+#else
+	return false;
+#endif
+}
+
 void HostSys::MemProtect(void* baseaddr, size_t size, const PageProtectionMode& mode)
 {
 	pxAssertMsg((size & (__pagesize - 1)) == 0, "Size is page aligned");
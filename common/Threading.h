@@ -188,7 +188,8 @@ namespace Threading
 
 	public:
 		/// Notify the worker thread that you've added new work to its queue
-		void NotifyOfWork()
+		/// Returns true if the worker was asleep and had to be woken up
+		bool NotifyOfWork()
 		{
 			// State change:
 			// DEAD: Stay in DEAD (starting DEAD state is INT_MIN so we can assume we won't flip over to anything else)
@@ -197,8 +198,11 @@ namespace Threading
 			// RUNNING_0: Change state to RUNNING_N.
 			// RUNNING_N: Stay in RUNNING_N
 			s32 old = m_state.fetch_add(2, std::memory_order_release);
-			if (old == STATE_SLEEPING)
-				m_sema.Post();
+			if (old != STATE_SLEEPING)
+				return false;
+
+			m_sema.Post();
+			return true;
 		}
 
 		/// Checks if there's any work in the queue
@@ -118,6 +118,12 @@ void HostSys::Munmap(void* base, size_t size)
 	VirtualFree((void*)base, 0, MEM_RELEASE);
 }
 
+bool HostSys::AdviseHugePages(void* base, size_t size)
+{
+	// Large pages have to be requested when the memory is allocated, and need SeLockMemoryPrivilege.
+	return false;
+}
+
 void HostSys::MemProtect(void* baseaddr, size_t size, const PageProtectionMode& mode)
 {
 	pxAssert((size & (__pagesize - 1)) == 0);
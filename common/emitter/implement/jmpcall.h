@@ -32,6 +32,7 @@ namespace x86Emitter
 				sptr dest = (sptr)func - ((sptr)xGetPtr() + 5);
 				pxAssertMsg(dest == (s32)dest, "Indirect jump is too far, must use a register!");
 				xWrite8(0xe8);
+				xRecordRelativeRef(xGetPtr(), func, sizeof(s32));
 				xWrite32(dest);
 			}
 		}
@@ -193,7 +193,10 @@ namespace x86Emitter
 		}
 
 		if (is_s8(displacement8))
-			xJcc8(comparison, displacement8);
+		{
+			s8* bah = xJcc8(comparison, displacement8);
+			xRecordRelativeRef(reinterpret_cast<u8*>(bah), target, sizeof(s8));
+		}
 		else
 		{
 			// Perform a 32 bit jump instead. :(
@@ -204,6 +207,7 @@ namespace x86Emitter
 			pxAssertMsg(distance >= -0x80000000LL && distance < 0x80000000LL, "Jump target is too far away, needs an indirect register");
 
 			*bah = (s32)distance;
+			xRecordRelativeRef(reinterpret_cast<u8*>(bah), target, sizeof(s32));
 		}
 	}
 
@@ -53,6 +53,7 @@ thread_local XMMSSEType g_xmmtypes[iREGCNT_XMM] = {XMMT_INT};
 
 namespace x86Emitter
 {
+	thread_local std::vector<xRelativeRef>* xRelativeRefs;
 
 	template void xWrite<u8>(u8 val);
 	template void xWrite<u16>(u16 val);
@@ -301,6 +302,7 @@ const xRegister32
 		{
 			ModRM(0, regfield, ModRm_UseDisp32);
 			displacement = ripRelative;
+			xRecordRelativeRef(x86Ptr, address, sizeof(s32));
 		}
 		else
 		{
@@ -1304,6 +1306,10 @@ const xRegister32
 		else
 		{
 			xMOV64(dst, iaddr);
+
+			// Low addresses are encoded as a 32-bit immediate, those can't be moved anyway.
+			if (iaddr != (u32)iaddr && iaddr != (s32)iaddr)
+				xRecordRelativeRef(xGetPtr() - sizeof(u64), addr, sizeof(u64), true);
 		}
 	}
 
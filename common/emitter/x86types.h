@@ -7,6 +7,8 @@
 #include "common/Assertions.h"
 #include "common/Pcsx2Defs.h"
 
+#include <vector>
+
 static const uint iREGCNT_XMM = 16;
 static const uint iREGCNT_GPR = 16;
 
@@ -36,6 +38,29 @@ namespace x86Emitter
 
 	extern const char* xGetRegName(int regid, int operandSize);
 
+	// --------------------------------------------------------------------------------------
+	//  xRelativeRef
+	// --------------------------------------------------------------------------------------
+	// Describes a field written by the emitter whose value depends on the location of the code
+	// or of what it refers to, i.e. a branch displacement, a rip-relative operand or an address
+	// loaded as an immediate. Recompilers which want to move generated code after the fact can
+	// collect these by pointing xRelativeRefs at a vector.
+	struct xRelativeRef
+	{
+		u8* field; // start of the displacement field
+		const void* target; // absolute address the field refers to
+		u8 size; // size of the field in bytes (1, 4 or 8)
+		bool absolute; // field holds the target address itself, not a displacement
+	};
+
+	extern thread_local std::vector<xRelativeRef>* xRelativeRefs;
+
+	static __fi void xRecordRelativeRef(u8* field, const void* target, u8 size, bool absolute = false)
+	{
+		if (xRelativeRefs) [[unlikely]]
+			xRelativeRefs->push_back(xRelativeRef{field, target, size, absolute});
+	}
+
 	//------------------------------------------------------------------
 	// templated version of is_s8 is required, so that u16's get correct sign extension treatment.
 	template <typename T>
@@ -1,9 +1,11 @@
 // SPDX-FileCopyrightText: 2002-2024 PCSX2 Dev Team
 // SPDX-License-Identifier: LGPL-3.0+
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <csignal>
+#include <cstdio>
 #include <cstdlib>
 #include <condition_variable>
 #include <mutex>
@@ -11,6 +13,9 @@
 
 #ifdef _WIN32
 #include "common/RedtapeWindows.h"
+#include <psapi.h>
+#else
+#include <sys/resource.h>
 #endif
 
 #include "fmt/core.h"
@@ -22,6 +27,7 @@
 #include "common/Path.h"
 #include "common/SettingsWrapper.h"
 #include "common/StringUtil.h"
+#include "common/Timer.h"
 
 #include "pcsx2/PrecompiledHeader.h"
 
@@ -49,6 +55,10 @@ namespace GSRunner
 	static bool InitializeConfig();
 	static bool ParseCommandLineArgs(int argc, char* argv[], VMBootParameters& params);
 	static void DumpStats();
+	static void ResetStats();
+	static bool RunBatch();
+	static bool ResetPeakRSS();
+	static u64 GetPeakRSS();
 
 	static bool CreatePlatformWindow();
 	static void DestroyPlatformWindow();
@@ -66,6 +76,11 @@ static s32 s_loop_count = 1;
 static std::optional<bool> s_use_window;
 static bool s_no_console = false;
 
+// Batch benchmark mode, replays every dump in a directory.
+static std::string s_batch_directory;
+static std::string s_report_filename;
+static s32 s_batch_runs = 1;
+
 // Owned by the GS thread.
 static u32 s_dump_frame_number = 0;
 static u32 s_loop_number = s_loop_count;
@@ -76,6 +91,9 @@ static double s_last_barriers = 0;
 static double s_last_copies = 0;
 static double s_last_uploads = 0;
 static double s_last_readbacks = 0;
+static double s_last_prims = 0;
+static double s_last_texture_hits = 0;
+static double s_last_texture_misses = 0;
 static u64 s_total_internal_draws = 0;
 static u64 s_total_draws = 0;
 static u64 s_total_render_passes = 0;
@@ -83,6 +101,9 @@ static u64 s_total_barriers = 0;
 static u64 s_total_copies = 0;
 static u64 s_total_uploads = 0;
 static u64 s_total_readbacks = 0;
+static u64 s_total_prims = 0;
+static u64 s_total_texture_hits = 0;
+static u64 s_total_texture_misses = 0;
 static u32 s_total_frames = 0;
 static u32 s_total_drawn_frames = 0;
 
@@ -250,35 +271,39 @@ void Host::BeginPresentFrame()
 		GSQueueSnapshot(dump_path);
 	}
 
-	if (GSIsHardwareRenderer())
-	{
-		const u32 last_draws = s_total_internal_draws;
-		const u32 last_uploads = s_total_uploads;
+	const u32 last_draws = s_total_internal_draws;
+	const u32 last_uploads = s_total_uploads;
+
+	static constexpr auto update_stat = [](GSPerfMon::counter_t counter, u64& dst, double& last) {
+		// perfmon resets every 30 frames to zero
+		const double val = g_perfmon.GetCounter(counter);
+		dst += static_cast<u64>((val < last) ? val : (val - last));
+		last = val;
+	};
 
-		static constexpr auto update_stat = [](GSPerfMon::counter_t counter, u64& dst, double& last) {
-			// perfmon resets every 30 frames to zero
-			const double val = g_perfmon.GetCounter(counter);
-			dst += static_cast<u64>((val < last) ? val : (val - last));
-			last = val;
-		};
+	update_stat(GSPerfMon::Draw, s_total_internal_draws, s_last_internal_draws);
+	update_stat(GSPerfMon::Prim, s_total_prims, s_last_prims);
+	update_stat(GSPerfMon::TextureCacheHits, s_total_texture_hits, s_last_texture_hits);
+	update_stat(GSPerfMon::TextureCacheMisses, s_total_texture_misses, s_last_texture_misses);
 
-		update_stat(GSPerfMon::Draw, s_total_internal_draws, s_last_internal_draws);
+	if (GSIsHardwareRenderer())
+	{
 		update_stat(GSPerfMon::DrawCalls, s_total_draws, s_last_draws);
 		update_stat(GSPerfMon::RenderPasses, s_total_render_passes, s_last_render_passes);
 		update_stat(GSPerfMon::Barriers, s_total_barriers, s_last_barriers);
 		update_stat(GSPerfMon::TextureCopies, s_total_copies, s_last_copies);
 		update_stat(GSPerfMon::TextureUploads, s_total_uploads, s_last_uploads);
 		update_stat(GSPerfMon::Readbacks, s_total_readbacks, s_last_readbacks);
+	}
 
-		const bool idle_frame = s_total_frames && (last_draws == s_total_internal_draws && last_uploads == s_total_uploads);
+	const bool idle_frame = s_total_frames && (last_draws == s_total_internal_draws && last_uploads == s_total_uploads);
 
-		if(!idle_frame)
-			s_total_drawn_frames++;
+	if(!idle_frame)
+		s_total_drawn_frames++;
 
-		s_total_frames++;
+	s_total_frames++;
 
-		std::atomic_thread_fence(std::memory_order_release);
-	}
+	std::atomic_thread_fence(std::memory_order_release);
 }
 
 void Host::RequestResizeHostDisplay(s32 width, s32 height)
@@ -434,6 +459,9 @@ static void PrintCommandLineHelp(const char* progname)
 	std::fprintf(stderr, "  -dumpdir <dir>: Frame dump directory (will be dumped as filename_frameN.png).\n");
 	std::fprintf(stderr, "  -loop <count>: Loops dump playback N times. Defaults to 1. 0 will loop infinitely.\n");
 	std::fprintf(stderr, "  -renderer <renderer>: Sets the graphics renderer. Defaults to Auto.\n");
+	std::fprintf(stderr, "  -batch <dir>: Benchmarks every dump in a directory instead of a single file.\n");
+	std::fprintf(stderr, "  -runs <count>: Number of times each dump is replayed in batch mode. Defaults to 1.\n");
+	std::fprintf(stderr, "  -report <filename>: Writes the batch results to filename as JSON.\n");
 	std::fprintf(stderr, "  -window: Forces a window to be displayed.\n");
 	std::fprintf(stderr, "  -surfaceless: Disables showing a window.\n");
 	std::fprintf(stderr, "  -logfile <filename>: Writes emu log to filename.\n");
@@ -522,6 +550,8 @@ bool GSRunner::ParseCommandLineArgs(int argc, char* argv[], VMBootParameters& pa
 #endif
 				else if (StringUtil::Strcasecmp(rname, "sw") == 0)
 					type = GSRendererType::SW;
+				else if (StringUtil::Strcasecmp(rname, "null") == 0)
+					type = GSRendererType::Null;
 				else
 				{
 					Console.Error("Unknown renderer '%s'", rname);
@@ -532,6 +562,33 @@ bool GSRunner::ParseCommandLineArgs(int argc, char* argv[], VMBootParameters& pa
 				s_settings_interface.SetIntValue("EmuCore/GS", "Renderer", static_cast<int>(type));
 				continue;
 			}
+			else if (CHECK_ARG_PARAM("-batch"))
+			{
+				s_batch_directory = StringUtil::StripWhitespace(argv[++i]);
+				if (!FileSystem::DirectoryExists(s_batch_directory.c_str()))
+				{
+					Console.Error("Batch directory '%s' does not exist.", s_batch_directory.c_str());
+					return false;
+				}
+
+				continue;
+			}
+			else if (CHECK_ARG_PARAM("-runs"))
+			{
+				s_batch_runs = StringUtil::FromChars<s32>(argv[++i]).value_or(0);
+				if (s_batch_runs <= 0)
+				{
+					Console.Error("Invalid run count specified.");
+					return false;
+				}
+
+				continue;
+			}
+			else if (CHECK_ARG_PARAM("-report"))
+			{
+				s_report_filename = argv[++i];
+				continue;
+			}
 			else if (CHECK_ARG_PARAM("-renderhacks"))
 			{
 				std::string str(argv[++i]);
@@ -620,6 +677,23 @@ bool GSRunner::ParseCommandLineArgs(int argc, char* argv[], VMBootParameters& pa
 		params.filename += argv[i];
 	}
 
+	if (!s_batch_directory.empty())
+	{
+		if (!params.filename.empty())
+		{
+			Console.Error("A dump filename can't be used in batch mode.");
+			return false;
+		}
+
+		if (!s_output_prefix.empty())
+		{
+			Console.Error("Frame dumping is not supported in batch mode.");
+			return false;
+		}
+
+		return true;
+	}
+
 	if (params.filename.empty())
 	{
 		Console.Error("No dump filename provided.");
@@ -660,6 +734,238 @@ void GSRunner::DumpStats()
 	Console.WriteLn("============================================");
 }
 
+void GSRunner::ResetStats()
+{
+	s_last_internal_draws = 0;
+	s_last_draws = 0;
+	s_last_render_passes = 0;
+	s_last_barriers = 0;
+	s_last_copies = 0;
+	s_last_uploads = 0;
+	s_last_readbacks = 0;
+	s_last_prims = 0;
+	s_last_texture_hits = 0;
+	s_last_texture_misses = 0;
+	s_total_internal_draws = 0;
+	s_total_draws = 0;
+	s_total_render_passes = 0;
+	s_total_barriers = 0;
+	s_total_copies = 0;
+	s_total_uploads = 0;
+	s_total_readbacks = 0;
+	s_total_prims = 0;
+	s_total_texture_hits = 0;
+	s_total_texture_misses = 0;
+	s_total_frames = 0;
+	s_total_drawn_frames = 0;
+	std::atomic_thread_fence(std::memory_order_release);
+}
+
+bool GSRunner::ResetPeakRSS()
+{
+#if defined(__linux__)
+	// Writing 5 resets the peak (VmHWM) to the current RSS. Elsewhere the peak only ever grows.
+	std::FILE* fp = std::fopen("/proc/self/clear_refs", "w");
+	if (!fp)
+		return false;
+
+	const bool result = (std::fputs("5", fp) >= 0);
+	return (std::fclose(fp) == 0 && result);
+#else
+	return false;
+#endif
+}
+
+u64 GSRunner::GetPeakRSS()
+{
+#if defined(__linux__)
+	// ru_maxrss isn't affected by clear_refs, VmHWM is.
+	if (std::FILE* fp = std::fopen("/proc/self/status", "r"))
+	{
+		char line[256];
+		unsigned long long hwm_kb = 0;
+		bool found = false;
+		while (!found && std::fgets(line, sizeof(line), fp))
+			found = (std::sscanf(line, "VmHWM: %llu kB", &hwm_kb) == 1);
+		std::fclose(fp);
+		if (found)
+			return static_cast<u64>(hwm_kb) * 1024;
+	}
+#endif
+
+#if defined(_WIN32)
+	PROCESS_MEMORY_COUNTERS pmc = {};
+	if (!GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+		return 0;
+	return static_cast<u64>(pmc.PeakWorkingSetSize);
+#else
+	struct rusage usage = {};
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+		return 0;
+#if defined(__APPLE__)
+	return static_cast<u64>(usage.ru_maxrss);
+#else
+	// Linux reports kilobytes.
+	return static_cast<u64>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+static std::string EscapeJSONString(const std::string_view& str)
+{
+	std::string ret;
+	ret.reserve(str.size());
+	for (const char ch : str)
+	{
+		if (ch == '"' || ch == '\\')
+		{
+			ret.push_back('\\');
+			ret.push_back(ch);
+		}
+		else if (static_cast<unsigned char>(ch) < 0x20)
+		{
+			ret.append(fmt::format("\\u{:04x}", static_cast<unsigned>(ch)));
+		}
+		else
+		{
+			ret.push_back(ch);
+		}
+	}
+
+	return ret;
+}
+
+bool GSRunner::RunBatch()
+{
+	struct RunResult
+	{
+		double seconds;
+		u32 frames;
+		u32 drawn_frames;
+		u64 draws;
+		u64 prims;
+		u64 draw_calls;
+		u64 texture_hits;
+		u64 texture_misses;
+	};
+
+	FileSystem::FindResultsArray files;
+	FileSystem::FindFiles(s_batch_directory.c_str(), "*", FILESYSTEM_FIND_FILES, &files);
+
+	std::vector<std::string> dumps;
+	for (const FILESYSTEM_FIND_DATA& fd : files)
+	{
+		if (VMManager::IsGSDumpFileName(fd.FileName))
+			dumps.push_back(fd.FileName);
+	}
+	std::sort(dumps.begin(), dumps.end());
+
+	if (dumps.empty())
+	{
+		Console.Error("No GS dumps found in '%s'.", s_batch_directory.c_str());
+		return false;
+	}
+
+	const GSRendererType renderer = static_cast<GSRendererType>(
+		s_settings_interface.GetIntValue("EmuCore/GS", "Renderer", static_cast<int>(GSRendererType::Auto)));
+
+	std::string report;
+	report += fmt::format("{{\n  \"version\": \"{}\",\n  \"renderer\": \"{}\",\n  \"runs\": {},\n  \"dumps\": [",
+		EscapeJSONString(GIT_REV), Pcsx2Config::GSOptions::GetRendererName(renderer), s_batch_runs);
+
+	bool all_succeeded = true;
+	for (size_t dump_index = 0; dump_index < dumps.size(); dump_index++)
+	{
+		const std::string& path = dumps[dump_index];
+		Console.WriteLn(fmt::format("Benchmarking {} ({} of {})...", Path::GetFileName(path), dump_index + 1, dumps.size()));
+
+		// Where the peak can't be reset, it covers every dump run so far, not just this one.
+		const bool per_dump_peak = ResetPeakRSS();
+
+		std::vector<RunResult> results;
+		for (s32 run = 0; run < s_batch_runs; run++)
+		{
+			VMBootParameters params;
+			params.filename = path;
+
+			ResetStats();
+			if (!VMManager::Initialize(params))
+				break;
+
+			GSDumpReplayer::SetLoopCount(1);
+			VMManager::SetState(VMState::Running);
+
+			Common::Timer timer;
+			while (VMManager::GetState() == VMState::Running)
+				VMManager::Execute();
+			if (MTGS::IsOpen())
+				MTGS::WaitGS(false);
+			const double seconds = timer.GetTimeSeconds();
+
+			VMManager::Shutdown(false);
+
+			std::atomic_thread_fence(std::memory_order_acquire);
+			results.push_back({seconds, s_total_frames, s_total_drawn_frames, s_total_internal_draws, s_total_prims,
+				s_total_draws, s_total_texture_hits, s_total_texture_misses});
+		}
+
+		const bool succeeded = (results.size() == static_cast<size_t>(s_batch_runs));
+		all_succeeded &= succeeded;
+
+		const u64 peak_rss = GetPeakRSS();
+		double best_fps = 0.0;
+		double total_fps = 0.0;
+
+		report += fmt::format("{}\n    {{\n      \"name\": \"{}\",\n      \"success\": {},\n      \"{}\": {},\n      \"runs\": [",
+			(dump_index > 0) ? "," : "", EscapeJSONString(Path::GetFileName(path)), succeeded,
+			per_dump_peak ? "peak_rss" : "process_peak_rss", peak_rss);
+
+		for (size_t i = 0; i < results.size(); i++)
+		{
+			const RunResult& res = results[i];
+			const double fps = (res.seconds > 0.0) ? (res.frames / res.seconds) : 0.0;
+			const u64 lookups = res.texture_hits + res.texture_misses;
+			const double hit_rate = lookups ? (static_cast<double>(res.texture_hits) / static_cast<double>(lookups)) : 0.0;
+			best_fps = std::max(best_fps, fps);
+			total_fps += fps;
+
+			report += fmt::format("{}\n        {{ \"seconds\": {:.6f}, \"frames\": {}, \"drawn_frames\": {}, \"fps\": {:.3f}, "
+								  "\"draws\": {}, \"prims\": {}, \"draw_calls\": {}, \"texture_cache_hits\": {}, "
+								  "\"texture_cache_misses\": {}, \"texture_cache_hit_rate\": {:.4f} }}",
+				(i > 0) ? "," : "", res.seconds, res.frames, res.drawn_frames, fps, res.draws, res.prims, res.draw_calls,
+				res.texture_hits, res.texture_misses, hit_rate);
+		}
+
+		report += results.empty() ? "]\n    }" : "\n      ]\n    }";
+
+		if (succeeded)
+		{
+			Console.WriteLn(fmt::format("@BENCH@ {}: {:.2f} fps best, {:.2f} fps avg, {} {} MB", Path::GetFileName(path),
+				best_fps, total_fps / static_cast<double>(results.size()), per_dump_peak ? "peak RSS" : "process peak RSS",
+				peak_rss / _1mb));
+		}
+		else
+		{
+			Console.Error(fmt::format("@BENCH@ {}: failed", Path::GetFileName(path)));
+		}
+	}
+
+	report += "\n  ]\n}\n";
+
+	if (!s_report_filename.empty())
+	{
+		if (!FileSystem::WriteStringToFile(s_report_filename.c_str(), report))
+		{
+			Console.Error("Failed to write report to '%s'.", s_report_filename.c_str());
+			return false;
+		}
+
+		Console.WriteLn("Wrote report to %s.", s_report_filename.c_str());
+	}
+
+	return all_succeeded;
+}
+
 #ifdef _WIN32
 // We can't handle unicode in filenames if we don't use wmain on Win32.
 #define main real_main
@@ -692,7 +998,12 @@ int main(int argc, char* argv[])
 	VMManager::ApplySettings();
 	GSDumpReplayer::SetIsDumpRunner(true);
 
-	if (VMManager::Initialize(params))
+	bool result = true;
+	if (!s_batch_directory.empty())
+	{
+		result = GSRunner::RunBatch();
+	}
+	else if (VMManager::Initialize(params))
 	{
 		// run until end
 		GSDumpReplayer::SetLoopCount(s_loop_count);
@@ -706,7 +1017,7 @@ int main(int argc, char* argv[])
 	VMManager::Internal::CPUThreadShutdown();
 	GSRunner::DestroyPlatformWindow();
 
-	return EXIT_SUCCESS;
+	return result ? EXIT_SUCCESS : EXIT_FAILURE;
 }
 
 void Host::PumpMessagesOnCPUThread()
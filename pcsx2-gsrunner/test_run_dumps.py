@@ -10,7 +10,7 @@ from functools import partial
 def get_gs_name(path):
     lpath = path.lower()
 
-    for extension in [".gs", ".gs.xz", ".gs.zst"]:
+    for extension in [".gs", ".gs.xz", ".gs.zst", ".gs.zsc"]:
         if lpath.endswith(extension):
             return os.path.basename(path)[:-len(extension)]
 
@@ -30,7 +30,8 @@ static const char* SUPPORTED_FORMATS_STRING = QT_TRANSLATE_NOOP(GameListWidget,
 	".chd (Compressed Hunks of Data)\n"
 	".cso (Compressed ISO)\n"
 	".zso (Compressed ISO)\n"
-	".gz (Gzip Compressed ISO)");
+	".gz (Gzip Compressed ISO)\n"
+	".iso.zst (Seekable Zstandard Compressed ISO)");
 
 static constexpr float MIN_SCALE = 0.1f;
 static constexpr float MAX_SCALE = 2.0f;
@@ -55,7 +55,7 @@
 #endif
 
 const char* MainWindow::OPEN_FILE_FILTER =
-	QT_TRANSLATE_NOOP("MainWindow", "All File Types (*.bin *.iso *.cue *.mdf *.chd *.cso *.zso *.gz *.elf *.irx *.gs *.gs.xz *.gs.zst *.dump);;"
+	QT_TRANSLATE_NOOP("MainWindow", "All File Types (*.bin *.iso *.cue *.mdf *.chd *.cso *.zso *.gz *.iso.zst *.elf *.irx *.gs *.gs.xz *.gs.zst *.gs.zsc *.dump);;"
 									"Single-Track Raw Images (*.bin *.iso);;"
 									"Cue Sheets (*.cue);;"
 									"Media Descriptor File (*.mdf);;"
@@ -63,12 +63,13 @@ const char* MainWindow::OPEN_FILE_FILTER =
 									"CSO Images (*.cso);;"
 									"ZSO Images (*.zso);;"
 									"GZ Images (*.gz);;"
+									"Seekable Zstandard Images (*.iso.zst);;"
 									"ELF Executables (*.elf);;"
 									"IRX Executables (*.irx);;"
-									"GS Dumps (*.gs *.gs.xz *.gs.zst);;"
+									"GS Dumps (*.gs *.gs.xz *.gs.zst *.gs.zsc);;"
 									"Block Dumps (*.dump)");
 
-const char* MainWindow::DISC_IMAGE_FILTER = QT_TRANSLATE_NOOP("MainWindow", "All File Types (*.bin *.iso *.cue *.mdf *.chd *.cso *.zso *.gz *.dump);;"
+const char* MainWindow::DISC_IMAGE_FILTER = QT_TRANSLATE_NOOP("MainWindow", "All File Types (*.bin *.iso *.cue *.mdf *.chd *.cso *.zso *.gz *.iso.zst *.dump);;"
 																			"Single-Track Raw Images (*.bin *.iso);;"
 																			"Cue Sheets (*.cue);;"
 																			"Media Descriptor File (*.mdf);;"
@@ -76,6 +77,7 @@ const char* MainWindow::DISC_IMAGE_FILTER = QT_TRANSLATE_NOOP("MainWindow", "All
 																			"CSO Images (*.cso);;"
 																			"ZSO Images (*.zso);;"
 																			"GZ Images (*.gz);;"
+																			"Seekable Zstandard Images (*.iso.zst);;"
 																			"Block Dumps (*.dump)");
 
 MainWindow* g_main_window = nullptr;
@@ -241,6 +241,7 @@ GraphicsSettingsWidget::GraphicsSettingsWidget(SettingsWindow* dialog, QWidget*
 	SettingWidgetBinder::BindWidgetToIntSetting(sif, m_ui.extraSWThreads, "EmuCore/GS", "extrathreads", 2);
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.swAutoFlush, "EmuCore/GS", "autoflush_sw", true);
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.swMipmap, "EmuCore/GS", "mipmap", true);
+	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.swTileBinning, "EmuCore/GS", "SWTileBinning", false);
 
 	//////////////////////////////////////////////////////////////////////////
 	// Non-trivial settings
@@ -527,6 +528,10 @@ GraphicsSettingsWidget::GraphicsSettingsWidget(SettingsWindow* dialog, QWidget*
 
 		dialog->registerWidgetHelp(
 			m_ui.swMipmap, tr("Mipmapping"), tr("Checked"), tr("Enables mipmapping, which some games require to render correctly."));
+
+		dialog->registerWidgetHelp(m_ui.swTileBinning, tr("Tile-Binned Threading"), tr("Unchecked"),
+			tr("Splits the screen between rendering threads in tiles instead of rows, and only sends each thread the draws "
+			   "which touch its tiles. Scales better with many threads."));
 	}
 
 	// Hardware Fixes tab
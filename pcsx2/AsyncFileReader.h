@@ -12,6 +12,7 @@
 #elif defined(__POSIX__)
 #include <aio.h>
 #endif
+#include <algorithm>
 #include <memory>
 #include <string>
 
@@ -49,6 +50,25 @@ public:
 	virtual void SetBlockSize(u32 bytes) {}
 	virtual void SetDataOffset(u32 bytes) {}
 
+	// Hint that the given sectors will be read soon. Readers which can't cache ahead ignore it.
+	virtual void Prefetch(u32 sector, u32 count) {}
+
+	// Reads every block into `dst`, which must hold GetBlockCount() blocks of GetBlockSize() bytes.
+	// Readers which can decompress on several threads override this.
+	virtual bool ReadAll(void* dst)
+	{
+		u8* write = static_cast<u8*>(dst);
+		const u32 blocks = GetBlockCount();
+		for (u32 lsn = 0; lsn < blocks;)
+		{
+			const u32 count = std::min(blocks - lsn, 256u);
+			if (ReadSync(write + static_cast<size_t>(lsn) * m_blocksize, lsn, count) < 0)
+				return false;
+			lsn += count;
+		}
+		return true;
+	}
+
 	const std::string& GetFilename() const { return m_filename; }
 	u32 GetBlockSize() const { return m_blocksize; }
 };
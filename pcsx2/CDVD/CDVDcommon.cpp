@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: LGPL-3.0+
 
 #include "CDVD/CDVDcommon.h"
+#include "CDVD/DiscPrefetcher.h"
 #include "CDVD/IsoReader.h"
 #include "CDVD/IsoFileFormats.h"
 #include "DebugTools/SymbolMap.h"
@@ -346,6 +347,8 @@ bool DoCDVDopen(Error* error)
 		return false; // error! (handled by caller)
 
 	int cdtype = DoCDVDdetectDiskType();
+	if (cdtype != CDVD_TYPE_NODISC)
+		DiscPrefetcher::Open();
 
 	if (!EmuConfig.CdvdDumpBlocks || (cdtype == CDVD_TYPE_NODISC))
 	{
@@ -414,6 +417,7 @@ void DoCDVDclose()
 
 	blockDumpFile.Close();
 
+	DiscPrefetcher::Close();
 	CDVD->close();
 
 	DoCDVDresetDiskTypeCache();
@@ -465,6 +469,7 @@ s32 DoCDVDreadTrack(u32 lsn, int mode)
 
 	//DevCon.Warning("CDVD readTrack(lsn=%d,mode=%d)",params lsn, lastReadSize);
 	lastLSN = lsn;
+	DiscPrefetcher::RecordRead(lsn);
 	return CDVD->readTrack(lsn, mode);
 }
 
@@ -602,4 +607,5 @@ const CDVD_API CDVDapi_NoDisc =
 
 		NODISCreadSector,
 		NODISCgetDualInfo,
+		nullptr,
 };
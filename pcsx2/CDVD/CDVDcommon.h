@@ -103,6 +103,7 @@ typedef s32 (*_CDVDreadSector)(u8* buffer, u32 lsn, int mode);
 typedef s32 (*_CDVDgetDualInfo)(s32* dualType, u32* _layer1start);
 
 typedef void (*_CDVDnewDiskCB)(void (*callback)());
+typedef void (*_CDVDprefetch)(u32 lsn, u32 count);
 
 enum class CDVD_SourceType : uint8_t
 {
@@ -133,6 +134,9 @@ struct CDVD_API
 	// special functions, not in external interface yet
 	_CDVDreadSector readSector;
 	_CDVDgetDualInfo getDualInfo;
+
+	// Optional, warms the source's cache ahead of reads. Null if the source can't.
+	_CDVDprefetch prefetch;
 };
 
 // ----------------------------------------------------------------------------
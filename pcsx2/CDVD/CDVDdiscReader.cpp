@@ -546,4 +546,5 @@ const CDVD_API CDVDapi_Disc =
 
 		DISCreadSector,
 		DISCgetDualInfo,
+		nullptr,
 };
@@ -396,6 +396,11 @@ static void ISOnewDiskCB(void (* /* callback */)())
 {
 }
 
+static void ISOprefetch(u32 lsn, u32 count)
+{
+	iso.Prefetch(lsn, count);
+}
+
 const CDVD_API CDVDapi_Iso =
 	{
 		ISOclose,
@@ -415,4 +420,5 @@ const CDVD_API CDVDapi_Iso =
 
 		ISOreadSector,
 		ISOgetDualInfo,
+		ISOprefetch,
 };
@@ -189,9 +189,35 @@ bool ChdFileReader::Open2(std::string filename, Error* error)
 		file_size = static_cast<u64>(chd_header->unitbytes) * chd_header->unitcount;
 	}
 
+	// Parents have already been located and their headers cached, so extra handles are fairly cheap.
+	// If one fails to open, we just decompress on fewer threads.
+	SetReadContextCount(GetDesiredReadContextCount());
 	return true;
 }
 
+void ChdFileReader::SetReadContextCount(u32 count)
+{
+	const size_t extra = std::max(count, 1u) - 1;
+	while (m_extraChdFiles.size() > extra)
+	{
+		chd_close(m_extraChdFiles.back());
+		m_extraChdFiles.pop_back();
+	}
+
+	while (m_extraChdFiles.size() < extra)
+	{
+		auto extra_fp = FileSystem::OpenManagedSharedCFile(m_filename.c_str(), "rb", FileSystem::FileShareMode::DenyWrite);
+		if (!extra_fp)
+			break;
+
+		chd_file* extra_chd = OpenCHD(m_filename, std::move(extra_fp), nullptr, 0);
+		if (!extra_chd)
+			break;
+
+		m_extraChdFiles.push_back(extra_chd);
+	}
+}
+
 ThreadedFileReader::Chunk ChdFileReader::ChunkForOffset(u64 offset)
 {
 	Chunk chunk = {0};
@@ -208,12 +234,13 @@ ThreadedFileReader::Chunk ChdFileReader::ChunkForOffset(u64 offset)
 	return chunk;
 }
 
-int ChdFileReader::ReadChunk(void* dst, s64 chunkID)
+int ChdFileReader::ReadChunk(void* dst, s64 chunkID, u32 context)
 {
 	if (chunkID < 0)
 		return -1;
 
-	chd_error error = chd_read(ChdFile, chunkID, dst);
+	chd_file* chd = (context == 0) ? ChdFile : m_extraChdFiles[context - 1];
+	chd_error error = chd_read(chd, chunkID, dst);
 	if (error != CHDERR_NONE)
 	{
 		Console.Error("CDVD: chd_read returned error: %s", chd_error_string(error));
@@ -225,6 +252,10 @@ int ChdFileReader::ReadChunk(void* dst, s64 chunkID)
 
 void ChdFileReader::Close2()
 {
+	for (chd_file* extra_chd : m_extraChdFiles)
+		chd_close(extra_chd);
+	m_extraChdFiles.clear();
+
 	if (ChdFile)
 	{
 		chd_close(ChdFile);
@@ -232,6 +263,11 @@ void ChdFileReader::Close2()
 	}
 }
 
+u32 ChdFileReader::GetReadContextCount() const
+{
+	return static_cast<u32>(m_extraChdFiles.size()) + 1;
+}
+
 u32 ChdFileReader::GetBlockCount() const
 {
 	return (file_size - m_dataoffset) / m_internalBlockSize;
@@ -18,7 +18,11 @@ public:
 	bool Open2(std::string filename, Error* error) override;
 
 	Chunk ChunkForOffset(u64 offset) override;
-	int ReadChunk(void* dst, s64 blockID) override;
+	int ReadChunk(void* dst, s64 blockID, u32 context) override;
+	u32 GetReadContextCount() const override;
+	void SetReadContextCount(u32 count) override;
+	// Hunks are zlib/LZMA/FLAC, which take tens to hundreds of times longer than caching one.
+	bool CacheDecompressedChunks() const override { return true; }
 
 	void Close2(void) override;
 	uint GetBlockCount(void) const override;
@@ -27,6 +31,8 @@ private:
 	bool ParseTOC(u64* out_frame_count);
 
 	chd_file* ChdFile;
+	// Extra handles for decompressing on more than one thread, chd_read() isn't reentrant.
+	std::vector<chd_file*> m_extraChdFiles;
 	u64 file_size;
 	u32 hunk_size;
 };
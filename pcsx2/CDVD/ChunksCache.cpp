@@ -3,43 +3,135 @@
 
 #include "ChunksCache.h"
 
+#include "common/Pcsx2Defs.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace
+{
+	struct CacheKey
+	{
+		u32 owner;
+		s64 chunk;
+
+		bool operator==(const CacheKey& other) const { return owner == other.owner && chunk == other.chunk; }
+	};
+
+	struct CacheKeyHash
+	{
+		size_t operator()(const CacheKey& key) const
+		{
+			return std::hash<u64>()(static_cast<u64>(key.chunk) * 0x9E3779B97F4A7C15ull ^ key.owner);
+		}
+	};
+
+	struct CacheEntry
+	{
+		CacheKey key;
+		void* data;
+		s64 offset;
+		int size;
+		int coverage;
+	};
+
+	using EntryList = std::list<CacheEntry>;
+} // namespace
+
+static std::mutex s_mutex;
+static EntryList s_entries; // front is most recently used
+static std::unordered_map<CacheKey, EntryList::iterator, CacheKeyHash> s_lookup;
+static s64 s_size = 0;
+static s64 s_limit = 256 * _1mb;
+static std::atomic<u32> s_next_id{0};
+
+static void RemoveEntry(EntryList::iterator it)
+{
+	s_size -= it->size;
+	std::free(it->data);
+	s_lookup.erase(it->key);
+	s_entries.erase(it);
+}
+
+static void MatchLimit()
+{
+	while (!s_entries.empty() && s_size > s_limit)
+		RemoveEntry(std::prev(s_entries.end()));
+}
+
+ChunksCache::ChunksCache()
+	: m_id(s_next_id.fetch_add(1, std::memory_order_relaxed))
+{
+}
+
+ChunksCache::~ChunksCache()
+{
+	Clear();
+}
+
 void ChunksCache::SetLimit(uint megabytes)
 {
-	m_limit = (s64)megabytes * 1024 * 1024;
+	std::unique_lock lock(s_mutex);
+	s_limit = static_cast<s64>(megabytes) * _1mb;
 	MatchLimit();
 }
 
-void ChunksCache::MatchLimit(bool removeAll)
+s64 ChunksCache::GetSize()
 {
-	std::list<CacheEntry*>::reverse_iterator rit;
-	while (!m_entries.empty() && (removeAll || m_size > m_limit))
+	std::unique_lock lock(s_mutex);
+	return s_size;
+}
+
+void ChunksCache::Clear()
+{
+	std::unique_lock lock(s_mutex);
+	for (EntryList::iterator it = s_entries.begin(); it != s_entries.end();)
 	{
-		rit = m_entries.rbegin();
-		m_size -= (*rit)->size;
-		delete (*rit);
-		m_entries.pop_back();
+		EntryList::iterator next = std::next(it);
+		if (it->key.owner == m_id)
+			RemoveEntry(it);
+		it = next;
 	}
 }
 
-void ChunksCache::Take(void* pMallocedSrc, s64 offset, int length, int coverage)
+void ChunksCache::Take(s64 chunk, void* pMallocedSrc, s64 offset, int length, int coverage)
 {
-	m_entries.push_front(new CacheEntry(pMallocedSrc, offset, length, coverage));
-	m_size += length;
+	const CacheKey key{m_id, chunk};
+
+	std::unique_lock lock(s_mutex);
+	if (const auto it = s_lookup.find(key); it != s_lookup.end())
+		RemoveEntry(it->second);
+
+	s_entries.push_front(CacheEntry{key, pMallocedSrc, offset, length, coverage});
+	s_lookup.emplace(key, s_entries.begin());
+	s_size += length;
 	MatchLimit();
 }
 
-// By design, succeed only if the entire request is in a single cached chunk
-int ChunksCache::Read(void* pDest, s64 offset, int length)
+int ChunksCache::Read(s64 chunk, void* pDest, s64 offset, int length)
 {
-	for (auto it = m_entries.begin(); it != m_entries.end(); it++)
-	{
-		CacheEntry* e = *it;
-		if (e && offset >= e->offset && (offset + length) <= (e->offset + e->coverage))
-		{
-			if (it != m_entries.begin())
-				m_entries.splice(m_entries.begin(), m_entries, it); // Move to top (MRU)
-			return CopyAvailable(e->data, e->offset, e->size, pDest, offset, length);
-		}
-	}
-	return -1;
+	std::unique_lock lock(s_mutex);
+	const auto it = s_lookup.find(CacheKey{m_id, chunk});
+	if (it == s_lookup.end())
+		return -1;
+
+	// By design, succeed only if the entire request is in a single cached chunk
+	CacheEntry& e = *it->second;
+	if (offset < e.offset || (offset + length) > (e.offset + e.coverage))
+		return -1;
+
+	if (it->second != s_entries.begin())
+		s_entries.splice(s_entries.begin(), s_entries, it->second); // Move to top (MRU)
+
+	return CopyAvailable(e.data, e.offset, e.size, pDest, offset, length);
+}
+
+bool ChunksCache::Contains(s64 chunk) const
+{
+	std::unique_lock lock(s_mutex);
+	return s_lookup.contains(CacheKey{m_id, chunk});
 }
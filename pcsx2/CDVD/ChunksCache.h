@@ -7,21 +7,32 @@
 
 #include <algorithm>
 #include <cstring>
-#include <list>
 
+/// Cache of decompressed image data.
+///
+/// Every compressed reader gets its own ChunksCache, but the entries all live in one LRU with a
+/// single byte budget, so however many images are open, they stay within the configured amount
+/// of memory. Entries are indexed by a chunk number chosen by the reader, so chunks don't have to
+/// be the same size, but a read has to fall inside a single cached chunk.
 class ChunksCache
 {
 public:
-	ChunksCache(uint initialLimitMb)
-		: m_entries(0)
-		, m_size(0)
-		, m_limit(initialLimitMb * 1024 * 1024){};
-	~ChunksCache() { Clear(); };
-	void SetLimit(uint megabytes);
-	void Clear() { MatchLimit(true); };
+	ChunksCache();
+	~ChunksCache();
 
-	void Take(void* pMallocedSrc, s64 offset, int length, int coverage);
-	int Read(void* pDest, s64 offset, int length);
+	/// Sets the budget shared by all caches, evicting if necessary.
+	static void SetLimit(uint megabytes);
+	/// Bytes held by all caches.
+	static s64 GetSize();
+
+	void Clear();
+
+	/// Takes ownership of a malloc()ed buffer of `length` bytes, which covers `coverage` bytes from `offset`.
+	/// Coverage past the length is EOF, reads of it succeed with fewer bytes.
+	void Take(s64 chunk, void* pMallocedSrc, s64 offset, int length, int coverage);
+	/// Returns the number of bytes copied, or -1 if the range isn't cached.
+	int Read(s64 chunk, void* pDest, s64 offset, int length);
+	bool Contains(s64 chunk) const;
 
 	static int CopyAvailable(void* pSrc, s64 srcOffset, int srcSize,
 							 void* pDst, s64 dstOffset, int maxCopySize)
@@ -32,29 +43,5 @@ public:
 	};
 
 private:
-	class CacheEntry
-	{
-	public:
-		CacheEntry(void* pMallocedSrc, s64 offset, int length, int coverage)
-			: data(pMallocedSrc)
-			, offset(offset)
-			, coverage(coverage)
-			, size(length){};
-
-		~CacheEntry()
-		{
-			if (data)
-				free(data);
-		};
-
-		void* data;
-		s64 offset;
-		int coverage;
-		int size;
-	};
-
-	std::list<CacheEntry*> m_entries;
-	void MatchLimit(bool removeAll = false);
-	s64 m_size;
-	s64 m_limit;
+	u32 m_id;
 };
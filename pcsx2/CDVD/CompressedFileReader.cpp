@@ -6,6 +6,7 @@
 #include "ChdFileReader.h"
 #include "CsoFileReader.h"
 #include "GzippedFileReader.h"
+#include "ZstdFileReader.h"
 
 #include "common/FileSystem.h"
 #include "common/Path.h"
@@ -30,6 +31,10 @@ AsyncFileReader* CompressedFileReader::GetNewReader(const std::string& fileName)
 	if (StringUtil::compareNoCase(extension, "gz"))
 		return new GzippedFileReader();
 
+	// Seekable zstd doesn't have an extension of its own, so recognise it by its seek table instead.
+	if (ZstdFileReader::IsSeekableZstdFile(fileName))
+		return new ZstdFileReader();
+
 	// Not a known compressed format.
 	return nullptr;
 }
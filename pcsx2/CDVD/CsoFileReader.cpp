@@ -71,10 +71,11 @@ bool CsoFileReader::Open2(std::string filename, Error* error)
 {
 	Close2();
 	m_filename = std::move(filename);
-	m_src = FileSystem::OpenCFile(m_filename.c_str(), "rb", error);
+	m_contexts.resize(1);
+	m_contexts[0].src = FileSystem::OpenCFile(m_filename.c_str(), "rb", error);
 
 	bool success = false;
-	if (m_src && ReadFileHeader(error) && InitializeBuffers(error))
+	if (m_contexts[0].src && ReadFileHeader(error) && InitializeBuffers(error))
 	{
 		success = true;
 	}
@@ -84,14 +85,40 @@ bool CsoFileReader::Open2(std::string filename, Error* error)
 		Close2();
 		return false;
 	}
+
+	// Each extra handle lets another thread decompress frames at the same time.
+	// Not being able to open them isn't fatal, we just don't decompress in parallel.
+	SetReadContextCount(GetDesiredReadContextCount());
 	return true;
 }
 
+void CsoFileReader::SetReadContextCount(u32 count)
+{
+	count = std::max(count, 1u);
+	while (m_contexts.size() > count)
+	{
+		CloseContext(m_contexts.back());
+		m_contexts.pop_back();
+	}
+
+	while (m_contexts.size() < count)
+	{
+		ReadContext& ctx = m_contexts.emplace_back();
+		ctx.src = FileSystem::OpenCFile(m_filename.c_str(), "rb");
+		if (!ctx.src || !InitializeContext(ctx, nullptr))
+		{
+			CloseContext(ctx);
+			m_contexts.pop_back();
+			break;
+		}
+	}
+}
+
 bool CsoFileReader::ReadFileHeader(Error* error)
 {
 	CsoHeader hdr;
 
-	if (FileSystem::FSeek64(m_src, m_dataoffset, SEEK_SET) != 0 || std::fread(&hdr, 1, sizeof(hdr), m_src) != sizeof(hdr))
+	if (FileSystem::FSeek64(m_contexts[0].src, m_dataoffset, SEEK_SET) != 0 || std::fread(&hdr, 1, sizeof(hdr), m_contexts[0].src) != sizeof(hdr))
 	{
 		Error::SetString(error, "Failed to read CSO file header.");
 		return false;
@@ -123,33 +150,39 @@ bool CsoFileReader::InitializeBuffers(Error* error)
 	// Round up, since part of a frame requires a full frame.
 	u32 numFrames = (u32)((m_totalSize + m_frameSize - 1) / m_frameSize);
 
+	const u32 indexSize = numFrames + 1;
+	m_index = std::make_unique<u32[]>(indexSize);
+	if (fread(m_index.get(), sizeof(u32), indexSize, m_contexts[0].src) != indexSize)
+	{
+		Error::SetString(error, "Unable to read index data from CSO.");
+		return false;
+	}
+
+	return InitializeContext(m_contexts[0], error);
+}
+
+bool CsoFileReader::InitializeContext(ReadContext& ctx, Error* error)
+{
 	// We might read a bit of alignment too, so be prepared.
 	if (m_frameSize + (1 << m_indexShift) < CSO_READ_BUFFER_SIZE)
 	{
-		m_readBuffer = std::make_unique<u8[]>(CSO_READ_BUFFER_SIZE);
+		ctx.readBuffer = std::make_unique<u8[]>(CSO_READ_BUFFER_SIZE);
 	}
 	else
 	{
-		m_readBuffer = std::make_unique<u8[]>(m_frameSize + (1 << m_indexShift));
-	}
-
-	const u32 indexSize = numFrames + 1;
-	m_index = std::make_unique<u32[]>(indexSize);
-	if (fread(m_index.get(), sizeof(u32), indexSize, m_src) != indexSize)
-	{
-		Error::SetString(error, "Unable to read index data from CSO.");
-		return false;
+		ctx.readBuffer = std::make_unique<u8[]>(m_frameSize + (1 << m_indexShift));
 	}
 
 	// initialize zlib if not a ZSO
 	if (!m_uselz4)
 	{
-		m_z_stream = std::make_unique<z_stream>();
-		m_z_stream->zalloc = Z_NULL;
-		m_z_stream->zfree = Z_NULL;
-		m_z_stream->opaque = Z_NULL;
-		if (inflateInit2(m_z_stream.get(), -15) != Z_OK)
+		ctx.zStream = std::make_unique<z_stream>();
+		ctx.zStream->zalloc = Z_NULL;
+		ctx.zStream->zfree = Z_NULL;
+		ctx.zStream->opaque = Z_NULL;
+		if (inflateInit2(ctx.zStream.get(), -15) != Z_OK)
 		{
+			ctx.zStream.reset();
 			Error::SetString(error, "Unable to initialize zlib for CSO decompression.");
 			return false;
 		}
@@ -158,25 +191,38 @@ bool CsoFileReader::InitializeBuffers(Error* error)
 	return true;
 }
 
-void CsoFileReader::Close2()
+void CsoFileReader::CloseContext(ReadContext& ctx)
 {
-	m_filename.clear();
-
-	if (m_src)
+	if (ctx.src)
 	{
-		fclose(m_src);
-		m_src = nullptr;
+		fclose(ctx.src);
+		ctx.src = nullptr;
 	}
-	if (m_z_stream)
+	if (ctx.zStream)
 	{
-		inflateEnd(m_z_stream.get());
-		m_z_stream.reset();
+		inflateEnd(ctx.zStream.get());
+		ctx.zStream.reset();
 	}
 
-	m_readBuffer.reset();
+	ctx.readBuffer.reset();
+}
+
+void CsoFileReader::Close2()
+{
+	m_filename.clear();
+
+	for (ReadContext& ctx : m_contexts)
+		CloseContext(ctx);
+	m_contexts.clear();
+
 	m_index.reset();
 }
 
+u32 CsoFileReader::GetReadContextCount() const
+{
+	return static_cast<u32>(m_contexts.size());
+}
+
 u32 CsoFileReader::GetBlockCount() const
 {
 	return static_cast<u32>((m_totalSize - m_dataoffset) / m_blocksize);
@@ -198,11 +244,13 @@ ThreadedFileReader::Chunk CsoFileReader::ChunkForOffset(u64 offset)
 	return chunk;
 }
 
-int CsoFileReader::ReadChunk(void* dst, s64 chunkID)
+int CsoFileReader::ReadChunk(void* dst, s64 chunkID, u32 context)
 {
 	if (chunkID < 0)
 		return -1;
 
+	ReadContext& ctx = m_contexts[context];
+
 	const u32 frame = chunkID;
 
 	// Grab the index data for the frame we're about to read.
@@ -217,30 +265,30 @@ int CsoFileReader::ReadChunk(void* dst, s64 chunkID)
 	if (!compressed)
 	{
 		// Just read directly, easy.
-		if (FileSystem::FSeek64(m_src, frameRawPos, SEEK_SET) != 0)
+		if (FileSystem::FSeek64(ctx.src, frameRawPos, SEEK_SET) != 0)
 		{
 			Console.Error("Unable to seek to uncompressed CSO data.");
 			return 0;
 		}
-		return fread(dst, 1, m_frameSize, m_src);
+		return fread(dst, 1, m_frameSize, ctx.src);
 	}
 	else
 	{
-		if (FileSystem::FSeek64(m_src, frameRawPos, SEEK_SET) != 0)
+		if (FileSystem::FSeek64(ctx.src, frameRawPos, SEEK_SET) != 0)
 		{
 			Console.Error("Unable to seek to compressed CSO data.");
 			return 0;
 		}
 		// This might be less bytes than frameRawSize in case of padding on the last frame.
 		// This is because the index positions must be aligned.
-		const u32 readRawBytes = fread(m_readBuffer.get(), 1, frameRawSize, m_src);
+		const u32 readRawBytes = fread(ctx.readBuffer.get(), 1, frameRawSize, ctx.src);
 		bool success = false;
 
 		if (m_uselz4)
 		{
 			const int src_size = static_cast<int>(readRawBytes);
 			const int dst_size = static_cast<int>(m_frameSize);
-			const char* src_buf = reinterpret_cast<const char*>(m_readBuffer.get());
+			const char* src_buf = reinterpret_cast<const char*>(ctx.readBuffer.get());
 			char* dst_buf = static_cast<char*>(dst);
 			
 			const int res = LZ4_decompress_safe_partial(src_buf, dst_buf, src_size, dst_size, dst_size);
@@ -248,20 +296,20 @@ int CsoFileReader::ReadChunk(void* dst, s64 chunkID)
 		}
 		else
 		{
-			m_z_stream->next_in = m_readBuffer.get();
-			m_z_stream->avail_in = readRawBytes;
-			m_z_stream->next_out = static_cast<Bytef*>(dst);
-			m_z_stream->avail_out = m_frameSize;
+			ctx.zStream->next_in = ctx.readBuffer.get();
+			ctx.zStream->avail_in = readRawBytes;
+			ctx.zStream->next_out = static_cast<Bytef*>(dst);
+			ctx.zStream->avail_out = m_frameSize;
 
-			const int status = inflate(m_z_stream.get(), Z_FINISH);
-			success = (status == Z_STREAM_END && m_z_stream->total_out == m_frameSize);
+			const int status = inflate(ctx.zStream.get(), Z_FINISH);
+			success = (status == Z_STREAM_END && ctx.zStream->total_out == m_frameSize);
 		}
 
 		if (!success)
 			Console.Error(fmt::format("Unable to decompress CSO frame using {}", (m_uselz4)? "lz4":"zlib"));
 		
 		if (!m_uselz4)
-			inflateReset(m_z_stream.get());
+			inflateReset(ctx.zStream.get());
 
 		return success ? m_frameSize : 0;
 	}
@@ -13,8 +13,8 @@
 #define CSO_USE_CHUNKSCACHE 0
 
 #include "ThreadedFileReader.h"
-#include "ChunksCache.h"
 #include <zlib.h>
+#include <vector>
 
 struct CsoHeader;
 typedef struct z_stream_s z_stream;
@@ -30,7 +30,10 @@ public:
 	bool Open2(std::string filename, Error* error) override;
 
 	Chunk ChunkForOffset(u64 offset) override;
-	int ReadChunk(void* dst, s64 chunkID) override;
+	int ReadChunk(void* dst, s64 chunkID, u32 context) override;
+	u32 GetReadContextCount() const override;
+	void SetReadContextCount(u32 count) override;
+	bool CacheDecompressedChunks() const override { return CSO_USE_CHUNKSCACHE; }
 
 	void Close2() override;
 
@@ -44,15 +47,24 @@ private:
 	bool DecompressFrame(Bytef* dst, u32 frame, u32 readBufferSize);
 	bool DecompressFrame(u32 frame, u32 readBufferSize);
 
+	struct ReadContext
+	{
+		// The actual source cso file handle.
+		std::FILE* src = nullptr;
+		std::unique_ptr<u8[]> readBuffer;
+		std::unique_ptr<z_stream> zStream;
+	};
+
+	bool InitializeContext(ReadContext& ctx, Error* error);
+	static void CloseContext(ReadContext& ctx);
+
 	u32 m_frameSize = 0;
 	u8 m_frameShift = 0;
 	u8 m_indexShift = 0;
 	bool m_uselz4 = false; // flag to enable LZ4 decompression (ZSO files)
-	std::unique_ptr<u8[]> m_readBuffer;
 
 	std::unique_ptr<u32[]> m_index;
 	u64 m_totalSize = 0;
-	// The actual source cso file handle.
-	std::FILE* m_src = nullptr;
-	std::unique_ptr<z_stream> m_z_stream;
+	// One per decompression thread, the first also reads the header and index.
+	std::vector<ReadContext> m_contexts;
 };
@@ -0,0 +1,410 @@
+// SPDX-FileCopyrightText: 2002-2024 PCSX2 Dev Team
+// SPDX-License-Identifier: LGPL-3.0+
+
+#include "CDVD/DiscPrefetcher.h"
+#include "CDVD/CDVDcommon.h"
+#include "CDVD/IsoReader.h"
+#include "Config.h"
+
+#include "common/Console.h"
+#include "common/FileSystem.h"
+#include "common/Path.h"
+
+#include "fmt/format.h"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#define XXH_STATIC_LINKING_ONLY 1
+#define XXH_INLINE_ALL 1
+#include "xxhash.h"
+
+namespace DiscPrefetcher
+{
+	namespace
+	{
+		struct ProfileHeader
+		{
+			u32 magic;
+			u32 version;
+			u32 block_count;
+			u32 num_paths;
+			u32 num_extents;
+		};
+
+		struct ProfileExtent
+		{
+			u32 lsn;
+			u32 count;
+			u32 hits;
+			u32 age;
+			s32 path_index;
+			u32 file_offset;
+		};
+
+		struct Extent
+		{
+			u32 lsn;
+			u32 count;
+			u32 hits;
+			u32 age;
+			bool seen;
+		};
+
+		struct FileRange
+		{
+			u32 lsn;
+			u32 sectors;
+			std::string path;
+		};
+	} // namespace
+
+	static std::string GetProfileFileName();
+	static std::vector<FileRange> GetFileRanges(IsoReader& isor);
+	static void LoadProfile(IsoReader& isor);
+	static void SaveProfile();
+	static void PrefetchExtents();
+	static void FlushStream();
+	static void Reset();
+
+	static constexpr u32 PROFILE_MAGIC = 0x46504344; // DCPF
+	static constexpr u32 PROFILE_VERSION = 1;
+
+	// Caps the profile for games which read all over the disc, e.g. streaming open worlds.
+	static constexpr size_t MAX_EXTENTS = 16384;
+
+	// Sessions an extent can go unread before it's dropped, so the profile follows what's actually played.
+	static constexpr u32 MAX_EXTENT_AGE = 8;
+
+	// CHD stores subchannel data alongside every sector, so budgets assume the largest sector we'll see.
+	static constexpr u32 MAX_RAW_SECTOR_SIZE = 2448;
+
+	static bool s_active = false;
+	static bool s_dirty = false;
+	static u64 s_profile_key = 0;
+	static u32 s_block_count = 0;
+
+	// Extents in the order they were first read, which is also the order they're prefetched in.
+	static std::vector<Extent> s_extents;
+	static std::unordered_map<u32, size_t> s_extent_lookup;
+
+	// Sequential run currently being read.
+	static u32 s_stream_start = 0;
+	static u32 s_stream_end = 0;
+} // namespace DiscPrefetcher
+
+std::string DiscPrefetcher::GetProfileFileName()
+{
+	return Path::Combine(EmuFolders::Cache, fmt::format("disc_prefetch_{:016X}.profile", s_profile_key));
+}
+
+std::vector<DiscPrefetcher::FileRange> DiscPrefetcher::GetFileRanges(IsoReader& isor)
+{
+	std::vector<FileRange> files;
+	isor.ForEachFile([&files](const std::string& path, const IsoReader::ISODirectoryEntry& de) {
+		const u32 sectors = (de.length_le + (IsoReader::SECTOR_SIZE - 1)) / IsoReader::SECTOR_SIZE;
+		if (sectors > 0)
+			files.push_back(FileRange{de.location_le, sectors, path});
+	});
+
+	std::sort(files.begin(), files.end(), [](const FileRange& lhs, const FileRange& rhs) { return lhs.lsn < rhs.lsn; });
+	return files;
+}
+
+void DiscPrefetcher::Open()
+{
+	Reset();
+
+	if (EmuConfig.CdvdPrefetchCacheSize == 0 || CDVDsys_GetSourceType() != CDVD_SourceType::Iso || !CDVD->prefetch)
+		return;
+
+	// No filesystem, no profile. Audio CDs end up here.
+	IsoReader isor;
+	if (!isor.Open())
+		return;
+
+	// Only the identifying parts of the volume descriptor, the layout can change between builds of an image.
+	const IsoReader::ISOPrimaryVolumeDescriptor& pvd = isor.GetPVD();
+	XXH64_state_t state;
+	XXH64_reset(&state, 0);
+	XXH64_update(&state, pvd.system_identifier, sizeof(pvd.system_identifier));
+	XXH64_update(&state, pvd.volume_identifier, sizeof(pvd.volume_identifier));
+	XXH64_update(&state, pvd.volume_set_identifier, sizeof(pvd.volume_set_identifier));
+	XXH64_update(&state, pvd.publisher_identifier, sizeof(pvd.publisher_identifier));
+	XXH64_update(&state, pvd.application_identifier, sizeof(pvd.application_identifier));
+	XXH64_update(&state, &pvd.volume_creation_time, sizeof(pvd.volume_creation_time));
+	s_profile_key = XXH64_digest(&state);
+
+	cdvdTD td;
+	CDVD->getTD(0, &td);
+	s_block_count = td.lsn;
+	s_active = true;
+
+	LoadProfile(isor);
+	PrefetchExtents();
+}
+
+void DiscPrefetcher::Close()
+{
+	if (!s_active)
+		return;
+
+	FlushStream();
+	if (s_dirty)
+		SaveProfile();
+
+	Reset();
+}
+
+void DiscPrefetcher::RecordRead(u32 lsn)
+{
+	if (!s_active)
+		return;
+
+	if (lsn == s_stream_end)
+	{
+		s_stream_end++;
+		return;
+	}
+
+	// Re-reading part of the current run doesn't start a new one.
+	if (lsn >= s_stream_start && lsn < s_stream_end)
+		return;
+
+	FlushStream();
+	s_stream_start = lsn;
+	s_stream_end = lsn + 1;
+}
+
+void DiscPrefetcher::FlushStream()
+{
+	if (s_stream_end == s_stream_start)
+		return;
+
+	const u32 count = s_stream_end - s_stream_start;
+	s_stream_end = s_stream_start;
+
+	const auto it = s_extent_lookup.find(s_stream_start);
+	if (it != s_extent_lookup.end())
+	{
+		Extent& extent = s_extents[it->second];
+		extent.count = std::max(extent.count, count);
+		extent.hits = std::min(extent.hits + 1, 0xFFFFu);
+		extent.seen = true;
+		s_dirty = true;
+		return;
+	}
+
+	if (s_extents.size() >= MAX_EXTENTS)
+		return;
+
+	s_extent_lookup.emplace(s_stream_start, s_extents.size());
+	s_extents.push_back(Extent{s_stream_start, count, 1, 0, true});
+	s_dirty = true;
+}
+
+void DiscPrefetcher::LoadProfile(IsoReader& isor)
+{
+	const std::string filename = GetProfileFileName();
+	const std::optional<std::vector<u8>> data = FileSystem::ReadBinaryFile(filename.c_str());
+	if (!data.has_value())
+		return;
+
+	ProfileHeader header;
+	if (data->size() < sizeof(header))
+		return;
+
+	std::memcpy(&header, data->data(), sizeof(header));
+	if (header.magic != PROFILE_MAGIC || header.version != PROFILE_VERSION || header.num_extents > MAX_EXTENTS)
+	{
+		Console.WarningFmt("Ignoring outdated disc prefetch profile '{}'", Path::GetFileName(filename));
+		return;
+	}
+
+	size_t pos = sizeof(header);
+	std::vector<std::string> paths;
+	paths.reserve(header.num_paths);
+	for (u32 i = 0; i < header.num_paths; i++)
+	{
+		u16 length;
+		if ((pos + sizeof(length)) > data->size())
+			break;
+		std::memcpy(&length, data->data() + pos, sizeof(length));
+		pos += sizeof(length);
+		if ((pos + length) > data->size())
+			break;
+		paths.emplace_back(reinterpret_cast<const char*>(data->data() + pos), length);
+		pos += length;
+	}
+	if (paths.size() != header.num_paths || (pos + header.num_extents * sizeof(ProfileExtent)) != data->size())
+	{
+		Console.WarningFmt("Ignoring corrupted disc prefetch profile '{}'", Path::GetFileName(filename));
+		return;
+	}
+
+	// Same layout, the sectors can be used as-is. Otherwise, find where each file went, and drop
+	// anything which wasn't inside a file.
+	const bool same_layout = (header.block_count == s_block_count);
+	std::unordered_map<std::string, std::pair<u32, u32>> file_locations;
+	if (!same_layout && !paths.empty())
+	{
+		for (FileRange& file : GetFileRanges(isor))
+			file_locations.emplace(std::move(file.path), std::make_pair(file.lsn, file.sectors));
+	}
+
+	for (u32 i = 0; i < header.num_extents; i++, pos += sizeof(ProfileExtent))
+	{
+		ProfileExtent pe;
+		std::memcpy(&pe, data->data() + pos, sizeof(pe));
+
+		u32 lsn = pe.lsn;
+		if (!same_layout)
+		{
+			if (pe.path_index < 0 || static_cast<u32>(pe.path_index) >= paths.size())
+				continue;
+
+			const auto it = file_locations.find(paths[pe.path_index]);
+			if (it == file_locations.end() || pe.file_offset >= it->second.second)
+				continue;
+
+			lsn = it->second.first + pe.file_offset;
+		}
+
+		if (pe.count == 0 || lsn >= s_block_count || s_extent_lookup.contains(lsn))
+			continue;
+
+		s_extent_lookup.emplace(lsn, s_extents.size());
+		s_extents.push_back(Extent{lsn, std::min(pe.count, s_block_count - lsn), pe.hits, pe.age, false});
+	}
+
+	DevCon.WriteLnFmt("Loaded {} extents from disc prefetch profile '{}'{}", s_extents.size(), Path::GetFileName(filename),
+		same_layout ? "" : " (relocated by file)");
+}
+
+void DiscPrefetcher::SaveProfile()
+{
+	// Anything which hasn't been read for a while probably belongs to a part of the game that isn't played anymore.
+	std::erase_if(s_extents, [](Extent& extent) {
+		if (extent.seen)
+		{
+			extent.age = 0;
+			return false;
+		}
+
+		return (++extent.age > MAX_EXTENT_AGE);
+	});
+
+	// Remember which file each extent belongs to, in case the image is rebuilt later.
+	std::vector<FileRange> files;
+	IsoReader isor;
+	if (isor.Open())
+		files = GetFileRanges(isor);
+
+	std::vector<s32> file_path_index(files.size(), -1);
+	std::vector<const std::string*> paths;
+	std::vector<ProfileExtent> profile_extents;
+	profile_extents.reserve(s_extents.size());
+	for (const Extent& extent : s_extents)
+	{
+		ProfileExtent pe = {extent.lsn, extent.count, extent.hits, extent.age, -1, 0};
+
+		auto it = std::upper_bound(files.begin(), files.end(), extent.lsn,
+			[](u32 lsn, const FileRange& file) { return lsn < file.lsn; });
+		if (it != files.begin())
+		{
+			--it;
+			if (extent.lsn < (it->lsn + it->sectors))
+			{
+				const size_t file_index = static_cast<size_t>(it - files.begin());
+				if (file_path_index[file_index] < 0)
+				{
+					file_path_index[file_index] = static_cast<s32>(paths.size());
+					paths.push_back(&it->path);
+				}
+
+				pe.path_index = file_path_index[file_index];
+				pe.file_offset = extent.lsn - it->lsn;
+			}
+		}
+
+		profile_extents.push_back(pe);
+	}
+
+	std::vector<u8> data(sizeof(ProfileHeader));
+	const ProfileHeader header = {PROFILE_MAGIC, PROFILE_VERSION, s_block_count, static_cast<u32>(paths.size()),
+		static_cast<u32>(profile_extents.size())};
+	std::memcpy(data.data(), &header, sizeof(header));
+	for (const std::string* path : paths)
+	{
+		const u16 length = static_cast<u16>(std::min<size_t>(path->size(), 0xFFFF));
+		const size_t pos = data.size();
+		data.resize(pos + sizeof(length) + length);
+		std::memcpy(&data[pos], &length, sizeof(length));
+		std::memcpy(&data[pos + sizeof(length)], path->data(), length);
+	}
+
+	const size_t pos = data.size();
+	data.resize(pos + profile_extents.size() * sizeof(ProfileExtent));
+	std::memcpy(&data[pos], profile_extents.data(), profile_extents.size() * sizeof(ProfileExtent));
+
+	const std::string filename = GetProfileFileName();
+	if (!FileSystem::WriteBinaryFile(filename.c_str(), data.data(), data.size()))
+	{
+		Console.ErrorFmt("Failed to write disc prefetch profile '{}'", filename);
+		return;
+	}
+
+	DevCon.WriteLnFmt("Wrote {} extents in {} files to disc prefetch profile '{}'", profile_extents.size(), paths.size(),
+		Path::GetFileName(filename));
+}
+
+void DiscPrefetcher::PrefetchExtents()
+{
+	if (s_extents.empty())
+		return;
+
+	std::vector<size_t> order(s_extents.size());
+	std::iota(order.begin(), order.end(), 0);
+
+	// If it doesn't all fit, keep what's read most often, then put it back in the order it's needed.
+	const u64 budget = static_cast<u64>(EmuConfig.CdvdPrefetchCacheSize) * _1mb / MAX_RAW_SECTOR_SIZE;
+	u64 total = 0;
+	for (const Extent& extent : s_extents)
+		total += extent.count;
+	if (total > budget)
+	{
+		std::stable_sort(order.begin(), order.end(),
+			[](size_t lhs, size_t rhs) { return s_extents[lhs].hits > s_extents[rhs].hits; });
+
+		total = 0;
+		size_t num_kept = 0;
+		for (; num_kept < order.size() && (total + s_extents[order[num_kept]].count) <= budget; num_kept++)
+			total += s_extents[order[num_kept]].count;
+
+		order.resize(num_kept);
+		std::sort(order.begin(), order.end());
+	}
+
+	for (const size_t index : order)
+		CDVD->prefetch(s_extents[index].lsn, s_extents[index].count);
+
+	Console.WriteLnFmt("Prefetching {:.1f} MB of disc data in {} extents.",
+		static_cast<double>(total * IsoReader::SECTOR_SIZE) / static_cast<double>(_1mb), order.size());
+}
+
+void DiscPrefetcher::Reset()
+{
+	s_active = false;
+	s_dirty = false;
+	s_profile_key = 0;
+	s_block_count = 0;
+	s_extents.clear();
+	s_extent_lookup.clear();
+	s_stream_start = 0;
+	s_stream_end = 0;
+}
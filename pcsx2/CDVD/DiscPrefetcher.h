@@ -0,0 +1,25 @@
+// SPDX-FileCopyrightText: 2002-2024 PCSX2 Dev Team
+// SPDX-License-Identifier: LGPL-3.0+
+
+#pragma once
+
+#include "common/Pcsx2Defs.h"
+
+/// Learns which parts of a disc image a game reads, and warms the image reader's cache with them
+/// on later boots.
+///
+/// Drive reads are collected into extents: runs of sequential sectors, counted each time the
+/// game comes back to them. Extents inside a file are also stored relative to that file, so a
+/// rebuilt image with a different layout can still use the profile. Profiles live in the cache
+/// folder, keyed by the disc's volume descriptor.
+namespace DiscPrefetcher
+{
+	/// Loads the profile for the disc which was just opened, and queues its extents for prefetching.
+	void Open();
+
+	/// Saves what was learned this session. Must be called while the disc is still readable.
+	void Close();
+
+	/// Called for every sector the drive reads.
+	void RecordRead(u32 lsn);
+} // namespace DiscPrefetcher
@@ -2,7 +2,6 @@
 // SPDX-License-Identifier: LGPL-3.0+
 
 #include "Config.h"
-#include "ChunksCache.h"
 #include "GzippedFileReader.h"
 #include "Host.h"
 #include "CDVD/zlib_indexed.h"
@@ -12,10 +11,11 @@
 #include "common/Error.h"
 #include "common/Path.h"
 #include "common/StringUtil.h"
-#include "common/Timer.h"
 
 #include "fmt/format.h"
 
+#include <algorithm>
+
 #define GZIP_ID "PCSX2.index.gzip.v1|"
 #define GZIP_ID_LEN (sizeof(GZIP_ID) - 1) /* sizeof includes the \0 terminator */
 
@@ -145,10 +145,8 @@ static std::string iso2indexname(const std::string& isoname, Error* error)
 }
 
 GzippedFileReader::GzippedFileReader()
-	: m_cache(GZFILE_CACHE_SIZE_MB)
 {
 	m_blocksize = 2048;
-	AsyncPrefetchReset();
 }
 
 GzippedFileReader::~GzippedFileReader()
@@ -156,102 +154,6 @@ GzippedFileReader::~GzippedFileReader()
 	Close();
 }
 
-void GzippedFileReader::InitZstates()
-{
-	if (m_zstates)
-	{
-		delete[] m_zstates;
-		m_zstates = 0;
-	}
-	if (!m_pIndex)
-		return;
-
-	// having another extra element helps avoiding logic for last (so 2+ instead of 1+)
-	int size = 2 + m_pIndex->uncompressed_size / m_pIndex->span;
-	m_zstates = new Czstate[size]();
-}
-
-#ifndef _WIN32
-void GzippedFileReader::AsyncPrefetchReset(){};
-void GzippedFileReader::AsyncPrefetchOpen(){};
-void GzippedFileReader::AsyncPrefetchClose(){};
-void GzippedFileReader::AsyncPrefetchChunk(s64 dummy){};
-void GzippedFileReader::AsyncPrefetchCancel(){};
-#else
-// AsyncPrefetch works as follows:
-// ater extracting a chunk from the compressed file, ask the OS to asynchronously
-// read the next chunk from the file, and then completely ignore the result and
-// cancel the async read before the next extract. the next extract then reads the
-// data from the disk buf if it's overlapping/contained within the chunk we've
-// asked the OS to prefetch, then the OS is likely to already have it cached.
-// This procedure is frequently able to overcome seek time due to fragmentation of the
-// compressed file on disk without any meaningful penalty.
-// This system is only enabled for win32 where we have this async read request.
-void GzippedFileReader::AsyncPrefetchReset()
-{
-	hOverlappedFile = INVALID_HANDLE_VALUE;
-	asyncInProgress = false;
-}
-
-void GzippedFileReader::AsyncPrefetchOpen()
-{
-	hOverlappedFile = CreateFile(
-		FileSystem::GetWin32Path(m_filename).c_str(),
-		GENERIC_READ,
-		FILE_SHARE_READ,
-		NULL,
-		OPEN_EXISTING,
-		FILE_FLAG_SEQUENTIAL_SCAN | FILE_FLAG_OVERLAPPED,
-		NULL);
-};
-
-void GzippedFileReader::AsyncPrefetchClose()
-{
-	AsyncPrefetchCancel();
-
-	if (hOverlappedFile != INVALID_HANDLE_VALUE)
-		CloseHandle(hOverlappedFile);
-
-	AsyncPrefetchReset();
-};
-
-void GzippedFileReader::AsyncPrefetchChunk(s64 start)
-{
-	if (hOverlappedFile == INVALID_HANDLE_VALUE || asyncInProgress)
-	{
-		Console.Warning("Unexpected file handle or progress state. Aborting prefetch.");
-		return;
-	}
-
-	LARGE_INTEGER offset;
-	offset.QuadPart = start;
-
-	DWORD bytesToRead = GZFILE_READ_CHUNK_SIZE;
-
-	ZeroMemory(&asyncOperationContext, sizeof(asyncOperationContext));
-	asyncOperationContext.hEvent = 0;
-	asyncOperationContext.Offset = offset.LowPart;
-	asyncOperationContext.OffsetHigh = offset.HighPart;
-
-	ReadFile(hOverlappedFile, mDummyAsyncPrefetchTarget, bytesToRead, NULL, &asyncOperationContext);
-	asyncInProgress = true;
-};
-
-void GzippedFileReader::AsyncPrefetchCancel()
-{
-	if (!asyncInProgress)
-		return;
-
-	if (!CancelIo(hOverlappedFile))
-	{
-		Console.Warning("Canceling gz prefetch failed. Following prefetching will not work.");
-		return;
-	}
-
-	asyncInProgress = false;
-};
-#endif /* _WIN32 */
-
 bool GzippedFileReader::OkIndex(Error* error)
 {
 	if (m_pIndex)
@@ -275,18 +177,18 @@ bool GzippedFileReader::OkIndex(Error* error)
 			Console.Warning("It will work fine, but if you want to generate a new index with default intervals, delete this index file.");
 			Console.Warning("(smaller intervals mean bigger index file and quicker but more frequent decompressions)");
 		}
-		InitZstates();
 		return true;
 	}
 
 	// No valid index file. Generate an index
 	Console.Warning("This may take a while (but only once). Scanning compressed file to generate a quick access index...");
 
-	const s64 prevoffset = FileSystem::FTell64(m_src);
+	std::FILE* src = m_contexts[0].src;
+	const s64 prevoffset = FileSystem::FTell64(src);
 	Access* index = nullptr;
-	int len = build_index(m_src, GZFILE_SPAN_DEFAULT, &index);
+	int len = build_index(src, GZFILE_SPAN_DEFAULT, &index);
 	printf("\n"); // build_index prints progress without \n's
-	FileSystem::FSeek64(m_src, prevoffset, SEEK_SET);
+	FileSystem::FSeek64(src, prevoffset, SEEK_SET);
 
 	if (len >= 0)
 	{
@@ -297,185 +199,122 @@ bool GzippedFileReader::OkIndex(Error* error)
 	{
 		Error::SetString(error, fmt::format("ERROR ({}): Index could not be generated for file '{}'", len, m_filename));
 		free_index(index);
-		InitZstates();
 		return false;
 	}
 
-	InitZstates();
 	return true;
 }
 
-bool GzippedFileReader::Open(std::string filename, Error* error)
+bool GzippedFileReader::Open2(std::string filename, Error* error)
 {
-	Close();
+	Close2();
 	m_filename = std::move(filename);
-	if (!(m_src = FileSystem::OpenCFile(m_filename.c_str(), "rb", error)) || !OkIndex(error))
+	m_contexts.resize(1);
+	m_contexts[0].src = FileSystem::OpenCFile(m_filename.c_str(), "rb", error);
+	m_contexts[0].zstate = std::make_unique<Czstate>();
+	if (!m_contexts[0].src || !OkIndex(error) || m_pIndex->have <= 0)
 	{
-		Close();
+		Close2();
 		return false;
 	}
 
-	AsyncPrefetchOpen();
+	// Each extra handle lets another thread inflate a different span at the same time.
+	// Not being able to open them isn't fatal, we just don't decompress in parallel.
+	SetReadContextCount(GetDesiredReadContextCount());
 	return true;
-};
-
-void GzippedFileReader::BeginRead(void* pBuffer, uint sector, uint count)
-{
-	// No a-sync support yet, implement as sync
-	mBytesRead = ReadSync(pBuffer, sector, count);
 }
 
-int GzippedFileReader::FinishRead()
+void GzippedFileReader::SetReadContextCount(u32 count)
 {
-	int res = mBytesRead;
-	mBytesRead = -1;
-	return res;
-}
+	count = std::max(count, 1u);
+	while (m_contexts.size() > count)
+	{
+		CloseContext(m_contexts.back());
+		m_contexts.pop_back();
+	}
 
-void GzippedFileReader::CancelRead()
-{
+	while (m_contexts.size() < count)
+	{
+		ReadContext& ctx = m_contexts.emplace_back();
+		ctx.src = FileSystem::OpenCFile(m_filename.c_str(), "rb");
+		if (!ctx.src)
+		{
+			m_contexts.pop_back();
+			break;
+		}
+		ctx.zstate = std::make_unique<Czstate>();
+	}
 }
 
-int GzippedFileReader::ReadSync(void* pBuffer, uint sector, uint count)
+void GzippedFileReader::CloseContext(ReadContext& ctx)
 {
-	s64 offset = (s64)sector * m_blocksize + m_dataoffset;
-	int bytesToRead = count * m_blocksize;
-	int res = _ReadSync(pBuffer, offset, bytesToRead);
-	if (res < 0)
-		Console.Error("Error: iso-gzip read unsuccessful.");
-	return res;
+	ctx.zstate.reset();
+	if (ctx.src)
+	{
+		fclose(ctx.src);
+		ctx.src = nullptr;
+	}
 }
 
-// If we have a valid and adequate zstate for this span, use it, else, use the index
-s64 GzippedFileReader::GetOptimalExtractionStart(s64 offset)
+u32 GzippedFileReader::GetReadContextCount() const
 {
-	int span = m_pIndex->span;
-	Czstate& cstate = m_zstates[offset / span];
-	s64 stateOffset = cstate.state.isValid ? cstate.state.out_offset : 0;
-	if (stateOffset && stateOffset <= offset)
-		return stateOffset; // state is faster than indexed
-
-	// If span is not exact multiples of GZFILE_READ_CHUNK_SIZE (because it was configured badly),
-	// we fallback to always GZFILE_READ_CHUNK_SIZE boundaries
-	if (span % GZFILE_READ_CHUNK_SIZE)
-		return offset / GZFILE_READ_CHUNK_SIZE * GZFILE_READ_CHUNK_SIZE;
-
-	return span * (offset / span); // index direct access boundaries
+	return static_cast<u32>(m_contexts.size());
 }
 
-int GzippedFileReader::_ReadSync(void* pBuffer, s64 offset, uint bytesToRead)
+ThreadedFileReader::Chunk GzippedFileReader::ChunkForOffset(u64 offset)
 {
-	if (!OkIndex(nullptr))
-		return -1;
-
-	if ((offset + bytesToRead) > m_pIndex->uncompressed_size)
-		return -1;
-
-	// Without all the caching, chunking and states, this would be enough:
-	// return extract(m_src, m_pIndex, offset, (unsigned char*)pBuffer, bytesToRead);
-
-	// Split request to GZFILE_READ_CHUNK_SIZE chunks at GZFILE_READ_CHUNK_SIZE boundaries
-	uint maxInChunk = GZFILE_READ_CHUNK_SIZE - offset % GZFILE_READ_CHUNK_SIZE;
-	if (bytesToRead > maxInChunk)
+	Chunk chunk = {0};
+	if (!m_pIndex || offset >= static_cast<u64>(m_pIndex->uncompressed_size))
 	{
-		int first = _ReadSync(pBuffer, offset, maxInChunk);
-		if (first != (int)maxInChunk)
-			return first; // EOF or failure
-
-		int rest = _ReadSync((char*)pBuffer + maxInChunk, offset + maxInChunk, bytesToRead - maxInChunk);
-		if (rest < 0)
-			return rest;
-
-		return first + rest;
+		chunk.chunkID = -1;
+		return chunk;
 	}
 
-	// From here onwards it's guarenteed that the request is inside a single GZFILE_READ_CHUNK_SIZE boundaries
+	// Access points are roughly a span apart but land on deflate block boundaries, so look them up
+	// rather than dividing by the span.
+	const Point* const begin = m_pIndex->list;
+	const Point* const end = begin + m_pIndex->have;
+	const Point* const next = std::upper_bound(begin, end, static_cast<s64>(offset),
+		[](s64 value, const Point& point) { return value < point.out; });
+	const s64 start = (next == begin) ? 0 : (next - 1)->out;
+	const s64 stop = (next == end) ? m_pIndex->uncompressed_size : next->out;
+
+	chunk.chunkID = std::max<s64>(next - begin - 1, 0);
+	chunk.offset = static_cast<u64>(start);
+	chunk.length = static_cast<u32>(stop - start);
+	return chunk;
+}
 
-	int res = m_cache.Read(pBuffer, offset, bytesToRead);
-	if (res >= 0)
-		return res;
+int GzippedFileReader::ReadChunk(void* dst, s64 chunkID, u32 context)
+{
+	if (chunkID < 0 || chunkID >= m_pIndex->have)
+		return -1;
 
-	// Not available from cache. Decompress from optimal starting
-	// point in GZFILE_READ_CHUNK_SIZE chunks and cache each chunk.
-	Common::Timer start_time;
-	s64 extractOffset = GetOptimalExtractionStart(offset); // guaranteed in GZFILE_READ_CHUNK_SIZE boundaries
-	int size = offset + maxInChunk - extractOffset;
-	unsigned char* extracted = (unsigned char*)malloc(size);
+	ReadContext& ctx = m_contexts[context];
+	const Chunk chunk = ChunkForOffset(static_cast<u64>(m_pIndex->list[chunkID].out));
 
-	int span = m_pIndex->span;
-	int spanix = extractOffset / span;
-	AsyncPrefetchCancel();
-	res = extract(m_src, m_pIndex, extractOffset, extracted, size, &(m_zstates[spanix].state));
+	// Starting exactly on an access point means nothing is inflated just to be skipped.
+	const int res = extract(ctx.src, m_pIndex, static_cast<s64>(chunk.offset), static_cast<unsigned char*>(dst),
+		static_cast<int>(chunk.length), &ctx.zstate->state);
 	if (res < 0)
-	{
-		free(extracted);
-		return res;
-	}
-	AsyncPrefetchChunk(getInOffset(&(m_zstates[spanix].state)));
-
-	int copied = ChunksCache::CopyAvailable(extracted, extractOffset, res, pBuffer, offset, bytesToRead);
-
-	if (m_zstates[spanix].state.isValid && (extractOffset + res) / span != offset / span)
-	{
-		// The state no longer matches this span.
-		// move the state to the appropriate span because it will be faster than using the index
-		int targetix = (extractOffset + res) / span;
-		m_zstates[targetix].Kill();
-		// We have elements for the entire file, and another one.
-		m_zstates[targetix].state.in_offset = m_zstates[spanix].state.in_offset;
-		m_zstates[targetix].state.isValid = m_zstates[spanix].state.isValid;
-		m_zstates[targetix].state.out_offset = m_zstates[spanix].state.out_offset;
-		inflateCopy(&m_zstates[targetix].state.strm, &m_zstates[spanix].state.strm);
-
-		m_zstates[spanix].Kill();
-	}
-
-	if (size <= GZFILE_READ_CHUNK_SIZE)
-		m_cache.Take(extracted, extractOffset, res, size);
-	else
-	{ // split into cacheable chunks
-		for (int i = 0; i < size; i += GZFILE_READ_CHUNK_SIZE)
-		{
-			int available = std::clamp(res - i, 0, GZFILE_READ_CHUNK_SIZE);
-			void* chunk = available ? malloc(available) : 0;
-			if (available)
-				memcpy(chunk, extracted + i, available);
-			m_cache.Take(chunk, extractOffset + i, available, std::min(size - i, GZFILE_READ_CHUNK_SIZE));
-		}
-		free(extracted);
-	}
-
-	if (const double duration = start_time.GetTimeMilliseconds(); duration > 10)
-	{
-		Console.WriteLn(Color_Gray, "gunzip: chunk #%5d-%2d : %1.2f MB - %d ms",
-			(int)(offset / 4 / 1024 / 1024),
-			(int)(offset % (4 * 1024 * 1024) / GZFILE_READ_CHUNK_SIZE),
-			(float)size / 1024 / 1024,
-			duration);
-	}
+		Console.Error("Error: iso-gzip read unsuccessful.");
 
-	return copied;
+	return res;
 }
 
-void GzippedFileReader::Close()
+void GzippedFileReader::Close2()
 {
 	m_filename.clear();
+
+	for (ReadContext& ctx : m_contexts)
+		CloseContext(ctx);
+	m_contexts.clear();
+
 	if (m_pIndex)
 	{
 		free_index((Access*)m_pIndex);
 		m_pIndex = 0;
 	}
-
-	InitZstates(); // results in delete because no index
-	m_cache.Clear();
-
-	if (m_src)
-	{
-		fclose(m_src);
-		m_src = nullptr;
-	}
-
-	AsyncPrefetchClose();
 }
 
 u32 GzippedFileReader::GetBlockCount() const
@@ -484,13 +323,3 @@ u32 GzippedFileReader::GetBlockCount() const
 	// FIXME? : Shouldn't it be uint and (size - m_dataoffset) / m_blocksize ?
 	return (int)((m_pIndex ? m_pIndex->uncompressed_size : 0) / m_blocksize);
 }
-
-void GzippedFileReader::SetBlockSize(u32 bytes)
-{
-	m_blocksize = bytes;
-}
-
-void GzippedFileReader::SetDataOffset(u32 bytes)
-{
-	m_dataoffset = bytes;
-}
@@ -3,39 +3,38 @@
 
 #pragma once
 
-#include "AsyncFileReader.h"
-#include "ChunksCache.h"
+#include "ThreadedFileReader.h"
 #include "zlib_indexed.h"
 
+#include <memory>
+#include <vector>
+
 static constexpr int GZFILE_SPAN_DEFAULT = (1048576 * 4); /* distance between direct access points when creating a new index */
-static constexpr int GZFILE_READ_CHUNK_SIZE = (256 * 1024); /* zlib extraction chunks size (at 0-based boundaries) */
-static constexpr int GZFILE_CACHE_SIZE_MB = 200; /* cache size for extracted data. must be at least GZFILE_READ_CHUNK_SIZE (in MB)*/
 
 typedef struct zstate Zstate;
 
-class GzippedFileReader final : public AsyncFileReader
+/// Each span between two index access points can be inflated on its own, so those are the chunks
+/// the worker pool decompresses in parallel.
+class GzippedFileReader final : public ThreadedFileReader
 {
 	DeclareNoncopyableObject(GzippedFileReader);
 
 public:
 	GzippedFileReader();
-	~GzippedFileReader();;
-
-	bool Open(std::string filename, Error* error) override;
+	~GzippedFileReader() override;
 
-	int ReadSync(void* pBuffer, u32 sector, u32 count) override;
+	bool Open2(std::string filename, Error* error) override;
 
-	void BeginRead(void* pBuffer, u32 sector, u32 count) override;
-	int FinishRead() override;
-	void CancelRead() override;
+	Chunk ChunkForOffset(u64 offset) override;
+	int ReadChunk(void* dst, s64 chunkID, u32 context) override;
+	u32 GetReadContextCount() const override;
+	void SetReadContextCount(u32 count) override;
+	bool CacheDecompressedChunks() const override { return true; }
 
-	void Close() override;
+	void Close2() override;
 
 	u32 GetBlockCount() const override;
 
-	void SetBlockSize(u32 bytes) override;
-	void SetDataOffset(u32 bytes) override;
-
 private:
 	class Czstate
 	{
@@ -51,29 +50,17 @@ private:
 		Zstate state;
 	};
 
+	struct ReadContext
+	{
+		std::FILE* src = nullptr;
+		// Left at the end of the last chunk, so the next one on this context doesn't need the index.
+		std::unique_ptr<Czstate> zstate;
+	};
+
 	bool OkIndex(Error* error); // Verifies that we have an index, or try to create one
-	s64 GetOptimalExtractionStart(s64 offset);
-	int _ReadSync(void* pBuffer, s64 offset, uint bytesToRead);
-	void InitZstates();
+	static void CloseContext(ReadContext& ctx);
 
-	int mBytesRead = 0; // Temp sync read result when simulating async read
 	Access* m_pIndex = nullptr; // Quick access index
-	Czstate* m_zstates = nullptr;
-	FILE* m_src = nullptr;
-
-	ChunksCache m_cache;
-
-#ifdef _WIN32
-	// Used by async prefetch
-	HANDLE hOverlappedFile = INVALID_HANDLE_VALUE;
-	OVERLAPPED asyncOperationContext = {};
-	bool asyncInProgress = false;
-	char mDummyAsyncPrefetchTarget[GZFILE_READ_CHUNK_SIZE];
-#endif
-
-	void AsyncPrefetchReset();
-	void AsyncPrefetchOpen();
-	void AsyncPrefetchClose();
-	void AsyncPrefetchChunk(s64 dummy);
-	void AsyncPrefetchCancel();
+	// One per decompression thread, the first is also used to build the index.
+	std::vector<ReadContext> m_contexts;
 };
@@ -6,8 +6,11 @@
 #include "Host.h"
 
 #include "common/Assertions.h"
+#include "common/BitUtils.h"
 #include "common/Console.h"
 #include "common/Error.h"
+#include "common/HostSys.h"
+#include "common/Timer.h"
 
 #include "fmt/format.h"
 
@@ -40,6 +43,12 @@ int InputIsoFile::ReadSync(u8* dst, uint lsn)
 		return -1;
 	}
 
+	if (m_preload)
+	{
+		std::memcpy(dst + m_blockofs, m_preload + static_cast<size_t>(lsn) * m_blocksize, m_blocksize);
+		return m_blocksize;
+	}
+
 	return m_reader->ReadSync(dst + m_blockofs, lsn, 1);
 }
 
@@ -55,6 +64,10 @@ void InputIsoFile::BeginRead2(uint lsn)
 		return;
 	}
 
+	// Preloaded images are read straight out of memory in FinishRead3().
+	if (m_preload)
+		return;
+
 	if (lsn >= m_read_lsn && lsn < (m_read_lsn + m_read_count))
 	{
 		// Already buffered
@@ -75,6 +88,14 @@ void InputIsoFile::BeginRead2(uint lsn)
 	m_read_inprogress = true;
 }
 
+void InputIsoFile::Prefetch(uint lsn, uint count)
+{
+	if (lsn >= m_blocks || m_preload)
+		return;
+
+	m_reader->Prefetch(lsn, std::min(count, m_blocks - lsn));
+}
+
 int InputIsoFile::FinishRead3(u8* dst, uint mode)
 {
 	// Do nothing for out of bounds disc sector reads. It prevents some games
@@ -135,8 +156,12 @@ int InputIsoFile::FinishRead3(u8* dst, uint mode)
 
 	length = end - _offset;
 
-	uint read_offset = (m_current_lsn - m_read_lsn) * m_blocksize;
-	memcpy(dst + diff, m_readbuffer + ndiff + read_offset, length);
+	const u8* src;
+	if (m_preload)
+		src = m_preload + static_cast<size_t>(m_current_lsn) * m_blocksize;
+	else
+		src = m_readbuffer + (m_current_lsn - m_read_lsn) * m_blocksize;
+	memcpy(dst + diff, src + ndiff, length);
 
 	if (m_type == ISOTYPE_CD && diff >= 12)
 	{
@@ -173,6 +198,8 @@ void InputIsoFile::_init()
 	m_current_lsn = -1;
 	m_read_lsn = -1;
 	m_reader = NULL;
+	m_preload = nullptr;
+	m_preload_size = 0;
 }
 
 // Tests the specified filename to see if it is a supported ISO type.  This function typically
@@ -267,11 +294,58 @@ bool InputIsoFile::Open(std::string srcfile, Error* error, bool testOnly)
 	DevCon.WriteLn("  blocksize   = %u", m_blocksize);
 	DevCon.WriteLn("  blockoffset = %d", m_blockofs);
 
+	// Blockdumps only hold the sectors which were dumped, there's nothing to gain from reading them up front.
+	if (EmuConfig.CdvdPreloadImage && !isBlockdump)
+		Preload();
+
+	return true;
+}
+
+bool InputIsoFile::Preload()
+{
+	const u64 size = static_cast<u64>(m_blocks) * m_blocksize;
+	const u64 limit = EmuConfig.CdvdPreloadMemoryLimit ?
+						  (static_cast<u64>(EmuConfig.CdvdPreloadMemoryLimit) * _1mb) :
+						  (GetPhysicalMemory() / 2);
+	if (size > limit)
+	{
+		Console.WarningFmt("isoFile: Image is {} MB, preload limit is {} MB, streaming it instead.", size / _1mb, limit / _1mb);
+		return false;
+	}
+
+	m_preload_size = Common::PageAlign(static_cast<size_t>(size));
+	m_preload = static_cast<u8*>(HostSys::Mmap(nullptr, m_preload_size, PageAccess_ReadWrite()));
+	if (!m_preload)
+	{
+		Console.WarningFmt("isoFile: Failed to allocate {} MB for preloading, streaming the image instead.", size / _1mb);
+		m_preload_size = 0;
+		return false;
+	}
+
+	if (EmuConfig.CdvdPreloadHugePages && !HostSys::AdviseHugePages(m_preload, m_preload_size))
+		Console.Warning("isoFile: Huge pages aren't available, preloading with normal pages.");
+
+	Common::Timer timer;
+	if (!m_reader->ReadAll(m_preload))
+	{
+		Console.Error("isoFile: Failed to preload the image, streaming it instead.");
+		HostSys::Munmap(m_preload, m_preload_size);
+		m_preload = nullptr;
+		m_preload_size = 0;
+		return false;
+	}
+
+	const double seconds = timer.GetTimeSeconds();
+	const double mb = static_cast<double>(size) / _1mb;
+	Console.WriteLnFmt(Color_StrongGreen, "isoFile: Preloaded {:.1f} MB in {:.2f} seconds ({:.1f} MB/s).", mb, seconds,
+		(seconds > 0.0) ? (mb / seconds) : 0.0);
 	return true;
 }
 
 void InputIsoFile::Close()
 {
+	HostSys::Munmap(m_preload, m_preload_size);
+
 	delete m_reader;
 	m_reader = NULL;
 
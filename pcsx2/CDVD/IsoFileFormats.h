@@ -56,6 +56,10 @@ protected:
 	uint m_read_count;
 	u8 m_readbuffer[MaxReadUnit * CD_FRAMESIZE_RAW];
 
+	// The whole image, when it's been preloaded into memory.
+	u8* m_preload;
+	size_t m_preload_size;
+
 public:
 	InputIsoFile();
 	~InputIsoFile();
@@ -79,6 +83,7 @@ public:
 	int ReadSync(u8* dst, uint lsn);
 
 	void BeginRead2(uint lsn);
+	void Prefetch(uint lsn, uint count);
 	int FinishRead3(u8* dest, uint mode);
 
 protected:
@@ -86,6 +91,10 @@ protected:
 
 	bool tryIsoType(u32 size, u32 offset, u32 blockofs);
 	void FindParts();
+
+	// Reads every block into memory, so later reads don't touch the reader. Returns false
+	// and leaves the image streaming if it's over the memory limit or can't be read.
+	bool Preload();
 };
 
 class OutputIsoFile final
@@ -252,6 +252,59 @@ std::vector<std::string> IsoReader::GetFilesInDirectory(const std::string_view&
 	return files;
 }
 
+bool IsoReader::ForEachFile(const FileCallback& callback, Error* error)
+{
+	const ISODirectoryEntry* root_de = reinterpret_cast<const ISODirectoryEntry*>(m_pvd.root_directory_entry);
+	return ForEachFileInDirectory(std::string(), root_de->location_le, root_de->length_le, 0, callback, error);
+}
+
+bool IsoReader::ForEachFileInDirectory(const std::string& base_path, u32 directory_record_lba, u32 directory_record_size,
+	u32 depth, const FileCallback& callback, Error* error)
+{
+	// Guard against directories which contain themselves on broken images.
+	static constexpr u32 MAX_DEPTH = 32;
+	if (depth >= MAX_DEPTH)
+	{
+		Error::SetString(error, fmt::format("Directory '{}' is nested too deeply", base_path));
+		return false;
+	}
+
+	const u32 num_sectors = (directory_record_size + (SECTOR_SIZE - 1)) / SECTOR_SIZE;
+	u8 sector_buffer[SECTOR_SIZE];
+	for (u32 i = 0; i < num_sectors; i++)
+	{
+		if (!ReadSector(sector_buffer, directory_record_lba + i, error))
+			return false;
+
+		u32 sector_offset = 0;
+		while ((sector_offset + sizeof(ISODirectoryEntry)) < SECTOR_SIZE)
+		{
+			const ISODirectoryEntry* de = reinterpret_cast<const ISODirectoryEntry*>(&sector_buffer[sector_offset]);
+			if (de->entry_length < sizeof(ISODirectoryEntry))
+				break;
+
+			const std::string_view de_filename = GetDirectoryEntryFileName(sector_buffer, sector_offset);
+			sector_offset += de->entry_length;
+
+			if (de_filename.empty() || de_filename == "." || de_filename == "..")
+				continue;
+
+			const std::string path = fmt::format("{}/{}", base_path, de_filename);
+			if (de->flags & ISODirectoryEntryFlag_Directory)
+			{
+				if (!ForEachFileInDirectory(path, de->location_le, de->length_le, depth + 1, callback, error))
+					return false;
+			}
+			else
+			{
+				callback(path, *de);
+			}
+		}
+	}
+
+	return true;
+}
+
 bool IsoReader::FileExists(const std::string_view& path, Error* error)
 {
 	auto de = LocateFile(path, error);
@@ -5,6 +5,7 @@
 
 #include "common/Pcsx2Defs.h"
 
+#include <functional>
 #include <memory>
 #include <optional>
 #include <string>
@@ -146,6 +147,11 @@ public:
 
 	std::vector<std::string> GetFilesInDirectory(const std::string_view& path, Error* error = nullptr);
 
+	/// Calls the callback for every file on the disc, walking directories recursively.
+	/// Paths are in the same form as GetFilesInDirectory() returns.
+	using FileCallback = std::function<void(const std::string& path, const ISODirectoryEntry& de)>;
+	bool ForEachFile(const FileCallback& callback, Error* error = nullptr);
+
 	std::optional<ISODirectoryEntry> LocateFile(const std::string_view& path, Error* error);
 
 	bool FileExists(const std::string_view& path, Error* error = nullptr);
@@ -162,5 +168,8 @@ private:
 	std::optional<ISODirectoryEntry> LocateFile(const std::string_view& path, u8* sector_buffer,
 		u32 directory_record_lba, u32 directory_record_size, Error* error);
 
+	bool ForEachFileInDirectory(const std::string& base_path, u32 directory_record_lba, u32 directory_record_size,
+		u32 depth, const FileCallback& callback, Error* error);
+
 	ISOPrimaryVolumeDescriptor m_pvd = {};
 };
@@ -2,27 +2,45 @@
 // SPDX-License-Identifier: LGPL-3.0+
 
 #include "ThreadedFileReader.h"
+#include "Config.h"
 
+#include "common/Console.h"
 #include "common/Threading.h"
+#include "common/Timer.h"
 
-// Make sure buffer size is bigger than the cutoff where PCSX2 emulates a seek
-// If buffers are smaller than that, we can't keep up with linear reads
-static constexpr u32 MINIMUM_SIZE = 128 * 1024;
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
 
-ThreadedFileReader::ThreadedFileReader()
+// Make sure the readahead window is bigger than the cutoff where PCSX2 emulates a seek
+// If it's smaller than that, we can't keep up with linear reads
+static constexpr u32 MINIMUM_READAHEAD_SIZE = 256 * 1024;
+// Every chunk in the window holds a slot, so formats with big chunks (whole gzip spans) get fewer of them
+static constexpr u32 MAXIMUM_READAHEAD_SIZE = 16 * 1024 * 1024;
+static constexpr u32 MAX_WORKERS = 8;
+static constexpr u32 MAX_PRELOAD_THREADS = 32;
+
+ThreadedFileReader::ThreadedFileReader() = default;
+
+ThreadedFileReader::~ThreadedFileReader()
 {
-	m_readThread = std::thread([](ThreadedFileReader* r){ r->Loop(); }, this);
+	StopWorkers();
 }
 
-ThreadedFileReader::~ThreadedFileReader()
+u32 ThreadedFileReader::GetWorkerCount()
 {
-	m_quit = true;
-	(void)std::lock_guard<std::mutex>{m_mtx};
-	m_condition.notify_one();
-	m_readThread.join();
-	for (auto& buffer : m_buffer)
-		if (buffer.ptr)
-			free(buffer.ptr);
+	// The emulator already keeps a few cores busy, so only take a share of what's left by default.
+	u32 workers = EmuConfig.CdvdDecompressionThreads;
+	if (workers == 0)
+		workers = std::clamp(std::thread::hardware_concurrency() / 4, 1u, 4u);
+
+	return std::min(workers, MAX_WORKERS);
+}
+
+u32 ThreadedFileReader::GetDesiredReadContextCount()
+{
+	return GetWorkerCount() + 1;
 }
 
 size_t ThreadedFileReader::CopyBlocks(void* dst, const void* src, size_t size) const
@@ -45,316 +63,385 @@ size_t ThreadedFileReader::CopyBlocks(void* dst, const void* src, size_t size) c
 	}
 }
 
-void ThreadedFileReader::Loop()
+void ThreadedFileReader::WorkerLoop(u32 context)
 {
 	Threading::SetNameOfCurrentThread("ISO Decompress");
 
 	std::unique_lock<std::mutex> lock(m_mtx);
-
-	while (true)
+	for (;;)
 	{
-		while (!m_requestSize && !m_quit)
-			m_condition.wait(lock);
-
+		m_workCondition.wait(lock, [this]() { return m_quit || !m_queue.empty() || !m_prefetchQueue.empty(); });
 		if (m_quit)
 			return;
 
-		u64 requestOffset;
-		u32 requestSize;
-
-		bool ok = true;
-		m_running = true;
-
-		for (;;)
+		if (m_queue.empty())
 		{
-			void* ptr = m_requestPtr.load(std::memory_order_acquire);
-			requestOffset = m_requestOffset;
-			requestSize = m_requestSize;
-			lock.unlock();
-
-			if (ptr)
-				ok = Decompress(ptr, requestOffset, requestSize);
-
-			// There's a potential for a race here when doing synchronous reads. Basically, another request can come in,
-			// after we release the lock, but before we store null to indicate we're finished. So, we do a compare-exchange
-			// instead, to detect when this happens, and if so, reload all the inputs and try again.
-			if (!m_requestPtr.compare_exchange_strong(ptr, nullptr, std::memory_order_release))
-			{
-				lock.lock();
-				continue;
-			}
-
-			m_condition.notify_one();
-			break;
+			const Chunk chunk = m_prefetchQueue.front();
+			m_prefetchQueue.pop_front();
+			PrefetchChunk(chunk, context, lock);
+			continue;
 		}
 
-		if (ok)
-		{
-			// Readahead
-			Chunk chunk = ChunkForOffset(requestOffset + requestSize);
-			if (chunk.chunkID >= 0)
-			{
-				int buffersFilled = 0;
-				Buffer* buf = GetBlockPtr(chunk);
-				// Cancel readahead if a new request comes in
-				while (buf && !m_requestPtr.load(std::memory_order_acquire))
-				{
-					u32 bufsize = buf->size.load(std::memory_order_relaxed);
-					chunk = ChunkForOffset(buf->offset + bufsize);
-					if (chunk.chunkID < 0)
-						break;
-					if (buf->offset + bufsize != chunk.offset || chunk.length + bufsize > buf->cap)
-					{
-						buffersFilled++;
-						if (buffersFilled >= 2)
-							break;
-						buf = GetBlockPtr(chunk);
-					}
-					else
-					{
-						int amt = ReadChunk(static_cast<char*>(buf->ptr) + bufsize, chunk.chunkID);
-						if (amt <= 0)
-							break;
-						buf->size.store(bufsize + amt, std::memory_order_release);
-					}
-				}
-			}
-		}
+		Slot* slot = m_queue.front();
+		m_queue.pop_front();
+		if (slot->state != SlotState::Queued)
+			continue;
 
-		lock.lock();
-		if (requestSize == m_requestSize && requestOffset == m_requestOffset && !m_requestPtr)
+		// Readahead from before a seek isn't wanted anymore, don't let it hold up the new position.
+		if (slot->generation != m_generation)
 		{
-			// If no one's added more work, mark this one as done
-			m_requestSize = 0;
+			slot->state = SlotState::Empty;
+			continue;
 		}
 
-		m_running = false;
-		m_condition.notify_one(); // For things waiting on m_running == false
+		DecompressSlot(slot, context, lock);
 	}
 }
 
-ThreadedFileReader::Buffer* ThreadedFileReader::GetBlockPtr(const Chunk& block)
+void ThreadedFileReader::StartWorkers()
 {
-	for (int i = 0; i < static_cast<int>(std::size(m_buffer)); i++)
-	{
-		u32 size = m_buffer[i].size.load(std::memory_order_relaxed);
-		u64 offset = m_buffer[i].offset;
-		if (size && offset <= block.offset && offset + size >= block.offset + block.length)
-		{
-			m_nextBuffer = (i + 1) % std::size(m_buffer);
-			return m_buffer + i;
-		}
-	}
+	m_contextCount = std::max(GetReadContextCount(), 1u);
+	m_contextMutexes = std::make_unique<std::mutex[]>(m_contextCount);
+
+	// Context 0 belongs to the reading thread, unless the reader can only do one thing at a time.
+	const u32 workers = std::clamp(m_contextCount - 1, 1u, GetWorkerCount());
+	m_quit = false;
+	m_stats = {};
+	m_stats.worker_count = workers;
+	for (u32 i = 0; i < workers; i++)
+		m_workers.emplace_back(&ThreadedFileReader::WorkerLoop, this, (m_contextCount > 1) ? (i + 1) : 0);
+}
+
+void ThreadedFileReader::StopWorkers()
+{
+	if (m_workers.empty())
+		return;
 
-	Buffer& buf = m_buffer[m_nextBuffer];
 	{
-		// This can be called from both the read thread threads in ReadSync
-		// Calls from ReadSync are done with the lock already held to keep the read thread out
-		// Therefore we should only lock on the read thread
-		std::unique_lock<std::mutex> lock(m_mtx, std::defer_lock);
-		if (std::this_thread::get_id() == m_readThread.get_id())
-			lock.lock();
-		u32 size = std::max(block.length, MINIMUM_SIZE);
-		if (buf.cap < size)
-		{
-			buf.ptr = realloc(buf.ptr, size);
-			buf.cap = size;
-		}
-		buf.size.store(0, std::memory_order_relaxed);
+		std::lock_guard<std::mutex> lock(m_mtx);
+		m_quit = true;
 	}
-	int size = ReadChunk(buf.ptr, block.chunkID);
-	if (size > 0)
+	m_workCondition.notify_all();
+	for (std::thread& thread : m_workers)
+		thread.join();
+	m_workers.clear();
+
+	if (m_stats.chunks_decompressed > 0)
 	{
-		buf.offset = block.offset;
-		buf.size.store(size, std::memory_order_release);
-		m_nextBuffer = (m_nextBuffer + 1) % std::size(m_buffer);
-		return &buf;
+		const double mb = static_cast<double>(m_stats.bytes_decompressed) / 1048576.0;
+		const double seconds = static_cast<double>(m_stats.decompress_time_ns) / 1e9;
+		DevCon.WriteLnFmt("ISO decompression: {:.1f} MB in {} chunks on {} workers, {:.1f} MB/s per thread, "
+						  "{} readahead hits, {} misses, {} prefetched chunks, {} chunk cache hits",
+			mb, m_stats.chunks_decompressed, m_stats.worker_count, (seconds > 0.0) ? (mb / seconds) : 0.0,
+			m_stats.readahead_hits, m_stats.readahead_misses, m_stats.prefetch_chunks, m_stats.cache_hits);
 	}
-	return nullptr;
+
+	m_requestPtr = nullptr;
+	m_queue.clear();
+	m_prefetchQueue.clear();
+	m_chunkCache.Clear();
+	m_prefetchQueuedBytes = 0;
+	m_slotLookup.clear();
+	m_slots.clear();
+	m_contextMutexes.reset();
+	m_contextCount = 0;
 }
 
-bool ThreadedFileReader::Decompress(void* target, u64 begin, u32 size)
+ThreadedFileReader::Slot* ThreadedFileReader::FindSlot(s64 chunkID)
 {
-	char* write = static_cast<char*>(target);
-	u32 remaining = size;
-	u64 off = begin;
-	while (remaining)
-	{
-		if (m_requestCancelled.load(std::memory_order_relaxed))
-			return false;
-
-		Chunk chunk = ChunkForOffset(off);
-		if (m_internalBlockSize || chunk.offset != off || chunk.length > remaining)
-		{
-			Buffer* buf = GetBlockPtr(chunk);
-			if (!buf)
-				return false;
-			u32 bufoff = off - buf->offset;
-			u32 bufsize = buf->size.load(std::memory_order_relaxed);
-			if (bufsize <= bufoff)
-				return false;
-			u32 len = std::min(bufsize - bufoff, remaining);
-			write += CopyBlocks(write, static_cast<char*>(buf->ptr) + bufoff, len);
-			remaining -= len;
-			off += len;
-		}
-		else
-		{
-			int amt = ReadChunk(write, chunk.chunkID);
-			if (amt < static_cast<int>(chunk.length))
-				return false;
-			write += chunk.length;
-			remaining -= chunk.length;
-			off += chunk.length;
-		}
-	}
-	m_amtRead += write - static_cast<char*>(target);
-	return true;
+	const auto it = m_slotLookup.find(chunkID);
+	return (it != m_slotLookup.end()) ? it->second : nullptr;
 }
 
-bool ThreadedFileReader::TryCachedRead(void*& buffer, u64& offset, u32& size, const std::lock_guard<std::mutex>&)
+ThreadedFileReader::Slot* ThreadedFileReader::AcquireSlot(const Chunk& chunk)
 {
-	// Run through twice so that if m_buffer[1] contains the first half and m_buffer[0] contains the second half it still works
-	m_amtRead = 0;
-	u64 end = 0;
-	bool allDone = false;
-	for (int i = 0; i < static_cast<int>(std::size(m_buffer) * 2); i++)
+	if (chunk.chunkID < 0 || chunk.length == 0)
+		return nullptr;
+
+	if (Slot* slot = FindSlot(chunk.chunkID))
 	{
-		Buffer& buf = m_buffer[i % std::size(m_buffer)];
-		u32 bufsize = buf.size.load(std::memory_order_acquire);
-		if (!bufsize)
+		slot->generation = m_generation;
+		return slot;
+	}
+
+	// Reuse whichever slot was wanted least recently, as long as nobody's writing to it and the current
+	// request doesn't need it. Otherwise the window is bigger than the pool, so grow it.
+	Slot* victim = nullptr;
+	for (const std::unique_ptr<Slot>& slot : m_slots)
+	{
+		if (slot->state == SlotState::Busy || slot->generation == m_generation)
 			continue;
-		if (buf.offset <= offset && buf.offset + bufsize > offset)
-		{
-			u32 off = offset - buf.offset;
-			u32 cpysize = std::min(size, bufsize - off);
-			size_t read = CopyBlocks(buffer, static_cast<char*>(buf.ptr) + off, cpysize);
-			m_amtRead += read;
-			size -= cpysize;
-			offset += cpysize;
-			buffer = static_cast<char*>(buffer) + read;
-			if (size == 0)
-				end = buf.offset + bufsize;
-		}
-		// Do buffers contain the current and next block?
-		if (end > 0 && buf.offset == end)
-			allDone = true;
+		if (!victim || slot->generation < victim->generation)
+			victim = slot.get();
 	}
-	return allDone;
+	if (!victim)
+		victim = m_slots.emplace_back(std::make_unique<Slot>()).get();
+	else if (victim->chunkID >= 0)
+		m_slotLookup.erase(victim->chunkID);
+
+	if (victim->cap < chunk.length)
+	{
+		victim->data = std::make_unique<u8[]>(chunk.length);
+		victim->cap = chunk.length;
+	}
+	victim->chunkID = chunk.chunkID;
+	victim->offset = chunk.offset;
+	victim->length = chunk.length;
+	victim->size = 0;
+	victim->state = SlotState::Empty;
+	victim->generation = m_generation;
+	m_slotLookup.emplace(chunk.chunkID, victim);
+
+	// Nothing goes in the cache unless the format asks for it or something was prefetched.
+	if (m_cacheDecompressed || m_stats.prefetch_chunks > 0)
+		ReadFromChunkCache(victim, chunk);
+	return victim;
 }
 
-bool ThreadedFileReader::Open(std::string filename, Error* error)
+bool ThreadedFileReader::ReadFromChunkCache(Slot* slot, const Chunk& chunk)
 {
-	CancelAndWaitUntilStopped();
-	return Open2(std::move(filename), error);
+	const int amt = m_chunkCache.Read(chunk.chunkID, slot->data.get(), chunk.offset, chunk.length);
+	if (amt <= 0)
+		return false;
+
+	slot->size = static_cast<u32>(amt);
+	slot->state = SlotState::Ready;
+	m_stats.cache_hits++;
+	return true;
 }
 
-int ThreadedFileReader::ReadSync(void* pBuffer, u32 sector, u32 count)
+void ThreadedFileReader::AddToChunkCache(const void* data, const Chunk& chunk, int size)
+{
+	void* copy = std::malloc(size);
+	if (!copy)
+		return;
+
+	// Coverage is the full chunk so a short final chunk still satisfies a whole-chunk read.
+	std::memcpy(copy, data, size);
+	m_chunkCache.Take(chunk.chunkID, copy, chunk.offset, size, chunk.length);
+}
+
+void ThreadedFileReader::PrefetchChunk(const Chunk& chunk, u32 context, std::unique_lock<std::mutex>& lock)
 {
-	u32 blocksize = InternalBlockSize();
-	u64 offset = (u64)sector * (u64)blocksize + m_dataoffset;
-	u32 size = count * blocksize;
+	// Don't decompress anything twice, as long as it's still around.
+	if (m_chunkCache.Contains(chunk.chunkID) || FindSlot(chunk.chunkID))
+		return;
+
+	void* data = std::malloc(chunk.length);
+	if (!data)
+		return;
+
+	lock.unlock();
+
+	Common::Timer timer;
+	int amt;
 	{
-		std::lock_guard<std::mutex> l(m_mtx);
-		if (TryCachedRead(pBuffer, offset, size, l))
-			return m_amtRead;
+		std::lock_guard<std::mutex> context_lock(m_contextMutexes[context]);
+		amt = ReadChunk(data, chunk.chunkID, context);
+	}
+	const u64 elapsed = static_cast<u64>(timer.GetTimeNanoseconds());
 
-		if (size > 0 && !m_running)
+	lock.lock();
+	if (amt > 0)
+	{
+		m_stats.bytes_decompressed += static_cast<u32>(amt);
+		m_stats.chunks_decompressed++;
+	}
+	m_stats.decompress_time_ns += elapsed;
+
+	if (amt <= 0)
+	{
+		std::free(data);
+		return;
+	}
+
+	m_chunkCache.Take(chunk.chunkID, data, chunk.offset, std::min(amt, static_cast<int>(chunk.length)), chunk.length);
+	m_stats.prefetch_chunks++;
+}
+
+void ThreadedFileReader::ScheduleRead(u64 offset, u32 size)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mtx);
+		m_generation++;
+
+		// Chunks the caller is about to wait for go ahead of any readahead, in order.
+		// Anything already queued is queued again up front, the old entry gets skipped.
+		const u64 end = offset + size;
+		u64 pos = offset;
+		size_t insert_pos = 0;
+		while (pos < end)
 		{
-			// Don't wait for read thread to start back up
-			if (Decompress(pBuffer, offset, size))
+			const Chunk chunk = ChunkForOffset(pos);
+			Slot* slot = AcquireSlot(chunk);
+			if (!slot)
+				break;
+
+			if (slot->state != SlotState::Busy && slot->state != SlotState::Ready)
 			{
-				offset += size;
-				size = 0;
+				slot->state = SlotState::Queued;
+				m_queue.insert(m_queue.begin() + insert_pos++, slot);
 			}
+			pos = chunk.offset + chunk.length;
 		}
 
-		if (size == 0)
+		for (u32 i = 0; i < m_readaheadChunks; i++)
 		{
-			// For readahead
-			m_requestOffset = offset - 1;
-			m_requestSize = 1;
-			m_requestPtr.store(nullptr, std::memory_order_relaxed);
-		}
-		else
-		{
-			m_requestOffset = offset;
-			m_requestSize = size;
-			m_requestPtr.store(pBuffer, std::memory_order_relaxed);
+			const Chunk chunk = ChunkForOffset(pos);
+			Slot* slot = AcquireSlot(chunk);
+			if (!slot)
+				break;
+
+			// Failed chunks are only retried when something actually asks for them.
+			if (slot->state == SlotState::Empty)
+			{
+				slot->state = SlotState::Queued;
+				m_queue.push_back(slot);
+			}
+			pos = chunk.offset + chunk.length;
 		}
-		m_requestCancelled.store(false, std::memory_order_relaxed);
 	}
-	m_condition.notify_one();
-	if (size == 0)
-		return m_amtRead;
-	return FinishRead();
+
+	m_workCondition.notify_all();
 }
 
-void ThreadedFileReader::CancelAndWaitUntilStopped(void)
+void ThreadedFileReader::DecompressSlot(Slot* slot, u32 context, std::unique_lock<std::mutex>& lock)
 {
-	m_requestCancelled.store(true, std::memory_order_relaxed);
-	std::unique_lock<std::mutex> lock(m_mtx);
+	// Busy slots are never evicted, so the buffer is ours until we put it back.
+	slot->state = SlotState::Busy;
+	const s64 chunkID = slot->chunkID;
+	lock.unlock();
 
-	// Prevent the last request being picked up, if there was one.
-	// m_requestCancelled just stops the current decompress.
-	m_requestSize = 0;
+	Common::Timer timer;
+	int amt;
+	{
+		std::lock_guard<std::mutex> context_lock(m_contextMutexes[context]);
+		amt = ReadChunk(slot->data.get(), chunkID, context);
+	}
+	const u64 elapsed = static_cast<u64>(timer.GetTimeNanoseconds());
+
+	// The slot will be reused soon, the cache can hang on to it for longer.
+	if (m_cacheDecompressed && amt > 0)
+		AddToChunkCache(slot->data.get(), Chunk{chunkID, slot->offset, slot->length}, std::min(amt, static_cast<int>(slot->length)));
 
-	while (m_running)
-		m_condition.wait(lock);
+	lock.lock();
+	slot->size = static_cast<u32>(std::clamp<int>(amt, 0, static_cast<int>(slot->length)));
+	slot->state = (amt > 0) ? SlotState::Ready : SlotState::Failed;
+	if (amt > 0)
+	{
+		m_stats.bytes_decompressed += slot->size;
+		m_stats.chunks_decompressed++;
+	}
+	m_stats.decompress_time_ns += elapsed;
+	m_doneCondition.notify_all();
 }
 
-void ThreadedFileReader::BeginRead(void* pBuffer, u32 sector, u32 count)
+int ThreadedFileReader::CompleteRead(void* dst, u64 offset, u32 size)
 {
-	s32 blocksize = InternalBlockSize();
-	u64 offset = (u64)sector * (u64)blocksize + m_dataoffset;
-	u32 size = count * blocksize;
+	char* write = static_cast<char*>(dst);
+	const u64 end = offset + size;
+	u64 pos = offset;
+
+	std::unique_lock<std::mutex> lock(m_mtx);
+	while (pos < end)
 	{
-		std::lock_guard<std::mutex> l(m_mtx);
-		if (TryCachedRead(pBuffer, offset, size, l))
-			return;
-		if (size == 0)
+		const Chunk chunk = ChunkForOffset(pos);
+		Slot* slot = AcquireSlot(chunk);
+		if (!slot)
+			break;
+
+		if (slot->state == SlotState::Ready)
 		{
-			// For readahead
-			m_requestOffset = offset - 1;
-			m_requestSize = 1;
-			m_requestPtr.store(nullptr, std::memory_order_relaxed);
+			m_stats.readahead_hits++;
 		}
 		else
 		{
-			m_requestOffset = offset;
-			m_requestSize = size;
-			m_requestPtr.store(pBuffer, std::memory_order_relaxed);
+			m_stats.readahead_misses++;
+
+			// Rather than waiting for a worker to get around to it, decompress it ourselves.
+			if (slot->state == SlotState::Busy)
+				m_doneCondition.wait(lock, [slot]() { return slot->state != SlotState::Busy; });
+			else
+				DecompressSlot(slot, 0, lock);
+
+			// Someone else may have reused the slot while we weren't holding the lock.
+			if (slot->chunkID != chunk.chunkID)
+				continue;
+			if (slot->state != SlotState::Ready)
+				break;
 		}
-		m_requestCancelled.store(false, std::memory_order_relaxed);
+
+		const u32 slot_offset = static_cast<u32>(pos - slot->offset);
+		if (slot->size <= slot_offset)
+			break;
+
+		const u32 len = static_cast<u32>(std::min<u64>(slot->size - slot_offset, end - pos));
+		write += CopyBlocks(write, slot->data.get() + slot_offset, len);
+		pos += len;
 	}
-	m_condition.notify_one();
+
+	return static_cast<int>(write - static_cast<char*>(dst));
+}
+
+bool ThreadedFileReader::Open(std::string filename, Error* error)
+{
+	StopWorkers();
+	if (!Open2(std::move(filename), error))
+		return false;
+
+	// Small chunks need a deeper window to cover the same distance.
+	const Chunk first = ChunkForOffset(0);
+	m_readaheadChunks = EmuConfig.CdvdReadaheadChunks;
+	if (first.length > 0)
+	{
+		m_readaheadChunks = std::max(m_readaheadChunks, (MINIMUM_READAHEAD_SIZE + first.length - 1) / first.length);
+		m_readaheadChunks = std::min(m_readaheadChunks, std::max(MAXIMUM_READAHEAD_SIZE / first.length, GetWorkerCount()));
+	}
+
+	ChunksCache::SetLimit(EmuConfig.CdvdChunkCacheSize);
+	m_cacheDecompressed = CacheDecompressedChunks();
+
+	StartWorkers();
+	return true;
+}
+
+int ThreadedFileReader::ReadSync(void* pBuffer, u32 sector, u32 count)
+{
+	const u32 blocksize = InternalBlockSize();
+	const u64 offset = (u64)sector * (u64)blocksize + m_dataoffset;
+	const u32 size = count * blocksize;
+	ScheduleRead(offset, size);
+	return CompleteRead(pBuffer, offset, size);
+}
+
+void ThreadedFileReader::BeginRead(void* pBuffer, u32 sector, u32 count)
+{
+	const u32 blocksize = InternalBlockSize();
+	m_requestOffset = (u64)sector * (u64)blocksize + m_dataoffset;
+	m_requestSize = count * blocksize;
+	m_requestPtr = pBuffer;
+	ScheduleRead(m_requestOffset, m_requestSize);
 }
 
 int ThreadedFileReader::FinishRead(void)
 {
-	if (m_requestPtr.load(std::memory_order_acquire) == nullptr)
-		return m_amtRead;
-	std::unique_lock<std::mutex> lock(m_mtx);
-	while (m_requestPtr.load(std::memory_order_acquire))
-		m_condition.wait(lock);
-	return m_amtRead;
+	// Workers only ever write to slots, so the copy into the caller's buffer happens here.
+	void* ptr = std::exchange(m_requestPtr, nullptr);
+	if (!ptr)
+		return 0;
+
+	return CompleteRead(ptr, m_requestOffset, m_requestSize);
 }
 
 void ThreadedFileReader::CancelRead(void)
 {
-	if (m_requestPtr.load(std::memory_order_acquire) == nullptr)
-		return;
-	m_requestCancelled.store(true, std::memory_order_release);
-	std::unique_lock<std::mutex> lock(m_mtx);
-	while (m_requestPtr.load(std::memory_order_relaxed))
-		m_condition.wait(lock);
+	// Nothing has touched the caller's buffer yet, decompressed chunks stay around for the next read.
+	m_requestPtr = nullptr;
 }
 
 void ThreadedFileReader::Close(void)
 {
-	CancelAndWaitUntilStopped();
-	for (auto& buf : m_buffer)
-		buf.size.store(0, std::memory_order_relaxed);
+	StopWorkers();
 	Close2();
 }
 
@@ -367,3 +454,124 @@ void ThreadedFileReader::SetDataOffset(u32 bytes)
 {
 	m_dataoffset = bytes;
 }
+
+void ThreadedFileReader::Prefetch(u32 sector, u32 count)
+{
+	const u32 blocksize = InternalBlockSize();
+	const u64 end = ((u64)sector + count) * (u64)blocksize + m_dataoffset;
+	u64 pos = (u64)sector * (u64)blocksize + m_dataoffset;
+	{
+		std::lock_guard<std::mutex> lock(m_mtx);
+
+		// Prefetches arrive in the order they're wanted, anything which doesn't fit in the cache
+		// would only push out earlier ones.
+		const u64 limit = static_cast<u64>(std::min(EmuConfig.CdvdPrefetchCacheSize, EmuConfig.CdvdChunkCacheSize)) * _1mb;
+		while (pos < end && m_prefetchQueuedBytes < limit)
+		{
+			const Chunk chunk = ChunkForOffset(pos);
+			if (chunk.chunkID < 0 || chunk.length == 0)
+				break;
+
+			// Neighbouring extents often share a chunk.
+			if (m_prefetchQueue.empty() || m_prefetchQueue.back().chunkID != chunk.chunkID)
+			{
+				m_prefetchQueue.push_back(chunk);
+				m_prefetchQueuedBytes += chunk.length;
+			}
+			pos = chunk.offset + chunk.length;
+		}
+	}
+
+	m_workCondition.notify_all();
+}
+
+bool ThreadedFileReader::ReadAll(void* dst)
+{
+	// Each chunk is copied out on its own, which only lines up with the blocks if chunks start on one.
+	const u32 blocksize = InternalBlockSize();
+	if (m_internalBlockSize && (m_dataoffset % blocksize) != 0)
+		return AsyncFileReader::ReadAll(dst);
+
+	const u64 start = m_dataoffset;
+	const u64 end = start + static_cast<u64>(GetBlockCount()) * blocksize;
+	u8* const write = static_cast<u8*>(dst);
+
+	// Nothing else is running while the image is preloaded, so it can have every core.
+	// The workers hold on to their contexts, and the extra ones can't be opened under them.
+	StopWorkers();
+	SetReadContextCount(std::clamp(std::thread::hardware_concurrency(), 1u, MAX_PRELOAD_THREADS));
+	const u32 num_contexts = std::max(GetReadContextCount(), 1u);
+
+	std::mutex next_mutex;
+	u64 next = start;
+	std::atomic_bool failed{false};
+
+	// Every context gets a thread, which hands out chunks in order so the file is read mostly sequentially.
+	const auto thread_func = [&](u32 context) {
+		std::unique_ptr<u8[]> buffer;
+		u32 buffer_size = 0;
+		while (!failed.load(std::memory_order_relaxed))
+		{
+			Chunk chunk;
+			{
+				std::lock_guard<std::mutex> lock(next_mutex);
+				if (next >= end)
+					return;
+
+				chunk = ChunkForOffset(next);
+				if (chunk.chunkID < 0 || chunk.length == 0)
+				{
+					failed = true;
+					return;
+				}
+				next = chunk.offset + chunk.length;
+			}
+
+			if (chunk.length > buffer_size)
+			{
+				buffer = std::make_unique<u8[]>(chunk.length);
+				buffer_size = chunk.length;
+			}
+
+			const int amt = ReadChunk(buffer.get(), chunk.chunkID, context);
+			if (amt <= 0)
+			{
+				failed = true;
+				return;
+			}
+
+			const u64 copy_start = std::max(chunk.offset, start);
+			const u64 copy_end = std::min(chunk.offset + static_cast<u64>(amt), end);
+			if (copy_start >= copy_end)
+				continue;
+
+			const u64 rel = copy_start - start;
+			const u64 dst_offset = m_internalBlockSize ? (rel / blocksize * m_blocksize) : rel;
+			CopyBlocks(write + dst_offset, buffer.get() + (copy_start - chunk.offset), copy_end - copy_start);
+		}
+	};
+
+	std::vector<std::thread> threads;
+	for (u32 i = 1; i < num_contexts; i++)
+	{
+		threads.emplace_back([&thread_func, i]() {
+			Threading::SetNameOfCurrentThread("ISO Preload");
+			thread_func(i);
+		});
+	}
+	thread_func(0);
+	for (std::thread& thread : threads)
+		thread.join();
+
+	// Go back to what streaming needs, rather than keeping a handle per core open all session.
+	SetReadContextCount(GetDesiredReadContextCount());
+	StartWorkers();
+
+	return !failed;
+}
+
+ThreadedFileReader::Statistics ThreadedFileReader::GetStatistics()
+{
+	std::lock_guard<std::mutex> lock(m_mtx);
+	return m_stats;
+}
@@ -4,17 +4,41 @@
 #pragma once
 
 #include "AsyncFileReader.h"
+#include "ChunksCache.h"
 
 #include <thread>
 #include <mutex>
 #include <atomic>
 #include <condition_variable>
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 
 /// A file reader for use with compressed formats
-/// Calls decompression code on a separate thread to make a synchronous decompression API async
+/// Calls decompression code on a pool of worker threads to make a synchronous decompression API async
+/// Chunks following the last read are decompressed ahead of time, and may complete in any order
 class ThreadedFileReader : public AsyncFileReader
 {
 	ThreadedFileReader(ThreadedFileReader&&) = delete;
+public:
+	struct Statistics
+	{
+		u64 bytes_decompressed;
+		u64 chunks_decompressed;
+		/// Summed over all threads, so can exceed wall time
+		u64 decompress_time_ns;
+		/// Chunks which were already decompressed when a read needed them
+		u64 readahead_hits;
+		/// Chunks a read had to wait for, or decompress itself
+		u64 readahead_misses;
+		/// Chunks decompressed because of Prefetch()
+		u64 prefetch_chunks;
+		/// Chunks which didn't need decompressing because they were in the chunk cache
+		u64 cache_hits;
+		u32 worker_count;
+	};
+
 protected:
 	struct Chunk
 	{
@@ -30,49 +54,94 @@ protected:
 	int m_internalBlockSize = 0;
 
 	/// Get the block containing the given offset
+	/// May be called from any thread, so must not modify the reader
 	virtual Chunk ChunkForOffset(u64 offset) = 0;
 	/// Synchronously read the given block into `dst`
-	virtual int ReadChunk(void* dst, s64 chunkID) = 0;
+	/// `context` is below GetReadContextCount(), and is never used by two threads at once
+	virtual int ReadChunk(void* dst, s64 chunkID, u32 context) = 0;
+	/// Number of independent decompression contexts (file handles, decoder state) opened by Open2
+	virtual u32 GetReadContextCount() const { return 1; }
+	/// Open or close extra contexts until there are `count`, or as many as could be opened
+	/// Only called while no worker is running, readers which can't have more than one can ignore it
+	virtual void SetReadContextCount(u32 count) {}
+	/// Keep every decompressed chunk in the shared chunk cache, rather than only prefetched ones
+	/// Costs a malloc, a copy and a global lock per chunk, so only worth it for slow decoders
+	virtual bool CacheDecompressedChunks() const { return false; }
 	/// AsyncFileReader open but ThreadedFileReader needs prep work first
 	virtual bool Open2(std::string filename, Error* error) = 0;
 	/// AsyncFileReader close but ThreadedFileReader needs prep work first
 	virtual void Close2() = 0;
 
+	/// Number of contexts Open2 should try to open: one per worker, plus one for the reading thread
+	static u32 GetDesiredReadContextCount();
+
 	ThreadedFileReader();
 	~ThreadedFileReader();
 
 private:
-	int m_amtRead;
-	/// Pointer to read into
-	/// If null when m_requestSize > 0, indicates a request for readahead only
-	std::atomic<void*> m_requestPtr{nullptr};
-	/// Request offset in (internal block) bytes from the beginning of the file
-	u64 m_requestOffset = 0;
-	/// Request size in (internal block) bytes
-	/// In addition to marking the request size, the loop thread uses this variable to decide whether there's work to do (size of 0 means no work)
-	u32 m_requestSize = 0;
-	/// Used to cancel requests early
-	/// Note: It might take a while for the cancellation request to be noticed, wait until `m_requestPtr` is cleared to ensure it's not being written to
-	std::atomic<bool> m_requestCancelled{false};
-	struct Buffer
+	enum class SlotState : u8
 	{
-		void* ptr = nullptr;
+		Empty,
+		Queued,
+		Busy,
+		Ready,
+		Failed,
+	};
+
+	/// One decompressed chunk
+	struct Slot
+	{
+		std::unique_ptr<u8[]> data;
+		s64 chunkID = -1;
 		u64 offset = 0;
-		std::atomic<u32> size{0};
+		/// Length of the chunk, the buffer may be bigger if it held a longer one before
+		u32 length = 0;
+		u32 size = 0;
 		u32 cap = 0;
+		SlotState state = SlotState::Empty;
+		/// Request generation which last wanted this chunk, slots from the current generation are never evicted
+		u64 generation = 0;
 	};
-	/// 2 buffers for readahead (current block, next block)
-	Buffer m_buffer[2];
-	u32 m_nextBuffer = 0;
 
-	std::thread m_readThread;
+	/// Request started by BeginRead, completed in FinishRead
+	/// If null, there's no request in flight
+	void* m_requestPtr = nullptr;
+	/// Request offset in (internal block) bytes from the beginning of the file
+	u64 m_requestOffset = 0;
+	/// Request size in (internal block) bytes
+	u32 m_requestSize = 0;
+
+	/// All state below is guarded by `m_mtx`
+	std::vector<std::unique_ptr<Slot>> m_slots;
+	std::unordered_map<s64, Slot*> m_slotLookup;
+	/// Slots waiting for a worker, request chunks go to the front and readahead to the back
+	/// May contain stale entries, workers skip anything which isn't Queued anymore
+	std::deque<Slot*> m_queue;
+	u64 m_generation = 0;
+	u32 m_readaheadChunks = 0;
+	/// Cached from CacheDecompressedChunks() when the file is opened
+	bool m_cacheDecompressed = false;
+	/// Chunks from Prefetch(), only picked up by workers with nothing else to do
+	std::deque<Chunk> m_prefetchQueue;
+	/// Every decompressed chunk, within the memory budget shared with other readers
+	ChunksCache m_chunkCache;
+	u64 m_prefetchQueuedBytes = 0;
+	Statistics m_stats = {};
+
+	std::vector<std::thread> m_workers;
+	/// One per decompression context, held while calling ReadChunk
+	std::unique_ptr<std::mutex[]> m_contextMutexes;
+	u32 m_contextCount = 0;
 	std::mutex m_mtx;
-	std::condition_variable m_condition;
-	/// True to tell the thread to exit
+	/// Signalled when work is queued
+	std::condition_variable m_workCondition;
+	/// Signalled when a slot finishes decompressing
+	std::condition_variable m_doneCondition;
+	/// True to tell the workers to exit
 	bool m_quit = false;
-	/// True if the thread is currently doing something other than waiting
-	/// View while holding `m_mtx`.  If false, you may touch decompression functions from other threads
-	bool m_running = false;
+
+	/// Number of streaming workers, which may be fewer than the contexts
+	static u32 GetWorkerCount();
 
 	/// Get the internal block size
 	u32 InternalBlockSize() const { return m_internalBlockSize ? m_internalBlockSize : m_blocksize; }
@@ -81,19 +150,31 @@ private:
 	/// Returns the number of external block bytes copied
 	size_t CopyBlocks(void* dst, const void* src, size_t size) const;
 
-	/// Main loop of read thread
-	void Loop();
+	/// Main loop of a worker thread
+	void WorkerLoop(u32 context);
+	/// Start workers once Open2 has told us how many contexts are available
+	void StartWorkers();
+	/// Stop workers, waiting for in-flight chunks to finish
+	void StopWorkers();
 
-	/// Load the given block into one of the `m_buffer` buffers if necessary and return a pointer to its contents if successful
-	Buffer* GetBlockPtr(const Chunk& block);
-	/// Decompress from offset to size into
-	bool Decompress(void* ptr, u64 offset, u32 size);
-	/// Cancel any inflight read and wait until the thread is no longer doing anything
-	void CancelAndWaitUntilStopped(void);
-	/// Attempt to read from the cache
-	/// Adjusts pointer, offset, and size if successful
-	/// Returns true if no additional reads are necessary
-	bool TryCachedRead(void*& buffer, u64& offset, u32& size, const std::lock_guard<std::mutex>&);
+	/// Find the slot holding the given chunk, if any
+	Slot* FindSlot(s64 chunkID);
+	/// Get a slot for the given chunk, evicting or allocating one if it's not present
+	/// Returns null if the chunk doesn't exist
+	Slot* AcquireSlot(const Chunk& chunk);
+	/// Queue the chunks covering the given range, and the readahead window after it
+	void ScheduleRead(u64 offset, u32 size);
+	/// Fill a newly acquired slot from the chunk cache, if the chunk's in there
+	bool ReadFromChunkCache(Slot* slot, const Chunk& chunk);
+	/// Copy a decompressed chunk into the chunk cache
+	void AddToChunkCache(const void* data, const Chunk& chunk, int size);
+	/// Decompress a chunk into the chunk cache, `lock` is released while decompressing
+	void PrefetchChunk(const Chunk& chunk, u32 context, std::unique_lock<std::mutex>& lock);
+	/// Decompress a slot on the calling thread, `lock` is released while decompressing
+	void DecompressSlot(Slot* slot, u32 context, std::unique_lock<std::mutex>& lock);
+	/// Copy a scheduled range to `dst`, waiting for or decompressing chunks which aren't ready yet
+	/// Returns the number of external block bytes copied
+	int CompleteRead(void* dst, u64 offset, u32 size);
 
 public:
 	bool Open(std::string filename, Error* error) final override;
@@ -104,4 +185,9 @@ public:
 	void Close() final override;
 	void SetBlockSize(u32 bytes) final override;
 	void SetDataOffset(u32 bytes) final override;
+	void Prefetch(u32 sector, u32 count) final override;
+	bool ReadAll(void* dst) final override;
+
+	/// Throughput counters since the file was opened
+	Statistics GetStatistics();
 };
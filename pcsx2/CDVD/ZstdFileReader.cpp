@@ -0,0 +1,296 @@
+// SPDX-FileCopyrightText: 2002-2024 PCSX2 Dev Team
+// SPDX-License-Identifier: LGPL-3.0+
+
+#include "ZstdFileReader.h"
+
+#include "common/Console.h"
+#include "common/Error.h"
+#include "common/FileSystem.h"
+
+#include "fmt/format.h"
+#include "xxhash.h"
+
+#include <zstd.h>
+
+#include <algorithm>
+#include <cstring>
+
+// Implementation of the zstd seekable format, based on:
+// https://github.com/facebook/zstd/blob/dev/contrib/seekable_format/zstd_seekable_compression_format.md
+
+static constexpr u32 SKIPPABLE_MAGIC = 0x184D2A5E;
+static constexpr u32 SEEKABLE_MAGIC = 0x8F92EAB1;
+static constexpr u32 SKIPPABLE_HEADER_SIZE = 8;
+static constexpr u32 SEEK_TABLE_FOOTER_SIZE = 9;
+static constexpr u8 SEEK_TABLE_CHECKSUM_FLAG = 0x80;
+static constexpr u8 SEEK_TABLE_RESERVED_BITS = 0x7C;
+
+// Each frame becomes a ThreadedFileReader chunk, and a readahead window of them is kept in memory.
+static constexpr u32 MAX_FRAME_SIZE = 16 * 1024 * 1024;
+
+ZstdFileReader::ZstdFileReader()
+{
+	m_blocksize = 2048;
+}
+
+ZstdFileReader::~ZstdFileReader()
+{
+	Close();
+}
+
+bool ZstdFileReader::IsSeekableZstdFile(const std::string& filename)
+{
+	auto fp = FileSystem::OpenManagedCFile(filename.c_str(), "rb");
+	if (!fp)
+		return false;
+
+	const s64 size = FileSystem::FSize64(fp.get());
+	u32 magic;
+	return (size >= static_cast<s64>(SKIPPABLE_HEADER_SIZE + SEEK_TABLE_FOOTER_SIZE) &&
+			FileSystem::FSeek64(fp.get(), size - static_cast<s64>(sizeof(magic)), SEEK_SET) == 0 &&
+			std::fread(&magic, sizeof(magic), 1, fp.get()) == 1 && magic == SEEKABLE_MAGIC);
+}
+
+bool ZstdFileReader::Open2(std::string filename, Error* error)
+{
+	Close2();
+	m_filename = std::move(filename);
+	m_contexts.resize(1);
+	m_contexts[0].src = FileSystem::OpenCFile(m_filename.c_str(), "rb", error);
+	if (!m_contexts[0].src || !ReadSeekTable(m_contexts[0].src, &m_table, error) || !InitializeContext(m_contexts[0], error))
+	{
+		Close2();
+		return false;
+	}
+
+	// Frames are independent, so every extra handle lets another thread decompress at the same time.
+	// Not being able to open them isn't fatal, we just don't decompress in parallel.
+	SetReadContextCount(GetDesiredReadContextCount());
+	return true;
+}
+
+void ZstdFileReader::SetReadContextCount(u32 count)
+{
+	count = std::max(count, 1u);
+	while (m_contexts.size() > count)
+	{
+		CloseContext(m_contexts.back());
+		m_contexts.pop_back();
+	}
+
+	while (m_contexts.size() < count)
+	{
+		ReadContext& ctx = m_contexts.emplace_back();
+		ctx.src = FileSystem::OpenCFile(m_filename.c_str(), "rb");
+		if (!ctx.src || !InitializeContext(ctx, nullptr))
+		{
+			CloseContext(ctx);
+			m_contexts.pop_back();
+			break;
+		}
+	}
+}
+
+bool ZstdFileReader::ReadSeekTable(std::FILE* fp, SeekTable* table, Error* error)
+{
+	*table = {};
+	const s64 file_size = FileSystem::FSize64(fp);
+
+	u8 footer[SEEK_TABLE_FOOTER_SIZE];
+	if (file_size < static_cast<s64>(SKIPPABLE_HEADER_SIZE + SEEK_TABLE_FOOTER_SIZE) ||
+		FileSystem::FSeek64(fp, file_size - SEEK_TABLE_FOOTER_SIZE, SEEK_SET) != 0 ||
+		std::fread(footer, sizeof(footer), 1, fp) != 1)
+	{
+		Error::SetString(error, "Failed to read zstd seek table footer.");
+		return false;
+	}
+
+	u32 num_frames, magic;
+	std::memcpy(&num_frames, &footer[0], sizeof(num_frames));
+	const u8 descriptor = footer[4];
+	std::memcpy(&magic, &footer[5], sizeof(magic));
+	if (magic != SEEKABLE_MAGIC)
+	{
+		Error::SetString(error, "File is not a seekable zstd image.");
+		return false;
+	}
+	if ((descriptor & SEEK_TABLE_RESERVED_BITS) != 0)
+	{
+		Error::SetString(error, "Unsupported zstd seek table descriptor.");
+		return false;
+	}
+
+	table->hasChecksums = (descriptor & SEEK_TABLE_CHECKSUM_FLAG) != 0;
+	const u32 entry_size = table->hasChecksums ? 12 : 8;
+	const u64 table_size = static_cast<u64>(num_frames) * entry_size + SEEK_TABLE_FOOTER_SIZE;
+	if (num_frames == 0 || table_size + SKIPPABLE_HEADER_SIZE > static_cast<u64>(file_size))
+	{
+		Error::SetString(error, "Invalid zstd seek table size.");
+		return false;
+	}
+
+	const s64 table_start = file_size - static_cast<s64>(table_size + SKIPPABLE_HEADER_SIZE);
+	u32 header[2];
+	if (FileSystem::FSeek64(fp, table_start, SEEK_SET) != 0 || std::fread(header, sizeof(header), 1, fp) != 1 ||
+		header[0] != SKIPPABLE_MAGIC || header[1] != table_size)
+	{
+		Error::SetString(error, "Invalid zstd seek table header.");
+		return false;
+	}
+
+	std::vector<u8> entries(table_size - SEEK_TABLE_FOOTER_SIZE);
+	if (std::fread(entries.data(), entries.size(), 1, fp) != 1)
+	{
+		Error::SetString(error, "Failed to read zstd seek table.");
+		return false;
+	}
+
+	table->frames.reserve(num_frames);
+	u64 compressed_offset = 0;
+	u64 decompressed_offset = 0;
+	for (u32 i = 0; i < num_frames; i++)
+	{
+		const u8* entry = &entries[static_cast<size_t>(i) * entry_size];
+		Frame frame;
+		std::memcpy(&frame.compressedSize, entry, sizeof(u32));
+		std::memcpy(&frame.decompressedSize, entry + 4, sizeof(u32));
+		frame.checksum = 0;
+		if (table->hasChecksums)
+			std::memcpy(&frame.checksum, entry + 8, sizeof(u32));
+		frame.compressedOffset = compressed_offset;
+		frame.decompressedOffset = decompressed_offset;
+
+		if (frame.decompressedSize > MAX_FRAME_SIZE || frame.compressedSize > ZSTD_compressBound(MAX_FRAME_SIZE))
+		{
+			Error::SetString(error, fmt::format("zstd frame {} is too large, frames must be {} MB or smaller.",
+										i, MAX_FRAME_SIZE / (1024 * 1024)));
+			return false;
+		}
+
+		compressed_offset += frame.compressedSize;
+		decompressed_offset += frame.decompressedSize;
+		if (frame.decompressedSize == 0)
+			continue;
+
+		table->maxCompressedSize = std::max(table->maxCompressedSize, frame.compressedSize);
+		table->frames.push_back(frame);
+	}
+
+	if (compressed_offset > static_cast<u64>(table_start))
+	{
+		Error::SetString(error, "zstd seek table describes more data than the file holds.");
+		return false;
+	}
+
+	table->totalSize = decompressed_offset;
+	return true;
+}
+
+bool ZstdFileReader::InitializeContext(ReadContext& ctx, Error* error)
+{
+	ctx.readBuffer = std::make_unique<u8[]>(m_table.maxCompressedSize);
+	ctx.dctx = ZSTD_createDCtx();
+	if (!ctx.dctx)
+	{
+		Error::SetString(error, "Unable to initialize zstd decompression context.");
+		return false;
+	}
+
+	return true;
+}
+
+void ZstdFileReader::CloseContext(ReadContext& ctx)
+{
+	if (ctx.src)
+	{
+		std::fclose(ctx.src);
+		ctx.src = nullptr;
+	}
+	if (ctx.dctx)
+	{
+		ZSTD_freeDCtx(ctx.dctx);
+		ctx.dctx = nullptr;
+	}
+
+	ctx.readBuffer.reset();
+}
+
+void ZstdFileReader::Close2()
+{
+	m_filename.clear();
+
+	for (ReadContext& ctx : m_contexts)
+		CloseContext(ctx);
+	m_contexts.clear();
+
+	m_table = {};
+}
+
+u32 ZstdFileReader::GetReadContextCount() const
+{
+	return static_cast<u32>(m_contexts.size());
+}
+
+u32 ZstdFileReader::GetBlockCount() const
+{
+	return static_cast<u32>((m_table.totalSize - m_dataoffset) / m_blocksize);
+}
+
+ThreadedFileReader::Chunk ZstdFileReader::ChunkForOffset(u64 offset)
+{
+	Chunk chunk = {0};
+	if (offset >= m_table.totalSize)
+	{
+		chunk.chunkID = -1;
+		return chunk;
+	}
+
+	// Frames are usually all the same size, which saves searching for the right one.
+	const u32 first_size = m_table.frames.front().decompressedSize;
+	size_t index = static_cast<size_t>(std::min<u64>(offset / first_size, m_table.frames.size() - 1));
+	if (offset < m_table.frames[index].decompressedOffset ||
+		offset - m_table.frames[index].decompressedOffset >= m_table.frames[index].decompressedSize)
+	{
+		const auto it = std::upper_bound(m_table.frames.begin(), m_table.frames.end(), offset,
+			[](u64 value, const Frame& frame) { return value < frame.decompressedOffset; });
+		index = static_cast<size_t>(std::distance(m_table.frames.begin(), it)) - 1;
+	}
+
+	const Frame& frame = m_table.frames[index];
+	chunk.chunkID = static_cast<s64>(index);
+	chunk.offset = frame.decompressedOffset;
+	chunk.length = frame.decompressedSize;
+	return chunk;
+}
+
+int ZstdFileReader::ReadChunk(void* dst, s64 chunkID, u32 context)
+{
+	if (chunkID < 0 || static_cast<size_t>(chunkID) >= m_table.frames.size())
+		return -1;
+
+	ReadContext& ctx = m_contexts[context];
+	const Frame& frame = m_table.frames[chunkID];
+
+	if (FileSystem::FSeek64(ctx.src, frame.compressedOffset, SEEK_SET) != 0 ||
+		std::fread(ctx.readBuffer.get(), 1, frame.compressedSize, ctx.src) != frame.compressedSize)
+	{
+		Console.Error(fmt::format("Unable to read zstd frame {}.", chunkID));
+		return 0;
+	}
+
+	const size_t res = ZSTD_decompressDCtx(ctx.dctx, dst, frame.decompressedSize, ctx.readBuffer.get(), frame.compressedSize);
+	if (ZSTD_isError(res) || res != frame.decompressedSize)
+	{
+		Console.Error(fmt::format("Unable to decompress zstd frame {}: {}", chunkID,
+			ZSTD_isError(res) ? ZSTD_getErrorName(res) : "size mismatch"));
+		return 0;
+	}
+
+	if (m_table.hasChecksums && static_cast<u32>(XXH64(dst, res, 0)) != frame.checksum)
+	{
+		Console.Error(fmt::format("Checksum mismatch in zstd frame {}.", chunkID));
+		return 0;
+	}
+
+	return static_cast<int>(res);
+}
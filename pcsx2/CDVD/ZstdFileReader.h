@@ -0,0 +1,70 @@
+// SPDX-FileCopyrightText: 2002-2024 PCSX2 Dev Team
+// SPDX-License-Identifier: LGPL-3.0+
+
+#pragma once
+
+#include "ThreadedFileReader.h"
+#include <vector>
+
+typedef struct ZSTD_DCtx_s ZSTD_DCtx;
+
+/// Reader for images in the zstd seekable format: independently compressed zstd frames, followed by
+/// a skippable frame holding a seek table with the compressed and decompressed size of each one.
+/// Any read only has to decompress the frames it touches.
+class ZstdFileReader final : public ThreadedFileReader
+{
+	DeclareNoncopyableObject(ZstdFileReader);
+
+public:
+	struct Frame
+	{
+		u64 compressedOffset;
+		u64 decompressedOffset;
+		u32 compressedSize;
+		u32 decompressedSize;
+		u32 checksum;
+	};
+
+	struct SeekTable
+	{
+		/// Frames which decompress to nothing are left out, so every offset maps to exactly one frame.
+		std::vector<Frame> frames;
+		u32 maxCompressedSize = 0;
+		bool hasChecksums = false;
+		u64 totalSize = 0;
+	};
+
+	ZstdFileReader();
+	~ZstdFileReader() override;
+
+	/// Looks for the seek table footer, since there's no dedicated extension for seekable zstd.
+	static bool IsSeekableZstdFile(const std::string& filename);
+	/// Parses and validates the seek table at the end of `fp`.
+	static bool ReadSeekTable(std::FILE* fp, SeekTable* table, Error* error);
+
+	bool Open2(std::string filename, Error* error) override;
+
+	Chunk ChunkForOffset(u64 offset) override;
+	int ReadChunk(void* dst, s64 chunkID, u32 context) override;
+	u32 GetReadContextCount() const override;
+	void SetReadContextCount(u32 count) override;
+
+	void Close2() override;
+
+	u32 GetBlockCount() const override;
+
+private:
+	struct ReadContext
+	{
+		std::FILE* src = nullptr;
+		std::unique_ptr<u8[]> readBuffer;
+		ZSTD_DCtx* dctx = nullptr;
+	};
+
+	bool InitializeContext(ReadContext& ctx, Error* error);
+	static void CloseContext(ReadContext& ctx);
+
+	SeekTable m_table;
+	// One per decompression thread, the first also reads the seek table.
+	std::vector<ReadContext> m_contexts;
+};
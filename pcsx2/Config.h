@@ -335,6 +335,7 @@ enum class GSDumpCompressionMethod : u8
 	Uncompressed,
 	LZMA,
 	Zstandard,
+	SeekableZstandard,
 };
 
 enum class GSHardwareDownloadMode : u8
@@ -518,6 +519,18 @@ struct Pcsx2Config
 			EnableFastmem : 1;
 		bool
 			PauseOnTLBMiss : 1;
+		bool
+			EnableEEBlockCache : 1;
+		bool
+			EnableVUProgramCache : 1;
+		bool
+			EnableEETiering : 1;
+		bool
+			EnableEESpeculativeCompile : 1;
+		bool
+			EnableIOPTiering : 1;
+		bool
+			IOPDispatcherBenchmark : 1;
 		BITFIELD_END
 
 		RecompilerOptions();
@@ -598,6 +611,7 @@ struct Pcsx2Config
 					DisableShaderCache : 1,
 					DisableFramebufferFetch : 1,
 					DisableVertexShaderExpand : 1,
+					DisableHWDrawBatching : 1,
 					DisableThreadedPresentation : 1,
 					SkipDuplicateFrames : 1,
 					OsdShowMessages : 1,
@@ -617,6 +631,7 @@ struct Pcsx2Config
 					HWSpinCPUForReadbacks : 1,
 					GPUPaletteConversion : 1,
 					AutoFlushSW : 1,
+					SWTileBinning : 1,
 					PreloadFrameWithGSData : 1,
 					Mipmap : 1,
 					ManualUserHacks : 1,
@@ -656,6 +671,9 @@ struct Pcsx2Config
 
 		int VsyncQueueSize = 2;
 
+		// size of the MTGS ring buffer in megabytes, 0 grows it automatically when the EE stalls.
+		int MTGSRingBufferSize = 0;
+
 		// forces the MTGS to execute tags/tasks in fully blocking/synchronous
 		// style. Useful for debugging potential bugs in the MTGS pipeline.
 		bool SynchronousMTGS = false;
@@ -717,6 +735,9 @@ struct Pcsx2Config
 		u16 SWExtraThreads = 2;
 		u16 SWExtraThreadsHeight = 4;
 
+		// memory budget for the HW texture cache in megabytes, 0 for no limit.
+		int TextureCacheBudget = 0;
+
 		int SaveN = 0;
 		int SaveL = 5000;
 
@@ -1126,6 +1147,8 @@ struct Pcsx2Config
 		CdvdVerboseReads : 1, // enables cdvd read activity verbosely dumped to the console
 		CdvdDumpBlocks : 1, // enables cdvd block dumping
 		CdvdShareWrite : 1, // allows the iso to be modified while it's loaded
+		CdvdPreloadImage : 1, // decompresses the whole disc image into memory when it's opened
+		CdvdPreloadHugePages : 1, // asks for the preloaded image to be backed by huge pages
 		EnablePatches : 1, // enables patch detection and application
 		EnableCheats : 1, // enables cheat detection and application
 		EnablePINE : 1, // enables inter-process communication
@@ -1141,6 +1164,7 @@ struct Pcsx2Config
 		InhibitScreensaver : 1,
 		BackupSavestate : 1,
 		SavestateZstdCompression : 1,
+		EnableRewind : 1, // keeps in-memory snapshots which can be stepped back to
 		McdFolderAutoManage : 1,
 
 		HostFs : 1,
@@ -1173,6 +1197,18 @@ struct Pcsx2Config
 
 	int PINESlot;
 
+	u32 RewindFrequency = 10; // frames between rewind snapshots
+	u32 RewindBufferSize = 256; // rewind memory budget in megabytes
+
+	u32 IncrementalAutosaveInterval = 0; // seconds between incremental autosaves, 0 disables them
+	u32 IncrementalAutosaveChainLength = 30; // incremental autosaves before a new full one is written
+
+	u32 CdvdDecompressionThreads = 0; // workers decompressing CSO/CHD/gzip images, 0 picks a count automatically
+	u32 CdvdReadaheadChunks = 16; // compressed chunks decoded ahead of the last disc read
+	u32 CdvdPrefetchCacheSize = 128; // megabytes of disc data prefetched from the game's access profile, 0 disables
+	u32 CdvdChunkCacheSize = 256; // megabytes of decompressed disc data kept, shared by all compressed images
+	u32 CdvdPreloadMemoryLimit = 0; // megabytes a preloaded image may use, 0 allows half of physical memory
+
 	// Set at runtime, not loaded from config.
 	std::string CurrentBlockdump;
 	std::string CurrentIRX;
@@ -481,6 +481,9 @@ void GSThrottlePresentation()
 
 void GSGameChanged()
 {
+	if (g_gs_device)
+		g_gs_device->GameChanged();
+
 	if (GSIsHardwareRenderer())
 		GSTextureReplacements::GameChanged();
 
@@ -607,9 +610,10 @@ void GSgetStats(SmallStringBase& info)
 	{
 		const double fps = GetVerticalFrequency();
 		const double fillrate = pm.Get(GSPerfMon::Fillrate);
-		info.format("{} SW | {} S | {} P | {} D | {:.2f} U | {:.2f} D | {:.2f} mpps",
+		info.format("{} SW | {} S | {} J | {} P | {} D | {:.2f} U | {:.2f} D | {:.2f} mpps",
 			api_name,
 			(int)pm.Get(GSPerfMon::SyncPoint),
+			(int)pm.Get(GSPerfMon::RasterizerJobs),
 			(int)pm.Get(GSPerfMon::Prim),
 			(int)pm.Get(GSPerfMon::Draw),
 			pm.Get(GSPerfMon::Swizzle) / 1024,
@@ -622,11 +626,12 @@ void GSgetStats(SmallStringBase& info)
 	}
 	else
 	{
-		info.format("{} HW | {} P | {} D | {} DC | {} B | {} RP | {} RB | {} TC | {} TU",
+		info.format("{} HW | {} P | {} D | {} DC | {} MD | {} B | {} RP | {} RB | {} TC | {} TU",
 			api_name,
 			(int)pm.Get(GSPerfMon::Prim),
 			(int)pm.Get(GSPerfMon::Draw),
 			(int)std::ceil(pm.Get(GSPerfMon::DrawCalls)),
+			(int)std::ceil(pm.Get(GSPerfMon::HWDrawsMerged)),
 			(int)std::ceil(pm.Get(GSPerfMon::Barriers)),
 			(int)std::ceil(pm.Get(GSPerfMon::RenderPasses)),
 			(int)std::ceil(pm.Get(GSPerfMon::Readbacks)),
@@ -663,6 +668,12 @@ void GSgetMemoryStats(SmallStringBase& info)
 			(int)std::ceil(sources / 1048576.0f),
 			(int)std::ceil(pool / 1048576.0f));
 	}
+
+	if (GSConfig.TextureCacheBudget > 0)
+	{
+		fmt::format_to(std::back_inserter(info), " | Budget: {} MB ({} evicted)",
+			GSConfig.TextureCacheBudget, g_texture_cache->GetBudgetEvictions());
+	}
 }
 
 void GSgetTitleStats(std::string& info)
@@ -700,7 +711,8 @@ void GSUpdateConfig(const Pcsx2Config::GSOptions& new_config)
 
 	// Options which aren't using the global struct yet, so we need to recreate all GS objects.
 	if (GSConfig.SWExtraThreads != old_config.SWExtraThreads ||
-		GSConfig.SWExtraThreadsHeight != old_config.SWExtraThreadsHeight)
+		GSConfig.SWExtraThreadsHeight != old_config.SWExtraThreadsHeight ||
+		GSConfig.SWTileBinning != old_config.SWTileBinning)
 	{
 		if (!GSreopen(false, GSConfig.Renderer, &old_config))
 			pxFailRel("Failed to do quick GS reopen");
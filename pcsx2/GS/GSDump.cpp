@@ -77,6 +77,7 @@ void GSDumpBase::Transfer(int index, const u8* mem, size_t size)
 	AppendRawData(static_cast<u8>(index));
 	AppendRawData(&size, 4);
 	AppendRawData(mem, size);
+	m_packets++;
 }
 
 void GSDumpBase::ReadFIFO(u32 size)
@@ -86,6 +87,7 @@ void GSDumpBase::ReadFIFO(u32 size)
 
 	AppendRawData(2);
 	AppendRawData(&size, 4);
+	m_packets++;
 }
 
 bool GSDumpBase::VSync(int field, bool last, const GSPrivRegSet* regs)
@@ -99,6 +101,9 @@ bool GSDumpBase::VSync(int field, bool last, const GSPrivRegSet* regs)
 
 	AppendRawData(1);
 	AppendRawData(static_cast<u8>(field));
+	m_packets += 2;
+
+	EndFrame();
 
 	if (last)
 		m_extra_frames--;
@@ -313,6 +318,9 @@ namespace
 {
 	class GSDumpZst final : public GSDumpBase
 	{
+		// Data is compressed as a series of frames of this size, so it can be decompressed in parallel.
+		static constexpr size_t FRAME_SIZE = 4 * _1mb;
+
 		ZSTD_CStream* m_strm;
 
 		std::vector<u8> m_in_buff;
@@ -340,7 +348,7 @@ namespace
 		// Compression level 6 provides a good balance between speed and ratio.
 		ZSTD_CCtx_setParameter(m_strm, ZSTD_c_compressionLevel, 6);
 
-		m_in_buff.reserve(_1mb);
+		m_in_buff.reserve(FRAME_SIZE + _1mb);
 		m_out_buff.resize(_1mb);
 
 		AddHeader(serial, crc, screenshot_width, screenshot_height, screenshot_pixels, fd, regs);
@@ -370,8 +378,8 @@ namespace
 
 	void GSDumpZst::MayFlush()
 	{
-		if (m_in_buff.size() >= _1mb)
-			Compress(ZSTD_e_continue);
+		if (m_in_buff.size() >= FRAME_SIZE)
+			Compress(ZSTD_e_end);
 	}
 
 	void GSDumpZst::Compress(ZSTD_EndDirective action)
@@ -379,6 +387,10 @@ namespace
 		if (m_in_buff.empty())
 			return;
 
+		// Each frame is compressed in one go, so record its size for the reader.
+		if (action == ZSTD_e_end)
+			ZSTD_CCtx_setPledgedSrcSize(m_strm, m_in_buff.size());
+
 		ZSTD_inBuffer inbuf = {m_in_buff.data(), m_in_buff.size(), 0};
 
 		for (;;)
@@ -425,3 +437,120 @@ std::unique_ptr<GSDumpBase> GSDumpBase::CreateZstDump(
 		screenshot_width, screenshot_height, screenshot_pixels,
 		fd, regs);
 }
+
+//////////////////////////////////////////////////////////////////////
+// GSDumpSeekableZst implementation
+//////////////////////////////////////////////////////////////////////
+
+namespace
+{
+	class GSDumpSeekableZst final : public GsDumpBuffered
+	{
+		// Chunks are only cut at the end of a frame, so they can be larger than this.
+		static constexpr size_t CHUNK_SIZE = 4 * _1mb;
+
+		void EndFrame() override;
+		void FlushChunk();
+		void WriteIndex();
+
+		ZSTD_CCtx* m_cctx;
+		DynamicHeapArray<u8, 64> m_out_buff;
+
+		std::vector<GSDumpChunkIndexEntry> m_index;
+		u64 m_file_offset = 0;
+		u32 m_frame_count = 0;
+		u32 m_chunk_first_frame = 0;
+		u32 m_chunk_first_packet = 0;
+
+	public:
+		GSDumpSeekableZst(const std::string& fn, const std::string& serial, u32 crc,
+			u32 screenshot_width, u32 screenshot_height, const u32* screenshot_pixels,
+			const freezeData& fd, const GSPrivRegSet* regs);
+		~GSDumpSeekableZst() override;
+	};
+
+	GSDumpSeekableZst::GSDumpSeekableZst(const std::string& fn, const std::string& serial, u32 crc,
+		u32 screenshot_width, u32 screenshot_height, const u32* screenshot_pixels,
+		const freezeData& fd, const GSPrivRegSet* regs)
+		: GsDumpBuffered(fn + ".gs.zsc")
+	{
+		m_cctx = ZSTD_createCCtx();
+		ZSTD_CCtx_setParameter(m_cctx, ZSTD_c_compressionLevel, 6);
+
+		AddHeader(serial, crc, screenshot_width, screenshot_height, screenshot_pixels, fd, regs);
+
+		// Header always gets a chunk to itself, so the first frame can be found without parsing it.
+		FlushChunk();
+	}
+
+	GSDumpSeekableZst::~GSDumpSeekableZst()
+	{
+		FlushChunk();
+		WriteIndex();
+
+		ZSTD_freeCCtx(m_cctx);
+	}
+
+	void GSDumpSeekableZst::EndFrame()
+	{
+		m_frame_count++;
+
+		if (m_buffer_size >= CHUNK_SIZE)
+			FlushChunk();
+	}
+
+	void GSDumpSeekableZst::FlushChunk()
+	{
+		if (m_buffer_size == 0)
+			return;
+
+		const size_t bound = ZSTD_compressBound(m_buffer_size);
+		if (m_out_buff.size() < bound)
+			m_out_buff.resize(bound);
+
+		const size_t compressed_size = ZSTD_compress2(m_cctx, m_out_buff.data(), m_out_buff.size(), m_buffer.data(), m_buffer_size);
+		if (ZSTD_isError(compressed_size))
+		{
+			Console.ErrorFmt("GSDumpSeekableZst: Error {}", ZSTD_getErrorName(compressed_size));
+			return;
+		}
+
+		Write(m_out_buff.data(), compressed_size);
+
+		GSDumpChunkIndexEntry entry;
+		entry.file_offset = m_file_offset;
+		entry.compressed_size = static_cast<u32>(compressed_size);
+		entry.uncompressed_size = static_cast<u32>(m_buffer_size);
+		entry.first_frame = m_chunk_first_frame;
+		entry.num_packets = GetPacketCount() - m_chunk_first_packet;
+		m_index.push_back(entry);
+
+		m_file_offset += compressed_size;
+		m_buffer_size = 0;
+		m_chunk_first_frame = m_frame_count;
+		m_chunk_first_packet = GetPacketCount();
+	}
+
+	void GSDumpSeekableZst::WriteIndex()
+	{
+		GSDumpChunkFooter footer;
+		footer.index_offset = m_file_offset;
+		footer.num_chunks = static_cast<u32>(m_index.size());
+		footer.num_frames = m_frame_count;
+		footer.version = GSDumpChunkFooter::VERSION;
+		footer.magic = GSDumpChunkFooter::MAGIC;
+
+		Write(m_index.data(), m_index.size() * sizeof(GSDumpChunkIndexEntry));
+		Write(&footer, sizeof(footer));
+	}
+} // namespace
+
+std::unique_ptr<GSDumpBase> GSDumpBase::CreateSeekableZstDump(
+	const std::string& fn, const std::string& serial, u32 crc,
+	u32 screenshot_width, u32 screenshot_height, const u32* screenshot_pixels,
+	const freezeData& fd, const GSPrivRegSet* regs)
+{
+	return std::make_unique<GSDumpSeekableZst>(fn, serial, crc,
+		screenshot_width, screenshot_height, screenshot_pixels,
+		fd, regs);
+}
@@ -24,6 +24,12 @@ ReadFIFO2 data (id == 2)
 Regs data (id == 3)
 - [PMODE/0x2000]
 
+Seekable dumps (.gs.zsc) store the same byte stream, split into chunks which are compressed as
+independent zstd frames. The first chunk holds everything up to and including the PMODE data, every
+following chunk holds whole frames of packets, ending on a VSync. An index of the chunks and a footer
+are appended after the last chunk:
+- [chunk 0] .. [chunk N] [GSDumpChunkIndexEntry * (N + 1)] [GSDumpChunkFooter]
+
 */
 
 #pragma pack(push, 4)
@@ -39,6 +45,27 @@ struct GSDumpHeader
 	u32 screenshot_offset;
 	u32 screenshot_size;
 };
+
+struct GSDumpChunkIndexEntry
+{
+	u64 file_offset;
+	u32 compressed_size;
+	u32 uncompressed_size;
+	u32 first_frame;
+	u32 num_packets;
+};
+
+struct GSDumpChunkFooter
+{
+	static constexpr u32 MAGIC = 0x43535347; // GSSC
+	static constexpr u32 VERSION = 1;
+
+	u64 index_offset;
+	u32 num_chunks;
+	u32 num_frames;
+	u32 version;
+	u32 magic;
+};
 #pragma pack(pop)
 
 class GSDumpBase
@@ -47,6 +74,7 @@ class GSDumpBase
 	std::string m_filename;
 	int m_frames;
 	int m_extra_frames;
+	u32 m_packets = 0;
 
 protected:
 	void AddHeader(const std::string& serial, u32 crc,
@@ -57,6 +85,11 @@ protected:
 	virtual void AppendRawData(const void* data, size_t size) = 0;
 	virtual void AppendRawData(u8 c) = 0;
 
+	/// Called after the VSync packet of each frame has been appended.
+	virtual void EndFrame() {}
+
+	__fi u32 GetPacketCount() const { return m_packets; }
+
 public:
 	GSDumpBase(std::string fn);
 	virtual ~GSDumpBase();
@@ -79,4 +112,8 @@ public:
 		const std::string& fn, const std::string& serial, u32 crc,
 		u32 screenshot_width, u32 screenshot_height, const u32* screenshot_pixels,
 		const freezeData& fd, const GSPrivRegSet* regs);
+	static std::unique_ptr<GSDumpBase> CreateSeekableZstDump(
+		const std::string& fn, const std::string& serial, u32 crc,
+		u32 screenshot_width, u32 screenshot_height, const u32* screenshot_pixels,
+		const freezeData& fd, const GSPrivRegSet* regs);
 };
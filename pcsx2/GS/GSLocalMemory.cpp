@@ -5,6 +5,7 @@
 #include "GS/GSLocalMemory.h"
 #include "GS/GSExtra.h"
 #include "GS/GSPng.h"
+#include "GS/GSXXH.h"
 #include <unordered_set>
 
 template <typename Fn>
@@ -56,6 +57,8 @@ GSLocalMemory::GSLocalMemory()
 
 	memset(m_vm8, 0, m_vmsize);
 
+	m_block_hashes = std::make_unique<u64[]>(MAX_BLOCKS);
+
 	MULTI_ISA_SELECT(GSLocalMemoryPopulateFunctions)(*this);
 
 	for (psm_t& psm : m_psm)
@@ -249,6 +252,24 @@ GSLocalMemory::~GSLocalMemory()
 	}
 }
 
+u64 GSLocalMemory::UpdateBlockHash(u32 bp)
+{
+	const u64 hash = GSXXH3_64bits(BlockPtr(bp), BLOCK_SIZE);
+	m_block_hashes[bp] = hash;
+	m_block_hash_valid[bp / BLOCKS_PER_PAGE] |= 1u << (bp % BLOCKS_PER_PAGE);
+	return hash;
+}
+
+void GSLocalMemory::InvalidateBlockHashes(const GSOffset& off, const GSVector4i& r)
+{
+	off.loopPages(r, [this](u32 page) { m_block_hash_valid[page % MAX_PAGES] = 0; });
+}
+
+void GSLocalMemory::InvalidateAllBlockHashes()
+{
+	m_block_hash_valid.fill(0);
+}
+
 GSPixelOffset* GSLocalMemory::GetPixelOffset(const GIFRegFRAME& FRAME, const GIFRegZBUF& ZBUF)
 {
 	u32 fbp = FRAME.Block();
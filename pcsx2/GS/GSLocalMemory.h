@@ -11,6 +11,7 @@
 #include "common/Assertions.h"
 
 #include <array>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -508,10 +509,33 @@ protected:
 	std::unordered_map<u32, GSPixelOffset4*> m_po4map;
 	std::unordered_map<u64, std::vector<GSVector2i>*> m_p2tmap;
 
+	/// Hash of every block, used to compose texture hashes without going through the whole texture.
+	/// Each page has one valid bit per block, which is cleared when anything writes to the page.
+	std::unique_ptr<u64[]> m_block_hashes;
+	std::array<u32, MAX_PAGES> m_block_hash_valid = {};
+
+	u64 UpdateBlockHash(u32 bp);
+
 public:
 	GSLocalMemory();
 	~GSLocalMemory();
 
+	/// Returns the hash of a block, rehashing it only if the page was written since it was last hashed.
+	__forceinline u64 GetBlockHash(u32 bp)
+	{
+		bp %= MAX_BLOCKS;
+		if (!(m_block_hash_valid[bp / BLOCKS_PER_PAGE] & (1u << (bp % BLOCKS_PER_PAGE)))) [[unlikely]]
+			return UpdateBlockHash(bp);
+
+		return m_block_hashes[bp];
+	}
+
+	/// Drops the cached hashes of all pages touched by a write to the specified rectangle.
+	void InvalidateBlockHashes(const GSOffset& off, const GSVector4i& r);
+
+	/// Drops all cached block hashes, for when the whole of memory is replaced.
+	void InvalidateAllBlockHashes();
+
 	__forceinline u8* vm8() const { return m_vm8; }
 	__forceinline u16* vm16() const { return reinterpret_cast<u16*>(m_vm8); }
 	__forceinline u32* vm32() const { return reinterpret_cast<u32*>(m_vm8); }
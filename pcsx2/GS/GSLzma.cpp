@@ -20,7 +20,11 @@
 #include <XzCrc64.h>
 #include <zstd.h>
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <mutex>
+#include <thread>
 
 using namespace GSDumpTypes;
 
@@ -127,6 +131,11 @@ bool GSDumpFile::ReadFile(Error* error)
 		return false;
 	}
 
+	return ReadPackets(error);
+}
+
+bool GSDumpFile::ReadPackets(Error* error)
+{
 	// read all the packet data in
 	// TODO: make this suck less by getting the full/extracted size and preallocating
 	for (;;)
@@ -150,82 +159,100 @@ bool GSDumpFile::ReadFile(Error* error)
 		}
 	}
 
-	u8* data = m_packet_data.data();
-	size_t remaining = m_packet_data.size();
-
-#define GET_BYTE(dst) \
-	do \
-	{ \
-		if (remaining < sizeof(u8)) \
-		{ \
-			Error::SetString(error, "Failed to read byte"); \
-			return false; \
-		} \
-		std::memcpy(dst, data, sizeof(u8)); \
-		data++; \
-		remaining--; \
-	} while (0)
-#define GET_WORD(dst) \
-	do \
-	{ \
-		if (remaining < sizeof(u32)) \
-		{ \
-			Error::SetString(error, "Failed to read word"); \
-			return false; \
-		} \
-		std::memcpy(dst, data, sizeof(u32)); \
-		data += sizeof(u32); \
-		remaining -= sizeof(u32); \
-	} while (0)
+	return ParsePackets(m_packet_data.data(), m_packet_data.size(), &m_dump_packets, &m_frame_count, error);
+}
 
-	while (remaining > 0)
-	{
-		GSData packet = {};
-		packet.path = GSTransferPath::Dummy;
-		GET_BYTE(&packet.id);
+size_t GSDumpFile::GetPacketCount() const
+{
+	return m_dump_packets.size();
+}
+
+const GSDumpFile::GSData* GSDumpFile::GetPacket(size_t index)
+{
+	return &m_dump_packets[index];
+}
+
+GSDumpFile::ParseResult GSDumpFile::ParsePacket(const u8* data, size_t size, GSData* packet, size_t* packet_size, Error* error)
+{
+	size_t header_size = sizeof(u8);
+	if (size < header_size)
+		return ParseResult::TruncatedHeader;
+
+	*packet = {};
+	packet->path = GSTransferPath::Dummy;
+	std::memcpy(&packet->id, data, sizeof(u8));
 
-		switch (packet.id)
+	switch (packet->id)
+	{
+		case GSType::Transfer:
 		{
-			case GSType::Transfer:
-				GET_BYTE(&packet.path);
-				GET_WORD(&packet.length);
-				break;
-			case GSType::VSync:
-				packet.length = 1;
-				break;
-			case GSType::ReadFIFO2:
-				packet.length = 4;
-				break;
-			case GSType::Registers:
-				packet.length = 8192;
-				break;
-			default:
-				Error::SetString(error, fmt::format("Unknown packet type {}", static_cast<u32>(packet.id)));
-				return false;
+			u32 length;
+			header_size += sizeof(u8) + sizeof(u32);
+			if (size < header_size)
+				return ParseResult::TruncatedHeader;
+
+			std::memcpy(&packet->path, data + 1, sizeof(u8));
+			std::memcpy(&length, data + 2, sizeof(u32));
+			packet->length = length;
 		}
+		break;
+		case GSType::VSync:
+			packet->length = 1;
+			break;
+		case GSType::ReadFIFO2:
+			packet->length = 4;
+			break;
+		case GSType::Registers:
+			packet->length = 8192;
+			break;
+		default:
+			Error::SetString(error, fmt::format("Unknown packet type {}", static_cast<u32>(packet->id)));
+			return ParseResult::Invalid;
+	}
+
+	if ((size - header_size) < packet->length)
+		return ParseResult::TruncatedData;
 
-		if (packet.length > 0)
+	packet->data = data + header_size;
+	*packet_size = header_size + packet->length;
+	return ParseResult::OK;
+}
+
+bool GSDumpFile::ParsePackets(const u8* data, size_t remaining, GSDataArray* packets, u32* frames, Error* error)
+{
+	while (remaining > 0)
+	{
+		GSData packet;
+		size_t packet_size;
+		switch (ParsePacket(data, remaining, &packet, &packet_size, error))
 		{
-			if (remaining < packet.length)
-			{
+			case ParseResult::OK:
+				break;
+
+			case ParseResult::TruncatedData:
 				// There's apparently some "bad" dumps out there that are missing bytes on the end..
 				// The "safest" option here is to discard the last packet, since that has less risk
 				// of leaving the GS in the middle of a command.
 				Console.Error("(GSDump) Dropping last packet of %u bytes (we only have %u bytes)",
 					static_cast<u32>(packet.length), static_cast<u32>(remaining));
-				break;
-			}
+				return true;
+
+			case ParseResult::TruncatedHeader:
+				Error::SetString(error, "Failed to read packet header");
+				return false;
 
-			packet.data = data;
-			data += packet.length;
-			remaining -= packet.length;
+			case ParseResult::Invalid:
+			default:
+				return false;
 		}
 
-		m_dump_packets.push_back(std::move(packet));
-	}
+		if (packet.id == GSType::VSync)
+			(*frames)++;
 
-#undef GET_WORD
-#undef GET_BYTE
+		packets->push_back(packet);
+		data += packet_size;
+		remaining -= packet_size;
+	}
 
 	return true;
 }
@@ -482,8 +509,22 @@ namespace
 
 		size_t m_avail = 0;
 		size_t m_start = 0;
+		size_t m_stream_pos = 0;
+
+		// Used when the dump is made up of several frames, which are decompressed on worker threads.
+		struct Frame
+		{
+			size_t file_offset;
+			size_t compressed_size;
+			size_t stream_offset;
+			size_t uncompressed_size;
+		};
+
+		DynamicHeapArray<u8, 64> m_stream_data;
 
 		bool Decompress();
+		bool ReadFrames(std::vector<Frame>* frames, DynamicHeapArray<u8, 64>* file_data);
+		bool ReadPacketsParallel(const std::vector<Frame>& frames, const u8* file_data, Error* error);
 
 	public:
 		GSDumpDecompressZst();
@@ -492,6 +533,7 @@ namespace
 		bool Open(std::FILE* fp, Error* error) override;
 		bool IsEof() override;
 		size_t Read(void* ptr, size_t size) override;
+		bool ReadPackets(Error* error) override;
 	};
 
 	GSDumpDecompressZst::GSDumpDecompressZst() = default;
@@ -580,9 +622,165 @@ namespace
 			off += l;
 		}
 
+		m_stream_pos += off;
 		return off;
 	}
 
+	bool GSDumpDecompressZst::ReadPackets(Error* error)
+	{
+		// Dumps written as a single frame (i.e. by older versions) have to be decompressed serially.
+		std::vector<Frame> frames;
+		DynamicHeapArray<u8, 64> file_data;
+		if (!ReadFrames(&frames, &file_data))
+			return GSDumpFile::ReadPackets(error);
+
+		return ReadPacketsParallel(frames, file_data.data(), error);
+	}
+
+	bool GSDumpDecompressZst::ReadFrames(std::vector<Frame>* frames, DynamicHeapArray<u8, 64>* file_data)
+	{
+		const s64 current_pos = FileSystem::FTell64(m_fp);
+		const s64 file_size = FileSystem::FSize64(m_fp);
+		if (current_pos < 0 || file_size <= 0)
+			return false;
+
+		file_data->resize(static_cast<size_t>(file_size));
+		const bool read_ok = (FileSystem::FSeek64(m_fp, 0, SEEK_SET) == 0 &&
+							  std::fread(file_data->data(), static_cast<size_t>(file_size), 1, m_fp) == 1);
+
+		// Put the stream back where it was, in case we have to fall back to it.
+		if (FileSystem::FSeek64(m_fp, current_pos, SEEK_SET) != 0 || !read_ok)
+			return false;
+
+		size_t file_offset = 0;
+		size_t stream_offset = 0;
+		while (file_offset < file_data->size())
+		{
+			const u8* data = file_data->data() + file_offset;
+			const size_t remaining = file_data->size() - file_offset;
+			const size_t compressed_size = ZSTD_findFrameCompressedSize(data, remaining);
+			const unsigned long long uncompressed_size = ZSTD_getFrameContentSize(data, remaining);
+			if (ZSTD_isError(compressed_size) || uncompressed_size == ZSTD_CONTENTSIZE_UNKNOWN ||
+				uncompressed_size == ZSTD_CONTENTSIZE_ERROR)
+			{
+				return false;
+			}
+
+			frames->push_back({file_offset, compressed_size, stream_offset, static_cast<size_t>(uncompressed_size)});
+			file_offset += compressed_size;
+			stream_offset += static_cast<size_t>(uncompressed_size);
+		}
+
+		return (frames->size() > 1);
+	}
+
+	bool GSDumpDecompressZst::ReadPacketsParallel(const std::vector<Frame>& frames, const u8* file_data, Error* error)
+	{
+		// The header has already been read through the stream, skip the frames it was in.
+		const size_t stream_size = frames.back().stream_offset + frames.back().uncompressed_size;
+		const size_t start_pos = m_stream_pos;
+		size_t first_frame = 0;
+		while (first_frame < frames.size() && (frames[first_frame].stream_offset + frames[first_frame].uncompressed_size) <= start_pos)
+			first_frame++;
+
+		m_stream_data.resize(stream_size);
+
+		std::mutex mutex;
+		std::condition_variable cv;
+		std::vector<u8> frame_done(frames.size(), 0);
+		std::atomic<size_t> next_frame{first_frame};
+		bool failed = false;
+
+		const auto worker = [&]() {
+			ZSTD_DCtx* dctx = ZSTD_createDCtx();
+			for (;;)
+			{
+				const size_t index = next_frame.fetch_add(1, std::memory_order_relaxed);
+				if (index >= frames.size())
+					break;
+
+				const Frame& frame = frames[index];
+				const size_t res = ZSTD_decompressDCtx(dctx, m_stream_data.data() + frame.stream_offset, frame.uncompressed_size,
+					file_data + frame.file_offset, frame.compressed_size);
+
+				std::unique_lock lock(mutex);
+				if (ZSTD_isError(res) || res != frame.uncompressed_size)
+				{
+					Console.ErrorFmt("Failed to decompress frame {}: {}", index, ZSTD_isError(res) ? ZSTD_getErrorName(res) : "size mismatch");
+					failed = true;
+					next_frame.store(frames.size(), std::memory_order_relaxed);
+				}
+				else
+				{
+					frame_done[index] = 1;
+				}
+
+				cv.notify_all();
+			}
+			ZSTD_freeDCtx(dctx);
+		};
+
+		const size_t num_workers = std::min<size_t>(frames.size() - first_frame, std::max(std::thread::hardware_concurrency(), 1u));
+		std::vector<std::thread> workers;
+		workers.reserve(num_workers);
+		for (size_t i = 0; i < num_workers; i++)
+			workers.emplace_back(worker);
+
+		// Parse packets as soon as the frames they are in have been decompressed.
+		const u8* data = m_stream_data.data();
+		size_t parse_pos = start_pos;
+		bool result = true;
+		for (size_t index = first_frame; index < frames.size() && result; index++)
+		{
+			{
+				std::unique_lock lock(mutex);
+				cv.wait(lock, [&]() { return frame_done[index] || failed; });
+				if (failed)
+				{
+					Error::SetString(error, "Failed to decompress packet data");
+					result = false;
+					break;
+				}
+			}
+
+			const size_t ready_end = frames[index].stream_offset + frames[index].uncompressed_size;
+			while (parse_pos < ready_end)
+			{
+				GSData packet;
+				size_t packet_size;
+				const ParseResult res = ParsePacket(data + parse_pos, ready_end - parse_pos, &packet, &packet_size, error);
+				if (res == ParseResult::Invalid)
+				{
+					result = false;
+					break;
+				}
+				else if (res != ParseResult::OK)
+				{
+					// Packet continues into the next frame.
+					break;
+				}
+
+				if (packet.id == GSDumpTypes::GSType::VSync)
+					m_frame_count++;
+
+				m_dump_packets.push_back(packet);
+				parse_pos += packet_size;
+			}
+		}
+
+		if (!result)
+			next_frame.store(frames.size(), std::memory_order_relaxed);
+		for (std::thread& thread : workers)
+			thread.join();
+
+		// Anything left over is a partial packet at the end of the dump.
+		if (result && parse_pos < stream_size)
+			result = ParsePackets(data + parse_pos, stream_size - parse_pos, &m_dump_packets, &m_frame_count, error);
+
+		DevCon.WriteLnFmt("Decompressed {} zstd frames on {} threads", frames.size() - first_frame, num_workers);
+		return result;
+	}
+
 	/******************************************************************/
 
 	class GSDumpRaw final : public GSDumpFile
@@ -628,6 +826,214 @@ namespace
 
 		return ret;
 	}
+
+	/******************************************************************/
+
+	class GSDumpSeekableZst final : public GSDumpFile
+	{
+	public:
+		GSDumpSeekableZst();
+		~GSDumpSeekableZst() override;
+
+		size_t GetPacketCount() const override;
+		const GSData* GetPacket(size_t index) override;
+
+	protected:
+		bool Open(std::FILE* fp, Error* error) override;
+		bool IsEof() override;
+		size_t Read(void* ptr, size_t size) override;
+		bool ReadPackets(Error* error) override;
+
+	private:
+		static constexpr size_t NO_CHUNK = static_cast<size_t>(-1);
+
+		bool LoadChunk(size_t index);
+
+		std::FILE* m_fp = nullptr;
+		ZSTD_DCtx* m_dctx = nullptr;
+
+		std::vector<GSDumpChunkIndexEntry> m_chunks;
+		std::vector<size_t> m_chunk_first_packet;
+		size_t m_packet_count = 0;
+
+		// Only one chunk is decompressed at a time, so memory use doesn't depend on the dump length.
+		DynamicHeapArray<u8, 64> m_compressed_buffer;
+		DynamicHeapArray<u8, 64> m_chunk_buffer;
+		GSDataArray m_chunk_packets;
+		size_t m_chunk_index = NO_CHUNK;
+		size_t m_chunk_size = 0;
+		size_t m_chunk_pos = 0;
+	};
+
+	GSDumpSeekableZst::GSDumpSeekableZst() = default;
+
+	GSDumpSeekableZst::~GSDumpSeekableZst()
+	{
+		if (m_dctx)
+			ZSTD_freeDCtx(m_dctx);
+
+		if (m_fp)
+			std::fclose(m_fp);
+	}
+
+	bool GSDumpSeekableZst::Open(std::FILE* fp, Error* error)
+	{
+		m_fp = fp;
+
+		GSDumpChunkFooter footer;
+		const s64 file_size = FileSystem::FSize64(m_fp);
+		if (file_size < static_cast<s64>(sizeof(footer)) ||
+			FileSystem::FSeek64(m_fp, file_size - static_cast<s64>(sizeof(footer)), SEEK_SET) != 0 ||
+			std::fread(&footer, sizeof(footer), 1, m_fp) != 1)
+		{
+			Error::SetString(error, "Failed to read chunk footer");
+			return false;
+		}
+
+		if (footer.magic != GSDumpChunkFooter::MAGIC || footer.version != GSDumpChunkFooter::VERSION ||
+			footer.num_chunks == 0 ||
+			(footer.index_offset + static_cast<u64>(footer.num_chunks) * sizeof(GSDumpChunkIndexEntry)) >
+				static_cast<u64>(file_size - static_cast<s64>(sizeof(footer))))
+		{
+			Error::SetString(error, "Chunk footer is corrupted. The dump may not have been finished.");
+			return false;
+		}
+
+		m_chunks.resize(footer.num_chunks);
+		if (FileSystem::FSeek64(m_fp, static_cast<s64>(footer.index_offset), SEEK_SET) != 0 ||
+			std::fread(m_chunks.data(), sizeof(GSDumpChunkIndexEntry), m_chunks.size(), m_fp) != m_chunks.size())
+		{
+			Error::SetString(error, "Failed to read chunk index");
+			return false;
+		}
+
+		u32 max_compressed_size = 0;
+		u32 max_uncompressed_size = 0;
+		m_chunk_first_packet.reserve(m_chunks.size());
+		for (const GSDumpChunkIndexEntry& chunk : m_chunks)
+		{
+			if ((chunk.file_offset + chunk.compressed_size) > footer.index_offset)
+			{
+				Error::SetString(error, "Chunk index is corrupted.");
+				return false;
+			}
+
+			m_chunk_first_packet.push_back(m_packet_count);
+			m_packet_count += chunk.num_packets;
+			max_compressed_size = std::max(max_compressed_size, chunk.compressed_size);
+			max_uncompressed_size = std::max(max_uncompressed_size, chunk.uncompressed_size);
+		}
+
+		m_frame_count = footer.num_frames;
+		m_compressed_buffer.resize(max_compressed_size);
+		m_chunk_buffer.resize(max_uncompressed_size);
+		m_dctx = ZSTD_createDCtx();
+
+		DevCon.WriteLnFmt("Seekable GS dump has {} packets and {} frames across {} chunks", m_packet_count, m_frame_count,
+			m_chunks.size());
+		return true;
+	}
+
+	bool GSDumpSeekableZst::LoadChunk(size_t index)
+	{
+		const GSDumpChunkIndexEntry& chunk = m_chunks[index];
+
+		if (FileSystem::FSeek64(m_fp, static_cast<s64>(chunk.file_offset), SEEK_SET) != 0 ||
+			std::fread(m_compressed_buffer.data(), chunk.compressed_size, 1, m_fp) != 1)
+		{
+			Console.ErrorFmt("Failed to read {} bytes from offset {}", chunk.compressed_size, chunk.file_offset);
+			return false;
+		}
+
+		const size_t size = ZSTD_decompressDCtx(
+			m_dctx, m_chunk_buffer.data(), chunk.uncompressed_size, m_compressed_buffer.data(), chunk.compressed_size);
+		if (ZSTD_isError(size) || size != chunk.uncompressed_size) [[unlikely]]
+		{
+			Console.ErrorFmt("Failed to decompress chunk {}: {}", index, ZSTD_isError(size) ? ZSTD_getErrorName(size) : "size mismatch");
+			m_chunk_index = NO_CHUNK;
+			return false;
+		}
+
+		m_chunk_index = index;
+		m_chunk_size = size;
+		m_chunk_pos = 0;
+
+		// The first chunk is the header, which is read as a stream.
+		m_chunk_packets.clear();
+		if (index == 0)
+			return true;
+
+		Error error;
+		u32 frames = 0;
+		if (!ParsePackets(m_chunk_buffer.data(), m_chunk_size, &m_chunk_packets, &frames, &error) ||
+			m_chunk_packets.size() != chunk.num_packets)
+		{
+			Console.ErrorFmt("Chunk {} is corrupted: {}", index, error.GetDescription());
+			m_chunk_index = NO_CHUNK;
+			return false;
+		}
+
+		return true;
+	}
+
+	bool GSDumpSeekableZst::IsEof()
+	{
+		return (m_chunk_pos == m_chunk_size && (m_chunk_index + 1) >= m_chunks.size());
+	}
+
+	size_t GSDumpSeekableZst::Read(void* ptr, size_t size)
+	{
+		u8* dst = static_cast<u8*>(ptr);
+		size_t remain = size;
+		while (remain > 0)
+		{
+			if (m_chunk_pos == m_chunk_size)
+			{
+				const size_t next = (m_chunk_index == NO_CHUNK) ? 0 : (m_chunk_index + 1);
+				if (next == m_chunks.size() || !LoadChunk(next)) [[unlikely]]
+					break;
+			}
+
+			const size_t read = std::min(m_chunk_size - m_chunk_pos, remain);
+			std::memcpy(dst, &m_chunk_buffer[m_chunk_pos], read);
+			dst += read;
+			remain -= read;
+			m_chunk_pos += read;
+		}
+
+		return size - remain;
+	}
+
+	bool GSDumpSeekableZst::ReadPackets(Error* error)
+	{
+		// Packets are decompressed on demand, but the header must have been all of the first chunk.
+		if (m_chunk_index != 0 || m_chunk_pos != m_chunk_size)
+		{
+			Error::SetString(error, "Header chunk is corrupted.");
+			return false;
+		}
+
+		return true;
+	}
+
+	size_t GSDumpSeekableZst::GetPacketCount() const
+	{
+		return m_packet_count;
+	}
+
+	const GSDumpFile::GSData* GSDumpSeekableZst::GetPacket(size_t index)
+	{
+		if (m_chunk_index == NO_CHUNK || index < m_chunk_first_packet[m_chunk_index] ||
+			(index - m_chunk_first_packet[m_chunk_index]) >= m_chunk_packets.size())
+		{
+			// Find the last chunk starting at or before the packet, skipping the header chunk.
+			const auto it = std::upper_bound(m_chunk_first_packet.begin() + 1, m_chunk_first_packet.end(), index);
+			if (!LoadChunk(static_cast<size_t>(std::distance(m_chunk_first_packet.begin(), it)) - 1))
+				return nullptr;
+		}
+
+		return &m_chunk_packets[index - m_chunk_first_packet[m_chunk_index]];
+	}
 } // namespace
 
 /******************************************************************/
@@ -643,6 +1049,8 @@ std::unique_ptr<GSDumpFile> GSDumpFile::OpenGSDump(const char* filename, Error*
 		file = std::make_unique<GSDumpLzma>();
 	else if (StringUtil::EndsWithNoCase(filename, ".zst"))
 		file = std::make_unique<GSDumpDecompressZst>();
+	else if (StringUtil::EndsWithNoCase(filename, ".zsc"))
+		file = std::make_unique<GSDumpSeekableZst>();
 	else
 		file = std::make_unique<GSDumpRaw>();
 
@@ -298,7 +298,16 @@ public:
 
 	__fi const ByteArray& GetRegsData() const { return m_regs_data; }
 	__fi const ByteArray& GetStateData() const { return m_state_data; }
-	__fi const GSDataArray& GetPackets() const { return m_dump_packets; }
+
+	/// Returns the number of VSyncs in the dump.
+	__fi u32 GetFrameCount() const { return m_frame_count; }
+
+	/// Returns the number of packets in the dump.
+	virtual size_t GetPacketCount() const;
+
+	/// Returns the specified packet. Its data is only valid until the next call, and a null
+	/// pointer is returned if the packet could not be read.
+	virtual const GSData* GetPacket(size_t index);
 
 	bool ReadFile(Error* error);
 
@@ -309,6 +318,27 @@ protected:
 	virtual bool IsEof() = 0;
 	virtual size_t Read(void* ptr, size_t size) = 0;
 
+	/// Reads the packets which follow the header. The default implementation reads the
+	/// remainder of the stream into memory.
+	virtual bool ReadPackets(Error* error);
+
+	enum class ParseResult
+	{
+		OK,
+		TruncatedHeader,
+		TruncatedData,
+		Invalid,
+	};
+
+	/// Parses the packet at the start of data. packet_size is set to the number of bytes it occupies.
+	static ParseResult ParsePacket(const u8* data, size_t size, GSData* packet, size_t* packet_size, Error* error);
+
+	/// Splits a block of packet data into packets, which point into the block.
+	static bool ParsePackets(const u8* data, size_t size, GSDataArray* packets, u32* frames, Error* error);
+
+	GSDataArray m_dump_packets;
+	u32 m_frame_count = 0;
+
 private:
 	std::string m_serial;
 	u32 m_crc = 0;
@@ -316,8 +346,6 @@ private:
 	std::vector<u8> m_regs_data;
 	std::vector<u8> m_state_data;
 	std::vector<u8> m_packet_data;
-
-	GSDataArray m_dump_packets;
 };
 
 // Initializes CRC tables used by LZMA SDK.
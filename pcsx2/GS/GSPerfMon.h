@@ -22,6 +22,11 @@ public:
 		SyncPoint,
 		Barriers,
 		RenderPasses,
+		RasterizerJobs,
+		TextureCacheHits,
+		TextureCacheMisses,
+		HWDrawsSubmitted,
+		HWDrawsMerged,
 		CounterLast,
 
 		// Reused counters for HW.
@@ -100,6 +100,7 @@ GSState::GSState()
 	memset(&m_vertex, 0, sizeof(m_vertex));
 	memset(&m_index, 0, sizeof(m_index));
 	memset(m_mem.m_vm8, 0, m_mem.m_vmsize);
+	m_mem.InvalidateAllBlockHashes();
 
 	m_v.RGBAQ.Q = 1.0f;
 
@@ -2697,6 +2698,7 @@ int GSState::Defrost(const freezeData* fd)
 	ReadState(&m_tr.x, data);
 	ReadState(&m_tr.y, data);
 	ReadState(m_mem.m_vm8, data, m_mem.m_vmsize);
+	m_mem.InvalidateAllBlockHashes();
 
 	m_tr.total = 0; // TODO: restore transfer state
 
@@ -4,6 +4,7 @@
 #include "GS/Renderers/Common/GSDevice.h"
 #include "GS/GSGL.h"
 #include "GS/GS.h"
+#include "GS/GSPerfMon.h"
 #include "Host.h"
 
 #include "common/Console.h"
@@ -313,6 +314,9 @@ bool GSDevice::Create()
 
 void GSDevice::Destroy()
 {
+	// Backend objects are gone at this point, so anything still held back is dropped.
+	m_hw_batch.pending = false;
+
 	if (m_imgui_font)
 	{
 		Recycle(m_imgui_font);
@@ -323,6 +327,10 @@ void GSDevice::Destroy()
 	PurgePool();
 }
 
+void GSDevice::GameChanged()
+{
+}
+
 bool GSDevice::AcquireWindow(bool recreate_window)
 {
 	std::optional<WindowInfo> wi = Host::AcquireRenderWindow(recreate_window);
@@ -350,19 +358,97 @@ bool GSDevice::GetHostRefreshRate(float* refresh_rate)
 
 void GSDevice::ClearRenderTarget(GSTexture* t, u32 c)
 {
+	FlushHWBatch(t);
 	t->SetClearColor(c);
 }
 
 void GSDevice::ClearDepth(GSTexture* t, float d)
 {
+	FlushHWBatch(t);
 	t->SetClearDepth(d);
 }
 
 void GSDevice::InvalidateRenderTarget(GSTexture* t)
 {
+	FlushHWBatch(t);
 	t->SetState(GSTexture::State::Invalidated);
 }
 
+bool GSDevice::CanBatchHWDraw(const GSHWDrawConfig& config)
+{
+	// Anything reading the framebuffer in the shader, or needing barriers/extra passes, sees the result of
+	// earlier primitives outside of the fixed function blend/depth units, so has to stay a separate draw.
+	return (!GSConfig.DisableHWDrawBatching && !config.drawlist && !config.require_one_barrier &&
+			!config.require_full_barrier && !config.line_expand && config.vs.expand == GSHWDrawConfig::VSExpand::None &&
+			config.destination_alpha == GSHWDrawConfig::DestinationAlphaMode::Off &&
+			!config.alpha_second_pass.enable && !config.blend_second_pass.enable && !config.ps.IsFeedbackLoop() &&
+			!config.ps.shuffle && config.tex != config.rt && config.tex != config.ds &&
+			config.nverts <= MAX_HW_BATCH_VERTICES && config.nindices <= MAX_HW_BATCH_INDICES);
+}
+
+bool GSDevice::CanMergeHWDraw(const GSHWDrawConfig& batch, const GSHWDrawConfig& config)
+{
+	return (batch.rt == config.rt && batch.ds == config.ds && batch.tex == config.tex && batch.pal == config.pal &&
+			batch.topology == config.topology && batch.indices_per_prim == config.indices_per_prim &&
+			batch.ps == config.ps && batch.vs.key == config.vs.key && batch.blend.key == config.blend.key &&
+			batch.sampler.key == config.sampler.key && batch.colormask.key == config.colormask.key &&
+			batch.depth.key == config.depth.key && batch.datm == config.datm && batch.scissor.eq(config.scissor) &&
+			batch.cb_vs == config.cb_vs && batch.cb_ps == config.cb_ps &&
+			(batch.nverts + config.nverts) <= MAX_HW_BATCH_VERTICES &&
+			(batch.nindices + config.nindices) <= MAX_HW_BATCH_INDICES);
+}
+
+void GSDevice::QueueHWDraw(GSHWDrawConfig& config)
+{
+	g_perfmon.Put(GSPerfMon::HWDrawsSubmitted, 1);
+
+	if (!CanBatchHWDraw(config))
+	{
+		FlushHWBatch();
+		RenderHW(config);
+		return;
+	}
+
+	HWDrawBatch& batch = m_hw_batch;
+	if (batch.pending)
+	{
+		if (CanMergeHWDraw(batch.config, config))
+		{
+			const u16 base_vertex = static_cast<u16>(batch.config.nverts);
+			batch.vertices.insert(batch.vertices.end(), config.verts, config.verts + config.nverts);
+			batch.indices.reserve(batch.indices.size() + config.nindices);
+			for (u32 i = 0; i < config.nindices; i++)
+				batch.indices.push_back(base_vertex + config.indices[i]);
+
+			batch.config.nverts += config.nverts;
+			batch.config.nindices += config.nindices;
+			batch.config.drawarea = batch.config.drawarea.runion(config.drawarea);
+			g_perfmon.Put(GSPerfMon::HWDrawsMerged, 1);
+			return;
+		}
+
+		SubmitHWBatch();
+	}
+
+	// The vertex/index buffers belong to the renderer and get overwritten by the next draw, so take a copy.
+	batch.config = config;
+	batch.vertices.assign(config.verts, config.verts + config.nverts);
+	batch.indices.assign(config.indices, config.indices + config.nindices);
+	batch.pending = true;
+}
+
+void GSDevice::SubmitHWBatch()
+{
+	HWDrawBatch& batch = m_hw_batch;
+	pxAssert(batch.pending);
+
+	// Cleared first, RenderHW() flushes on entry.
+	batch.pending = false;
+	batch.config.verts = batch.vertices.data();
+	batch.config.indices = batch.indices.data();
+	RenderHW(batch.config);
+}
+
 bool GSDevice::UpdateImGuiFontTexture()
 {
 	ImGuiIO& io = ImGui::GetIO();
@@ -491,6 +577,8 @@ void GSDevice::Recycle(GSTexture* t)
 	if (!t)
 		return;
 
+	FlushHWBatch(t);
+
 	t->SetLastFrameUsed(m_frame);
 
 	FastList<GSTexture*>& pool = m_pool[!t->IsTexture()];
@@ -624,6 +712,8 @@ void GSDevice::ClearCurrent()
 
 void GSDevice::Merge(GSTexture* sTex[3], GSVector4* sRect, GSVector4* dRect, const GSVector2i& fs, const GSRegPMODE& PMODE, const GSRegEXTBUF& EXTBUF, u32 c)
 {
+	FlushHWBatch();
+
 	if (ResizeRenderTarget(&m_merge, fs.x, fs.y, false, false))
 		DoMerge(sTex, sRect, m_merge, dRect, PMODE, EXTBUF, c, GSConfig.PCRTCOffsets);
 
@@ -632,6 +722,8 @@ void GSDevice::Merge(GSTexture* sTex[3], GSVector4* sRect, GSVector4* dRect, con
 
 void GSDevice::Interlace(const GSVector2i& ds, int field, int mode, float yoffset)
 {
+	FlushHWBatch();
+
 	static int bufIdx = 0;
 	float offset = yoffset * static_cast<float>(field);
 	offset = GSConfig.DisableInterlaceOffset ? 0.0f : offset;
@@ -700,6 +792,8 @@ void GSDevice::Interlace(const GSVector2i& ds, int field, int mode, float yoffse
 
 void GSDevice::FXAA()
 {
+	FlushHWBatch();
+
 	// Combining FXAA+ShadeBoost can't share the same target.
 	GSTexture*& dTex = (m_current == m_target_tmp) ? m_merge : m_target_tmp;
 	if (ResizeRenderTarget(&dTex, m_current->GetWidth(), m_current->GetHeight(), false, false))
@@ -711,6 +805,8 @@ void GSDevice::FXAA()
 
 void GSDevice::ShadeBoost()
 {
+	FlushHWBatch();
+
 	if (ResizeRenderTarget(&m_target_tmp, m_current->GetWidth(), m_current->GetHeight(), false, false))
 	{
 		// predivide to avoid the divide (multiply) in the shader
@@ -822,6 +918,8 @@ bool GSDevice::GetCASShaderSource(std::string* source)
 
 void GSDevice::CAS(GSTexture*& tex, GSVector4i& src_rect, GSVector4& src_uv, const GSVector4& draw_rect, bool sharpen_only)
 {
+	FlushHWBatch();
+
 	const int dst_width = sharpen_only ? src_rect.width() : static_cast<int>(std::ceil(draw_rect.z - draw_rect.x));
 	const int dst_height = sharpen_only ? src_rect.height() : static_cast<int>(std::ceil(draw_rect.w - draw_rect.y));
 	const int src_offset_x = static_cast<int>(src_rect.x);
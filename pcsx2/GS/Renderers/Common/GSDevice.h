@@ -774,9 +774,25 @@ public:
 	// clang-format on
 
 private:
+	/// HW draw which has been held back, so that following compatible draws can be appended to it.
+	struct HWDrawBatch
+	{
+		GSHWDrawConfig config;
+		std::vector<GSVertex> vertices;
+		std::vector<u16> indices;
+		bool pending = false;
+
+		__fi bool UsesTexture(const GSTexture* t) const
+		{
+			return (t == config.rt || t == config.ds || t == config.tex || t == config.pal);
+		}
+	};
+
 	std::array<FastList<GSTexture*>, 2> m_pool; // [texture, target]
 	u64 m_pool_memory_usage = 0;
 
+	HWDrawBatch m_hw_batch;
+
 	static const std::array<HWBlend, 3*3*3*3> m_blendMap;
 
 protected:
@@ -788,6 +804,8 @@ protected:
 	static constexpr u32 MAX_TEXTURE_AGE = 10;
 	static constexpr u32 NUM_CAS_CONSTANTS = 12; // 8 plus src offset x/y, 16 byte alignment
 	static constexpr u32 EXPAND_BUFFER_SIZE = sizeof(u16) * 16383 * 6;
+	static constexpr u32 MAX_HW_BATCH_VERTICES = 0x10000; // indices are 16-bit
+	static constexpr u32 MAX_HW_BATCH_INDICES = 0x30000;
 
 	WindowInfo m_window_info;
 	VsyncMode m_vsync_mode = VsyncMode::Off;
@@ -830,6 +848,16 @@ protected:
 	/// Applies CAS and writes to the destination texture, which should be a RWTexture.
 	virtual bool DoCAS(GSTexture* sTex, GSTexture* dTex, bool sharpen_only, const std::array<u32, NUM_CAS_CONSTANTS>& constants) = 0;
 
+	/// Returns true if the draw doesn't depend on the output of earlier draws, other than through blending and
+	/// depth testing, and can therefore share a draw call with them.
+	static bool CanBatchHWDraw(const GSHWDrawConfig& config);
+
+	/// Returns true if the draw uses the same targets, textures, pipeline and constants as the batch.
+	static bool CanMergeHWDraw(const GSHWDrawConfig& batch, const GSHWDrawConfig& config);
+
+	/// Renders the held back draw.
+	void SubmitHWBatch();
+
 public:
 	GSDevice();
 	virtual ~GSDevice();
@@ -901,6 +929,9 @@ public:
 	/// Presents the frame to the display.
 	virtual void EndPresent() = 0;
 
+	/// Called when the running game changes, so per-game caches can be switched over.
+	virtual void GameChanged();
+
 	/// Changes vsync mode for this display.
 	virtual void SetVSync(VsyncMode mode) = 0;
 
@@ -954,6 +985,28 @@ public:
 
 	virtual void RenderHW(GSHWDrawConfig& config) = 0;
 
+	/// Renders a HW draw. Draws which can be batched are held back, and merged with the following draws when they
+	/// share the same state, instead of being submitted individually.
+	void QueueHWDraw(GSHWDrawConfig& config);
+
+	/// Renders any held back HW draw. Backends call this before recording anything else, so nothing can be
+	/// reordered around a queued draw.
+	__fi void FlushHWBatch()
+	{
+		if (m_hw_batch.pending) [[unlikely]]
+			SubmitHWBatch();
+	}
+
+	/// Returns true if the held back HW draw uses the specified texture.
+	__fi bool IsInHWBatch(const GSTexture* t) const { return (m_hw_batch.pending && m_hw_batch.UsesTexture(t)); }
+
+	/// Renders the held back HW draw, if it uses the specified texture.
+	__fi void FlushHWBatch(const GSTexture* t)
+	{
+		if (IsInHWBatch(t)) [[unlikely]]
+			SubmitHWBatch();
+	}
+
 	virtual void ClearSamplerCache() = 0;
 
 	void ClearCurrent();
@@ -694,6 +694,13 @@ void GSRenderer::VSync(u32 field, bool registers_written, bool idle_frame)
 					screenshot_pixels.empty() ? nullptr : screenshot_pixels.data(), fd, m_regs);
 				compression_str = TRANSLATE_SV("GS", "with LZMA compression");
 			}
+			else if (GSConfig.GSDumpCompression == GSDumpCompressionMethod::SeekableZstandard)
+			{
+				m_dump = GSDumpBase::CreateSeekableZstDump(m_snapshot, VMManager::GetDiscSerial(),
+					VMManager::GetDiscCRC(), screenshot_width, screenshot_height,
+					screenshot_pixels.empty() ? nullptr : screenshot_pixels.data(), fd, m_regs);
+				compression_str = TRANSLATE_SV("GS", "with seekable Zstandard compression");
+			}
 			else
 			{
 				m_dump = GSDumpBase::CreateZstDump(m_snapshot, VMManager::GetDiscSerial(),
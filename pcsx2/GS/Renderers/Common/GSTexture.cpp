@@ -157,6 +157,11 @@ u32 GSTexture::CalcUploadSize(Format format, u32 height, u32 pitch)
 	return pitch * ((static_cast<u32>(height) + (block_size - 1)) / block_size);
 }
 
+bool GSTexture::IsInPendingHWBatch() const
+{
+	return (g_gs_device && g_gs_device->IsInHWBatch(this));
+}
+
 void GSTexture::GenerateMipmapsIfNeeded()
 {
 	if (!m_needs_mipmaps_generated || m_mipmap_levels <= 1 || IsCompressedFormat())
@@ -129,14 +129,28 @@ public:
 		return (m_type == Type::Texture);
 	}
 
-	__fi State GetState() const { return m_state; }
+	/// State and clear value are only current once any queued draw into the texture has been rendered,
+	/// call GSDevice::FlushHWBatch() with it first.
+	__fi State GetState() const
+	{
+		pxAssertMsg(!IsInPendingHWBatch(), "Texture state read with a draw into it still queued");
+		return m_state;
+	}
 	__fi void SetState(State state) { m_state = state; }
 
 	__fi u32 GetLastFrameUsed() const { return m_last_frame_used; }
 	void SetLastFrameUsed(u32 frame) { m_last_frame_used = frame; }
 
-	__fi u32 GetClearColor() const { return m_clear_value.color; }
-	__fi float GetClearDepth() const { return m_clear_value.depth; }
+	__fi u32 GetClearColor() const
+	{
+		pxAssertMsg(!IsInPendingHWBatch(), "Texture clear color read with a draw into it still queued");
+		return m_clear_value.color;
+	}
+	__fi float GetClearDepth() const
+	{
+		pxAssertMsg(!IsInPendingHWBatch(), "Texture clear depth read with a draw into it still queued");
+		return m_clear_value.depth;
+	}
 	__fi GSVector4 GetUNormClearColor() const { return GSVector4::unorm8(m_clear_value.color); }
 
 	__fi void SetClearColor(u32 color)
@@ -150,6 +164,9 @@ public:
 		m_clear_value.depth = depth;
 	}
 
+	/// Returns true if the device is holding back a batched draw which uses this texture.
+	bool IsInPendingHWBatch() const;
+
 	void GenerateMipmapsIfNeeded();
 	void ClearMipmapGenerationFlag() { m_needs_mipmaps_generated = false; }
 
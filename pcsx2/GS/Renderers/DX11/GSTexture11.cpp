@@ -54,6 +54,8 @@ void* GSTexture11::GetNativeHandle() const
 
 bool GSTexture11::Update(const GSVector4i& r, const void* data, int pitch, int layer)
 {
+	g_gs_device->FlushHWBatch(this);
+
 	if (layer >= m_mipmap_levels)
 		return false;
 
@@ -73,6 +75,8 @@ bool GSTexture11::Update(const GSVector4i& r, const void* data, int pitch, int l
 
 bool GSTexture11::Map(GSMap& m, const GSVector4i* r, int layer)
 {
+	g_gs_device->FlushHWBatch(this);
+
 	// Not supported
 	return false;
 }
@@ -84,6 +88,8 @@ void GSTexture11::Unmap()
 
 void GSTexture11::GenerateMipmap()
 {
+	g_gs_device->FlushHWBatch(this);
+
 	GSDevice11::GetInstance()->GetD3DContext()->GenerateMips(operator ID3D11ShaderResourceView*());
 }
 
@@ -210,6 +216,8 @@ std::unique_ptr<GSDownloadTexture11> GSDownloadTexture11::Create(u32 width, u32
 void GSDownloadTexture11::CopyFromTexture(
 	const GSVector4i& drc, GSTexture* stex, const GSVector4i& src, u32 src_level, bool use_transfer_pitch)
 {
+	g_gs_device->FlushHWBatch(stex);
+
 	pxAssert(stex->GetFormat() == m_format);
 	pxAssert(drc.width() == src.width() && drc.height() == src.height());
 	pxAssert(src.z <= stex->GetWidth() && src.w <= stex->GetHeight());
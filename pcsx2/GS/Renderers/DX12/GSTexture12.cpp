@@ -396,6 +396,8 @@ void GSTexture12::CopyTextureDataForUpload(void* dst, const void* src, u32 pitch
 
 bool GSTexture12::Update(const GSVector4i& r, const void* data, int pitch, int layer)
 {
+	g_gs_device->FlushHWBatch(this);
+
 	if (layer >= m_mipmap_levels)
 		return false;
 
@@ -484,6 +486,8 @@ bool GSTexture12::Update(const GSVector4i& r, const void* data, int pitch, int l
 
 bool GSTexture12::Map(GSMap& m, const GSVector4i* r, int layer)
 {
+	g_gs_device->FlushHWBatch(this);
+
 	if (layer >= m_mipmap_levels || IsCompressedFormat())
 		return false;
 
@@ -570,6 +574,8 @@ void GSTexture12::Unmap()
 
 void GSTexture12::GenerateMipmap()
 {
+	g_gs_device->FlushHWBatch(this);
+
 	pxAssert(!IsCompressedFormat(m_format));
 
 	for (int dst_level = 1; dst_level < m_mipmap_levels; dst_level++)
@@ -693,6 +699,8 @@ std::unique_ptr<GSDownloadTexture12> GSDownloadTexture12::Create(u32 width, u32
 void GSDownloadTexture12::CopyFromTexture(
 	const GSVector4i& drc, GSTexture* stex, const GSVector4i& src, u32 src_level, bool use_transfer_pitch)
 {
+	g_gs_device->FlushHWBatch(stex);
+
 	GSTexture12* const tex12 = static_cast<GSTexture12*>(stex);
 
 	pxAssert(tex12->GetFormat() == m_format);
@@ -94,6 +94,9 @@ void GSRendererHW::UpdateSettings(const Pcsx2Config::GSOptions& old_config)
 
 void GSRendererHW::VSync(u32 field, bool registers_written, bool idle_frame)
 {
+	// Don't hold a draw back across frames.
+	g_gs_device->FlushHWBatch();
+
 	if (GSConfig.LoadTextureReplacements)
 		GSTextureReplacements::ProcessAsyncLoadedTextures();
 
@@ -5930,7 +5933,7 @@ __ri void GSRendererHW::DrawPrims(GSTextureCache::Target* rt, GSTextureCache::Ta
 
 	m_conf.drawlist = (m_conf.require_full_barrier && m_vt.m_primclass == GS_SPRITE_CLASS) ? &m_drawlist : nullptr;
 
-	g_gs_device->RenderHW(m_conf);
+	g_gs_device->QueueHWDraw(m_conf);
 
 	if (tex_copy)
 		g_gs_device->Recycle(tex_copy);
@@ -6634,6 +6637,8 @@ void GSRendererHW::ClearGSLocalMemory(const GSOffset& off, const GSVector4i& r,
 	const u32 psm = (off.psm() == PSMCT32 && m_cached_ctx.FRAME.FBMSK == 0xFF000000u) ? PSMCT24 : off.psm();
 	const int format = GSLocalMemory::m_psm[psm].fmt;
 
+	m_mem.InvalidateBlockHashes(off, r);
+
 	const int left = r.left;
 	const int right = r.right;
 	const int bottom = r.bottom;
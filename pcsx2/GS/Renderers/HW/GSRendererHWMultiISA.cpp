@@ -542,6 +542,10 @@ bool GSRendererHWFunctions::SwPrimRender(GSRendererHW& hw, bool invalidate_tc, b
 
 	static_cast<GSSingleRasterizer*>(hw.m_sw_rasterizer.get())->Draw(data);
 
+	// Texture hashes have to see the write even when the texture cache doesn't.
+	hw.m_mem.InvalidateBlockHashes(context->offset.fb, bbox);
+	hw.m_mem.InvalidateBlockHashes(context->offset.zb, bbox);
+
 	if (invalidate_tc)
 		g_texture_cache->InvalidateVideoMem(context->offset.fb, bbox);
 
@@ -32,6 +32,19 @@ static u8* s_unswizzle_buffer;
 /// List of candidates for purging when the hash cache gets too large.
 static std::vector<std::pair<GSTextureCache::HashCacheMap::iterator, s32>> s_hash_cache_purge_list;
 
+namespace
+{
+	struct BudgetEvictionCandidate
+	{
+		GSTextureCache::HashCacheMap::iterator hc_it;
+		GSTextureCache::Source* src;
+		GSTextureCache::Target* dst;
+		u32 score;
+	};
+} // namespace
+
+static std::vector<BudgetEvictionCandidate> s_budget_eviction_list;
+
 #ifdef PCSX2_DEVBUILD
 // We can only set one texture name per command buffer, which would break our fancy texture cache RT/DS/texture naming.
 // So, when debug device is enabled, don't reuse any textures that are drawable.
@@ -62,6 +75,7 @@ GSTextureCache::~GSTextureCache()
 	RemoveAll(true, true, true);
 
 	s_hash_cache_purge_list = {};
+	s_budget_eviction_list = {};
 	_aligned_free(s_unswizzle_buffer);
 }
 
@@ -1706,6 +1720,8 @@ GSTextureCache::Source* GSTextureCache::LookupSource(const bool is_color, const
 		src = CreateSource(TEX0, TEXA, dst, half_right, x_offset, y_offset, lod, &r, gpu_clut, region);
 		if (!src) [[unlikely]]
 			return nullptr;
+
+		g_perfmon.Put(GSPerfMon::TextureCacheMisses, 1);
 	}
 	else
 	{
@@ -1713,6 +1729,8 @@ GSTextureCache::Source* GSTextureCache::LookupSource(const bool is_color, const
 			TEX0.TBP0, psm_s.pal > 0 ? TEX0.CBP : 0,
 			psm_str(TEX0.PSM));
 
+		g_perfmon.Put(GSPerfMon::TextureCacheHits, 1);
+
 		// If it's from a target, we need to make sure the alpha information is up to date, especially in 16/24 bit formats where it can change draw to draw.
 		// Guard against merged targets which don't actually link.
 		if (src->m_target && src->m_from_target)
@@ -2229,6 +2247,8 @@ GSTextureCache::Target* GSTextureCache::LookupTarget(GIFRegTEX0 TEX0, const GSVe
 					!dst->m_dirty.GetDirtyRect(0, TEX0, dst->GetUnscaledRect(), false).eq(dst->GetUnscaledRect()))
 				{
 					// If the old target was cleared, simply propagate that through.
+					// A queued draw would leave it dirty, so render that first.
+					g_gs_device->FlushHWBatch(dst_match->m_texture);
 					if (dst_match->m_texture->GetState() == GSTexture::State::Cleared)
 					{
 						if (type == DepthStencil)
@@ -2893,6 +2913,7 @@ bool GSTextureCache::CopyRGBFromDepthToColor(Target* dst, Target* depth_src)
 	depth_src->Update();
 
 	constexpr ShaderConvert shader = ShaderConvert::FLOAT32_TO_RGB8;
+	g_gs_device->FlushHWBatch(depth_src->m_texture);
 	if (depth_src->m_texture->GetState() == GSTexture::State::Cleared)
 	{
 		g_gs_device->ClearRenderTarget(tex, ConvertDepthToColor(depth_src->m_texture->GetClearDepth(), shader));
@@ -3067,6 +3088,8 @@ void GSTextureCache::InvalidateVideoMem(const GSOffset& off, const GSVector4i& r
 	const u32 bw = off.bw();
 	const u32 psm = off.psm();
 
+	g_gs_renderer->m_mem.InvalidateBlockHashes(off, rect);
+
 	if (!target)
 	{
 		// Remove Source that have same BP as the render target (color&dss)
@@ -4272,6 +4295,119 @@ void GSTextureCache::IncAge()
 			++it;
 		}
 	}
+
+	EnforceMemoryBudget();
+}
+
+void GSTextureCache::EnforceMemoryBudget()
+{
+	if (GSConfig.TextureCacheBudget <= 0)
+		return;
+
+	const u64 budget = static_cast<u64>(GSConfig.TextureCacheBudget) * 1048576;
+	if (GetTotalMemoryUsage() <= budget)
+		return;
+
+	// Don't throw away anything that was used in the last couple of frames, we'd only recreate it straight away.
+	static constexpr int min_evict_age = 2;
+
+	// Targets may hold data which only exists on the GPU, so they need a readback before they can go.
+	// Leave them alone until they've been idle for a good while, just short of the regular max age.
+	static constexpr int min_target_evict_age = 60;
+
+	// Surfaces go in order of how cheap they are to bring back, and the longest idle first within each
+	// class. Hash cache entries are a single upload, sources are an upload plus a hash/copy, replacements
+	// have to go back through the loader, and targets cost a readback. Age never promotes a surface into an
+	// earlier class, so a live target can't be dropped while there's still cache to throw away.
+	static constexpr u32 hash_cache_class = 3;
+	static constexpr u32 source_class = 2;
+	static constexpr u32 replacement_class = 1;
+	static constexpr u32 target_class = 0;
+
+	const auto score = [](int age, u32 eviction_class) {
+		return (eviction_class << 24) | std::min(static_cast<u32>(age), 0xFFFFFFu);
+	};
+
+	s_budget_eviction_list.clear();
+
+	for (auto it = m_hash_cache.begin(); it != m_hash_cache.end(); ++it)
+	{
+		const HashCacheEntry& e = it->second;
+		if (e.refcount == 0 && e.age >= min_evict_age)
+			s_budget_eviction_list.push_back({it, nullptr, nullptr, score(e.age, e.is_replacement ? replacement_class : hash_cache_class)});
+	}
+
+	// Sources sharing a texture with a target or the hash cache don't own any memory, and ones from targets
+	// can be removed as a side effect of evicting the target, so skip them.
+	for (Source* s : m_src.m_surfaces)
+	{
+		if (!s->m_shared_texture && !s->m_from_hash_cache && !s->m_from_target && s->m_age >= min_evict_age)
+			s_budget_eviction_list.push_back({m_hash_cache.end(), s, nullptr, score(s->m_age, source_class)});
+	}
+
+	for (int type = 0; type < 2; type++)
+	{
+		for (Target* t : m_dst[type])
+		{
+			if (t->m_age >= min_target_evict_age)
+				s_budget_eviction_list.push_back({m_hash_cache.end(), nullptr, t, score(t->m_age, target_class)});
+		}
+	}
+
+	std::sort(s_budget_eviction_list.begin(), s_budget_eviction_list.end(),
+		[](const BudgetEvictionCandidate& lhs, const BudgetEvictionCandidate& rhs) { return lhs.score > rhs.score; });
+
+	u32 evicted = 0;
+	for (const BudgetEvictionCandidate& c : s_budget_eviction_list)
+	{
+		if (GetTotalMemoryUsage() <= budget)
+			break;
+
+		if (c.dst)
+		{
+			Target* t = c.dst;
+			GL_CACHE("TC: Remove Target(%s): (0x%x) due to memory budget", to_string(t->m_type), t->m_TEX0.TBP0);
+
+			if (!t->m_drawn_since_read.rempty())
+				Read(t, t->m_drawn_since_read);
+
+			InvalidateSourcesFromTarget(t);
+
+			auto& list = m_dst[t->m_type];
+			for (auto i = list.begin(); i != list.end(); ++i)
+			{
+				if (*i == t)
+				{
+					list.erase(i);
+					break;
+				}
+			}
+
+			delete t;
+		}
+		else if (c.src)
+		{
+			GL_CACHE("TC: Remove Source: (0x%x) due to memory budget", c.src->m_TEX0.TBP0);
+			m_src.RemoveAt(c.src);
+		}
+		else
+		{
+			RemoveFromHashCache(c.hc_it);
+		}
+
+		evicted++;
+	}
+
+	s_budget_eviction_list.clear();
+
+	if (evicted == 0)
+		return;
+
+	m_budget_evictions += evicted;
+
+	// Recycled textures end up in the pool, which would just move the memory elsewhere.
+	if ((GetTotalMemoryUsage() + g_gs_device->GetPoolMemoryUsage()) > budget)
+		g_gs_device->PurgePool();
 }
 
 //Fixme: Several issues in here. Not handling depth stencil, pitch conversion doesnt work.
@@ -5135,7 +5271,8 @@ GSTextureCache::HashCacheEntry* GSTextureCache::LookupHashCache(const GIFRegTEX0
 
 	// need the hash either for replacing, dumping or caching.
 	// if dumping/replacing is on, we compute the clut hash regardless, since replacements aren't indexed
-	HashCacheKey key{HashCacheKey::Create(TEX0, TEXA, (dump || replace || !paltex) ? clut : nullptr, lod, region)};
+	// replacement names are the data hash, so the cheaper block hash composition is only used for caching
+	HashCacheKey key{HashCacheKey::Create(TEX0, TEXA, (dump || replace || !paltex) ? clut : nullptr, lod, region, dump || replace)};
 
 	// handle dumping first, this is mostly isolated.
 	if (dump)
@@ -5575,6 +5712,7 @@ void GSTextureCache::Read(Target* t, const GSVector4i& r)
 			break;
 	}
 
+	g_gs_renderer->m_mem.InvalidateBlockHashes(off, r);
 	dltex->get()->Unmap();
 }
 
@@ -5596,6 +5734,7 @@ void GSTextureCache::Read(Source* t, const GSVector4i& r)
 		const GSOffset off = g_gs_renderer->m_mem.GetOffset(t->m_TEX0.TBP0, t->m_TEX0.TBW, t->m_TEX0.PSM);
 		g_gs_renderer->m_mem.WritePixel32(
 			const_cast<u8*>(m_color_download_texture->GetMapPointer()), m_color_download_texture->GetMapPitch(), off, r);
+		g_gs_renderer->m_mem.InvalidateBlockHashes(off, r);
 		m_color_download_texture->Unmap();
 	}
 }
@@ -6322,7 +6461,8 @@ bool GSTextureCache::Target::ResizeTexture(int new_unscaled_width, int new_unsca
 		return false;
 	}
 
-	// Only need to copy if it's been written to.
+	// Only need to copy if it's been written to, which includes any draw still queued.
+	g_gs_device->FlushHWBatch(m_texture);
 	if (m_texture->GetState() == GSTexture::State::Dirty)
 	{
 		const GSVector4i rc = GSVector4i::loadh(size.min(new_size));
@@ -7039,7 +7179,7 @@ __fi static GSTextureCache::HashType FinishBlockHash(BlockHashState& st)
 	return GSXXH3_64bits_digest(&st);
 }
 
-static void HashTextureLevel(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, GSTextureCache::SourceRegion region, BlockHashState& hash_st, u8* temp)
+static void HashTextureLevel(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, GSTextureCache::SourceRegion region, BlockHashState& hash_st, u8* temp, bool use_block_hashes)
 {
 	const GSLocalMemory::psm_t& psm = GSLocalMemory::m_psm[TEX0.PSM];
 	const GSVector2i& bs = psm.bs;
@@ -7084,6 +7224,32 @@ static void HashTextureLevel(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, GST
 				BlockHashAccumulate(hash_st, ptr, row_size);
 		}
 	}
+	else if (use_block_hashes)
+	{
+		// Hash the per-block hashes instead of the data, only blocks which were written since they were last
+		// hashed get read. This gives different values to hashing the data, so it can't be used for replacements.
+		GSOffset::BNHelper bn = off.bnMulti(block_rect.left, block_rect.top);
+		const int right = block_rect.right >> off.blockShiftX();
+		const int bottom = block_rect.bottom >> off.blockShiftY();
+
+		u64 block_hashes[128];
+		u32 num_block_hashes = 0;
+		for (; bn.blkY() < bottom; bn.nextBlockY())
+		{
+			for (; bn.blkX() < right; bn.nextBlockX())
+			{
+				block_hashes[num_block_hashes++] = mem.GetBlockHash(bn.value());
+				if (num_block_hashes == std::size(block_hashes))
+				{
+					BlockHashAccumulate(hash_st, reinterpret_cast<const u8*>(block_hashes), sizeof(block_hashes));
+					num_block_hashes = 0;
+				}
+			}
+		}
+
+		if (num_block_hashes > 0)
+			BlockHashAccumulate(hash_st, reinterpret_cast<const u8*>(block_hashes), num_block_hashes * sizeof(u64));
+	}
 	else
 	{
 		GSOffset::BNHelper bn = off.bnMulti(block_rect.left, block_rect.top);
@@ -7105,7 +7271,7 @@ GSTextureCache::HashType GSTextureCache::HashTexture(const GIFRegTEX0& TEX0, con
 {
 	BlockHashState hash_st;
 	BlockHashReset(hash_st);
-	HashTextureLevel(TEX0, TEXA, region, hash_st, s_unswizzle_buffer);
+	HashTextureLevel(TEX0, TEXA, region, hash_st, s_unswizzle_buffer, true);
 	return FinishBlockHash(hash_st);
 }
 
@@ -7170,7 +7336,7 @@ GSTextureCache::HashCacheKey::HashCacheKey()
 	TEXA.U64 = 0;
 }
 
-GSTextureCache::HashCacheKey GSTextureCache::HashCacheKey::Create(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, const u32* clut, const GSVector2i* lod, SourceRegion region)
+GSTextureCache::HashCacheKey GSTextureCache::HashCacheKey::Create(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, const u32* clut, const GSVector2i* lod, SourceRegion region, bool stable_hash)
 {
 	const GSLocalMemory::psm_t& psm = GSLocalMemory::m_psm[TEX0.PSM];
 
@@ -7185,7 +7351,7 @@ GSTextureCache::HashCacheKey GSTextureCache::HashCacheKey::Create(const GIFRegTE
 	BlockHashReset(hash_st);
 
 	// base level is always hashed
-	HashTextureLevel(TEX0, TEXA, region, hash_st, s_unswizzle_buffer);
+	HashTextureLevel(TEX0, TEXA, region, hash_st, s_unswizzle_buffer, !stable_hash);
 
 	if (lod)
 	{
@@ -7195,7 +7361,7 @@ GSTextureCache::HashCacheKey GSTextureCache::HashCacheKey::Create(const GIFRegTE
 		for (int i = 1; i < nmips; i++)
 		{
 			const GIFRegTEX0 MIP_TEX0{g_gs_renderer->GetTex0Layer(basemip + i)};
-			HashTextureLevel(MIP_TEX0, TEXA, region.AdjustForMipmap(i), hash_st, s_unswizzle_buffer);
+			HashTextureLevel(MIP_TEX0, TEXA, region.AdjustForMipmap(i), hash_st, s_unswizzle_buffer, !stable_hash);
 		}
 	}
 
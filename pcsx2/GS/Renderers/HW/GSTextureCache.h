@@ -94,7 +94,7 @@ public:
 
 		HashCacheKey();
 
-		static HashCacheKey Create(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, const u32* clut, const GSVector2i* lod, SourceRegion region);
+		static HashCacheKey Create(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, const u32* clut, const GSVector2i* lod, SourceRegion region, bool stable_hash);
 
 		HashCacheKey WithRemovedCLUTHash() const;
 		void RemoveCLUTHash();
@@ -416,6 +416,8 @@ protected:
 	FastList<TargetHeightElem> m_target_heights;
 	u64 m_target_memory_usage = 0;
 
+	u32 m_budget_evictions = 0;
+
 	int m_expected_src_bp = -1;
 	int m_remembered_src_bp = -1;
 	int m_expected_dst_bp = -1;
@@ -449,6 +451,9 @@ protected:
 	void RemoveFromHashCache(HashCacheMap::iterator it);
 	void AgeHashCache();
 
+	/// Evicts the least recently used surfaces until the cache fits in the configured memory budget.
+	void EnforceMemoryBudget();
+
 	static void PreloadTexture(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, SourceRegion region, GSLocalMemory& mem, bool paltex, GSTexture* tex, u32 level, std::pair<u8, u8>* alpha_minmax);
 	static HashType HashTexture(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, SourceRegion region);
 
@@ -466,6 +471,8 @@ public:
 	__fi u64 GetTotalHashCacheMemoryUsage() const { return (m_hash_cache_memory_usage + m_hash_cache_replacement_memory_usage); }
 	__fi u64 GetSourceMemoryUsage() const { return m_source_memory_usage; }
 	__fi u64 GetTargetMemoryUsage() const { return m_target_memory_usage; }
+	__fi u64 GetTotalMemoryUsage() const { return (m_source_memory_usage + m_target_memory_usage + GetTotalHashCacheMemoryUsage()); }
+	__fi u32 GetBudgetEvictions() const { return m_budget_evictions; }
 
 	void Read(Target* t, const GSVector4i& r);
 	void Read(Source* t, const GSVector4i& r);
@@ -17,18 +17,20 @@ struct LoaderDefinition
 {
 	const char* extension;
 	GSTextureReplacements::ReplacementTextureLoader loader;
+	GSTextureReplacements::ReplacementTextureBufferLoader buffer_loader;
 };
 
 static bool PNGLoader(const std::string& filename, GSTextureReplacements::ReplacementTexture* tex, bool only_base_image);
+static bool PNGBufferLoader(const std::string& filename, std::span<const u8> data, GSTextureReplacements::ReplacementTexture* tex, bool only_base_image);
 static bool DDSLoader(const std::string& filename, GSTextureReplacements::ReplacementTexture* tex, bool only_base_image);
+static bool DDSBufferLoader(const std::string& filename, std::span<const u8> data, GSTextureReplacements::ReplacementTexture* tex, bool only_base_image);
 
 static constexpr LoaderDefinition s_loaders[] = {
-	{"png", PNGLoader},
-	{"dds", DDSLoader},
+	{"png", PNGLoader, PNGBufferLoader},
+	{"dds", DDSLoader, DDSBufferLoader},
 };
 
-
-GSTextureReplacements::ReplacementTextureLoader GSTextureReplacements::GetLoader(const std::string_view& filename)
+static const LoaderDefinition* GetLoaderDefinition(const std::string_view& filename)
 {
 	const std::string_view extension(Path::GetExtension(filename));
 	if (extension.empty())
@@ -37,12 +39,24 @@ GSTextureReplacements::ReplacementTextureLoader GSTextureReplacements::GetLoader
 	for (const LoaderDefinition& defn : s_loaders)
 	{
 		if (StringUtil::Strncasecmp(extension.data(), defn.extension, extension.size()) == 0)
-			return defn.loader;
+			return &defn;
 	}
 
 	return nullptr;
 }
 
+GSTextureReplacements::ReplacementTextureLoader GSTextureReplacements::GetLoader(const std::string_view& filename)
+{
+	const LoaderDefinition* defn = GetLoaderDefinition(filename);
+	return defn ? defn->loader : nullptr;
+}
+
+GSTextureReplacements::ReplacementTextureBufferLoader GSTextureReplacements::GetBufferLoader(const std::string_view& filename)
+{
+	const LoaderDefinition* defn = GetLoaderDefinition(filename);
+	return defn ? defn->buffer_loader : nullptr;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Helper routines
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -146,31 +160,8 @@ static void ConvertTexture_R8G8B8(u32 width, u32 height, std::vector<u8>& data,
 // PNG Handlers
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-bool PNGLoader(const std::string& filename, GSTextureReplacements::ReplacementTexture* tex, bool only_base_image)
+static bool PNGCommonLoader(GSTextureReplacements::ReplacementTexture* tex, png_structp png_ptr, png_infop info_ptr)
 {
-	png_structp png_ptr = png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
-	if (!png_ptr)
-		return false;
-
-	png_infop info_ptr = png_create_info_struct(png_ptr);
-	if (!info_ptr)
-	{
-		png_destroy_read_struct(&png_ptr, nullptr, nullptr);
-		return false;
-	}
-
-	ScopedGuard cleanup([&png_ptr, &info_ptr]() {
-		png_destroy_read_struct(&png_ptr, &info_ptr, nullptr);
-	});
-
-	auto fp = FileSystem::OpenManagedCFile(filename.c_str(), "rb");
-	if (!fp)
-		return false;
-
-	if (setjmp(png_jmpbuf(png_ptr)))
-		return false;
-
-	png_init_io(png_ptr, fp.get());
 	png_read_info(png_ptr, info_ptr);
 
 	png_uint_32 width = 0;
@@ -220,6 +211,76 @@ bool PNGLoader(const std::string& filename, GSTextureReplacements::ReplacementTe
 	return true;
 }
 
+bool PNGLoader(const std::string& filename, GSTextureReplacements::ReplacementTexture* tex, bool only_base_image)
+{
+	png_structp png_ptr = png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+	if (!png_ptr)
+		return false;
+
+	png_infop info_ptr = png_create_info_struct(png_ptr);
+	if (!info_ptr)
+	{
+		png_destroy_read_struct(&png_ptr, nullptr, nullptr);
+		return false;
+	}
+
+	ScopedGuard cleanup([&png_ptr, &info_ptr]() {
+		png_destroy_read_struct(&png_ptr, &info_ptr, nullptr);
+	});
+
+	auto fp = FileSystem::OpenManagedCFile(filename.c_str(), "rb");
+	if (!fp)
+		return false;
+
+	if (setjmp(png_jmpbuf(png_ptr)))
+		return false;
+
+	png_init_io(png_ptr, fp.get());
+	return PNGCommonLoader(tex, png_ptr, info_ptr);
+}
+
+bool PNGBufferLoader(const std::string& filename, std::span<const u8> data, GSTextureReplacements::ReplacementTexture* tex, bool only_base_image)
+{
+	png_structp png_ptr = png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+	if (!png_ptr)
+		return false;
+
+	png_infop info_ptr = png_create_info_struct(png_ptr);
+	if (!info_ptr)
+	{
+		png_destroy_read_struct(&png_ptr, nullptr, nullptr);
+		return false;
+	}
+
+	ScopedGuard cleanup([&png_ptr, &info_ptr]() {
+		png_destroy_read_struct(&png_ptr, &info_ptr, nullptr);
+	});
+
+	if (setjmp(png_jmpbuf(png_ptr)))
+		return false;
+
+	struct IOData
+	{
+		std::span<const u8> buffer;
+		size_t buffer_pos;
+	};
+	IOData io = {data, 0};
+
+	png_set_read_fn(png_ptr, &io, [](png_structp png_ptr, png_bytep data_ptr, png_size_t size) {
+		IOData* io = static_cast<IOData*>(png_get_io_ptr(png_ptr));
+		const size_t read_size = std::min<size_t>(io->buffer.size() - io->buffer_pos, size);
+		if (read_size > 0)
+		{
+			std::memcpy(data_ptr, io->buffer.data() + io->buffer_pos, read_size);
+			io->buffer_pos += read_size;
+		}
+		if (read_size != size)
+			png_error(png_ptr, "Unexpected end of PNG data");
+	});
+
+	return PNGCommonLoader(tex, png_ptr, info_ptr);
+}
+
 bool GSTextureReplacements::SavePNGImage(const std::string& filename, u32 width, u32 height, const u8* buffer, u32 pitch)
 {
 	const int compression = GSConfig.PNGCompressionLevel;
@@ -401,15 +462,53 @@ struct DDSLoadInfo
 	std::function<void(u32 width, u32 height, std::vector<u8>& data, u32& pitch)> conversion_function;
 };
 
-static bool ParseDDSHeader(std::FILE* fp, DDSLoadInfo* info)
+/// Reads DDS data from either a file or a memory buffer (texture packs).
+struct DDSReader
+{
+	std::FILE* fp = nullptr;
+	std::span<const u8> buffer;
+	size_t buffer_pos = 0;
+
+	bool Read(void* dst, size_t size)
+	{
+		if (fp)
+			return (std::fread(dst, size, 1, fp) == 1);
+
+		if ((buffer.size() - buffer_pos) < size)
+			return false;
+
+		std::memcpy(dst, buffer.data() + buffer_pos, size);
+		buffer_pos += size;
+		return true;
+	}
+
+	bool Seek(s64 offset)
+	{
+		if (fp)
+			return (FileSystem::FSeek64(fp, offset, SEEK_SET) == 0);
+
+		if (offset < 0 || static_cast<size_t>(offset) > buffer.size())
+			return false;
+
+		buffer_pos = static_cast<size_t>(offset);
+		return true;
+	}
+
+	s64 Size() const
+	{
+		return fp ? FileSystem::FSize64(fp) : static_cast<s64>(buffer.size());
+	}
+};
+
+static bool ParseDDSHeader(DDSReader& reader, DDSLoadInfo* info)
 {
 	u32 magic;
-	if (std::fread(&magic, sizeof(magic), 1, fp) != 1 || magic != DDS_MAGIC)
+	if (!reader.Read(&magic, sizeof(magic)) || magic != DDS_MAGIC)
 		return false;
 
 	DDS_HEADER header;
 	u32 header_size = sizeof(header);
-	if (std::fread(&header, header_size, 1, fp) != 1 || header.dwSize < header_size)
+	if (!reader.Read(&header, header_size) || header.dwSize < header_size)
 		return false;
 
 	// We should check for DDS_HEADER_FLAGS_TEXTURE here, but some tools don't seem
@@ -453,7 +552,7 @@ static bool ParseDDSHeader(std::FILE* fp, DDSLoadInfo* info)
 		if (header.ddspf.dwFourCC == MAKEFOURCC('D', 'X', '1', '0'))
 		{
 			DDS_HEADER_DXT10 dxt10_header;
-			if (std::fread(&dxt10_header, sizeof(dxt10_header), 1, fp) != 1)
+			if (!reader.Read(&dxt10_header, sizeof(dxt10_header)))
 				return false;
 
 			// Can't handle array textures here. Doesn't make sense to use them, anyway.
@@ -564,13 +663,13 @@ static bool ParseDDSHeader(std::FILE* fp, DDSLoadInfo* info)
 
 	// Check for truncated or corrupted files.
 	info->base_image_offset = sizeof(magic) + header_size;
-	if (info->base_image_offset >= FileSystem::FSize64(fp))
+	if (info->base_image_offset >= reader.Size())
 		return false;
 
 	return true;
 }
 
-static bool ReadDDSMipLevel(std::FILE* fp, const std::string& filename, u32 mip_level, const DDSLoadInfo& info, u32 width, u32 height, std::vector<u8>& data, u32& pitch, u32 size)
+static bool ReadDDSMipLevel(DDSReader& reader, const std::string& filename, u32 mip_level, const DDSLoadInfo& info, u32 width, u32 height, std::vector<u8>& data, u32& pitch, u32 size)
 {
 	// D3D11 cannot handle block compressed textures where the first mip level is
 	// not a multiple of the block size.
@@ -585,7 +684,7 @@ static bool ReadDDSMipLevel(std::FILE* fp, const std::string& filename, u32 mip_
 	}
 
 	data.resize(size);
-	if (std::fread(data.data(), size, 1, fp) != 1)
+	if (!reader.Read(data.data(), size))
 		return false;
 
 	// Apply conversion function for uncompressed textures.
@@ -595,25 +694,21 @@ static bool ReadDDSMipLevel(std::FILE* fp, const std::string& filename, u32 mip_
 	return true;
 }
 
-bool DDSLoader(const std::string& filename, GSTextureReplacements::ReplacementTexture* tex, bool only_base_image)
+static bool DDSCommonLoader(DDSReader& reader, const std::string& filename, GSTextureReplacements::ReplacementTexture* tex, bool only_base_image)
 {
-	auto fp = FileSystem::OpenManagedCFile(filename.c_str(), "rb");
-	if (!fp)
-		return false;
-
 	DDSLoadInfo info;
-	if (!ParseDDSHeader(fp.get(), &info))
+	if (!ParseDDSHeader(reader, &info))
 		return false;
 
 	// always load the base image
-	if (FileSystem::FSeek64(fp.get(), info.base_image_offset, SEEK_SET) != 0)
+	if (!reader.Seek(info.base_image_offset))
 		return false;
 
 	tex->format = info.format;
 	tex->width = info.width;
 	tex->height = info.height;
 	tex->pitch = info.base_image_pitch;
-	if (!ReadDDSMipLevel(fp.get(), filename, 0, info, tex->width, tex->height, tex->data, tex->pitch, info.base_image_size))
+	if (!ReadDDSMipLevel(reader, filename, 0, info, tex->width, tex->height, tex->data, tex->pitch, info.base_image_size))
 		return false;
 
 	// Read in any remaining mip levels in the file.
@@ -624,7 +719,7 @@ bool DDSLoader(const std::string& filename, GSTextureReplacements::ReplacementTe
 			GSTextureReplacements::ReplacementTexture::MipData md;
 			u32 mip_size;
 			CalcBlockMipmapSize(info.block_size, info.bytes_per_block, info.width, info.height, level, md.width, md.height, md.pitch, mip_size);
-			if (!ReadDDSMipLevel(fp.get(), filename, level, info, md.width, md.height, md.data, md.pitch, mip_size))
+			if (!ReadDDSMipLevel(reader, filename, level, info, md.width, md.height, md.data, md.pitch, mip_size))
 				break;
 
 			tex->mips.push_back(std::move(md));
@@ -633,3 +728,21 @@ bool DDSLoader(const std::string& filename, GSTextureReplacements::ReplacementTe
 
 	return true;
 }
+
+bool DDSLoader(const std::string& filename, GSTextureReplacements::ReplacementTexture* tex, bool only_base_image)
+{
+	auto fp = FileSystem::OpenManagedCFile(filename.c_str(), "rb");
+	if (!fp)
+		return false;
+
+	DDSReader reader;
+	reader.fp = fp.get();
+	return DDSCommonLoader(reader, filename, tex, only_base_image);
+}
+
+bool DDSBufferLoader(const std::string& filename, std::span<const u8> data, GSTextureReplacements::ReplacementTexture* tex, bool only_base_image)
+{
+	DDSReader reader;
+	reader.buffer = data;
+	return DDSCommonLoader(reader, filename, tex, only_base_image);
+}
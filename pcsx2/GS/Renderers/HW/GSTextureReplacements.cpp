@@ -9,6 +9,7 @@
 #include "common/StringUtil.h"
 #include "common/ScopedGuard.h"
 #include "common/TextureDecompress.h"
+#include "common/ZipHelpers.h"
 
 #include "Config.h"
 #include "Host.h"
@@ -18,11 +19,13 @@
 #include "GS/Renderers/HW/GSTextureReplacements.h"
 #include "VMManager.h"
 
+#include <algorithm>
 #include <cinttypes>
 #include <condition_variable>
 #include <cstring>
 #include <deque>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <unordered_map>
 #include <unordered_set>
@@ -38,6 +41,7 @@
 #define TEXTURE_FILENAME_OLD_REGION_CLUT_FORMAT_STRING "%" PRIx64 "-%" PRIx64 "-r%" PRIx64 "-%08x"
 #define TEXTURE_REPLACEMENT_SUBDIRECTORY_NAME "replacements"
 #define TEXTURE_DUMP_SUBDIRECTORY_NAME "dumps"
+#define TEXTURE_PACK_EXTENSION "zip"
 
 namespace
 {
@@ -100,6 +104,32 @@ namespace std
 
 namespace GSTextureReplacements
 {
+	/// Zip archive of replacement textures. Saves opening thousands of individual files for large packs,
+	/// the central directory gives us the index for free.
+	struct TexturePack
+	{
+		TexturePack(std::string path_, std::unique_ptr<zip_t, void (*)(zip_t*)> zip_)
+			: path(std::move(path_))
+			, zip(std::move(zip_))
+		{
+		}
+
+		std::string path;
+		std::unique_ptr<zip_t, void (*)(zip_t*)> zip;
+
+		/// libzip handles can't be used from multiple threads at once.
+		std::mutex mutex;
+	};
+
+	/// Where a replacement texture lives, either a loose file, or an entry in a texture pack.
+	struct ReplacementFile
+	{
+		std::string filename;
+		std::shared_ptr<TexturePack> pack;
+		u64 pack_index;
+		u64 pack_size;
+	};
+
 	static TextureName CreateTextureName(const GSTextureCache::HashCacheKey& hash, u32 miplevel);
 	static GSTextureCache::HashCacheKey HashCacheKeyFromTextureName(const TextureName& tn);
 	static std::optional<TextureName> ParseReplacementName(const std::string& filename);
@@ -108,9 +138,11 @@ namespace GSTextureReplacements
 	template <GSTexture::Format format>
 	std::pair<u8, u8> GetBCAlphaMinMax(ReplacementTexture& rtex);
 	static void SetReplacementTextureAlphaMinMax(ReplacementTexture& rtex);
-	static std::optional<ReplacementTexture> LoadReplacementTexture(const TextureName& name, const std::string& filename, bool only_base_image);
-	static void QueueAsyncReplacementTextureLoad(const TextureName& name, const std::string& filename, bool mipmap, bool cache_only);
+	static void AddTexturePack(const std::string& path);
+	static std::optional<ReplacementTexture> LoadReplacementTexture(const TextureName& name, const ReplacementFile& file, bool only_base_image);
+	static void QueueAsyncReplacementTextureLoad(const TextureName& name, const ReplacementFile& file, bool mipmap, bool cache_only);
 	static void PrecacheReplacementTextures();
+	static void PrefetchRecentReplacementTextures();
 	static void ClearReplacementTextures();
 
 	static void StartWorkerThread();
@@ -126,7 +158,7 @@ namespace GSTextureReplacements
 	static std::unordered_set<TextureName> s_dumped_textures;
 
 	/// Lookup map of texture names to replacements, if they exist.
-	static std::unordered_map<TextureName, std::string> s_replacement_texture_filenames;
+	static std::unordered_map<TextureName, ReplacementFile> s_replacement_texture_filenames;
 
 	/// Lookup map of texture names without CLUT hash, to know when we need to disable paltex.
 	static std::unordered_set<TextureName> s_replacement_textures_without_clut_hash;
@@ -142,11 +174,20 @@ namespace GSTextureReplacements
 	/// Second element is whether the texture should be created with mipmaps.
 	static std::vector<std::pair<TextureName, bool>> s_async_loaded_textures;
 
-	/// Loader/dumper thread.
-	static std::thread s_worker_thread;
+	/// Frame and mipmap flag of the last request for each replacement, so the working set can be
+	/// prefetched when the replacements are reloaded.
+	static std::unordered_map<TextureName, std::pair<u32, bool>> s_recent_replacement_lookups;
+	static u32 s_frame_number = 0;
+	static constexpr u32 PREFETCH_RECENT_FRAMES = 300;
+
+	/// Loader/dumper threads.
+	static constexpr u32 MAX_WORKER_THREADS = 4;
+	static std::vector<std::thread> s_worker_threads;
 	static std::mutex s_worker_thread_mutex;
 	static std::condition_variable s_worker_thread_cv;
+	static std::condition_variable s_worker_thread_idle_cv;
 	static std::deque<std::pair<std::function<void()>, bool>> s_worker_thread_queue;
+	static u32 s_worker_thread_active_items = 0;
 	static bool s_worker_thread_running = false;
 }; // namespace GSTextureReplacements
 
@@ -345,6 +386,7 @@ void GSTextureReplacements::GameChanged()
 		return;
 
 	s_current_serial = std::move(new_serial);
+	s_recent_replacement_lookups.clear();
 	ReloadReplacementMap();
 	ClearDumpedTextureList();
 }
@@ -374,13 +416,19 @@ void GSTextureReplacements::ReloadReplacementMap()
 	if (!FileSystem::FindFiles(replacement_dir.c_str(), "*", FILESYSTEM_FIND_FILES | FILESYSTEM_FIND_HIDDEN_FILES | FILESYSTEM_FIND_RECURSIVE, &files))
 		return;
 
+	std::vector<std::string> packs;
 	std::string filename;
 	for (FILESYSTEM_FIND_DATA& fd : files)
 	{
 		// file format we can handle?
 		filename = Path::GetFileName(fd.FileName);
 		if (!GetLoader(filename))
+		{
+			if (StringUtil::compareNoCase(Path::GetExtension(filename), TEXTURE_PACK_EXTENSION))
+				packs.push_back(std::move(fd.FileName));
+
 			continue;
+		}
 
 		// parse the name if it's valid
 		std::optional<TextureName> name = ParseReplacementName(filename);
@@ -388,15 +436,22 @@ void GSTextureReplacements::ReloadReplacementMap()
 			continue;
 
 		DbgCon.WriteLn("Found %ux%u replacement '%.*s'", name->Width(), name->Height(), static_cast<int>(filename.size()), filename.data());
-		s_replacement_texture_filenames.emplace(name.value(), std::move(fd.FileName));
+		s_replacement_texture_filenames.emplace(name.value(), ReplacementFile{std::move(fd.FileName), nullptr, 0, 0});
 
 		// zero out the CLUT hash, because we need this for checking if there's any replacements with this hash when using paltex
 		name->CLUTHash = 0;
 		s_replacement_textures_without_clut_hash.insert(name.value());
 	}
 
+	// loose files take priority over packs, so individual textures can be fixed up without repacking
+	std::sort(packs.begin(), packs.end());
+	for (const std::string& path : packs)
+		AddTexturePack(path);
+
 	if (!s_replacement_texture_filenames.empty())
 	{
+		PrefetchRecentReplacementTextures();
+
 		if (GSConfig.PrecacheTextureReplacements)
 			PrecacheReplacementTextures();
 
@@ -471,6 +526,8 @@ GSTexture* GSTextureReplacements::LookupReplacementTexture(const GSTextureCache:
 	if (fnit == s_replacement_texture_filenames.end())
 		return nullptr;
 
+	s_recent_replacement_lookups[name] = std::make_pair(s_frame_number, mipmap);
+
 	// try the full cache first, to avoid reloading from disk
 	{
 		std::unique_lock<std::mutex> lock(s_replacement_texture_cache_mutex);
@@ -587,17 +644,82 @@ void GSTextureReplacements::SetReplacementTextureAlphaMinMax(ReplacementTexture&
 	}
 }
 
-std::optional<GSTextureReplacements::ReplacementTexture> GSTextureReplacements::LoadReplacementTexture(const TextureName& name, const std::string& filename, bool only_base_image)
+void GSTextureReplacements::AddTexturePack(const std::string& path)
 {
-	ReplacementTextureLoader loader = GetLoader(filename);
-	if (!loader)
-		return std::nullopt;
+	zip_error_t ze = {};
+	auto zf = zip_open_managed(path.c_str(), ZIP_RDONLY, &ze);
+	if (!zf)
+	{
+		Console.Error("Failed to open texture pack '%s': %s", path.c_str(), zip_error_strerror(&ze));
+		return;
+	}
+
+	const std::shared_ptr<TexturePack> pack = std::make_shared<TexturePack>(path, std::move(zf));
+	const zip_int64_t num_entries = zip_get_num_entries(pack->zip.get(), 0);
+	u32 num_added = 0;
+	for (zip_int64_t i = 0; i < num_entries; i++)
+	{
+		zip_stat_t zst;
+		if (zip_stat_index(pack->zip.get(), static_cast<zip_uint64_t>(i), 0, &zst) != 0 ||
+			(zst.valid & (ZIP_STAT_NAME | ZIP_STAT_SIZE)) != (ZIP_STAT_NAME | ZIP_STAT_SIZE))
+		{
+			continue;
+		}
+
+		const std::string filename(Path::GetFileName(zst.name));
+		if (!GetBufferLoader(filename))
+			continue;
+
+		std::optional<TextureName> name = ParseReplacementName(filename);
+		if (!name.has_value())
+			continue;
+
+		if (!s_replacement_texture_filenames.emplace(name.value(), ReplacementFile{zst.name, pack, static_cast<u64>(i), static_cast<u64>(zst.size)}).second)
+			continue;
+
+		name->CLUTHash = 0;
+		s_replacement_textures_without_clut_hash.insert(name.value());
+		num_added++;
+	}
 
+	Console.WriteLn("Found %u replacements in texture pack '%s'.", num_added, Path::GetFileName(path).data());
+}
+
+std::optional<GSTextureReplacements::ReplacementTexture> GSTextureReplacements::LoadReplacementTexture(const TextureName& name, const ReplacementFile& file, bool only_base_image)
+{
 	ReplacementTexture rtex;
-	if (!loader(filename.c_str(), &rtex, only_base_image))
+	if (file.pack)
+	{
+		ReplacementTextureBufferLoader loader = GetBufferLoader(file.filename);
+		if (!loader)
+			return std::nullopt;
+
+		// only hold the pack lock while inflating, decoding can happen in parallel
+		std::vector<u8> data(file.pack_size);
+		bool read_ok;
+		{
+			std::unique_lock<std::mutex> lock(file.pack->mutex);
+			auto zf = zip_fopen_index_managed(file.pack->zip.get(), file.pack_index, 0);
+			read_ok = (zf && zip_fread(zf.get(), data.data(), data.size()) == static_cast<zip_int64_t>(data.size()));
+		}
+
+		if (!read_ok || !loader(file.filename, data, &rtex, only_base_image))
+		{
+			Console.Warning("Failed to load replacement texture %s from %s", file.filename.c_str(), file.pack->path.c_str());
+			return std::nullopt;
+		}
+	}
+	else
 	{
-		Console.Warning("Failed to load replacement texture %s", filename.c_str());
-		return std::nullopt;
+		ReplacementTextureLoader loader = GetLoader(file.filename);
+		if (!loader)
+			return std::nullopt;
+
+		if (!loader(file.filename.c_str(), &rtex, only_base_image))
+		{
+			Console.Warning("Failed to load replacement texture %s", file.filename.c_str());
+			return std::nullopt;
+		}
 	}
 
 	SetReplacementTextureAlphaMinMax(rtex);
@@ -605,7 +727,7 @@ std::optional<GSTextureReplacements::ReplacementTexture> GSTextureReplacements::
 	return rtex;
 }
 
-void GSTextureReplacements::QueueAsyncReplacementTextureLoad(const TextureName& name, const std::string& filename, bool mipmap, bool cache_only)
+void GSTextureReplacements::QueueAsyncReplacementTextureLoad(const TextureName& name, const ReplacementFile& file, bool mipmap, bool cache_only)
 {
 	// check the pending list, so we don't queue it up multiple times
 	auto it = s_pending_async_load_textures.find(name);
@@ -624,9 +746,9 @@ void GSTextureReplacements::QueueAsyncReplacementTextureLoad(const TextureName&
 	}
 
 	s_pending_async_load_textures.emplace(name, cache_only);
-	QueueWorkerThreadItem([name, filename, mipmap]() {
+	QueueWorkerThreadItem([name, file, mipmap]() {
 		// actually load the file, this is what will take the time
-		std::optional<ReplacementTexture> replacement(LoadReplacementTexture(name, filename, !mipmap));
+		std::optional<ReplacementTexture> replacement(LoadReplacementTexture(name, file, !mipmap));
 
 		// check the pending set, there's a race here if we disable replacements while loading otherwise
 		// also check the full replacement list, if async loading is off, it might already be in there
@@ -675,10 +797,32 @@ void GSTextureReplacements::PrecacheReplacementTextures()
 	}
 }
 
+void GSTextureReplacements::PrefetchRecentReplacementTextures()
+{
+	std::unique_lock<std::mutex> lock(s_replacement_texture_cache_mutex);
+
+	// whatever was on screen recently is most likely to be needed straight away, so get it queued before the rest
+	for (auto it = s_recent_replacement_lookups.begin(); it != s_recent_replacement_lookups.end();)
+	{
+		const auto fnit = s_replacement_texture_filenames.find(it->first);
+		if (fnit == s_replacement_texture_filenames.end() || (s_frame_number - it->second.first) > PREFETCH_RECENT_FRAMES)
+		{
+			it = s_recent_replacement_lookups.erase(it);
+			continue;
+		}
+
+		if (s_replacement_texture_cache.find(it->first) == s_replacement_texture_cache.end())
+			QueueAsyncReplacementTextureLoad(it->first, fnit->second, it->second.second, true);
+
+		++it;
+	}
+}
+
 void GSTextureReplacements::ClearReplacementTextures()
 {
 	s_replacement_texture_filenames.clear();
 	s_replacement_textures_without_clut_hash.clear();
+	s_recent_replacement_lookups.clear();
 
 	std::unique_lock<std::mutex> lock(s_replacement_texture_cache_mutex);
 	s_replacement_texture_cache.clear();
@@ -728,6 +872,9 @@ GSTexture* GSTextureReplacements::CreateReplacementTexture(const ReplacementText
 
 void GSTextureReplacements::ProcessAsyncLoadedTextures()
 {
+	// called once per frame
+	s_frame_number++;
+
 	// this holds the lock while doing the upload, but it should be reasonably quick
 	std::unique_lock<std::mutex> lock(s_replacement_texture_cache_mutex);
 	for (const auto& [name, mipmap] : s_async_loaded_textures)
@@ -813,25 +960,30 @@ void GSTextureReplacements::StartWorkerThread()
 {
 	std::unique_lock<std::mutex> lock(s_worker_thread_mutex);
 
-	if (s_worker_thread.joinable())
+	if (!s_worker_threads.empty())
 		return;
 
+	// decoding is mostly independent per texture, but leave some cores for the emulator itself
+	const u32 num_threads = std::clamp(std::thread::hardware_concurrency() / 2, 1u, MAX_WORKER_THREADS);
 	s_worker_thread_running = true;
-	s_worker_thread = std::thread(WorkerThreadEntryPoint);
+	for (u32 i = 0; i < num_threads; i++)
+		s_worker_threads.emplace_back(WorkerThreadEntryPoint);
 }
 
 void GSTextureReplacements::StopWorkerThread()
 {
 	{
 		std::unique_lock<std::mutex> lock(s_worker_thread_mutex);
-		if (!s_worker_thread.joinable())
+		if (s_worker_threads.empty())
 			return;
 
 		s_worker_thread_running = false;
-		s_worker_thread_cv.notify_one();
+		s_worker_thread_cv.notify_all();
 	}
 
-	s_worker_thread.join();
+	for (std::thread& thread : s_worker_threads)
+		thread.join();
+	s_worker_threads.clear();
 
 	// clear out workery-things too
 	CancelPendingLoadsAndDumps();
@@ -839,7 +991,7 @@ void GSTextureReplacements::StopWorkerThread()
 
 void GSTextureReplacements::QueueWorkerThreadItem(std::function<void()> fn, bool high_priority)
 {
-	pxAssert(s_worker_thread.joinable());
+	pxAssert(!s_worker_threads.empty());
 
 	std::unique_lock<std::mutex> lock(s_worker_thread_mutex);
 	if (!high_priority)
@@ -888,28 +1040,24 @@ void GSTextureReplacements::WorkerThreadEntryPoint()
 
 		std::function<void()> fn = std::move(s_worker_thread_queue.front().first);
 		s_worker_thread_queue.pop_front();
+		s_worker_thread_active_items++;
 		lock.unlock();
 		fn();
 		lock.lock();
+
+		if ((--s_worker_thread_active_items) == 0 && s_worker_thread_queue.empty())
+			s_worker_thread_idle_cv.notify_all();
 	}
 }
 
 void GSTextureReplacements::SyncWorkerThread()
 {
 	std::unique_lock<std::mutex> lock(s_worker_thread_mutex);
-	if (!s_worker_thread.joinable())
+	if (s_worker_threads.empty())
 		return;
 
-	// not the most efficient by far, but it only gets called on config changes, so whatever
-	for (;;)
-	{
-		if (s_worker_thread_queue.empty())
-			break;
-
-		lock.unlock();
-		std::this_thread::sleep_for(std::chrono::milliseconds(1));
-		lock.lock();
-	}
+	// wait for items which are in progress too, otherwise they could race with the caller clearing the caches
+	s_worker_thread_idle_cv.wait(lock, []() { return (s_worker_thread_queue.empty() && s_worker_thread_active_items == 0); });
 }
 
 void GSTextureReplacements::CancelPendingLoadsAndDumps()
@@ -5,6 +5,7 @@
 
 #include "GS/Renderers/HW/GSTextureCache.h"
 
+#include <span>
 #include <utility>
 
 namespace GSTextureReplacements
@@ -51,6 +52,10 @@ namespace GSTextureReplacements
 	using ReplacementTextureLoader = bool (*)(const std::string& filename, GSTextureReplacements::ReplacementTexture* tex, bool only_base_image);
 	ReplacementTextureLoader GetLoader(const std::string_view& filename);
 
+	/// Same as above, but decodes an image which has already been read into memory, e.g. from a texture pack.
+	using ReplacementTextureBufferLoader = bool (*)(const std::string& filename, std::span<const u8> data, GSTextureReplacements::ReplacementTexture* tex, bool only_base_image);
+	ReplacementTextureBufferLoader GetBufferLoader(const std::string_view& filename);
+
 	/// Saves an image buffer to a PNG file (for dumping).
 	bool SavePNGImage(const std::string& filename, u32 width, u32 height, const u8* buffer, u32 pitch);
 } // namespace GSTextureReplacements
@@ -44,6 +44,8 @@ void* GSTextureMTL::GetNativeHandle() const
 
 bool GSTextureMTL::Update(const GSVector4i& r, const void* data, int pitch, int layer)
 {
+	g_gs_device->FlushHWBatch(this);
+
 	if (void* buffer = MapWithPitch(r, pitch, layer))
 	{
 		memcpy(buffer, data, CalcUploadSize(r.height(), pitch));
@@ -54,6 +56,8 @@ bool GSTextureMTL::Update(const GSVector4i& r, const void* data, int pitch, int
 
 bool GSTextureMTL::Map(GSMap& m, const GSVector4i* _r, int layer)
 {
+	g_gs_device->FlushHWBatch(this);
+
 	GSVector4i r = _r ? *_r : GSVector4i(0, 0, m_size.x, m_size.y);
 	u32 block_size = GetCompressedBlockSize();
 	u32 blocks_wide = (r.width() + block_size - 1) / block_size;
@@ -121,6 +125,8 @@ void GSTextureMTL::Unmap()
 
 void GSTextureMTL::GenerateMipmap()
 { @autoreleasepool {
+	g_gs_device->FlushHWBatch(this);
+
 	if (m_mipmap_levels > 1 && !m_has_mipmaps)
 	{
 		id<MTLBlitCommandEncoder> enc = m_dev->GetTextureUploadEncoder();
@@ -174,6 +180,8 @@ std::unique_ptr<GSDownloadTextureMTL> GSDownloadTextureMTL::Create(GSDeviceMTL*
 void GSDownloadTextureMTL::CopyFromTexture(
 	const GSVector4i& drc, GSTexture* stex, const GSVector4i& src, u32 src_level, bool use_transfer_pitch)
 { @autoreleasepool {
+	g_gs_device->FlushHWBatch(stex);
+
 	GSTextureMTL* const mtlTex = static_cast<GSTextureMTL*>(stex);
 
 	pxAssert(mtlTex->GetFormat() == m_format);
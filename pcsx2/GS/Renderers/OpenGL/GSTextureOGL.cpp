@@ -172,6 +172,8 @@ void* GSTextureOGL::GetNativeHandle() const
 
 bool GSTextureOGL::Update(const GSVector4i& r, const void* data, int pitch, int layer)
 {
+	g_gs_device->FlushHWBatch(this);
+
 	pxAssert(m_type != Type::DepthStencil);
 
 	if (layer >= m_mipmap_levels)
@@ -241,6 +243,8 @@ bool GSTextureOGL::Update(const GSVector4i& r, const void* data, int pitch, int
 
 bool GSTextureOGL::Map(GSMap& m, const GSVector4i* _r, int layer)
 {
+	g_gs_device->FlushHWBatch(this);
+
 	if (layer >= m_mipmap_levels || IsCompressedFormat())
 		return false;
 
@@ -311,6 +315,8 @@ void GSTextureOGL::Unmap()
 
 void GSTextureOGL::GenerateMipmap()
 {
+	g_gs_device->FlushHWBatch(this);
+
 	pxAssert(m_mipmap_levels > 1);
 	GSDeviceOGL::GetInstance()->CommitClear(this, true);
 	glGenerateTextureMipmap(m_texture_id);
@@ -408,6 +414,8 @@ std::unique_ptr<GSDownloadTextureOGL> GSDownloadTextureOGL::Create(u32 width, u3
 void GSDownloadTextureOGL::CopyFromTexture(
 	const GSVector4i& drc, GSTexture* stex, const GSVector4i& src, u32 src_level, bool use_transfer_pitch)
 {
+	g_gs_device->FlushHWBatch(stex);
+
 	GSTextureOGL* const glTex = static_cast<GSTextureOGL*>(stex);
 	GSDeviceOGL::GetInstance()->CommitClear(glTex, true);
 
@@ -33,10 +33,20 @@ static int compute_best_thread_height(int threads)
 		return 4;
 }
 
-GSRasterizer::GSRasterizer(GSDrawScanline* ds, int id, int threads)
+// Binned tiles are as wide as a GS page, and as high as the rows a thread gets in a band.
+static constexpr int TILE_WIDTH_SHIFT = 6;
+
+static __fi int GetTileOwner(int column, int row, int threads)
+{
+	// Neighbouring tiles, both across and down, belong to different threads.
+	return (column + row) % threads;
+}
+
+GSRasterizer::GSRasterizer(GSDrawScanline* ds, int id, int threads, bool tiled)
 	: m_ds(ds)
 	, m_id(id)
 	, m_threads(threads)
+	, m_tiled(tiled && threads > 1)
 	, m_scanmsk_value(0)
 {
 	memset(&m_pixels, 0, sizeof(m_pixels));
@@ -52,9 +62,11 @@ GSRasterizer::GSRasterizer(GSDrawScanline* ds, int id, int threads)
 	int rows = (2048 >> m_thread_height) + 16;
 	m_scanline = (u8*)_aligned_malloc(rows, 64);
 
+	// When tiled, rows are filled in for each draw. Rows past the bottom of the screen stay set,
+	// so FindMyNextScanline() always finds one.
 	for (int i = 0; i < rows; i++)
 	{
-		m_scanline[i] = (i % threads) == id ? 1 : 0;
+		m_scanline[i] = (m_tiled || (i % threads) == id) ? 1 : 0;
 	}
 }
 
@@ -111,6 +123,52 @@ int GSRasterizer::FindMyNextScanline(int top) const
 	return top;
 }
 
+bool GSRasterizer::IsOneOfMyTiles(int left, int top) const
+{
+	return !m_tiled || GetTileOwner(left >> TILE_WIDTH_SHIFT, top >> m_thread_height, m_threads) == m_id;
+}
+
+int GSRasterizer::SkipOtherScanlines(int top) const
+{
+	return m_tiled ? FindMyNextScanline(top) : (top + ((m_threads - 1) << m_thread_height));
+}
+
+void GSRasterizer::UpdateMyScanlines(const GSVector4i& r)
+{
+	if (r.rempty())
+		return;
+
+	const int first = r.left >> TILE_WIDTH_SHIFT;
+	const int columns = ((r.right - 1) >> TILE_WIDTH_SHIFT) - first + 1;
+	const int bottom = (r.bottom - 1) >> m_thread_height;
+
+	for (int row = r.top >> m_thread_height; row <= bottom; row++)
+	{
+		int skip = m_id - GetTileOwner(first, row, m_threads);
+		if (skip < 0)
+			skip += m_threads;
+
+		m_scanline[row] = (skip < columns) ? 1 : 0;
+	}
+}
+
+template <typename Func>
+void GSRasterizer::ForEachMySpan(int left, int right, int top, Func&& func) const
+{
+	const int row = top >> m_thread_height;
+	int column = left >> TILE_WIDTH_SHIFT;
+	int skip = m_id - GetTileOwner(column, row, m_threads);
+	if (skip < 0)
+		skip += m_threads;
+
+	for (column += skip; (column << TILE_WIDTH_SHIFT) < right; column += m_threads)
+	{
+		const int span_left = std::max(left, column << TILE_WIDTH_SHIFT);
+		const int span_right = std::min(right, (column + 1) << TILE_WIDTH_SHIFT);
+		func(span_left, span_right - span_left);
+	}
+}
+
 int GSRasterizer::GetPixels(bool reset)
 {
 	int pixels = m_pixels.sum;
@@ -155,6 +213,9 @@ void GSRasterizer::Draw(GSRasterizerData& data)
 	m_fscissor_y = GSVector4(data.scissor).ywyw();
 	m_scanmsk_value = data.scanmsk_value;
 
+	if (m_tiled)
+		UpdateMyScanlines(data.bbox.rintersect(data.scissor));
+
 	switch (data.primclass)
 	{
 		case GS_POINT_CLASS:
@@ -264,7 +325,7 @@ void GSRasterizer::DrawPoint(const GSVertexSW* vertex, int vertex_count, const u
 
 			if (!scissor_test || (m_scissor.left <= p.x && p.x < m_scissor.right && m_scissor.top <= p.y && p.y < m_scissor.bottom))
 			{
-				if (IsOneOfMyScanlines(p.y))
+				if (IsOneOfMyScanlines(p.y) && IsOneOfMyTiles(p.x, p.y))
 				{
 					m_setup_prim(vertex, index, GSVertexSW::zero(), m_local);
 
@@ -285,7 +346,7 @@ void GSRasterizer::DrawPoint(const GSVertexSW* vertex, int vertex_count, const u
 
 			if (!scissor_test || (m_scissor.left <= p.x && p.x < m_scissor.right && m_scissor.top <= p.y && p.y < m_scissor.bottom))
 			{
-				if (IsOneOfMyScanlines(p.y))
+				if (IsOneOfMyScanlines(p.y) && IsOneOfMyTiles(p.x, p.y))
 				{
 					m_setup_prim(vertex, tmp_index, GSVertexSW::zero(), m_local);
 
@@ -357,7 +418,10 @@ void GSRasterizer::DrawLine(const GSVertexSW* vertex, const u16* index)
 
 					m_setup_prim(vertex, index, dscan, m_local);
 
-					DrawScanline(pixels, left, p.y, scan);
+					if (m_tiled)
+						DrawTiledScanline(pixels, left, p.y, scan, dscan);
+					else
+						DrawScanline(pixels, left, p.y, scan);
 				}
 			}
 		}
@@ -586,7 +650,7 @@ void GSRasterizer::DrawTriangleSection(int top, int bottom, GSVertexSW2& RESTRIC
 
 		if (!IsOneOfMyScanlines(top))
 		{
-			top += (m_threads - 1) << m_thread_height;
+			top = SkipOtherScanlines(top);
 		}
 	}
 
@@ -764,7 +828,7 @@ void GSRasterizer::DrawTriangleSection(int top, int bottom, GSVertexSW& RESTRICT
 
 		if (!IsOneOfMyScanlines(top))
 		{
-			top += (m_threads - 1) << m_thread_height;
+			top = SkipOtherScanlines(top);
 		}
 	}
 
@@ -821,14 +885,28 @@ void GSRasterizer::DrawSprite(const GSVertexSW* vertex, const u16* index)
 				r.top = top;
 				r.bottom = std::min<int>((top + (1 << m_thread_height)) & ~((1 << m_thread_height) - 1), bottom);
 
-				GSDrawScanline::DrawRect(r, scan, m_local);
+				if (m_tiled)
+				{
+					ForEachMySpan(r.left, r.right, r.top, [&](int left, int pixels) {
+						const GSVector4i tr(left, r.top, left + pixels, r.bottom);
 
-				int pixels = r.width() * r.height();
+						GSDrawScanline::DrawRect(tr, scan, m_local);
 
-				m_pixels.actual += pixels;
-				m_pixels.total += pixels;
+						m_pixels.actual += pixels * tr.height();
+						m_pixels.total += pixels * tr.height();
+					});
+				}
+				else
+				{
+					GSDrawScanline::DrawRect(r, scan, m_local);
+
+					int pixels = r.width() * r.height();
+
+					m_pixels.actual += pixels;
+					m_pixels.total += pixels;
+				}
 
-				top = r.bottom + ((m_threads - 1) << m_thread_height);
+				top = SkipOtherScanlines(r.bottom);
 			}
 		}
 
@@ -856,7 +934,19 @@ void GSRasterizer::DrawSprite(const GSVertexSW* vertex, const u16* index)
 	{
 		if (IsOneOfMyScanlines(r.top))
 		{
-			DrawScanline(r.width(), r.left, r.top, scan);
+			if (m_tiled)
+			{
+				// Only t changes across a sprite, and the rest of dscan is not set up.
+				ForEachMySpan(r.left, r.right, r.top, [&](int left, int pixels) {
+					GSVertexSW span = scan;
+					span.t += dscan.t * GSVector4(static_cast<float>(left - r.left));
+					DrawScanline(pixels, left, r.top, span);
+				});
+			}
+			else
+			{
+				DrawScanline(r.width(), r.left, r.top, scan);
+			}
 		}
 
 		if (++r.top >= r.bottom)
@@ -1092,7 +1182,10 @@ void GSRasterizer::Flush(const GSVertexSW* vertex, const u16* index, const GSVer
 				int left = e->_pad.I32[1];
 				int top = e->_pad.I32[2];
 
-				DrawScanline(pixels, left, top, *e++);
+				if (m_tiled)
+					DrawTiledScanline(pixels, left, top, *e++, dscan);
+				else
+					DrawScanline(pixels, left, top, *e++);
 			} while (e < ee);
 		}
 		else
@@ -1103,7 +1196,10 @@ void GSRasterizer::Flush(const GSVertexSW* vertex, const u16* index, const GSVer
 				int left = e->_pad.I32[1];
 				int top = e->_pad.I32[2];
 
-				DrawEdge(pixels, left, top, *e++);
+				if (IsOneOfMyTiles(left, top))
+					DrawEdge(pixels, left, top, *e);
+
+				e++;
 			} while (e < ee);
 		}
 
@@ -1129,6 +1225,16 @@ void GSRasterizer::DrawScanline(int pixels, int left, int top, const GSVertexSW&
 	m_draw_scanline(pixels, left, top, scan, m_local);
 }
 
+void GSRasterizer::DrawTiledScanline(int pixels, int left, int top, const GSVertexSW& scan, const GSVertexSW& dscan)
+{
+	ForEachMySpan(left, left + pixels, top, [&](int span_left, int span_pixels) {
+		if (span_left == left)
+			DrawScanline(span_pixels, span_left, top, scan);
+		else
+			DrawScanline(span_pixels, span_left, top, scan + dscan * GSVector4(static_cast<float>(span_left - left)));
+	});
+}
+
 void GSRasterizer::DrawEdge(int pixels, int left, int top, const GSVertexSW& scan)
 {
 	if ((m_scanmsk_value & 2) && (m_scanmsk_value & 1) == (top & 1)) return;
@@ -1143,7 +1249,7 @@ void GSRasterizer::DrawEdge(int pixels, int left, int top, const GSVertexSW& sca
 //
 
 GSSingleRasterizer::GSSingleRasterizer()
-	: m_r(&m_ds, 0, 1)
+	: m_r(&m_ds, 0, 1, false)
 {
 }
 
@@ -1191,6 +1297,8 @@ void GSSingleRasterizer::PrintStats()
 GSRasterizerList::GSRasterizerList(int threads)
 {
 	m_thread_height = compute_best_thread_height(threads);
+	m_tiled = GSConfig.SWTileBinning && threads > 1;
+	m_queued.resize(threads);
 
 	const int rows = (2048 >> m_thread_height) + 16;
 	m_scanline = static_cast<u8*>(_aligned_malloc(rows, 64));
@@ -1248,12 +1356,46 @@ void GSRasterizerList::Queue(const GSRingHeap::SharedPtr<GSRasterizerData>& data
 
 	pxAssert(r.top >= 0 && r.top < 2048 && r.bottom >= 0 && r.bottom < 2048);
 
+	const int threads = static_cast<int>(m_workers.size());
 	int top = r.top >> m_thread_height;
-	int bottom = std::min<int>((r.bottom + (1 << m_thread_height) - 1) >> m_thread_height, top + m_workers.size());
+	int bottom = std::min<int>((r.bottom + (1 << m_thread_height) - 1) >> m_thread_height, top + threads);
 
-	while (top < bottom)
+	if (!m_tiled)
 	{
-		m_workers[m_scanline[top++]]->Push(data);
+		g_perfmon.Put(GSPerfMon::RasterizerJobs, bottom - top);
+
+		while (top < bottom)
+		{
+			m_workers[m_scanline[top++]]->Push(data);
+		}
+
+		return;
+	}
+
+	// Bin the draw to every thread which owns a tile it touches. The owners repeat after as many
+	// rows or columns as there are threads, so there's no need to look any further than that.
+	if (r.rempty())
+		return;
+
+	const int first = r.left >> TILE_WIDTH_SHIFT;
+	const int columns = std::min<int>(((r.right - 1) >> TILE_WIDTH_SHIFT) - first + 1, threads);
+	int remaining = threads;
+
+	std::fill(m_queued.begin(), m_queued.end(), 0);
+
+	for (; top < bottom && remaining > 0; top++)
+	{
+		for (int column = first; column < first + columns; column++)
+		{
+			const int owner = GetTileOwner(column, top, threads);
+			if (m_queued[owner])
+				continue;
+
+			m_queued[owner] = 1;
+			m_workers[owner]->Push(data);
+			g_perfmon.Put(GSPerfMon::RasterizerJobs, 1);
+			remaining--;
+		}
 	}
 }
 
@@ -1308,7 +1450,7 @@ std::unique_ptr<IRasterizer> GSRasterizerList::Create(int threads)
 
 	for (int i = 0; i < threads; i++)
 	{
-		rl->m_r.push_back(std::unique_ptr<GSRasterizer>(new GSRasterizer(&rl->m_ds, i, threads)));
+		rl->m_r.push_back(std::unique_ptr<GSRasterizer>(new GSRasterizer(&rl->m_ds, i, threads, rl->m_tiled)));
 		auto& r = *rl->m_r[i];
 		rl->m_workers.push_back(std::unique_ptr<GSWorker>(new GSWorker([i]() { GSRasterizerList::OnWorkerStartup(i); },
 			[&r](GSRingHeap::SharedPtr<GSRasterizerData>& item) { r.Draw(*item.get()); },
@@ -71,6 +71,7 @@ protected:
 	int m_id;
 	int m_threads;
 	int m_thread_height;
+	bool m_tiled;
 	u8* m_scanline;
 	u8 m_scanmsk_value;
 	GSVector4i m_scissor;
@@ -108,13 +109,22 @@ protected:
 	__forceinline void DrawScanline(int pixels, int left, int top, const GSVertexSW& scan);
 	__forceinline void DrawEdge(int pixels, int left, int top, const GSVertexSW& scan);
 
+	// Tile binning: each thread owns screen tiles rather than whole rows, so spans are split at
+	// tile columns. The rows which contain one of our tiles are worked out for each draw.
+	void UpdateMyScanlines(const GSVector4i& r);
+	template <typename Func>
+	__forceinline void ForEachMySpan(int left, int right, int top, Func&& func) const;
+	__forceinline void DrawTiledScanline(int pixels, int left, int top, const GSVertexSW& scan, const GSVertexSW& dscan);
+
 public:
-	GSRasterizer(GSDrawScanline* ds, int id, int threads);
+	GSRasterizer(GSDrawScanline* ds, int id, int threads, bool tiled);
 	~GSRasterizer();
 
 	__forceinline bool IsOneOfMyScanlines(int top) const;
 	__forceinline bool IsOneOfMyScanlines(int top, int bottom) const;
+	__forceinline bool IsOneOfMyTiles(int left, int top) const;
 	__forceinline int FindMyNextScanline(int top) const;
+	__forceinline int SkipOtherScanlines(int top) const;
 
 	void Draw(GSRasterizerData& data);
 	int GetPixels(bool reset);
@@ -161,8 +171,10 @@ protected:
 	// Worker threads depend on the rasterizers, so don't change the order.
 	std::vector<std::unique_ptr<GSRasterizer>> m_r;
 	std::vector<std::unique_ptr<GSWorker>> m_workers;
+	std::vector<u8> m_queued;
 	u8* m_scanline;
 	int m_thread_height;
+	bool m_tiled;
 
 	GSRasterizerList(int threads);
 
@@ -42,10 +42,12 @@ GSTextureCacheSW::Texture* GSTextureCacheSW::Lookup(const GIFRegTEX0& TEX0, cons
 		// Lookup hit
 		m.MoveFront(i.Index());
 		t->m_age = 0;
+		g_perfmon.Put(GSPerfMon::TextureCacheHits, 1);
 		return t;
 	}
 
 	// Lookup miss
+	g_perfmon.Put(GSPerfMon::TextureCacheMisses, 1);
 	Texture* t = new Texture(tw0, TEX0, TEXA);
 
 	m_textures.insert(t);
@@ -11,12 +11,18 @@
 #include "GS/Renderers/Vulkan/VKSwapChain.h"
 
 #include "Host.h"
+#include "IconsFontAwesome5.h"
+#include "ShaderCacheVersion.h"
+#include "VMManager.h"
 
 #include "common/Console.h"
 #include "common/BitUtils.h"
+#include "common/FileSystem.h"
 #include "common/HostSys.h"
 #include "common/Path.h"
 #include "common/ScopedGuard.h"
+#include "common/Threading.h"
+#include "common/Timer.h"
 
 #include "imgui.h"
 
@@ -2182,6 +2188,7 @@ bool GSDeviceVK::Create()
 		return false;
 
 	InitializeState();
+	StartPipelineWarmup();
 	return true;
 }
 
@@ -2348,6 +2355,8 @@ void GSDeviceVK::SetVSync(VsyncMode mode)
 
 GSDevice::PresentResult GSDeviceVK::BeginPresent(bool frame_skip)
 {
+	FlushHWBatch();
+
 	EndRenderPass();
 
 	if (frame_skip)
@@ -2442,6 +2451,19 @@ void GSDeviceVK::EndPresent()
 	MoveToNextCommandBuffer();
 
 	InvalidateCachedState();
+
+	if (!m_warmup_threads.empty())
+		UpdatePipelineWarmup();
+}
+
+void GSDeviceVK::GameChanged()
+{
+	if (VMManager::GetDiscSerial() == m_pipeline_manifest_serial)
+		return;
+
+	StopPipelineWarmup();
+	SavePipelineManifest();
+	StartPipelineWarmup();
 }
 
 #ifdef ENABLE_OGL_DEBUG
@@ -2815,6 +2837,8 @@ std::unique_ptr<GSDownloadTexture> GSDeviceVK::CreateDownloadTexture(u32 width,
 
 void GSDeviceVK::CopyRect(GSTexture* sTex, GSTexture* dTex, const GSVector4i& r, u32 destX, u32 destY)
 {
+	FlushHWBatch();
+
 	g_perfmon.Put(GSPerfMon::TextureCopies, 1);
 
 	GSTextureVK* const sTexVK = static_cast<GSTextureVK*>(sTex);
@@ -2907,6 +2931,8 @@ void GSDeviceVK::CopyRect(GSTexture* sTex, GSTexture* dTex, const GSVector4i& r,
 void GSDeviceVK::StretchRect(GSTexture* sTex, const GSVector4& sRect, GSTexture* dTex, const GSVector4& dRect,
 	ShaderConvert shader /* = ShaderConvert::COPY */, bool linear /* = true */)
 {
+	FlushHWBatch();
+
 	pxAssert(HasDepthOutput(shader) == (dTex && dTex->GetType() == GSTexture::Type::DepthStencil));
 	pxAssert(linear ? SupportsBilinear(shader) : SupportsNearest(shader));
 
@@ -2922,6 +2948,8 @@ void GSDeviceVK::StretchRect(GSTexture* sTex, const GSVector4& sRect, GSTexture*
 void GSDeviceVK::StretchRect(GSTexture* sTex, const GSVector4& sRect, GSTexture* dTex, const GSVector4& dRect, bool red,
 	bool green, bool blue, bool alpha, ShaderConvert shader)
 {
+	FlushHWBatch();
+
 	GL_PUSH("ColorCopy Red:%d Green:%d Blue:%d Alpha:%d", red, green, blue, alpha);
 
 	const u32 index = (red ? 1 : 0) | (green ? 2 : 0) | (blue ? 4 : 0) | (alpha ? 8 : 0);
@@ -2934,6 +2962,8 @@ void GSDeviceVK::StretchRect(GSTexture* sTex, const GSVector4& sRect, GSTexture*
 void GSDeviceVK::PresentRect(GSTexture* sTex, const GSVector4& sRect, GSTexture* dTex, const GSVector4& dRect,
 	PresentShader shader, float shaderTime, bool linear)
 {
+	FlushHWBatch();
+
 	DisplayConstantBuffer cb;
 	cb.SetSource(sRect, sTex->GetSize());
 	cb.SetTarget(dRect, dTex ? dTex->GetSize() : GSVector2i(GetWindowWidth(), GetWindowHeight()));
@@ -2947,6 +2977,8 @@ void GSDeviceVK::PresentRect(GSTexture* sTex, const GSVector4& sRect, GSTexture*
 void GSDeviceVK::DrawMultiStretchRects(
 	const MultiStretchRect* rects, u32 num_rects, GSTexture* dTex, ShaderConvert shader)
 {
+	FlushHWBatch();
+
 	GSTexture* last_tex = rects[0].src;
 	bool last_linear = rects[0].linear;
 	u8 last_wmask = rects[0].wmask.wrgba;
@@ -3190,6 +3222,8 @@ void GSDeviceVK::BlitRect(GSTexture* sTex, const GSVector4i& sRect, u32 sLevel,
 void GSDeviceVK::UpdateCLUTTexture(
 	GSTexture* sTex, float sScale, u32 offsetX, u32 offsetY, GSTexture* dTex, u32 dOffset, u32 dSize)
 {
+	FlushHWBatch();
+
 	// Super annoying, but apparently NVIDIA doesn't like floats/ints packed together in the same vec4?
 	struct Uniforms
 	{
@@ -3210,6 +3244,8 @@ void GSDeviceVK::UpdateCLUTTexture(
 void GSDeviceVK::ConvertToIndexedTexture(
 	GSTexture* sTex, float sScale, u32 offsetX, u32 offsetY, u32 SBW, u32 SPSM, GSTexture* dTex, u32 DBW, u32 DPSM)
 {
+	FlushHWBatch();
+
 	struct Uniforms
 	{
 		u32 SBW;
@@ -4610,6 +4646,9 @@ bool GSDeviceVK::DoCAS(
 
 void GSDeviceVK::DestroyResources()
 {
+	StopPipelineWarmup();
+	SavePipelineManifest();
+
 	if (m_tfx_ubo_descriptor_set != VK_NULL_HANDLE)
 		FreePersistentDescriptorSet(m_tfx_ubo_descriptor_set);
 
@@ -4744,9 +4783,13 @@ void GSDeviceVK::DestroyResources()
 
 VkShaderModule GSDeviceVK::GetTFXVertexShader(GSHWDrawConfig::VSSelector sel)
 {
-	const auto it = m_tfx_vertex_shaders.find(sel.key);
-	if (it != m_tfx_vertex_shaders.end())
-		return it->second;
+	// Can be called from the warm-up threads, so only hold the lock for the lookup and not the compile.
+	{
+		std::unique_lock lock(m_tfx_shader_mutex);
+		const auto it = m_tfx_vertex_shaders.find(sel.key);
+		if (it != m_tfx_vertex_shaders.end())
+			return it->second;
+	}
 
 	std::stringstream ss;
 	AddShaderHeader(ss);
@@ -4763,15 +4806,27 @@ VkShaderModule GSDeviceVK::GetTFXVertexShader(GSHWDrawConfig::VSSelector sel)
 	if (mod)
 		Vulkan::SetObjectName(m_device, mod, "TFX Vertex %08X", sel.key);
 
-	m_tfx_vertex_shaders.emplace(sel.key, mod);
+	std::unique_lock lock(m_tfx_shader_mutex);
+	const auto [it, inserted] = m_tfx_vertex_shaders.emplace(sel.key, mod);
+	if (!inserted)
+	{
+		// another thread got there first
+		if (mod != VK_NULL_HANDLE)
+			vkDestroyShaderModule(m_device, mod, nullptr);
+		return it->second;
+	}
+
 	return mod;
 }
 
 VkShaderModule GSDeviceVK::GetTFXFragmentShader(const GSHWDrawConfig::PSSelector& sel)
 {
-	const auto it = m_tfx_fragment_shaders.find(sel);
-	if (it != m_tfx_fragment_shaders.end())
-		return it->second;
+	{
+		std::unique_lock lock(m_tfx_shader_mutex);
+		const auto it = m_tfx_fragment_shaders.find(sel);
+		if (it != m_tfx_fragment_shaders.end())
+			return it->second;
+	}
 
 	std::stringstream ss;
 	AddShaderHeader(ss);
@@ -4838,11 +4893,30 @@ VkShaderModule GSDeviceVK::GetTFXFragmentShader(const GSHWDrawConfig::PSSelector
 	if (mod)
 		Vulkan::SetObjectName(m_device, mod, "TFX Fragment %" PRIX64 "%08X", sel.key_hi, sel.key_lo);
 
-	m_tfx_fragment_shaders.emplace(sel, mod);
+	std::unique_lock lock(m_tfx_shader_mutex);
+	const auto [it, inserted] = m_tfx_fragment_shaders.emplace(sel, mod);
+	if (!inserted)
+	{
+		if (mod != VK_NULL_HANDLE)
+			vkDestroyShaderModule(m_device, mod, nullptr);
+		return it->second;
+	}
+
 	return mod;
 }
 
-VkPipeline GSDeviceVK::CreateTFXPipeline(const PipelineSelector& p)
+VkRenderPass GSDeviceVK::GetTFXPipelineRenderPass(const PipelineSelector& p) const
+{
+	// DATE image prepass
+	if (IsDATEModePrimIDInit(p.ps.date))
+		return m_date_image_setup_render_passes[p.ds][0];
+
+	return GetTFXRenderPass(p.rt, p.ds, p.ps.hdr, p.dss.date, p.IsRTFeedbackLoop(), p.IsTestingAndSamplingDepth(),
+		p.rt ? VK_ATTACHMENT_LOAD_OP_LOAD : VK_ATTACHMENT_LOAD_OP_DONT_CARE,
+		p.ds ? VK_ATTACHMENT_LOAD_OP_LOAD : VK_ATTACHMENT_LOAD_OP_DONT_CARE);
+}
+
+VkPipeline GSDeviceVK::CreateTFXPipeline(const PipelineSelector& p, VkRenderPass render_pass, VkPipelineCache pipeline_cache)
 {
 	static constexpr std::array<VkPrimitiveTopology, 3> topology_lookup = {{
 		VK_PRIMITIVE_TOPOLOGY_POINT_LIST, // Point
@@ -4869,20 +4943,7 @@ VkPipeline GSDeviceVK::CreateTFXPipeline(const PipelineSelector& p)
 
 	// Common state
 	gpb.SetPipelineLayout(m_tfx_pipeline_layout);
-	if (IsDATEModePrimIDInit(p.ps.date))
-	{
-		// DATE image prepass
-		gpb.SetRenderPass(m_date_image_setup_render_passes[p.ds][0], 0);
-	}
-	else
-	{
-		gpb.SetRenderPass(
-			GetTFXRenderPass(p.rt, p.ds, p.ps.hdr, p.dss.date,
-				p.IsRTFeedbackLoop(), p.IsTestingAndSamplingDepth(),
-				p.rt ? VK_ATTACHMENT_LOAD_OP_LOAD : VK_ATTACHMENT_LOAD_OP_DONT_CARE,
-				p.ds ? VK_ATTACHMENT_LOAD_OP_LOAD : VK_ATTACHMENT_LOAD_OP_DONT_CARE),
-			0);
-	}
+	gpb.SetRenderPass(render_pass, 0);
 	gpb.SetPrimitiveTopology(topology_lookup[p.topology]);
 	gpb.SetRasterizationState(VK_POLYGON_MODE_FILL, VK_CULL_MODE_NONE, VK_FRONT_FACE_CLOCKWISE);
 	if (m_optional_extensions.vk_ext_line_rasterization &&
@@ -4959,7 +5020,7 @@ VkPipeline GSDeviceVK::CreateTFXPipeline(const PipelineSelector& p)
 	if (m_features.framebuffer_fetch && p.IsRTFeedbackLoop())
 		gpb.AddBlendFlags(VK_PIPELINE_COLOR_BLEND_STATE_CREATE_RASTERIZATION_ORDER_ATTACHMENT_ACCESS_BIT_EXT);
 
-	VkPipeline pipeline = gpb.Create(m_device, g_vulkan_shader_cache->GetPipelineCache(true));
+	VkPipeline pipeline = gpb.Create(m_device, pipeline_cache);
 	if (pipeline)
 	{
 		Vulkan::SetObjectName(
@@ -4971,15 +5032,255 @@ VkPipeline GSDeviceVK::CreateTFXPipeline(const PipelineSelector& p)
 
 VkPipeline GSDeviceVK::GetTFXPipeline(const PipelineSelector& p)
 {
-	const auto it = m_tfx_pipelines.find(p);
+	auto it = m_tfx_pipelines.find(p);
 	if (it != m_tfx_pipelines.end())
 		return it->second;
 
-	VkPipeline pipeline = CreateTFXPipeline(p);
+	// might be sitting in the warm-up results already
+	if (!m_warmup_threads.empty())
+	{
+		CollectWarmedUpPipelines();
+		it = m_tfx_pipelines.find(p);
+		if (it != m_tfx_pipelines.end())
+			return it->second;
+	}
+
+	VkPipeline pipeline = CreateTFXPipeline(p, GetTFXPipelineRenderPass(p), g_vulkan_shader_cache->GetPipelineCache(true));
 	m_tfx_pipelines.emplace(p, pipeline);
 	return pipeline;
 }
 
+namespace
+{
+	struct PipelineManifestHeader
+	{
+		u32 magic;
+		u32 version;
+		u32 feature_bits;
+		u32 count;
+	};
+} // namespace
+
+static constexpr u32 PIPELINE_MANIFEST_MAGIC = 0x464D4C50; // PLMF
+static constexpr u32 MAX_PIPELINE_WARMUP_THREADS = 4;
+
+std::string GSDeviceVK::GetPipelineManifestFileName() const
+{
+	return Path::Combine(EmuFolders::Cache, fmt::format("vulkan_pipelines_{}.manifest", m_pipeline_manifest_serial));
+}
+
+u32 GSDeviceVK::GetPipelineManifestFeatureBits() const
+{
+	// Selectors are already adjusted for the device features, so a manifest recorded on another GPU could
+	// contain state which this one can't handle. Bit positions are part of the file format, only append.
+	const bool features[] = {
+		m_features.broken_point_sampler,
+		m_features.vs_expand,
+		m_features.primitive_id,
+		m_features.texture_barrier,
+		m_features.provoking_vertex_last,
+		m_features.point_expand,
+		m_features.line_expand,
+		m_features.prefer_new_textures,
+		m_features.dxt_textures,
+		m_features.bptc_textures,
+		m_features.framebuffer_fetch,
+		m_features.stencil_buffer,
+		m_features.cas_sharpening,
+		m_features.test_and_sample_depth,
+		m_optional_extensions.vk_ext_provoking_vertex,
+		m_optional_extensions.vk_ext_rasterization_order_attachment_access,
+		m_optional_extensions.vk_ext_attachment_feedback_loop_layout,
+		m_optional_extensions.vk_ext_line_rasterization,
+	};
+	static_assert(std::size(features) <= 32);
+
+	u32 bits = 0;
+	for (u32 i = 0; i < std::size(features); i++)
+		bits |= static_cast<u32>(features[i]) << i;
+	return bits;
+}
+
+void GSDeviceVK::SavePipelineManifest()
+{
+	// Nothing new since it was loaded?
+	if (m_pipeline_manifest_serial.empty() || GSConfig.DisableShaderCache ||
+		m_tfx_pipelines.size() <= m_pipeline_manifest_size)
+	{
+		return;
+	}
+
+	std::vector<u8> data(sizeof(PipelineManifestHeader));
+	u32 count = 0;
+	for (const auto& [p, pipeline] : m_tfx_pipelines)
+	{
+		if (pipeline == VK_NULL_HANDLE)
+			continue;
+
+		const size_t pos = data.size();
+		data.resize(pos + sizeof(PipelineSelector));
+		std::memcpy(&data[pos], &p, sizeof(PipelineSelector));
+		count++;
+	}
+
+	const PipelineManifestHeader header = {PIPELINE_MANIFEST_MAGIC, SHADER_CACHE_VERSION, GetPipelineManifestFeatureBits(), count};
+	std::memcpy(data.data(), &header, sizeof(header));
+
+	const std::string filename = GetPipelineManifestFileName();
+	if (!FileSystem::WriteBinaryFile(filename.c_str(), data.data(), data.size()))
+	{
+		Console.ErrorFmt("Failed to write pipeline manifest '{}'", filename);
+		return;
+	}
+
+	DevCon.WriteLnFmt("Wrote {} pipelines to manifest '{}'", count, Path::GetFileName(filename));
+	m_pipeline_manifest_size = m_tfx_pipelines.size();
+}
+
+void GSDeviceVK::StartPipelineWarmup()
+{
+	pxAssert(m_warmup_threads.empty());
+
+	m_pipeline_manifest_serial = VMManager::GetDiscSerial();
+	m_pipeline_manifest_size = 0;
+	if (m_pipeline_manifest_serial.empty() || GSConfig.DisableShaderCache)
+		return;
+
+	const std::string filename = GetPipelineManifestFileName();
+	const std::optional<std::vector<u8>> data = FileSystem::ReadBinaryFile(filename.c_str());
+	if (!data.has_value())
+		return;
+
+	PipelineManifestHeader header;
+	if (data->size() < sizeof(header))
+		return;
+
+	std::memcpy(&header, data->data(), sizeof(header));
+	if (header.magic != PIPELINE_MANIFEST_MAGIC || header.version != SHADER_CACHE_VERSION ||
+		header.feature_bits != GetPipelineManifestFeatureBits() ||
+		data->size() != (sizeof(header) + header.count * sizeof(PipelineSelector)))
+	{
+		Console.WarningFmt("Ignoring outdated pipeline manifest '{}'", Path::GetFileName(filename));
+		return;
+	}
+
+	m_pipeline_manifest_size = header.count;
+
+	m_warmup_selectors.resize(header.count);
+	std::memcpy(m_warmup_selectors.data(), data->data() + sizeof(header), header.count * sizeof(PipelineSelector));
+
+	// Don't bother with anything which is already around, e.g. when switching back to a game.
+	std::erase_if(m_warmup_selectors, [this](const PipelineSelector& p) { return m_tfx_pipelines.contains(p); });
+	if (m_warmup_selectors.empty())
+		return;
+
+	// Render passes come from device state which the GS thread keeps using, so resolve them all here and
+	// hand the workers plain handles, rather than having them look anything up while the game runs.
+	m_warmup_render_passes.reserve(m_warmup_selectors.size());
+	for (const PipelineSelector& p : m_warmup_selectors)
+		m_warmup_render_passes.push_back(GetTFXPipelineRenderPass(p));
+
+	m_warmup_next_index.store(0, std::memory_order_relaxed);
+	m_warmup_completed.store(0, std::memory_order_relaxed);
+	m_warmup_failed.store(0, std::memory_order_relaxed);
+	m_warmup_cancelled.store(false, std::memory_order_relaxed);
+	m_warmup_last_reported = 0;
+	m_warmup_start_time = Common::Timer::GetCurrentValue();
+
+	// Leave some cores for the emulator itself, which is starting up at the same time.
+	const u32 num_threads = std::min(static_cast<u32>(m_warmup_selectors.size()),
+		std::clamp(std::thread::hardware_concurrency() / 2, 1u, MAX_PIPELINE_WARMUP_THREADS));
+	const VkPipelineCache pipeline_cache = g_vulkan_shader_cache->GetPipelineCache(true);
+	for (u32 i = 0; i < num_threads; i++)
+		m_warmup_threads.emplace_back(&GSDeviceVK::PipelineWarmupThreadEntryPoint, this, pipeline_cache);
+
+	Console.WriteLnFmt("Warming up {} pipelines for {} on {} threads.", m_warmup_selectors.size(),
+		m_pipeline_manifest_serial, num_threads);
+}
+
+void GSDeviceVK::StopPipelineWarmup()
+{
+	if (m_warmup_threads.empty())
+		return;
+
+	m_warmup_cancelled.store(true, std::memory_order_release);
+	for (std::thread& thread : m_warmup_threads)
+		thread.join();
+	m_warmup_threads.clear();
+
+	CollectWarmedUpPipelines();
+
+	const u32 completed = m_warmup_completed.load(std::memory_order_acquire);
+	const u32 failed = m_warmup_failed.load(std::memory_order_relaxed);
+	Console.WriteLnFmt("Pipeline warm-up: {} of {} pipelines compiled in {:.2f} ms, {} failed.", completed - failed,
+		m_warmup_selectors.size(),
+		Common::Timer::ConvertValueToMilliseconds(Common::Timer::GetCurrentValue() - m_warmup_start_time), failed);
+
+	Host::RemoveKeyedOSDMessage("PipelineWarmup");
+	m_warmup_selectors = {};
+	m_warmup_render_passes = {};
+}
+
+void GSDeviceVK::UpdatePipelineWarmup()
+{
+	CollectWarmedUpPipelines();
+
+	const u32 total = static_cast<u32>(m_warmup_selectors.size());
+	const u32 completed = m_warmup_completed.load(std::memory_order_acquire);
+	if (completed >= total)
+	{
+		StopPipelineWarmup();
+		return;
+	}
+
+	// Only refresh the message every few percent.
+	if (completed == 0 || (completed - m_warmup_last_reported) < std::max(total / 20, 1u))
+		return;
+
+	m_warmup_last_reported = completed;
+	Host::AddIconOSDMessage("PipelineWarmup", ICON_FA_MICROCHIP,
+		fmt::format(TRANSLATE_FS("GS", "Compiling pipelines: {} of {}..."), completed, total),
+		Host::OSD_INFO_DURATION);
+}
+
+void GSDeviceVK::CollectWarmedUpPipelines()
+{
+	std::unique_lock lock(m_warmup_mutex);
+	for (const auto& [p, pipeline] : m_warmup_results)
+	{
+		// A draw may have needed it before it was ready.
+		if (!m_tfx_pipelines.emplace(p, pipeline).second)
+			vkDestroyPipeline(m_device, pipeline, nullptr);
+	}
+	m_warmup_results.clear();
+}
+
+void GSDeviceVK::PipelineWarmupThreadEntryPoint(VkPipelineCache pipeline_cache)
+{
+	Threading::SetNameOfCurrentThread("Pipeline Warm-up");
+
+	while (!m_warmup_cancelled.load(std::memory_order_acquire))
+	{
+		const u32 index = m_warmup_next_index.fetch_add(1, std::memory_order_relaxed);
+		if (index >= m_warmup_selectors.size())
+			break;
+
+		const PipelineSelector& p = m_warmup_selectors[index];
+		const VkPipeline pipeline = CreateTFXPipeline(p, m_warmup_render_passes[index], pipeline_cache);
+		if (pipeline != VK_NULL_HANDLE)
+		{
+			std::unique_lock lock(m_warmup_mutex);
+			m_warmup_results.emplace_back(p, pipeline);
+		}
+		else
+		{
+			m_warmup_failed.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		m_warmup_completed.fetch_add(1, std::memory_order_release);
+	}
+}
+
 bool GSDeviceVK::BindDrawPipeline(const PipelineSelector& p)
 {
 	VkPipeline pipeline = GetTFXPipeline(p);
@@ -5629,6 +5930,8 @@ GSTextureVK* GSDeviceVK::SetupPrimitiveTrackingDATE(GSHWDrawConfig& config)
 
 void GSDeviceVK::RenderHW(GSHWDrawConfig& config)
 {
+	FlushHWBatch();
+
 	// Destination Alpha Setup
 	switch (config.destination_alpha)
 	{
@@ -76,7 +76,7 @@ public:
 	/// Returns true if running on an NVIDIA GPU.
 	__fi bool IsDeviceNVIDIA() const { return (m_device_properties.vendorID == 0x10DE); }
 
-	// Creates a simple render pass.
+	// Creates a simple render pass. GS thread only, the cache isn't locked.
 	VkRenderPass GetRenderPass(VkFormat color_format, VkFormat depth_format,
 		VkAttachmentLoadOp color_load_op = VK_ATTACHMENT_LOAD_OP_LOAD,
 		VkAttachmentStoreOp color_store_op = VK_ATTACHMENT_STORE_OP_STORE,
@@ -431,6 +431,23 @@ private:
 	std::unordered_map<GSHWDrawConfig::PSSelector, VkShaderModule, GSHWDrawConfig::PSSelectorHash>
 		m_tfx_fragment_shaders;
 	std::unordered_map<PipelineSelector, VkPipeline, PipelineSelectorHash> m_tfx_pipelines;
+	std::mutex m_tfx_shader_mutex;
+
+	// Pipeline warm-up: selectors used by the current game are recorded to a manifest in the cache directory,
+	// and compiled on worker threads next time the game boots, instead of hitching on first use.
+	std::string m_pipeline_manifest_serial;
+	size_t m_pipeline_manifest_size = 0;
+	std::vector<PipelineSelector> m_warmup_selectors;
+	std::vector<VkRenderPass> m_warmup_render_passes; // looked up on the GS thread, one per selector
+	std::vector<std::thread> m_warmup_threads;
+	std::mutex m_warmup_mutex;
+	std::vector<std::pair<PipelineSelector, VkPipeline>> m_warmup_results;
+	std::atomic<u32> m_warmup_next_index{0};
+	std::atomic<u32> m_warmup_completed{0};
+	std::atomic<u32> m_warmup_failed{0};
+	std::atomic_bool m_warmup_cancelled{false};
+	u32 m_warmup_last_reported = 0;
+	u64 m_warmup_start_time = 0;
 
 	VkRenderPass m_utility_color_render_pass_load = VK_NULL_HANDLE;
 	VkRenderPass m_utility_color_render_pass_clear = VK_NULL_HANDLE;
@@ -471,9 +488,19 @@ private:
 
 	VkShaderModule GetTFXVertexShader(GSHWDrawConfig::VSSelector sel);
 	VkShaderModule GetTFXFragmentShader(const GSHWDrawConfig::PSSelector& sel);
-	VkPipeline CreateTFXPipeline(const PipelineSelector& p);
+	VkRenderPass GetTFXPipelineRenderPass(const PipelineSelector& p) const;
+	VkPipeline CreateTFXPipeline(const PipelineSelector& p, VkRenderPass render_pass, VkPipelineCache pipeline_cache);
 	VkPipeline GetTFXPipeline(const PipelineSelector& p);
 
+	std::string GetPipelineManifestFileName() const;
+	u32 GetPipelineManifestFeatureBits() const;
+	void SavePipelineManifest();
+	void StartPipelineWarmup();
+	void StopPipelineWarmup();
+	void UpdatePipelineWarmup();
+	void CollectWarmedUpPipelines();
+	void PipelineWarmupThreadEntryPoint(VkPipelineCache pipeline_cache);
+
 	VkShaderModule GetUtilityVertexShader(const std::string& source, const char* replace_main);
 	VkShaderModule GetUtilityFragmentShader(const std::string& source, const char* replace_main);
 
@@ -533,6 +560,7 @@ public:
 
 	PresentResult BeginPresent(bool frame_skip) override;
 	void EndPresent() override;
+	void GameChanged() override;
 
 	bool SetGPUTimingEnabled(bool enabled) override;
 	float GetAndResetAccumulatedGPUTime() override;
@@ -324,6 +324,8 @@ void GSTextureVK::UpdateFromBuffer(VkCommandBuffer cmdbuf, int level, u32 x, u32
 
 bool GSTextureVK::Update(const GSVector4i& r, const void* data, int pitch, int layer)
 {
+	g_gs_device->FlushHWBatch(this);
+
 	if (layer >= m_mipmap_levels)
 		return false;
 
@@ -393,6 +395,8 @@ bool GSTextureVK::Update(const GSVector4i& r, const void* data, int pitch, int l
 
 bool GSTextureVK::Map(GSMap& m, const GSVector4i* r, int layer)
 {
+	g_gs_device->FlushHWBatch(this);
+
 	if (layer >= m_mipmap_levels || IsCompressedFormat())
 		return false;
 
@@ -464,6 +468,8 @@ void GSTextureVK::Unmap()
 
 void GSTextureVK::GenerateMipmap()
 {
+	g_gs_device->FlushHWBatch(this);
+
 	const VkCommandBuffer cmdbuf = GetCommandBufferForUpdate();
 
 	if (m_layout == Layout::Undefined)
@@ -831,6 +837,8 @@ std::unique_ptr<GSDownloadTextureVK> GSDownloadTextureVK::Create(u32 width, u32
 void GSDownloadTextureVK::CopyFromTexture(
 	const GSVector4i& drc, GSTexture* stex, const GSVector4i& src, u32 src_level, bool use_transfer_pitch)
 {
+	g_gs_device->FlushHWBatch(stex);
+
 	GSTextureVK* const vkTex = static_cast<GSTextureVK*>(stex);
 
 	pxAssert(vkTex->GetFormat() == m_format);
@@ -18,16 +18,19 @@
 #include "fmt/format.h"
 #include "shaderc/shaderc.hpp"
 
+#include <atomic>
 #include <cstring>
 #include <fstream>
 #include <memory>
+#include <mutex>
 
 // TODO: store the driver version and stuff in the shader header
 
 std::unique_ptr<VKShaderCache> g_vulkan_shader_cache;
 
 static std::unique_ptr<shaderc::Compiler> s_shaderc_compiler;
-static u32 s_next_bad_shader_id = 0;
+static std::once_flag s_shaderc_compiler_once;
+static std::atomic<u32> s_next_bad_shader_id{0};
 
 namespace
 {
@@ -101,9 +104,8 @@ static void FillPipelineCacheHeader(VK_PIPELINE_CACHE_HEADER* header)
 
 std::optional<VKShaderCache::SPIRVCodeVector> VKShaderCache::CompileShaderToSPV(u32 stage, std::string_view source, bool debug)
 {
-	// TODO: NOT thread safe, yet.
-	if (!s_shaderc_compiler)
-		s_shaderc_compiler = std::make_unique<shaderc::Compiler>();
+	// Compiler objects can be used from multiple threads, only creation needs to be synchronized.
+	std::call_once(s_shaderc_compiler_once, []() { s_shaderc_compiler = std::make_unique<shaderc::Compiler>(); });
 
 	shaderc::CompileOptions options;
 	options.SetSourceLanguage(shaderc_source_language_glsl);
@@ -499,20 +501,25 @@ VKShaderCache::CacheIndexKey VKShaderCache::GetCacheKey(u32 type, const std::str
 std::optional<VKShaderCache::SPIRVCodeVector> VKShaderCache::GetShaderSPV(u32 type, std::string_view shader_code)
 {
 	const auto key = GetCacheKey(type, shader_code);
-	auto iter = m_index.find(key);
-	if (iter == m_index.end())
-		return CompileAndAddShaderSPV(key, shader_code);
-
-	std::optional<SPIRVCodeVector> spv = SPIRVCodeVector(iter->second.blob_size);
-
-	if (std::fseek(m_blob_file, iter->second.file_offset, SEEK_SET) != 0 ||
-		std::fread(spv->data(), sizeof(SPIRVCodeType), iter->second.blob_size, m_blob_file) != iter->second.blob_size)
 	{
-		Console.Error("Read blob from file failed, recompiling");
-		spv = CompileShaderToSPV(type, shader_code, GSConfig.UseDebugDevice);
+		std::unique_lock lock(m_mutex);
+		auto iter = m_index.find(key);
+		if (iter == m_index.end())
+		{
+			lock.unlock();
+			return CompileAndAddShaderSPV(key, shader_code);
+		}
+
+		std::optional<SPIRVCodeVector> spv = SPIRVCodeVector(iter->second.blob_size);
+		if (std::fseek(m_blob_file, iter->second.file_offset, SEEK_SET) == 0 &&
+			std::fread(spv->data(), sizeof(SPIRVCodeType), iter->second.blob_size, m_blob_file) == iter->second.blob_size)
+		{
+			return spv;
+		}
 	}
 
-	return spv;
+	Console.Error("Read blob from file failed, recompiling");
+	return CompileShaderToSPV(type, shader_code, GSConfig.UseDebugDevice);
 }
 
 VkShaderModule VKShaderCache::GetShaderModule(u32 type, std::string_view shader_code)
@@ -557,7 +564,9 @@ std::optional<VKShaderCache::SPIRVCodeVector> VKShaderCache::CompileAndAddShader
 	if (!spv.has_value())
 		return {};
 
-	if (!m_blob_file || std::fseek(m_blob_file, 0, SEEK_END) != 0)
+	// Another thread may have compiled the same shader in the meantime.
+	std::unique_lock lock(m_mutex);
+	if (m_index.find(key) != m_index.end() || !m_blob_file || std::fseek(m_blob_file, 0, SEEK_END) != 0)
 		return spv;
 
 	CacheIndexData data;
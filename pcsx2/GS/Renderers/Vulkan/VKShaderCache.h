@@ -9,6 +9,7 @@
 
 #include <cstdio>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -95,6 +96,9 @@ private:
 
 	CacheIndex m_index;
 
+	// Shaders can be requested from the pipeline warm-up threads, protects the index and files.
+	std::mutex m_mutex;
+
 	VkPipelineCache m_pipeline_cache = VK_NULL_HANDLE;
 	bool m_pipeline_cache_dirty = false;
 };
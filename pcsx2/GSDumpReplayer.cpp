@@ -261,8 +261,17 @@ void GSDumpReplayerCpuStep()
 		s_needs_state_loaded = false;
 	}
 
-	const GSDumpFile::GSData& packet = s_dump_file->GetPackets()[s_current_packet];
-	s_current_packet = (s_current_packet + 1) % static_cast<u32>(s_dump_file->GetPackets().size());
+	const GSDumpFile::GSData* packet_ptr = s_dump_file->GetPacket(s_current_packet);
+	if (!packet_ptr) [[unlikely]]
+	{
+		Host::ReportFormattedErrorAsync("GSDumpReplayer", "Failed to read packet %u.", s_current_packet);
+		Host::RequestVMShutdown(false, false, false);
+		s_dump_running = false;
+		return;
+	}
+
+	const GSDumpFile::GSData& packet = *packet_ptr;
+	s_current_packet = (s_current_packet + 1) % static_cast<u32>(s_dump_file->GetPacketCount());
 	if (s_current_packet == 0)
 	{
 		s_dump_frame_number = 0;
@@ -384,11 +393,11 @@ void GSDumpReplayer::RenderUI()
 		position_y += text_size.y + spacing; \
 	} while (0)
 
-	fmt::format_to(std::back_inserter(text), "Dump Frame: {}", s_dump_frame_number);
+	fmt::format_to(std::back_inserter(text), "Dump Frame: {}/{}", s_dump_frame_number, s_dump_file->GetFrameCount());
 	DRAW_LINE(font, text.c_str(), IM_COL32(255, 255, 255, 255));
 
 	text.clear();
-	fmt::format_to(std::back_inserter(text), "Packet Number: {}/{}", s_current_packet, static_cast<u32>(s_dump_file->GetPackets().size()));
+	fmt::format_to(std::back_inserter(text), "Packet Number: {}/{}", s_current_packet, static_cast<u32>(s_dump_file->GetPacketCount()));
 	DRAW_LINE(font, text.c_str(), IM_COL32(255, 255, 255, 255));
 
 #undef DRAW_LINE
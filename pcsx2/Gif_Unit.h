@@ -183,7 +183,10 @@ struct Gif_Path_MTVU
 	// Set a size based on MTGS but keep a factor 2 to avoid too waste to much
 	// memory overhead. Note the struct is instantied 3 times (for each gif
 	// path)
-	ringbuffer_base<GS_Packet, MTGS::RingBufferSize / 2> gsPackQueue;
+	// Sized for the largest MTGS ring, since the ring can grow at runtime and the queue can't.
+	// That's 8MB per path (24MB total, 12MB more than the default ring needs), but the pages
+	// are only touched once that many packets are actually in flight.
+	ringbuffer_base<GS_Packet, MTGS::MaxRingBufferSize / 2> gsPackQueue;
 	Gif_Path_MTVU() { Reset(); }
 	void Reset()
 	{
@@ -240,6 +240,21 @@ DEFINE_HOTKEY("LoadStateFromSlot", TRANSLATE_NOOP("Hotkeys", "Save States"),
 		if (!pressed && VMManager::HasValidVM())
 			SaveStateSelectorUI::LoadCurrentSlot();
 	})
+DEFINE_HOTKEY("LoadIncrementalAutosave", TRANSLATE_NOOP("Hotkeys", "Save States"),
+	TRANSLATE_NOOP("Hotkeys", "Load Latest Autosave"), [](s32 pressed) {
+		if (!pressed && VMManager::HasValidVM())
+			Host::RunOnCPUThread([]() { VMManager::LoadIncrementalAutosave(); });
+	})
+DEFINE_HOTKEY("Rewind", TRANSLATE_NOOP("Hotkeys", "Save States"),
+	TRANSLATE_NOOP("Hotkeys", "Rewind One Second"), [](s32 pressed) {
+		if (!pressed && VMManager::HasValidVM())
+		{
+			// Loads a state, therefore must be deferred like the slot hotkeys.
+			Host::RunOnCPUThread([]() {
+				VMManager::RewindFrames(static_cast<u32>(std::max(VMManager::GetFrameRate(), 1.0f)));
+			});
+		}
+	})
 DEFINE_HOTKEY("SaveStateAndSelectNextSlot", TRANSLATE_NOOP("Hotkeys", "Save States"),
 	TRANSLATE_NOOP("Hotkeys", "Save State and Select Next Slot"), [](s32 pressed) {
 		if (!pressed && VMManager::HasValidVM())
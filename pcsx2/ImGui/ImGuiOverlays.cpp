@@ -36,6 +36,7 @@
 #include "imgui.h"
 
 #include <array>
+#include <algorithm>
 #include <chrono>
 #include <cmath>
 #include <deque>
@@ -202,10 +203,57 @@ __ri void ImGuiManager::DrawPerformanceOverlay(float& position_y, float scale, f
 			FormatProcessorStat(text, PerformanceMetrics::GetCPUThreadUsage(), PerformanceMetrics::GetCPUThreadAverageTime());
 			DRAW_LINE(fixed_font, text.c_str(), IM_COL32(255, 255, 255, 255));
 
+			if (EmuConfig.Cpu.Recompiler.EnableEETiering)
+			{
+				text.clear();
+				text.append_format("EE tiers: {} tier-ups, T0 {} blocks ({:.1f}ms), T1 {} blocks ({:.1f}ms)",
+					PerformanceMetrics::GetEETierUps(), PerformanceMetrics::GetEETierBlocks(0),
+					PerformanceMetrics::GetEETierCompileTime(0), PerformanceMetrics::GetEETierBlocks(1),
+					PerformanceMetrics::GetEETierCompileTime(1));
+				DRAW_LINE(fixed_font, text.c_str(), IM_COL32(255, 255, 255, 255));
+			}
+
+			if (EmuConfig.Cpu.Recompiler.EnableEESpeculativeCompile)
+			{
+				text.clear();
+				text.append_format("EE speculation: {} blocks ({:.1f}ms), {} entered, {:.0f}% hit",
+					PerformanceMetrics::GetEESpeculativeBlocksCompiled(), PerformanceMetrics::GetEESpeculativeCompileTime(),
+					PerformanceMetrics::GetEESpeculativeBlocksEntered(), PerformanceMetrics::GetEESpeculationHitRate());
+				DRAW_LINE(fixed_font, text.c_str(), IM_COL32(255, 255, 255, 255));
+			}
+
+			if (EmuConfig.Cpu.Recompiler.EnableEEBlockCache)
+			{
+				text.clear();
+				text.append_format("EE block cache: {} reads, {} read ahead, {:.0f}% hit",
+					PerformanceMetrics::GetEEBlockCacheReads(), PerformanceMetrics::GetEEBlockCacheReadAhead(),
+					PerformanceMetrics::GetEEBlockCacheReadAheadHitRate());
+				DRAW_LINE(fixed_font, text.c_str(), IM_COL32(255, 255, 255, 255));
+			}
+
 			text = "GS: ";
 			FormatProcessorStat(text, PerformanceMetrics::GetGSThreadUsage(), PerformanceMetrics::GetGSThreadAverageTime());
 			DRAW_LINE(fixed_font, text.c_str(), IM_COL32(255, 255, 255, 255));
 
+			if (PerformanceMetrics::GetMTGSStallsPerSecond() > 0.0f)
+			{
+				text.clear();
+				text.append_format("MTGS: {}MB, {:.2f}ms stalled ({:.0f}/s), {:.0f} wakeups/s",
+					PerformanceMetrics::GetMTGSRingBufferSize() >> 20, PerformanceMetrics::GetMTGSStallTime(),
+					PerformanceMetrics::GetMTGSStallsPerSecond(), PerformanceMetrics::GetMTGSWakeupsPerSecond());
+				DRAW_LINE(fixed_font, text.c_str(), IM_COL32(255, 255, 255, 255));
+			}
+
+			// Share of packets queued at each eighth of ring occupancy, mostly-full buckets are where stalls come from.
+			const PerformanceMetrics::MTGSOccupancyHistogram& occupancy = PerformanceMetrics::GetMTGSOccupancyHistogram();
+			if (std::any_of(occupancy.begin(), occupancy.end(), [](float v) { return v > 0.0f; }))
+			{
+				text = "MTGS fill:";
+				for (const float bucket : occupancy)
+					text.append_format(" {:.0f}%", bucket * 100.0f);
+				DRAW_LINE(fixed_font, text.c_str(), IM_COL32(255, 255, 255, 255));
+			}
+
 			const u32 gs_sw_threads = PerformanceMetrics::GetGSSWThreadCount();
 			for (u32 i = 0; i < gs_sw_threads; i++)
 			{
@@ -222,6 +270,16 @@ __ri void ImGuiManager::DrawPerformanceOverlay(float& position_y, float scale, f
 				DRAW_LINE(fixed_font, text.c_str(), IM_COL32(255, 255, 255, 255));
 			}
 
+			if (EmuConfig.EnableRewind)
+			{
+				const Rewind::Statistics& rewind = PerformanceMetrics::GetRewindStatistics();
+				text.clear();
+				text.append_format("Rewind: {} snapshots, {}MB, {:.2f}ms avg, {:.2f}ms max, every {} frames, {} skipped",
+					rewind.num_snapshots, rewind.memory_usage >> 20, rewind.average_capture_time_ms,
+					rewind.max_capture_time_ms, rewind.capture_interval, rewind.skipped_captures);
+				DRAW_LINE(fixed_font, text.c_str(), IM_COL32(255, 255, 255, 255));
+			}
+
 			if (GSCapture::IsCapturing())
 			{
 				text = "CAP: ";
@@ -12,8 +12,10 @@
 #include "common/FPControl.h"
 #include "common/ScopedGuard.h"
 #include "common/StringUtil.h"
+#include "common/Timer.h"
 #include "common/WrappedMemCopy.h"
 
+#include <bit>
 #include <list>
 #include <mutex>
 #include <thread>
@@ -32,14 +34,20 @@
 
 namespace MTGS
 {
+	// Current size of the ringbuffer in simd128's, and the mask to apply to ring buffer indices to
+	// wrap the pointer from end to start. Only changed by the EE thread while the ring is empty.
+	static uint s_RingBufferSizeFactor = DefaultRingBufferSizeFactor;
+	static uint s_RingBufferSize = 1u << DefaultRingBufferSizeFactor;
+	static uint s_RingBufferMask = (1u << DefaultRingBufferSizeFactor) - 1;
+
 	struct BufferedData
 	{
-		u128 m_Ring[RingBufferSize];
+		u128 m_Ring[MaxRingBufferSize];
 		u8 Regs[Ps2MemSize::GSregs];
 
 		u128& operator[](uint idx)
 		{
-			pxAssert(idx < RingBufferSize);
+			pxAssert(idx < s_RingBufferSize);
 			return m_Ring[idx];
 		}
 	};
@@ -48,6 +56,8 @@ namespace MTGS
 	static void MainLoop();
 
 	static void GenericStall(uint size);
+	static void UpdateRingBufferSize();
+	static void SetRingBufferSizeFactor(uint factor);
 
 	static void PrepDataPacket(Command cmd, u32 size);
 	static void PrepDataPacket(GIF_PATH pathidx, u32 size);
@@ -99,6 +109,25 @@ namespace MTGS
 	static std::atomic_bool s_shutdown_flag{false};
 	static std::atomic_bool s_run_idle_flag{false};
 	static Threading::UserspaceSemaphore s_open_or_close_done;
+
+	// Backpressure counters. Only touched by the EE thread, and published once per vsync.
+	static u32 s_ee_stalls = 0;
+	static Common::Timer::Value s_ee_stall_ticks = 0;
+	static u32 s_ee_wakeups = 0;
+	static u32 s_ee_occupancy[NumRingOccupancyBuckets] = {};
+
+	static std::atomic<u32> s_stat_stalls{0};
+	static std::atomic<u64> s_stat_stall_ticks{0};
+	static std::atomic<u32> s_stat_wakeups{0};
+	static std::atomic<u32> s_stat_occupancy[NumRingOccupancyBuckets] = {};
+
+	// Adaptive sizing: if the EE spends more than this fraction of a window waiting for space,
+	// the ring is doubled (up to MaxRingBufferSizeFactor). It never shrinks on its own.
+	static constexpr u32 ADAPTIVE_WINDOW_FRAMES = 120;
+	static constexpr float ADAPTIVE_GROW_STALL_FRACTION = 0.02f;
+	static Common::Timer::Value s_adaptive_window_start = 0;
+	static Common::Timer::Value s_adaptive_stall_ticks = 0;
+	static u32 s_adaptive_frames = 0;
 } // namespace MTGS
 
 // =====================================================================================================
@@ -232,16 +261,18 @@ void MTGS::PostVsyncStart(bool registers_written)
 	// 256-byte copy is only a few dozen cycles -- executed 60 times a second -- so probably
 	// not worth the effort or overhead of trying to selectively avoid it.
 
+	UpdateRingBufferSize();
+
 	uint packsize = sizeof(RingCmdPacket_Vsync) / 16;
 	PrepDataPacket(Command::VSync, packsize);
-	MemCopy_WrappedDest((u128*)PS2MEM_GS, RingBuffer.m_Ring, s_packet_writepos, RingBufferSize, 0xf);
+	MemCopy_WrappedDest((u128*)PS2MEM_GS, RingBuffer.m_Ring, s_packet_writepos, s_RingBufferSize, 0xf);
 
 	u32* remainder = (u32*)GetDataPacketPtr();
 	remainder[0] = GSCSRr;
 	remainder[1] = GSIMR._u32;
 	(GSRegSIGBLID&)remainder[2] = GSSIGLBLID;
 	remainder[4] = static_cast<u32>(registers_written);
-	s_packet_writepos = (s_packet_writepos + 2) & RingBufferMask;
+	s_packet_writepos = (s_packet_writepos + 2) & s_RingBufferMask;
 
 	SendDataPacket();
 
@@ -323,8 +354,10 @@ void MTGS::MainLoop()
 		}
 		else
 		{
+			// Spin for a moment before sleeping. The EE usually queues more work right after the
+			// ring drains, and while we're spinning it can hand it over without a kernel wakeup.
 			mtvu_lock.unlock();
-			s_sem_event.WaitForWork();
+			s_sem_event.WaitForWorkWithSpin();
 			mtvu_lock.lock();
 		}
 
@@ -337,7 +370,7 @@ void MTGS::MainLoop()
 		{
 			const unsigned int local_ReadPos = s_ReadPos.load(std::memory_order_relaxed);
 
-			pxAssert(local_ReadPos < RingBufferSize);
+			pxAssert(local_ReadPos < s_RingBufferSize);
 
 			const PacketTagType& tag = (PacketTagType&)RingBuffer[local_ReadPos];
 			u32 ringposinc = 1;
@@ -362,18 +395,18 @@ void MTGS::MainLoop()
 #if COPY_GS_PACKET_TO_MTGS == 1
 				case Command::GIFPath1:
 				{
-					uint datapos = (local_ReadPos + 1) & RingBufferMask;
+					uint datapos = (local_ReadPos + 1) & s_RingBufferMask;
 					const int qsize = tag.data[0];
 					const u128* data = &RingBuffer[datapos];
 
 					MTGS_LOG("(MTGS Packet Read) ringtype=P1, qwc=%u", qsize);
 
 					uint endpos = datapos + qsize;
-					if (endpos >= RingBufferSize)
+					if (endpos >= s_RingBufferSize)
 					{
-						uint firstcopylen = RingBufferSize - datapos;
+						uint firstcopylen = s_RingBufferSize - datapos;
 						GSgifTransfer((u8*)data, firstcopylen);
-						datapos = endpos & RingBufferMask;
+						datapos = endpos & s_RingBufferMask;
 						GSgifTransfer((u8*)RingBuffer.m_Ring, datapos);
 					}
 					else
@@ -387,18 +420,18 @@ void MTGS::MainLoop()
 
 				case Command::GIFPath2:
 				{
-					uint datapos = (local_ReadPos + 1) & RingBufferMask;
+					uint datapos = (local_ReadPos + 1) & s_RingBufferMask;
 					const int qsize = tag.data[0];
 					const u128* data = &RingBuffer[datapos];
 
 					MTGS_LOG("(MTGS Packet Read) ringtype=P2, qwc=%u", qsize);
 
 					uint endpos = datapos + qsize;
-					if (endpos >= RingBufferSize)
+					if (endpos >= s_RingBufferSize)
 					{
-						uint firstcopylen = RingBufferSize - datapos;
+						uint firstcopylen = s_RingBufferSize - datapos;
 						GSgifTransfer2((u32*)data, firstcopylen);
-						datapos = endpos & RingBufferMask;
+						datapos = endpos & s_RingBufferMask;
 						GSgifTransfer2((u32*)RingBuffer.m_Ring, datapos);
 					}
 					else
@@ -412,18 +445,18 @@ void MTGS::MainLoop()
 
 				case Command::GIFPath3:
 				{
-					uint datapos = (local_ReadPos + 1) & RingBufferMask;
+					uint datapos = (local_ReadPos + 1) & s_RingBufferMask;
 					const int qsize = tag.data[0];
 					const u128* data = &RingBuffer[datapos];
 
 					MTGS_LOG("(MTGS Packet Read) ringtype=P3, qwc=%u", qsize);
 
 					uint endpos = datapos + qsize;
-					if (endpos >= RingBufferSize)
+					if (endpos >= s_RingBufferSize)
 					{
-						uint firstcopylen = RingBufferSize - datapos;
+						uint firstcopylen = s_RingBufferSize - datapos;
 						GSgifTransfer3((u32*)data, firstcopylen);
-						datapos = endpos & RingBufferMask;
+						datapos = endpos & s_RingBufferMask;
 						GSgifTransfer3((u32*)RingBuffer.m_Ring, datapos);
 					}
 					else
@@ -480,8 +513,8 @@ void MTGS::MainLoop()
 							// This seemingly obtuse system is needed in order to handle cases where the vsync data wraps
 							// around the edge of the ringbuffer.  If not for that I'd just use a struct. >_<
 
-							uint datapos = (local_ReadPos + 1) & RingBufferMask;
-							MemCopy_WrappedSrc(RingBuffer.m_Ring, datapos, RingBufferSize, (u128*)RingBuffer.Regs, 0xf);
+							uint datapos = (local_ReadPos + 1) & s_RingBufferMask;
+							MemCopy_WrappedSrc(RingBuffer.m_Ring, datapos, s_RingBufferSize, (u128*)RingBuffer.Regs, 0xf);
 
 							u32* remainder = (u32*)&RingBuffer[datapos];
 							((u32&)RingBuffer.Regs[0x1000]) = remainder[0];
@@ -549,7 +582,7 @@ void MTGS::MainLoop()
 				}
 			}
 
-			uint newringpos = (s_ReadPos.load(std::memory_order_relaxed) + ringposinc) & RingBufferMask;
+			uint newringpos = (s_ReadPos.load(std::memory_order_relaxed) + ringposinc) & s_RingBufferMask;
 
 			if (EmuConfig.GS.SynchronousMTGS)
 			{
@@ -651,13 +684,13 @@ void MTGS::WaitGS(bool syncRegs, bool weakWait, bool isMTVU)
 // For use in loops that wait on the GS thread to do certain things.
 void MTGS::SetEvent()
 {
-	s_sem_event.NotifyOfWork();
+	s_ee_wakeups += static_cast<u32>(s_sem_event.NotifyOfWork());
 	s_CopyDataTally = 0;
 }
 
 u8* MTGS::GetDataPacketPtr()
 {
-	return (u8*)&RingBuffer[s_packet_writepos & RingBufferMask];
+	return (u8*)&RingBuffer[s_packet_writepos & s_RingBufferMask];
 }
 
 // Closes the data packet send command, and initiates the gs thread (if needed).
@@ -666,9 +699,9 @@ void MTGS::SendDataPacket()
 	// make sure a previous copy block has been started somewhere.
 	pxAssert(s_packet_size != 0);
 
-	uint actualSize = ((s_packet_writepos - s_packet_startpos) & RingBufferMask) - 1;
+	uint actualSize = ((s_packet_writepos - s_packet_startpos) & s_RingBufferMask) - 1;
 	pxAssert(actualSize <= s_packet_size);
-	pxAssert(s_packet_writepos < RingBufferSize);
+	pxAssert(s_packet_writepos < s_RingBufferSize);
 
 	PacketTagType& tag = (PacketTagType&)RingBuffer[s_packet_startpos];
 	tag.data[0] = actualSize;
@@ -699,8 +732,8 @@ void MTGS::GenericStall(uint size)
 	const uint writepos = s_WritePos.load(std::memory_order_relaxed);
 
 	// Sanity checks! (within the confines of our ringbuffer please!)
-	pxAssert(size < RingBufferSize);
-	pxAssert(writepos < RingBufferSize);
+	pxAssert(size < s_RingBufferSize);
+	pxAssert(writepos < s_RingBufferSize);
 
 	// generic gs wait/stall.
 	// if the writepos is past the readpos then we're safe.
@@ -713,7 +746,9 @@ void MTGS::GenericStall(uint size)
 	if (writepos < readpos)
 		freeroom = readpos - writepos;
 	else
-		freeroom = RingBufferSize - (writepos - readpos);
+		freeroom = s_RingBufferSize - (writepos - readpos);
+
+	s_ee_occupancy[((s_RingBufferSize - freeroom) * NumRingOccupancyBuckets) >> s_RingBufferSizeFactor]++;
 
 	if (freeroom <= size)
 	{
@@ -725,7 +760,10 @@ void MTGS::GenericStall(uint size)
 		// the next packet will likely stall up too.  So lets set a condition for the MTGS
 		// thread to wake up the EE once there's a sizable chunk of the ringbuffer emptied.
 
-		uint somedone = (RingBufferSize - freeroom) / 4;
+		const Common::Timer::Value stall_start = Common::Timer::GetCurrentValue();
+		s_ee_stalls++;
+
+		uint somedone = (s_RingBufferSize - freeroom) / 4;
 		if (somedone < size + 1)
 			somedone = size + 1;
 
@@ -735,29 +773,46 @@ void MTGS::GenericStall(uint size)
 
 		if (somedone > 0x80)
 		{
-			pxAssertMsg(s_SignalRingEnable == 0, "MTGS Thread Synchronization Error");
-			s_SignalRingPosition.store(somedone, std::memory_order_release);
-
-			//Console.WriteLn( Color_Blue, "(EEcore Sleep) PrepDataPacker \tringpos=0x%06x, writepos=0x%06x, signalpos=0x%06x", readpos, writepos, m_SignalRingPosition );
-
-			while (true)
+			// Most stalls only last until the GS thread gets through its current packet, so spin
+			// for a moment before paying for a semaphore round-trip in both directions.
+			SetEvent();
+			for (u32 waited = 0; waited < SPIN_TIME_NS && freeroom <= size;)
 			{
-				s_SignalRingEnable.store(true, std::memory_order_release);
-				SetEvent();
-				s_sem_OnRingReset.Wait();
+				waited += ShortSpin();
 				readpos = s_ReadPos.load(std::memory_order_acquire);
-				//Console.WriteLn( Color_Blue, "(EEcore Awake) Report!\tringpos=0x%06x", readpos );
 
 				if (writepos < readpos)
 					freeroom = readpos - writepos;
 				else
-					freeroom = RingBufferSize - (writepos - readpos);
-
-				if (freeroom > size)
-					break;
+					freeroom = s_RingBufferSize - (writepos - readpos);
 			}
 
-			pxAssertMsg(s_SignalRingPosition <= 0, "MTGS Thread Synchronization Error");
+			if (freeroom <= size)
+			{
+				pxAssertMsg(s_SignalRingEnable == 0, "MTGS Thread Synchronization Error");
+				s_SignalRingPosition.store(somedone, std::memory_order_release);
+
+				//Console.WriteLn( Color_Blue, "(EEcore Sleep) PrepDataPacker \tringpos=0x%06x, writepos=0x%06x, signalpos=0x%06x", readpos, writepos, m_SignalRingPosition );
+
+				while (true)
+				{
+					s_SignalRingEnable.store(true, std::memory_order_release);
+					SetEvent();
+					s_sem_OnRingReset.Wait();
+					readpos = s_ReadPos.load(std::memory_order_acquire);
+					//Console.WriteLn( Color_Blue, "(EEcore Awake) Report!\tringpos=0x%06x", readpos );
+
+					if (writepos < readpos)
+						freeroom = readpos - writepos;
+					else
+						freeroom = s_RingBufferSize - (writepos - readpos);
+
+					if (freeroom > size)
+						break;
+				}
+
+				pxAssertMsg(s_SignalRingPosition <= 0, "MTGS Thread Synchronization Error");
+			}
 		}
 		else
 		{
@@ -771,13 +826,87 @@ void MTGS::GenericStall(uint size)
 				if (writepos < readpos)
 					freeroom = readpos - writepos;
 				else
-					freeroom = RingBufferSize - (writepos - readpos);
+					freeroom = s_RingBufferSize - (writepos - readpos);
 
 				if (freeroom > size)
 					break;
 			}
 		}
+
+		s_ee_stall_ticks += Common::Timer::GetCurrentValue() - stall_start;
+	}
+}
+
+void MTGS::SetRingBufferSizeFactor(uint factor)
+{
+	if (factor == s_RingBufferSizeFactor)
+		return;
+
+	// The GS thread only looks at the size while it has packets to process, so draining the ring
+	// is enough to make it safe to change. Restart at the beginning, in case it is shrinking.
+	if (IsOpen())
+		WaitGS(false, false, false);
+
+	DevCon.WriteLn("MTGS: Ring buffer is now %u MB.", (static_cast<u32>(sizeof(u128)) << factor) >> 20);
+	s_RingBufferSizeFactor = factor;
+	s_RingBufferSize = 1u << factor;
+	s_RingBufferMask = s_RingBufferSize - 1;
+	s_WritePos.store(0, std::memory_order_relaxed);
+	s_ReadPos.store(0, std::memory_order_release);
+}
+
+void MTGS::UpdateRingBufferSize()
+{
+	// Publish the counters for this frame.
+	s_stat_stalls.fetch_add(std::exchange(s_ee_stalls, 0), std::memory_order_relaxed);
+	s_stat_stall_ticks.fetch_add(s_ee_stall_ticks, std::memory_order_relaxed);
+	s_stat_wakeups.fetch_add(std::exchange(s_ee_wakeups, 0), std::memory_order_relaxed);
+	for (u32 i = 0; i < NumRingOccupancyBuckets; i++)
+		s_stat_occupancy[i].fetch_add(std::exchange(s_ee_occupancy[i], 0), std::memory_order_relaxed);
+
+	s_adaptive_stall_ticks += std::exchange(s_ee_stall_ticks, 0);
+
+	if (EmuConfig.GS.MTGSRingBufferSize > 0)
+	{
+		// Fixed size, in megabytes. 1MB is 1<<16 qwords.
+		const uint factor = std::clamp(static_cast<uint>(std::bit_width(static_cast<u32>(EmuConfig.GS.MTGSRingBufferSize))) + 15,
+			MinRingBufferSizeFactor, MaxRingBufferSizeFactor);
+		SetRingBufferSizeFactor(factor);
+		s_adaptive_frames = 0;
+		return;
 	}
+
+	if (s_adaptive_frames++ == 0)
+	{
+		s_adaptive_window_start = Common::Timer::GetCurrentValue();
+		s_adaptive_stall_ticks = 0;
+		return;
+	}
+
+	if (s_adaptive_frames < ADAPTIVE_WINDOW_FRAMES)
+		return;
+
+	const Common::Timer::Value window_ticks = Common::Timer::GetCurrentValue() - s_adaptive_window_start;
+	if (s_RingBufferSizeFactor < MaxRingBufferSizeFactor &&
+		static_cast<float>(s_adaptive_stall_ticks) > static_cast<float>(window_ticks) * ADAPTIVE_GROW_STALL_FRACTION)
+	{
+		SetRingBufferSizeFactor(s_RingBufferSizeFactor + 1);
+	}
+
+	s_adaptive_frames = 0;
+}
+
+MTGS::RingStatistics MTGS::GetAndResetRingStatistics()
+{
+	RingStatistics stats;
+	stats.ring_size = (1u << s_RingBufferSizeFactor) * sizeof(u128);
+	stats.stalls = s_stat_stalls.exchange(0, std::memory_order_relaxed);
+	stats.stall_time_ns = static_cast<u64>(Common::Timer::ConvertValueToNanoseconds(s_stat_stall_ticks.exchange(0, std::memory_order_relaxed)));
+	stats.wakeups = s_stat_wakeups.exchange(0, std::memory_order_relaxed);
+	for (u32 i = 0; i < NumRingOccupancyBuckets; i++)
+		stats.occupancy[i] = s_stat_occupancy[i].exchange(0, std::memory_order_relaxed);
+
+	return stats;
 }
 
 void MTGS::PrepDataPacket(Command cmd, u32 size)
@@ -794,7 +923,7 @@ void MTGS::PrepDataPacket(Command cmd, u32 size)
 	tag.command = static_cast<u32>(cmd);
 	tag.data[0] = s_packet_size;
 	s_packet_startpos = local_WritePos;
-	s_packet_writepos = (local_WritePos + 1) & RingBufferMask;
+	s_packet_writepos = (local_WritePos + 1) & s_RingBufferMask;
 }
 
 // Returns the amount of giftag data processed (in simd128 values).
@@ -811,7 +940,7 @@ void MTGS::PrepDataPacket(GIF_PATH pathidx, u32 size)
 
 __fi void MTGS::_FinishSimplePacket()
 {
-	uint future_writepos = (s_WritePos.load(std::memory_order_relaxed) + 1) & RingBufferMask;
+	uint future_writepos = (s_WritePos.load(std::memory_order_relaxed) + 1) & s_RingBufferMask;
 	pxAssert(future_writepos != s_ReadPos.load(std::memory_order_acquire));
 	s_WritePos.store(future_writepos, std::memory_order_release);
 
@@ -1054,7 +1183,7 @@ void Gif_AddCompletedGSPacket(GS_Packet& gsPack, GIF_PATH path)
 	{
 		MTGS::PrepDataPacket(path, gsPack.size / 16);
 		MemCopy_WrappedDest((u128*)&gifUnit.gifPath[path].buffer[gsPack.offset], MTGS::RingBuffer.m_Ring,
-							MTGS::s_packet_writepos, MTGS::RingBufferSize, gsPack.size / 16);
+							MTGS::s_packet_writepos, MTGS::s_RingBufferSize, gsPack.size / 16);
 		MTGS::SendDataPacket();
 	}
 	else
@@ -82,12 +82,26 @@ namespace MTGS
 	// (actual size is 1<<m_RingBufferSizeFactor simd vectors [128-bit values])
 	// A value of 19 is a 8meg ring buffer.  18 would be 4 megs, and 20 would be 16 megs.
 	// Default was 2mb, but some games with lots of MTGS activity want 8mb to run fast (rama)
-	static const uint RingBufferSizeFactor = 19;
+	// The size in use is picked at runtime from GSOptions::MTGSRingBufferSize, or grown within
+	// these limits when the EE keeps stalling on a full ring.
+	static constexpr uint MinRingBufferSizeFactor = 18;
+	static constexpr uint DefaultRingBufferSizeFactor = 19;
+	static constexpr uint MaxRingBufferSizeFactor = 20;
 
-	// size of the ringbuffer in simd128's.
-	static const uint RingBufferSize = 1 << RingBufferSizeFactor;
+	// size of the largest ringbuffer in simd128's, which is what gets reserved.
+	static constexpr uint MaxRingBufferSize = 1 << MaxRingBufferSizeFactor;
 
-	// Mask to apply to ring buffer indices to wrap the pointer from end to
-	// start (the wrapping is what makes it a ringbuffer, yo!)
-	static const uint RingBufferMask = RingBufferSize - 1;
+	static constexpr u32 NumRingOccupancyBuckets = 8;
+
+	struct RingStatistics
+	{
+		u32 ring_size; // in bytes
+		u32 stalls; // number of packets which had to wait for space
+		u64 stall_time_ns; // time the EE spent waiting for space
+		u32 wakeups; // number of times the GS thread had to be woken up
+		u32 occupancy[NumRingOccupancyBuckets]; // fill level of the ring when packets are queued
+	};
+
+	/// Returns the counters accumulated since the previous call. Safe to call from any thread.
+	RingStatistics GetAndResetRingStatistics();
 }
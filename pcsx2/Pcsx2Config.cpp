@@ -363,6 +363,12 @@ Pcsx2Config::RecompilerOptions::RecompilerOptions()
 	EnableVU1 = true;
 	EnableFastmem = true;
 	PauseOnTLBMiss = false;
+	EnableEEBlockCache = false;
+	EnableVUProgramCache = false;
+	EnableEETiering = false;
+	EnableEESpeculativeCompile = false;
+	EnableIOPTiering = false;
+	IOPDispatcherBenchmark = false;
 
 	// vu and fpu clamping default to standard overflow.
 	vu0Overflow = true;
@@ -441,6 +447,12 @@ void Pcsx2Config::RecompilerOptions::LoadSave(SettingsWrapper& wrap)
 	SettingsWrapBitBool(EnableVU1);
 	SettingsWrapBitBool(EnableFastmem);
 	SettingsWrapBitBool(PauseOnTLBMiss);
+	SettingsWrapBitBool(EnableEEBlockCache);
+	SettingsWrapBitBool(EnableVUProgramCache);
+	SettingsWrapBitBool(EnableEETiering);
+	SettingsWrapBitBool(EnableEESpeculativeCompile);
+	SettingsWrapBitBool(EnableIOPTiering);
+	SettingsWrapBitBool(IOPDispatcherBenchmark);
 
 	SettingsWrapBitBool(vu0Overflow);
 	SettingsWrapBitBool(vu0ExtraOverflow);
@@ -618,6 +630,7 @@ Pcsx2Config::GSOptions::GSOptions()
 	DisableShaderCache = false;
 	DisableFramebufferFetch = false;
 	DisableVertexShaderExpand = false;
+	DisableHWDrawBatching = false;
 	DisableThreadedPresentation = false;
 	SkipDuplicateFrames = false;
 	OsdShowMessages = true;
@@ -637,6 +650,7 @@ Pcsx2Config::GSOptions::GSOptions()
 	HWSpinCPUForReadbacks = false;
 	GPUPaletteConversion = false;
 	AutoFlushSW = true;
+	SWTileBinning = false;
 	PreloadFrameWithGSData = false;
 	Mipmap = true;
 
@@ -674,6 +688,7 @@ bool Pcsx2Config::GSOptions::operator==(const GSOptions& right) const
 	return (
 		OpEqu(SynchronousMTGS) &&
 		OpEqu(VsyncQueueSize) &&
+		OpEqu(MTGSRingBufferSize) &&
 
 		OpEqu(FramerateNTSC) &&
 		OpEqu(FrameratePAL) &&
@@ -716,6 +731,7 @@ bool Pcsx2Config::GSOptions::OptionsAreEqual(const GSOptions& right) const
 		OpEqu(MaxAnisotropy) &&
 		OpEqu(SWExtraThreads) &&
 		OpEqu(SWExtraThreadsHeight) &&
+		OpEqu(TextureCacheBudget) &&
 		OpEqu(TriFilter) &&
 		OpEqu(TVShader) &&
 		OpEqu(GetSkipCountFunctionId) &&
@@ -793,6 +809,7 @@ void Pcsx2Config::GSOptions::LoadSave(SettingsWrapper& wrap)
 	SettingsWrapEntry(SynchronousMTGS);
 #endif
 	SettingsWrapEntry(VsyncQueueSize);
+	SettingsWrapEntry(MTGSRingBufferSize);
 
 	wrap.EnumEntry(CURRENT_SETTINGS_SECTION, "VsyncEnable", VsyncEnable, NULL, VsyncEnable);
 
@@ -832,6 +849,7 @@ void Pcsx2Config::GSOptions::LoadSave(SettingsWrapper& wrap)
 	GSSettingBool(DisableShaderCache);
 	GSSettingBool(DisableFramebufferFetch);
 	GSSettingBool(DisableVertexShaderExpand);
+	GSSettingBool(DisableHWDrawBatching);
 	GSSettingBool(DisableThreadedPresentation);
 	GSSettingBool(SkipDuplicateFrames);
 	GSSettingBool(OsdShowMessages);
@@ -850,6 +868,7 @@ void Pcsx2Config::GSOptions::LoadSave(SettingsWrapper& wrap)
 	GSSettingBool(HWSpinCPUForReadbacks);
 	GSSettingBoolEx(GPUPaletteConversion, "paltex");
 	GSSettingBoolEx(AutoFlushSW, "autoflush_sw");
+	GSSettingBool(SWTileBinning);
 	GSSettingBoolEx(PreloadFrameWithGSData, "preload_frame_with_gs_data");
 	GSSettingBoolEx(Mipmap, "mipmap");
 	GSSettingBoolEx(ManualUserHacks, "UserHacks");
@@ -911,6 +930,7 @@ void Pcsx2Config::GSOptions::LoadSave(SettingsWrapper& wrap)
 	GSSettingIntEx(MaxAnisotropy, "MaxAnisotropy");
 	GSSettingIntEx(SWExtraThreads, "extrathreads");
 	GSSettingIntEx(SWExtraThreadsHeight, "extrathreads_height");
+	GSSettingIntEx(TextureCacheBudget, "TextureCacheBudget");
 	GSSettingIntEx(TVShader, "TVShader");
 	GSSettingIntEx(SkipDrawStart, "UserHacks_SkipDraw_Start");
 	GSSettingIntEx(SkipDrawEnd, "UserHacks_SkipDraw_End");
@@ -1712,6 +1732,8 @@ void Pcsx2Config::LoadSaveCore(SettingsWrapper& wrap)
 	SettingsWrapBitBool(CdvdVerboseReads);
 	SettingsWrapBitBool(CdvdDumpBlocks);
 	SettingsWrapBitBool(CdvdShareWrite);
+	SettingsWrapBitBool(CdvdPreloadImage);
+	SettingsWrapBitBool(CdvdPreloadHugePages);
 	SettingsWrapBitBool(EnablePatches);
 	SettingsWrapBitBool(EnableCheats);
 	SettingsWrapBitBool(EnablePINE);
@@ -1728,6 +1750,16 @@ void Pcsx2Config::LoadSaveCore(SettingsWrapper& wrap)
 
 	SettingsWrapBitBool(BackupSavestate);
 	SettingsWrapBitBool(SavestateZstdCompression);
+	SettingsWrapBitBool(EnableRewind);
+	SettingsWrapEntry(RewindFrequency);
+	SettingsWrapEntry(RewindBufferSize);
+	SettingsWrapEntry(IncrementalAutosaveInterval);
+	SettingsWrapEntry(IncrementalAutosaveChainLength);
+	SettingsWrapEntry(CdvdDecompressionThreads);
+	SettingsWrapEntry(CdvdReadaheadChunks);
+	SettingsWrapEntry(CdvdPrefetchCacheSize);
+	SettingsWrapEntry(CdvdChunkCacheSize);
+	SettingsWrapEntry(CdvdPreloadMemoryLimit);
 	SettingsWrapBitBool(McdFolderAutoManage);
 
 	SettingsWrapBitBool(WarnAboutUnsafeSettings);
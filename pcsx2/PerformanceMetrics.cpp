@@ -13,6 +13,7 @@
 #include "GS/GSCapture.h"
 #include "MTGS.h"
 #include "MTVU.h"
+#include "R5900.h"
 #include "VMManager.h"
 
 static const float UPDATE_INTERVAL = 0.5f;
@@ -71,6 +72,19 @@ static float s_accumulated_gpu_time = 0.0f;
 static float s_gpu_usage = 0.0f;
 static u32 s_presents_since_last_update = 0;
 
+static u32 s_mtgs_ring_size = 0;
+static float s_mtgs_stall_time = 0.0f;
+static float s_mtgs_stalls_per_second = 0.0f;
+static float s_mtgs_wakeups_per_second = 0.0f;
+static PerformanceMetrics::MTGSOccupancyHistogram s_mtgs_occupancy = {};
+
+static_assert(PerformanceMetrics::NUM_MTGS_OCCUPANCY_BUCKETS == MTGS::NumRingOccupancyBuckets);
+
+static R5900TierStatistics s_ee_tier_stats = {};
+static R5900BlockCacheStatistics s_ee_block_cache_stats = {};
+static R5900SpeculationStatistics s_ee_speculation_stats = {};
+static Rewind::Statistics s_rewind_stats = {};
+
 void PerformanceMetrics::Clear()
 {
 	Reset();
@@ -94,6 +108,15 @@ void PerformanceMetrics::Clear()
 	s_average_gpu_time = 0.0f;
 	s_gpu_usage = 0.0f;
 
+	s_mtgs_stall_time = 0.0f;
+	s_mtgs_stalls_per_second = 0.0f;
+	s_mtgs_wakeups_per_second = 0.0f;
+	s_mtgs_occupancy.fill(0.0f);
+
+	s_ee_tier_stats = {};
+	s_ee_speculation_stats = {};
+	s_rewind_stats = {};
+
 	s_frame_number = 0;
 
 	s_frame_time_history.fill(0.0f);
@@ -124,6 +147,8 @@ void PerformanceMetrics::Reset()
 
 	for (GSSWThreadStats& stat : s_gs_sw_threads)
 		stat.last_cpu_time = stat.handle.GetCPUTime();
+
+	MTGS::GetAndResetRingStatistics();
 }
 
 void PerformanceMetrics::Update(bool gs_register_write, bool fb_blit, bool is_skipping_present)
@@ -221,6 +246,28 @@ void PerformanceMetrics::Update(bool gs_register_write, bool fb_blit, bool is_sk
 		thread.time = static_cast<double>(delta) * time_divider;
 	}
 
+	const MTGS::RingStatistics ring_stats = MTGS::GetAndResetRingStatistics();
+	u32 total_packets = 0;
+	for (u32 count : ring_stats.occupancy)
+		total_packets += count;
+	for (u32 i = 0; i < NUM_MTGS_OCCUPANCY_BUCKETS; i++)
+	{
+		s_mtgs_occupancy[i] =
+			(total_packets > 0) ? (static_cast<float>(ring_stats.occupancy[i]) / static_cast<float>(total_packets)) : 0.0f;
+	}
+	s_mtgs_ring_size = ring_stats.ring_size;
+	s_mtgs_stall_time = static_cast<float>(static_cast<double>(ring_stats.stall_time_ns) / 1000000.0 /
+										   static_cast<double>(s_frames_since_last_update));
+	s_mtgs_stalls_per_second = static_cast<float>(ring_stats.stalls) / time;
+	s_mtgs_wakeups_per_second = static_cast<float>(ring_stats.wakeups) / time;
+
+	s_ee_tier_stats = (Cpu == &recCpu) ? recGetTierStatistics() : R5900TierStatistics{};
+	s_ee_speculation_stats = (Cpu == &recCpu) ? recGetSpeculationStatistics() : R5900SpeculationStatistics{};
+	s_ee_block_cache_stats = (Cpu == &recCpu && EmuConfig.Cpu.Recompiler.EnableEEBlockCache) ?
+								 recGetBlockCacheStatistics() :
+								 R5900BlockCacheStatistics{};
+	s_rewind_stats = EmuConfig.EnableRewind ? Rewind::GetStatistics() : Rewind::Statistics{};
+
 	s_frames_since_last_update = 0;
 	s_unskipped_frames_since_last_update = 0;
 	s_presents_since_last_update = 0;
@@ -371,3 +418,87 @@ u32 PerformanceMetrics::GetFrameTimeHistoryPos()
 {
 	return s_frame_time_history_pos;
 }
+
+u32 PerformanceMetrics::GetMTGSRingBufferSize()
+{
+	return s_mtgs_ring_size;
+}
+
+float PerformanceMetrics::GetMTGSStallTime()
+{
+	return s_mtgs_stall_time;
+}
+
+float PerformanceMetrics::GetMTGSStallsPerSecond()
+{
+	return s_mtgs_stalls_per_second;
+}
+
+float PerformanceMetrics::GetMTGSWakeupsPerSecond()
+{
+	return s_mtgs_wakeups_per_second;
+}
+
+const PerformanceMetrics::MTGSOccupancyHistogram& PerformanceMetrics::GetMTGSOccupancyHistogram()
+{
+	return s_mtgs_occupancy;
+}
+
+u32 PerformanceMetrics::GetEETierUps()
+{
+	return s_ee_tier_stats.tier_ups;
+}
+
+u32 PerformanceMetrics::GetEETierBlocks(u32 tier)
+{
+	return s_ee_tier_stats.blocks[tier];
+}
+
+float PerformanceMetrics::GetEETierCompileTime(u32 tier)
+{
+	return s_ee_tier_stats.compile_ms[tier];
+}
+
+u32 PerformanceMetrics::GetEESpeculativeBlocksCompiled()
+{
+	return s_ee_speculation_stats.compiled;
+}
+
+u32 PerformanceMetrics::GetEESpeculativeBlocksEntered()
+{
+	return s_ee_speculation_stats.entered;
+}
+
+float PerformanceMetrics::GetEESpeculativeCompileTime()
+{
+	return s_ee_speculation_stats.compile_ms;
+}
+
+float PerformanceMetrics::GetEESpeculationHitRate()
+{
+	return (s_ee_speculation_stats.compiled > 0) ? (static_cast<float>(s_ee_speculation_stats.entered) * 100.0f /
+													   static_cast<float>(s_ee_speculation_stats.compiled)) :
+												   0.0f;
+}
+
+u32 PerformanceMetrics::GetEEBlockCacheReads()
+{
+	return s_ee_block_cache_stats.reads;
+}
+
+u32 PerformanceMetrics::GetEEBlockCacheReadAhead()
+{
+	return s_ee_block_cache_stats.read_ahead;
+}
+
+float PerformanceMetrics::GetEEBlockCacheReadAheadHitRate()
+{
+	return (s_ee_block_cache_stats.reads > 0) ? (static_cast<float>(s_ee_block_cache_stats.read_ahead_hits) * 100.0f /
+													static_cast<float>(s_ee_block_cache_stats.reads)) :
+												0.0f;
+}
+
+const Rewind::Statistics& PerformanceMetrics::GetRewindStatistics()
+{
+	return s_rewind_stats;
+}
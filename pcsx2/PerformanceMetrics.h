@@ -5,6 +5,7 @@
 
 #include <array>
 #include "common/Threading.h"
+#include "Rewind.h"
 
 namespace PerformanceMetrics
 {
@@ -18,6 +19,10 @@ namespace PerformanceMetrics
 	static constexpr u32 NUM_FRAME_TIME_SAMPLES = 150;
 	using FrameTimeHistory = std::array<float, NUM_FRAME_TIME_SAMPLES>;
 
+	/// Fraction of packets queued while the MTGS ring was 0-12.5%, 12.5-25%, ... full.
+	static constexpr u32 NUM_MTGS_OCCUPANCY_BUCKETS = 8;
+	using MTGSOccupancyHistogram = std::array<float, NUM_MTGS_OCCUPANCY_BUCKETS>;
+
 	void Clear();
 	void Reset();
 	void Update(bool gs_register_write, bool fb_blit, bool is_skipping_present);
@@ -58,6 +63,31 @@ namespace PerformanceMetrics
 	float GetGPUUsage();
 	float GetGPUAverageTime();
 
+	u32 GetMTGSRingBufferSize();
+	float GetMTGSStallTime();
+	float GetMTGSStallsPerSecond();
+	float GetMTGSWakeupsPerSecond();
+	const MTGSOccupancyHistogram& GetMTGSOccupancyHistogram();
+
+	/// EE recompiler tiering since it was last reset, tier is 0 or 1.
+	u32 GetEETierUps();
+	u32 GetEETierBlocks(u32 tier);
+	float GetEETierCompileTime(u32 tier);
+
+	/// EE blocks compiled speculatively, how many of them have run since, and the percentage that did.
+	u32 GetEESpeculativeBlocksCompiled();
+	u32 GetEESpeculativeBlocksEntered();
+	float GetEESpeculativeCompileTime();
+	float GetEESpeculationHitRate();
+
+	/// EE block cache reads, entries read ahead, and the percentage of reads served by read-ahead.
+	u32 GetEEBlockCacheReads();
+	u32 GetEEBlockCacheReadAhead();
+	float GetEEBlockCacheReadAheadHitRate();
+
+	/// Rewind snapshot count, memory usage and capture times, while rewind is enabled.
+	const Rewind::Statistics& GetRewindStatistics();
+
 	const FrameTimeHistory& GetFrameTimeHistory();
 	u32 GetFrameTimeHistoryPos();
 } // namespace PerformanceMetrics
@@ -281,6 +281,46 @@ extern R5900cpu *Cpu;
 extern R5900cpu intCpu;
 extern R5900cpu recCpu;
 
+// Tiered compilation in the EE recompiler, since it was last reset.
+struct R5900TierStatistics
+{
+	u32 tier_ups;
+	u32 blocks[2];
+	float compile_ms[2];
+};
+
+// Speculative compilation in the EE recompiler, since it was last reset.
+struct R5900SpeculationStatistics
+{
+	u32 queued;
+	u32 compiled;
+	u32 entered;
+	float compile_ms;
+};
+
+// Publishes the EE thread's counters for recGetTierStatistics() and recGetSpeculationStatistics(),
+// called once per vsync.
+extern void recPublishTierStatistics();
+// Safe to call from any thread, return the counters as of the last vsync.
+extern R5900TierStatistics recGetTierStatistics();
+extern R5900SpeculationStatistics recGetSpeculationStatistics();
+
+// Lets the recompiler compile queued blocks on its own thread while the EE thread waits, returns false
+// if there's nothing to do. Until recEndIdleCompile() returns, the EE thread must not run guest code or
+// touch the recompiler, since compiling uses its state.
+extern bool recBeginIdleCompile();
+extern void recEndIdleCompile();
+
+// EE block cache reads since it was opened, and how many of them had already been read ahead.
+struct R5900BlockCacheStatistics
+{
+	u32 reads;
+	u32 read_ahead;
+	u32 read_ahead_hits;
+};
+
+extern R5900BlockCacheStatistics recGetBlockCacheStatistics();
+
 enum EE_intProcessStatus
 {
 	INT_NOT_RUNNING = 0,
@@ -0,0 +1,465 @@
+// SPDX-FileCopyrightText: 2002-2024 PCSX2 Dev Team
+// SPDX-License-Identifier: LGPL-3.0+
+
+#include "Achievements.h"
+#include "Config.h"
+#include "Counters.h"
+#include "GSDumpReplayer.h"
+#include "Rewind.h"
+#include "SaveState.h"
+#include "VMManager.h"
+
+#include "common/BitUtils.h"
+#include "common/Console.h"
+#include "common/Error.h"
+#include "common/Threading.h"
+#include "common/Timer.h"
+
+#include "fmt/core.h"
+
+#include <zstd.h>
+
+#include <algorithm>
+#include <bit>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Rewind
+{
+	namespace
+	{
+		/// Snapshot, stored as the difference to the next newer snapshot.
+		struct Delta
+		{
+			u32 frame;
+			u32 data_size;
+			u32 num_pages;
+			std::vector<ArchiveEntry> entries;
+			std::vector<u64> page_mask; ///< One bit per page which differs from the newer snapshot.
+			std::vector<u8> compressed; ///< XOR of the differing pages, zstd compressed.
+
+			size_t GetMemoryUsage() const { return compressed.size() + page_mask.size() * sizeof(u64); }
+		};
+
+		/// Newest snapshot, stored uncompressed.
+		struct Head
+		{
+			u32 frame = 0;
+			u32 data_size = 0;
+			std::vector<ArchiveEntry> entries;
+			std::vector<u8> data; ///< Zero-padded to a multiple of the page size.
+		};
+	} // namespace
+
+	static constexpr u32 DELTA_PAGE_SIZE = 4096;
+	static constexpr int COMPRESSION_LEVEL = 1;
+
+	/// Captures are spread out further when they take more than this fraction of a frame,
+	/// and up to this multiple of the configured frequency.
+	static constexpr float MAX_CAPTURE_FRAME_FRACTION = 0.25f;
+	static constexpr float RELAX_CAPTURE_FRAME_FRACTION = 0.10f;
+	static constexpr u32 MAX_INTERVAL_MULTIPLIER = 8;
+
+	static void WorkerThreadEntryPoint();
+	static void WaitForWorker(std::unique_lock<std::mutex>& lock);
+	static void ProcessSnapshot(std::unique_ptr<ArchiveEntryList> list, u32 frame);
+	static void EncodeDelta(Delta* delta, const Head& older, const std::vector<u8>& newer);
+	static bool ApplyDelta(std::vector<u8>* data, const Delta& delta);
+	static void EvictOldSnapshots();
+	static void UpdateCaptureInterval(float capture_time_ms);
+
+	// Protects everything below. The worker only touches the head and deltas outside the lock
+	// while s_worker_busy is set, so the CPU thread must wait for it before using them.
+	static std::mutex s_mutex;
+	static std::condition_variable s_work_cv;
+	static std::condition_variable s_done_cv;
+	static std::thread s_worker_thread;
+	static bool s_worker_shutdown = false;
+	static bool s_worker_busy = false;
+	static std::unique_ptr<ArchiveEntryList> s_pending;
+	static u32 s_pending_frame = 0;
+
+	static Head s_head;
+	static std::deque<Delta> s_deltas;
+	static size_t s_memory_usage = 0;
+	// Storage of the previous head, so a capture doesn't have to allocate and fault in a new buffer.
+	static std::vector<u8> s_spare_buffer;
+
+	// Only used by the worker thread.
+	static ZSTD_CCtx* s_cctx = nullptr;
+	static std::vector<u8> s_encode_buffer;
+
+	// Only used by the CPU thread.
+	static u32 s_frames_since_capture = 0;
+	static u32 s_capture_interval = 0;
+	static u32 s_skipped_captures = 0;
+	static float s_last_capture_time_ms = 0.0f;
+	static float s_average_capture_time_ms = 0.0f;
+	static float s_max_capture_time_ms = 0.0f;
+} // namespace Rewind
+
+void Rewind::OnVSync()
+{
+	if (!EmuConfig.EnableRewind || GSDumpReplayer::IsReplayingDump() || Achievements::IsHardcoreModeActive())
+		return;
+
+	const u32 base_interval = std::max(EmuConfig.RewindFrequency, 1u);
+	s_capture_interval = std::clamp(s_capture_interval, base_interval, base_interval * MAX_INTERVAL_MULTIPLIER);
+	if (++s_frames_since_capture < s_capture_interval)
+		return;
+
+	s_frames_since_capture = 0;
+
+	std::vector<u8> buffer;
+	{
+		// Never stall the CPU thread on compression, drop the capture instead.
+		std::unique_lock lock(s_mutex);
+		if (s_worker_busy || s_pending)
+		{
+			s_skipped_captures++;
+			return;
+		}
+
+		buffer = std::move(s_spare_buffer);
+	}
+
+	Common::Timer timer;
+	Error error;
+	std::unique_ptr<ArchiveEntryList> list = SaveState_DownloadState(&buffer, &error);
+	if (!list)
+	{
+		Console.Error(fmt::format("Rewind: Failed to capture snapshot: {}", error.GetDescription()));
+
+		// Put the storage back, otherwise every later capture has to allocate a fresh buffer.
+		std::unique_lock lock(s_mutex);
+		if (s_spare_buffer.empty())
+			s_spare_buffer = std::move(buffer);
+		return;
+	}
+
+	UpdateCaptureInterval(static_cast<float>(timer.GetTimeMilliseconds()));
+
+	std::unique_lock lock(s_mutex);
+	s_pending = std::move(list);
+	s_pending_frame = g_FrameCount;
+	if (!s_worker_thread.joinable())
+	{
+		s_worker_shutdown = false;
+		s_worker_thread = std::thread(WorkerThreadEntryPoint);
+	}
+	s_work_cv.notify_one();
+}
+
+void Rewind::UpdateCaptureInterval(float capture_time_ms)
+{
+	s_last_capture_time_ms = capture_time_ms;
+	s_max_capture_time_ms = std::max(s_max_capture_time_ms, capture_time_ms);
+	s_average_capture_time_ms = (s_average_capture_time_ms == 0.0f) ?
+									capture_time_ms :
+									(s_average_capture_time_ms * 0.875f + capture_time_ms * 0.125f);
+
+	const float frame_rate = VMManager::GetFrameRate();
+	if (frame_rate <= 0.0f)
+		return;
+
+	const float frame_time_ms = 1000.0f / frame_rate;
+	const u32 base_interval = std::max(EmuConfig.RewindFrequency, 1u);
+	if (s_average_capture_time_ms > frame_time_ms * MAX_CAPTURE_FRAME_FRACTION &&
+		s_capture_interval < base_interval * MAX_INTERVAL_MULTIPLIER)
+	{
+		s_capture_interval *= 2;
+		DevCon.WriteLn("Rewind: Capture takes %.2f ms, reducing frequency to every %u frames.",
+			s_average_capture_time_ms, s_capture_interval);
+	}
+	else if (s_average_capture_time_ms < frame_time_ms * RELAX_CAPTURE_FRAME_FRACTION &&
+			 s_capture_interval > base_interval)
+	{
+		s_capture_interval /= 2;
+	}
+}
+
+void Rewind::WorkerThreadEntryPoint()
+{
+	Threading::SetNameOfCurrentThread("Rewind Worker");
+
+	std::unique_lock lock(s_mutex);
+	for (;;)
+	{
+		s_work_cv.wait(lock, []() { return s_worker_shutdown || s_pending; });
+		if (s_worker_shutdown)
+			break;
+
+		std::unique_ptr<ArchiveEntryList> list = std::move(s_pending);
+		const u32 frame = s_pending_frame;
+		s_worker_busy = true;
+		lock.unlock();
+
+		ProcessSnapshot(std::move(list), frame);
+
+		lock.lock();
+		s_worker_busy = false;
+		s_done_cv.notify_all();
+	}
+
+	if (s_cctx)
+	{
+		ZSTD_freeCCtx(s_cctx);
+		s_cctx = nullptr;
+	}
+	s_encode_buffer = {};
+}
+
+void Rewind::WaitForWorker(std::unique_lock<std::mutex>& lock)
+{
+	s_done_cv.wait(lock, []() { return !s_worker_busy && !s_pending; });
+}
+
+void Rewind::ProcessSnapshot(std::unique_ptr<ArchiveEntryList> list, u32 frame)
+{
+	std::vector<ArchiveEntry> entries;
+	entries.reserve(list->GetLength());
+	u32 data_size = 0;
+	for (uint i = 0; i < list->GetLength(); i++)
+	{
+		const ArchiveEntry& entry = (*list)[i];
+		entries.push_back(entry);
+		data_size = std::max(data_size, static_cast<u32>(entry.GetDataIndex() + entry.GetDataSize()));
+	}
+
+	// Pad to whole pages, so deltas can be computed a page at a time.
+	std::vector<u8> data = std::move(list->GetBuffer());
+	list.reset();
+	data.resize(Common::AlignUpPow2(data_size, DELTA_PAGE_SIZE));
+	std::memset(data.data() + data_size, 0, data.size() - data_size);
+
+	Delta delta;
+	const bool has_delta = !s_head.data.empty();
+	if (has_delta)
+		EncodeDelta(&delta, s_head, data);
+
+	std::unique_lock lock(s_mutex);
+	if (has_delta)
+	{
+		s_memory_usage += delta.GetMemoryUsage();
+		s_deltas.push_back(std::move(delta));
+	}
+
+	s_memory_usage = s_memory_usage - s_head.data.size() + data.size();
+	s_head.frame = frame;
+	s_head.data_size = data_size;
+	s_head.entries = std::move(entries);
+	s_spare_buffer = std::move(s_head.data);
+	s_head.data = std::move(data);
+
+	EvictOldSnapshots();
+}
+
+void Rewind::EncodeDelta(Delta* delta, const Head& older, const std::vector<u8>& newer)
+{
+	const size_t num_pages = std::max(older.data.size(), newer.size()) / DELTA_PAGE_SIZE;
+	delta->frame = older.frame;
+	delta->data_size = older.data_size;
+	delta->num_pages = static_cast<u32>(num_pages);
+	delta->entries = older.entries;
+	delta->page_mask.resize((num_pages + 63) / 64);
+
+	static constexpr u8 zero_page[DELTA_PAGE_SIZE] = {};
+	s_encode_buffer.clear();
+	for (size_t page = 0; page < num_pages; page++)
+	{
+		const size_t offset = page * DELTA_PAGE_SIZE;
+		const u8* old_page = (offset < older.data.size()) ? &older.data[offset] : zero_page;
+		const u8* new_page = (offset < newer.size()) ? &newer[offset] : zero_page;
+		if (std::memcmp(old_page, new_page, DELTA_PAGE_SIZE) == 0)
+			continue;
+
+		const size_t pos = s_encode_buffer.size();
+		s_encode_buffer.resize(pos + DELTA_PAGE_SIZE);
+		for (u32 i = 0; i < DELTA_PAGE_SIZE; i += sizeof(u64))
+		{
+			u64 a, b;
+			std::memcpy(&a, old_page + i, sizeof(a));
+			std::memcpy(&b, new_page + i, sizeof(b));
+			a ^= b;
+			std::memcpy(&s_encode_buffer[pos + i], &a, sizeof(a));
+		}
+
+		delta->page_mask[page / 64] |= u64(1) << (page % 64);
+	}
+
+	if (s_encode_buffer.empty())
+		return;
+
+	if (!s_cctx && !(s_cctx = ZSTD_createCCtx()))
+		pxFailRel("Failed to create zstd compression context.");
+
+	delta->compressed.resize(ZSTD_compressBound(s_encode_buffer.size()));
+	const size_t compressed_size = ZSTD_compressCCtx(s_cctx, delta->compressed.data(), delta->compressed.size(),
+		s_encode_buffer.data(), s_encode_buffer.size(), COMPRESSION_LEVEL);
+	pxAssertRel(!ZSTD_isError(compressed_size), "Rewind delta compression failed");
+	delta->compressed.resize(compressed_size);
+	delta->compressed.shrink_to_fit();
+}
+
+bool Rewind::ApplyDelta(std::vector<u8>* data, const Delta& delta)
+{
+	size_t num_dirty_pages = 0;
+	for (const u64 mask : delta.page_mask)
+		num_dirty_pages += static_cast<size_t>(std::popcount(mask));
+
+	data->resize(static_cast<size_t>(delta.num_pages) * DELTA_PAGE_SIZE, 0);
+
+	if (num_dirty_pages > 0)
+	{
+		std::vector<u8> pages(num_dirty_pages * DELTA_PAGE_SIZE);
+		const size_t decompressed_size = ZSTD_decompress(pages.data(), pages.size(), delta.compressed.data(), delta.compressed.size());
+		if (ZSTD_isError(decompressed_size) || decompressed_size != pages.size())
+			return false;
+
+		const u8* src = pages.data();
+		for (u32 page = 0; page < delta.num_pages; page++)
+		{
+			if (!(delta.page_mask[page / 64] & (u64(1) << (page % 64))))
+				continue;
+
+			u8* dst = data->data() + static_cast<size_t>(page) * DELTA_PAGE_SIZE;
+			for (u32 i = 0; i < DELTA_PAGE_SIZE; i += sizeof(u64))
+			{
+				u64 a, b;
+				std::memcpy(&a, dst + i, sizeof(a));
+				std::memcpy(&b, src + i, sizeof(b));
+				a ^= b;
+				std::memcpy(dst + i, &a, sizeof(a));
+			}
+
+			src += DELTA_PAGE_SIZE;
+		}
+	}
+
+	data->resize(Common::AlignUpPow2(delta.data_size, DELTA_PAGE_SIZE));
+	return true;
+}
+
+void Rewind::EvictOldSnapshots()
+{
+	const size_t budget = static_cast<size_t>(EmuConfig.RewindBufferSize) * static_cast<size_t>(_1mb);
+	while (s_memory_usage > budget && !s_deltas.empty())
+	{
+		s_memory_usage -= s_deltas.front().GetMemoryUsage();
+		s_deltas.pop_front();
+	}
+}
+
+void Rewind::Clear()
+{
+	std::unique_lock lock(s_mutex);
+	WaitForWorker(lock);
+
+	s_head = {};
+	s_deltas.clear();
+	s_memory_usage = 0;
+	s_frames_since_capture = 0;
+}
+
+void Rewind::Shutdown()
+{
+	{
+		std::unique_lock lock(s_mutex);
+		if (!s_worker_thread.joinable())
+			return;
+
+		WaitForWorker(lock);
+		s_worker_shutdown = true;
+		s_work_cv.notify_one();
+	}
+
+	s_worker_thread.join();
+
+	DevCon.WriteLn("Rewind: %u snapshots, %u MB, capture avg %.2f ms max %.2f ms, %u captures skipped.",
+		static_cast<u32>(s_deltas.size() + !s_head.data.empty()), static_cast<u32>(s_memory_usage / _1mb), s_average_capture_time_ms,
+		s_max_capture_time_ms, s_skipped_captures);
+
+	Clear();
+	s_spare_buffer = {};
+	s_capture_interval = 0;
+	s_skipped_captures = 0;
+	s_last_capture_time_ms = 0.0f;
+	s_average_capture_time_ms = 0.0f;
+	s_max_capture_time_ms = 0.0f;
+}
+
+bool Rewind::CanStepBack()
+{
+	std::unique_lock lock(s_mutex);
+	return (!s_head.data.empty() || s_pending);
+}
+
+bool Rewind::StepBack(u32 frames, Error* error)
+{
+	std::unique_lock lock(s_mutex);
+	WaitForWorker(lock);
+
+	if (s_head.data.empty())
+	{
+		Error::SetString(error, "No rewind snapshots are available.");
+		return false;
+	}
+
+	// Walk back from the newest snapshot, discarding everything newer than the target.
+	const u32 target_frame = (g_FrameCount > frames) ? (g_FrameCount - frames) : 0;
+	std::vector<u8> data = std::move(s_head.data);
+	s_memory_usage -= data.size();
+	while (s_head.frame > target_frame && !s_deltas.empty())
+	{
+		const Delta& delta = s_deltas.back();
+		if (!ApplyDelta(&data, delta))
+		{
+			Error::SetString(error, fmt::format("Rewind snapshot for frame {} is corrupted.", delta.frame));
+			s_head = {};
+			s_deltas.clear();
+			s_memory_usage = 0;
+			return false;
+		}
+
+		s_head.frame = delta.frame;
+		s_head.data_size = delta.data_size;
+		s_head.entries = std::move(s_deltas.back().entries);
+		s_memory_usage -= delta.GetMemoryUsage();
+		s_deltas.pop_back();
+	}
+
+	ArchiveEntryList list;
+	list.GetBuffer() = std::move(data);
+	for (const ArchiveEntry& entry : s_head.entries)
+		list.Add(entry);
+
+	const bool result = SaveState_LoadFromMemory(list, error);
+
+	// The loaded snapshot stays around as the newest, so repeated rewinds keep going back.
+	s_head.data = std::move(list.GetBuffer());
+	s_memory_usage += s_head.data.size();
+	s_frames_since_capture = 0;
+	return result;
+}
+
+Rewind::Statistics Rewind::GetStatistics()
+{
+	std::unique_lock lock(s_mutex);
+
+	Statistics stats = {};
+	stats.num_snapshots = static_cast<u32>(s_deltas.size() + !s_head.data.empty());
+	stats.oldest_frame = s_deltas.empty() ? s_head.frame : s_deltas.front().frame;
+	stats.newest_frame = s_head.frame;
+	stats.capture_interval = s_capture_interval;
+	stats.skipped_captures = s_skipped_captures;
+	stats.memory_usage = s_memory_usage;
+	stats.last_capture_time_ms = s_last_capture_time_ms;
+	stats.average_capture_time_ms = s_average_capture_time_ms;
+	stats.max_capture_time_ms = s_max_capture_time_ms;
+	return stats;
+}
@@ -0,0 +1,50 @@
+// SPDX-FileCopyrightText: 2002-2024 PCSX2 Dev Team
+// SPDX-License-Identifier: LGPL-3.0+
+
+#pragma once
+
+#include "common/Pcsx2Defs.h"
+
+class Error;
+
+/// In-memory rewind buffer.
+///
+/// A full snapshot of the machine is taken every few frames on the CPU thread. Only the newest
+/// snapshot is kept uncompressed; when a new one arrives, the previous one is replaced by a
+/// page-level XOR against its successor (zero pages are dropped, the rest compressed with zstd)
+/// on a worker thread. Since every delta only depends on newer data, the oldest entry can always
+/// be evicted when the buffer exceeds its memory budget.
+namespace Rewind
+{
+	struct Statistics
+	{
+		u32 num_snapshots;
+		u32 oldest_frame;
+		u32 newest_frame;
+		u32 capture_interval;
+		u32 skipped_captures;
+		size_t memory_usage;
+		float last_capture_time_ms;
+		float average_capture_time_ms;
+		float max_capture_time_ms;
+	};
+
+	/// Called at the end of every frame on the CPU thread. Captures a snapshot when due.
+	void OnVSync();
+
+	/// Discards all snapshots, e.g. after a reset or a state load.
+	void Clear();
+
+	/// Discards all snapshots and stops the worker thread.
+	void Shutdown();
+
+	/// Loads the newest snapshot which is at least the specified number of frames old.
+	/// Must be called on the CPU thread.
+	bool StepBack(u32 frames, Error* error);
+
+	/// Returns true if there is at least one snapshot to step back to.
+	bool CanStepBack();
+
+	/// Returns capture timings and memory usage, for the performance overlay/logging.
+	Statistics GetStatistics();
+} // namespace Rewind
@@ -26,6 +26,7 @@
 #include "USB/USB.h"
 #include "VMManager.h"
 #include "VUmicro.h"
+#include "vtlb.h"
 #include "ps2/BiosTools.h"
 #include "svnrev.h"
 
@@ -33,13 +34,22 @@
 #include "common/FileSystem.h"
 #include "common/Path.h"
 #include "common/ScopedGuard.h"
+#include "common/Threading.h"
 #include "common/StringUtil.h"
 #include "common/ZipHelpers.h"
 
 #include "fmt/core.h"
 
+#include <atomic>
+#include <condition_variable>
 #include <csetjmp>
+#include <functional>
+#include <mutex>
 #include <png.h>
+#include <span>
+#include <thread>
+#include <zlib.h>
+#include <zstd.h>
 
 using namespace R5900;
 
@@ -278,7 +288,6 @@ bool SaveStateBase::FreezeInternals()
 	return okay;
 }
 
-
 // --------------------------------------------------------------------------------------
 //  memSavingState (implementations)
 // --------------------------------------------------------------------------------------
@@ -327,6 +336,8 @@ void memLoadingState::FreezeMem( void* data, int size )
 static const char* EntryFilename_StateVersion = "PCSX2 Savestate Version.id";
 static const char* EntryFilename_Screenshot = "Screenshot.png";
 static const char* EntryFilename_InternalStructures = "PCSX2 Internal Structures.dat";
+static const char* EntryFilename_EEMemory = "eeMemory.bin";
+static const char* EntryFilename_EEMemoryPages = "eeMemory.pages";
 static constexpr u32 STATE_PCSX2_VERSION_SIZE = 32;
 
 struct SysState_Component
@@ -378,6 +389,34 @@ static bool SysState_ComponentFreezeIn(zip_file_t* zf, SysState_Component comp)
 	return true;
 }
 
+static bool SysState_ComponentFreezeInMemory(const u8* data, u32 size, SysState_Component comp)
+{
+	if (!data)
+		return true;
+
+	freezeData fP = { 0, nullptr };
+	if (comp.freeze(FreezeAction::Size, &fP) != 0)
+		fP.size = 0;
+
+	Console.WriteLn("  Loading %s", comp.name);
+
+	if (fP.size > 0 && static_cast<u32>(fP.size) != size)
+	{
+		Console.Error(fmt::format("* {}: Expected {} bytes of save data, got {}", comp.name, fP.size, size));
+		return false;
+	}
+
+	// The component only reads from the buffer when loading.
+	fP.data = const_cast<u8*>(data);
+	if (comp.freeze(FreezeAction::Load, &fP) != 0)
+	{
+		Console.Error(fmt::format("* {}: Failed to load freeze data", comp.name));
+		return false;
+	}
+
+	return true;
+}
+
 static bool SysState_ComponentFreezeOut(SaveStateBase& writer, SysState_Component comp)
 {
 	freezeData fP = {};
@@ -423,6 +462,14 @@ static bool SysState_ComponentFreezeInNew(zip_file_t* zf, const char* name, bool
 	return do_state_func(sw);
 }
 
+static bool SysState_ComponentFreezeInMemoryNew(const u8* data, u32 size, bool(*do_state_func)(StateWrapper&))
+{
+	StateWrapper::ReadOnlyMemoryStream stream(data, size);
+	StateWrapper sw(&stream, StateWrapper::Mode::Read, g_SaveVersion);
+
+	return do_state_func(sw);
+}
+
 static bool SysState_ComponentFreezeOutNew(SaveStateBase& writer, const char* name, u32 reserve, bool (*do_state_func)(StateWrapper&))
 {
 	StateWrapper::VectorMemoryStream stream(reserve);
@@ -455,8 +502,13 @@ public:
 
 	virtual const char* GetFilename() const = 0;
 	virtual bool FreezeIn(zip_file_t* zf) const = 0;
+	virtual bool FreezeInMemory(const u8* data, u32 size) const = 0;
 	virtual bool FreezeOut(SaveStateBase& writer) const = 0;
 	virtual bool IsRequired() const = 0;
+
+	/// Returns the memory a block-compressed entry of the given size can be decompressed into
+	/// directly, or nullptr if it has to go through FreezeInMemory().
+	virtual u8* GetDirectLoadPtr(u32 size) const { return nullptr; }
 };
 
 class MemorySavestateEntry : public BaseSavestateEntry
@@ -467,8 +519,10 @@ protected:
 
 public:
 	virtual bool FreezeIn(zip_file_t* zf) const;
+	virtual bool FreezeInMemory(const u8* data, u32 size) const;
 	virtual bool FreezeOut(SaveStateBase& writer) const;
 	virtual bool IsRequired() const { return true; }
+	virtual u8* GetDirectLoadPtr(u32 size) const { return (size == GetDataSize()) ? GetDataPtr() : nullptr; }
 
 protected:
 	virtual u8* GetDataPtr() const = 0;
@@ -488,6 +542,22 @@ bool MemorySavestateEntry::FreezeIn(zip_file_t* zf) const
 	return true;
 }
 
+bool MemorySavestateEntry::FreezeInMemory(const u8* data, u32 size) const
+{
+	const u32 expectedSize = GetDataSize();
+	const u32 bytesRead = std::min(expectedSize, data ? size : 0u);
+	if (bytesRead != expectedSize)
+	{
+		Console.WriteLn(Color_Yellow, " '%s' is incomplete (expected 0x%x bytes, loading only 0x%x bytes)",
+			GetFilename(), expectedSize, bytesRead);
+	}
+
+	if (bytesRead > 0)
+		std::memcpy(GetDataPtr(), data, bytesRead);
+
+	return true;
+}
+
 bool MemorySavestateEntry::FreezeOut(SaveStateBase& writer) const
 {
 	writer.FreezeMem(GetDataPtr(), GetDataSize());
@@ -508,7 +578,7 @@ class SavestateEntry_EmotionMemory final : public MemorySavestateEntry
 public:
 	~SavestateEntry_EmotionMemory() override = default;
 
-	const char* GetFilename() const override { return "eeMemory.bin"; }
+	const char* GetFilename() const override { return EntryFilename_EEMemory; }
 	u8* GetDataPtr() const override { return eeMem->Main; }
 	uint GetDataSize() const override { return sizeof(eeMem->Main); }
 
@@ -605,6 +675,7 @@ public:
 
 	const char* GetFilename() const override { return "SPU2.bin"; }
 	bool FreezeIn(zip_file_t* zf) const override { return SysState_ComponentFreezeIn(zf, SPU2_); }
+	bool FreezeInMemory(const u8* data, u32 size) const override { return SysState_ComponentFreezeInMemory(data, size, SPU2_); }
 	bool FreezeOut(SaveStateBase& writer) const override { return SysState_ComponentFreezeOut(writer, SPU2_); }
 	bool IsRequired() const override { return true; }
 };
@@ -616,6 +687,7 @@ public:
 
 	const char* GetFilename() const override { return "USB.bin"; }
 	bool FreezeIn(zip_file_t* zf) const override { return SysState_ComponentFreezeInNew(zf, "USB", &USB::DoState); }
+	bool FreezeInMemory(const u8* data, u32 size) const override { return SysState_ComponentFreezeInMemoryNew(data, size, &USB::DoState); }
 	bool FreezeOut(SaveStateBase& writer) const override { return SysState_ComponentFreezeOutNew(writer, "USB", 16 * 1024, &USB::DoState); }
 	bool IsRequired() const override { return false; }
 };
@@ -627,6 +699,7 @@ public:
 
 	const char* GetFilename() const override { return "PAD.bin"; }
 	bool FreezeIn(zip_file_t* zf) const override { return SysState_ComponentFreezeInNew(zf, "PAD", &Pad::Freeze); }
+	bool FreezeInMemory(const u8* data, u32 size) const override { return SysState_ComponentFreezeInMemoryNew(data, size, &Pad::Freeze); }
 	bool FreezeOut(SaveStateBase& writer) const override { return SysState_ComponentFreezeOutNew(writer, "PAD", 16 * 1024, &Pad::Freeze); }
 	bool IsRequired() const override { return true; }
 };
@@ -638,6 +711,7 @@ public:
 
 	const char* GetFilename() const { return "GS.bin"; }
 	bool FreezeIn(zip_file_t* zf) const { return SysState_ComponentFreezeIn(zf, GS); }
+	bool FreezeInMemory(const u8* data, u32 size) const { return SysState_ComponentFreezeInMemory(data, size, GS); }
 	bool FreezeOut(SaveStateBase& writer) const { return SysState_ComponentFreezeOut(writer, GS); }
 	bool IsRequired() const { return true; }
 };
@@ -664,6 +738,15 @@ class SaveStateEntry_Achievements final : public BaseSavestateEntry
 		return true;
 	}
 
+	bool FreezeInMemory(const u8* data, u32 size) const override
+	{
+		if (!Achievements::IsActive())
+			return true;
+
+		Achievements::LoadState(size > 0 ? data : nullptr, size);
+		return true;
+	}
+
 	bool FreezeOut(SaveStateBase& writer) const override
 	{
 		if (!Achievements::IsActive())
@@ -683,6 +766,24 @@ class SaveStateEntry_Achievements final : public BaseSavestateEntry
 	bool IsRequired() const override { return false; }
 };
 
+// Memory belonging to the caller of SaveState_UnzipMemoryEntriesFromDisk(), rather than the VM.
+class SavestateEntry_External final : public MemorySavestateEntry
+{
+public:
+	explicit SavestateEntry_External(const SaveStateMemoryEntry& entry)
+		: m_entry(entry)
+	{
+	}
+	~SavestateEntry_External() override = default;
+
+	const char* GetFilename() const override { return m_entry.name; }
+	u8* GetDataPtr() const override { return m_entry.data; }
+	uint GetDataSize() const override { return m_entry.size; }
+
+private:
+	SaveStateMemoryEntry m_entry;
+};
+
 // (cpuRegs, iopRegs, VPU/GIF/DMAC structures should all remain as part of a larger unified
 //  block, since they're all PCSX2-dependent and having separate files in the archie for them
 //  would not be useful).
@@ -705,9 +806,69 @@ static const std::unique_ptr<BaseSavestateEntry> SavestateEntries[] = {
 	std::unique_ptr<BaseSavestateEntry>(new SaveStateEntry_Achievements),
 };
 
-std::unique_ptr<ArchiveEntryList> SaveState_DownloadState(Error* error)
+// --------------------------------------------------------------------------------------
+//  Incremental EE memory
+// --------------------------------------------------------------------------------------
+// Incremental states replace eeMemory.bin with only the pages written since the previous state
+// in the chain:
+//   [page size/4] [page count/4] [dirty bitmap/(page count / 8)] [dirty pages/(dirty count * page size)]
+
+struct EEMemoryPagesHeader
+{
+	u32 page_size;
+	u32 page_count;
+};
+
+static bool FreezeOutEEMemoryPages(SaveStateBase& writer, const u64* dirty_pages)
+{
+	EEMemoryPagesHeader header = {__pagesize, Ps2MemSize::MainRam >> __pageshift};
+	writer.FreezeMem(&header, sizeof(header));
+	writer.FreezeMem(const_cast<u64*>(dirty_pages), MMAP_DIRTY_BITMAP_WORDS * sizeof(u64));
+
+	for (u32 page = 0; page < header.page_count; page++)
+	{
+		if (dirty_pages[page / 64] & (u64(1) << (page % 64)))
+			writer.FreezeMem(&eeMem->Main[page << __pageshift], __pagesize);
+	}
+
+	return writer.IsOkay();
+}
+
+static bool ApplyEEMemoryPages(const std::vector<u8>& data)
+{
+	EEMemoryPagesHeader header;
+	if (data.size() < sizeof(header))
+		return false;
+
+	std::memcpy(&header, data.data(), sizeof(header));
+	const size_t bitmap_size = MMAP_DIRTY_BITMAP_WORDS * sizeof(u64);
+	if (header.page_size != __pagesize || header.page_count != (Ps2MemSize::MainRam >> __pageshift) ||
+		data.size() < sizeof(header) + bitmap_size)
+	{
+		return false;
+	}
+
+	u64 dirty_pages[MMAP_DIRTY_BITMAP_WORDS];
+	std::memcpy(dirty_pages, data.data() + sizeof(header), bitmap_size);
+
+	size_t pos = sizeof(header) + bitmap_size;
+	for (u32 page = 0; page < header.page_count; page++)
+	{
+		if (!(dirty_pages[page / 64] & (u64(1) << (page % 64))))
+			continue;
+
+		if ((data.size() - pos) < __pagesize)
+			return false;
+
+		std::memcpy(&eeMem->Main[page << __pageshift], data.data() + pos, __pagesize);
+		pos += __pagesize;
+	}
+
+	return true;
+}
+
+static bool FreezeOutState(ArchiveEntryList* destlist, const u64* ee_dirty_pages, Error* error)
 {
-	std::unique_ptr<ArchiveEntryList> destlist = std::make_unique<ArchiveEntryList>();
 	destlist->GetBuffer().resize(1024 * 1024 * 64);
 
 	memSavingState saveme(destlist->GetBuffer());
@@ -717,13 +878,13 @@ std::unique_ptr<ArchiveEntryList> SaveState_DownloadState(Error* error)
 	if (!saveme.FreezeBios())
 	{
 		Error::SetString(error, "FreezeBios() failed");
-		return nullptr;
+		return false;
 	}
 
 	if (!saveme.FreezeInternals())
 	{
 		Error::SetString(error, "FreezeInternals() failed");
-		return nullptr;
+		return false;
 	}
 
 	internals.SetDataSize(saveme.GetCurrentPos() - internals.GetDataIndex());
@@ -732,11 +893,25 @@ std::unique_ptr<ArchiveEntryList> SaveState_DownloadState(Error* error)
 	for (const std::unique_ptr<BaseSavestateEntry>& entry : SavestateEntries)
 	{
 		uint startpos = saveme.GetCurrentPos();
+		if (ee_dirty_pages && std::strcmp(entry->GetFilename(), EntryFilename_EEMemory) == 0)
+		{
+			if (!FreezeOutEEMemoryPages(saveme, ee_dirty_pages))
+			{
+				Error::SetString(error, "Failed to save dirty EE memory pages.");
+				return false;
+			}
+
+			destlist->Add(
+				ArchiveEntry(EntryFilename_EEMemoryPages)
+					.SetDataIndex(startpos)
+					.SetDataSize(saveme.GetCurrentPos() - startpos));
+			continue;
+		}
+
 		if (!entry->FreezeOut(saveme))
 		{
 			Error::SetString(error, fmt::format("FreezeOut() failed for {}.", entry->GetFilename()));
-			destlist.reset();
-			break;
+			return false;
 		}
 
 		destlist->Add(
@@ -745,9 +920,71 @@ std::unique_ptr<ArchiveEntryList> SaveState_DownloadState(Error* error)
 				.SetDataSize(saveme.GetCurrentPos() - startpos));
 	}
 
+	return true;
+}
+
+static std::unique_ptr<ArchiveEntryList> DownloadState(const u64* ee_dirty_pages, std::vector<u8>* buffer, Error* error)
+{
+	std::unique_ptr<ArchiveEntryList> destlist = std::make_unique<ArchiveEntryList>();
+	if (buffer)
+		destlist->GetBuffer() = std::move(*buffer);
+
+	if (!FreezeOutState(destlist.get(), ee_dirty_pages, error))
+	{
+		// Hand the storage back so the caller can reuse it for the next attempt.
+		if (buffer)
+			*buffer = std::move(destlist->GetBuffer());
+		return nullptr;
+	}
+
 	return destlist;
 }
 
+std::unique_ptr<ArchiveEntryList> SaveState_DownloadState(Error* error)
+{
+	return DownloadState(nullptr, nullptr, error);
+}
+
+std::unique_ptr<ArchiveEntryList> SaveState_DownloadState(std::vector<u8>* buffer, Error* error)
+{
+	return DownloadState(nullptr, buffer, error);
+}
+
+std::unique_ptr<ArchiveEntryList> SaveState_DownloadIncrementalState(bool base, Error* error)
+{
+	if (base)
+	{
+		// Start tracking before copying memory, so nothing written afterwards can be missed.
+		if (mmap_IsDirtyTrackingEnabled())
+		{
+			u64 discarded_pages[MMAP_DIRTY_BITMAP_WORDS];
+			mmap_GetAndResetDirtyRamPages(discarded_pages);
+		}
+		else
+		{
+			mmap_SetDirtyTracking(true);
+		}
+
+		return DownloadState(nullptr, nullptr, error);
+	}
+
+	if (!mmap_IsDirtyTrackingEnabled())
+	{
+		Error::SetString(error, "No base state has been saved for this incremental state.");
+		return nullptr;
+	}
+
+	u64 dirty_pages[MMAP_DIRTY_BITMAP_WORDS];
+	mmap_GetAndResetDirtyRamPages(dirty_pages);
+	return DownloadState(dirty_pages, nullptr, error);
+}
+
+void SaveState_StopIncrementalTracking()
+{
+	if (mmap_IsDirtyTrackingEnabled())
+		mmap_SetDirtyTracking(false);
+}
+
 std::unique_ptr<SaveStateScreenshotData> SaveState_SaveScreenshot()
 {
 	static constexpr u32 SCREENSHOT_WIDTH = 640;
@@ -914,6 +1151,376 @@ static bool SaveState_ReadScreenshot(zip_t* zf, u32* out_width, u32* out_height,
 	return true;
 }
 
+// --------------------------------------------------------------------------------------
+//  Block compression
+// --------------------------------------------------------------------------------------
+// Entries larger than a block are split up and compressed as independent zstd frames on several
+// threads. The frames are handed to libzip as already-compressed data, so it only has to copy them,
+// and since a zstd stream may consist of multiple frames, older versions still load these states.
+
+static constexpr u32 COMPRESSION_BLOCK_SIZE = 1024 * 1024;
+static constexpr u32 MAX_COMPRESSION_THREADS = 8;
+
+static u32 GetCompressionThreadCount(size_t num_jobs)
+{
+	const u32 num_cpus = std::clamp(std::thread::hardware_concurrency(), 1u, MAX_COMPRESSION_THREADS);
+	return static_cast<u32>(std::min<size_t>(num_jobs, num_cpus));
+}
+
+namespace
+{
+	/// Helper threads for RunParallel(), started on first use and kept around so that saving or loading a
+	/// state doesn't have to spin up a new set of threads each time.
+	class CompressionWorkerPool
+	{
+	public:
+		~CompressionWorkerPool();
+
+		/// Runs job(index, worker) for every index in [0, num_jobs), on up to num_workers threads.
+		/// The calling thread works on the jobs too, as worker 0.
+		void Run(size_t num_jobs, u32 num_workers, const std::function<void(size_t, u32)>& job);
+
+	private:
+		void WorkerThread(u32 worker_index, u64 generation);
+		void DoJobs(u32 worker_index);
+
+		/// Only one batch runs at a time, save threads queue up behind each other.
+		std::mutex m_run_mutex;
+
+		std::mutex m_mutex;
+		std::condition_variable m_work_cv;
+		std::condition_variable m_done_cv;
+		std::vector<std::thread> m_threads;
+		const std::function<void(size_t, u32)>* m_job = nullptr;
+		size_t m_num_jobs = 0;
+		std::atomic<size_t> m_next_job{0};
+		u64 m_generation = 0;
+		u32 m_batch_workers = 0;
+		u32 m_running = 0;
+		bool m_shutdown = false;
+	};
+} // namespace
+
+static CompressionWorkerPool s_compression_pool;
+
+CompressionWorkerPool::~CompressionWorkerPool()
+{
+	{
+		std::unique_lock lock(m_mutex);
+		m_shutdown = true;
+	}
+	m_work_cv.notify_all();
+
+	for (std::thread& thread : m_threads)
+		thread.join();
+}
+
+void CompressionWorkerPool::Run(size_t num_jobs, u32 num_workers, const std::function<void(size_t, u32)>& job)
+{
+	std::unique_lock run_lock(m_run_mutex);
+
+	{
+		std::unique_lock lock(m_mutex);
+		m_job = &job;
+		m_num_jobs = num_jobs;
+		m_next_job.store(0, std::memory_order_relaxed);
+		m_generation++;
+
+		// Worker 0 is the caller, so the pool only needs the rest.
+		while (m_threads.size() + 1 < num_workers)
+			m_threads.emplace_back(&CompressionWorkerPool::WorkerThread, this, static_cast<u32>(m_threads.size() + 1), m_generation - 1);
+
+		m_batch_workers = num_workers;
+		m_running = num_workers - 1;
+	}
+	if (num_workers > 1)
+		m_work_cv.notify_all();
+
+	DoJobs(0);
+
+	std::unique_lock lock(m_mutex);
+	m_done_cv.wait(lock, [this]() { return m_running == 0; });
+	m_job = nullptr;
+}
+
+void CompressionWorkerPool::WorkerThread(u32 worker_index, u64 generation)
+{
+	Threading::SetNameOfCurrentThread("Save State Compression");
+
+	std::unique_lock lock(m_mutex);
+	for (;;)
+	{
+		m_work_cv.wait(lock, [this, generation]() { return m_shutdown || m_generation != generation; });
+		if (m_shutdown)
+			return;
+
+		generation = m_generation;
+		if (worker_index >= m_batch_workers)
+			continue;
+
+		lock.unlock();
+		DoJobs(worker_index);
+		lock.lock();
+
+		if (--m_running == 0)
+			m_done_cv.notify_one();
+	}
+}
+
+void CompressionWorkerPool::DoJobs(u32 worker_index)
+{
+	for (size_t i = m_next_job.fetch_add(1, std::memory_order_relaxed); i < m_num_jobs;
+		 i = m_next_job.fetch_add(1, std::memory_order_relaxed))
+	{
+		(*m_job)(i, worker_index);
+	}
+}
+
+/// Runs job(index, worker) for every index in [0, num_jobs), on up to num_workers threads.
+static void RunParallel(size_t num_jobs, u32 num_workers, const std::function<void(size_t, u32)>& job)
+{
+	s_compression_pool.Run(num_jobs, num_workers, job);
+}
+
+namespace
+{
+	struct PrecompressedZipSource
+	{
+		std::vector<u8> data;
+		u64 uncompressed_size = 0;
+		u32 crc = 0;
+		size_t pos = 0;
+		zip_error_t error;
+	};
+} // namespace
+
+static zip_int64_t PrecompressedZipSourceCallback(void* userdata, void* data, zip_uint64_t len, zip_source_cmd_t cmd)
+{
+	PrecompressedZipSource* src = static_cast<PrecompressedZipSource*>(userdata);
+	switch (cmd)
+	{
+		case ZIP_SOURCE_OPEN:
+			src->pos = 0;
+			return 0;
+
+		case ZIP_SOURCE_READ:
+		{
+			const size_t count = std::min(static_cast<size_t>(len), src->data.size() - src->pos);
+			std::memcpy(data, src->data.data() + src->pos, count);
+			src->pos += count;
+			return static_cast<zip_int64_t>(count);
+		}
+
+		case ZIP_SOURCE_CLOSE:
+			return 0;
+
+		case ZIP_SOURCE_STAT:
+		{
+			// Reporting the method, CRC and both sizes stops libzip from compressing the data again.
+			zip_stat_t* st = static_cast<zip_stat_t*>(data);
+			zip_stat_init(st);
+			st->valid = ZIP_STAT_SIZE | ZIP_STAT_COMP_SIZE | ZIP_STAT_COMP_METHOD | ZIP_STAT_CRC | ZIP_STAT_ENCRYPTION_METHOD;
+			st->size = src->uncompressed_size;
+			st->comp_size = src->data.size();
+			st->comp_method = ZIP_CM_ZSTD;
+			st->encryption_method = ZIP_EM_NONE;
+			st->crc = src->crc;
+			return sizeof(*st);
+		}
+
+		case ZIP_SOURCE_ERROR:
+			return zip_error_to_data(&src->error, data, len);
+
+		case ZIP_SOURCE_FREE:
+			zip_error_fini(&src->error);
+			delete src;
+			return 0;
+
+		case ZIP_SOURCE_SUPPORTS:
+			return zip_source_make_command_bitmap(ZIP_SOURCE_OPEN, ZIP_SOURCE_READ, ZIP_SOURCE_CLOSE, ZIP_SOURCE_STAT,
+				ZIP_SOURCE_ERROR, ZIP_SOURCE_FREE, -1);
+
+		default:
+			zip_error_set(&src->error, ZIP_ER_OPNOTSUPP, 0);
+			return -1;
+	}
+}
+
+static std::vector<std::unique_ptr<PrecompressedZipSource>> CompressLargeEntries(const ArchiveEntryList& srclist)
+{
+	struct Block
+	{
+		u32 entry;
+		const u8* src;
+		u32 size;
+		std::vector<u8> dst;
+		uLong crc;
+		bool okay;
+	};
+
+	std::vector<Block> blocks;
+	for (uint i = 0; i < srclist.GetLength(); i++)
+	{
+		const ArchiveEntry& entry = srclist[i];
+		if (entry.GetDataSize() <= COMPRESSION_BLOCK_SIZE)
+			continue;
+
+		const u8* src = srclist.GetPtr(entry.GetDataIndex());
+		for (u32 offset = 0; offset < entry.GetDataSize(); offset += COMPRESSION_BLOCK_SIZE)
+			blocks.push_back(Block{i, src + offset, std::min(entry.GetDataSize() - offset, COMPRESSION_BLOCK_SIZE), {}, 0, false});
+	}
+
+	std::vector<std::unique_ptr<PrecompressedZipSource>> ret(srclist.GetLength());
+	if (blocks.empty())
+		return ret;
+
+	const u32 num_workers = GetCompressionThreadCount(blocks.size());
+	std::vector<ZSTD_CCtx*> contexts(num_workers);
+	RunParallel(blocks.size(), num_workers, [&blocks, &contexts](size_t index, u32 worker) {
+		Block& block = blocks[index];
+		ZSTD_CCtx*& cctx = contexts[worker];
+		if (!cctx)
+		{
+			if (!(cctx = ZSTD_createCCtx()))
+				return;
+
+			ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, ZSTD_CLEVEL_DEFAULT);
+			ZSTD_CCtx_setParameter(cctx, ZSTD_c_checksumFlag, 1);
+		}
+
+		block.dst.resize(ZSTD_compressBound(block.size));
+		const size_t size = ZSTD_compress2(cctx, block.dst.data(), block.dst.size(), block.src, block.size);
+		if (ZSTD_isError(size))
+			return;
+
+		block.dst.resize(size);
+		block.crc = crc32(0, block.src, block.size);
+		block.okay = true;
+	});
+
+	for (ZSTD_CCtx* cctx : contexts)
+		ZSTD_freeCCtx(cctx);
+
+	// Stitch the frames back together. Entries with a failed block fall back to libzip compression.
+	for (size_t first = 0; first < blocks.size();)
+	{
+		const u32 entry = blocks[first].entry;
+		size_t last = first;
+		size_t compressed_size = 0;
+		bool okay = true;
+		for (; last < blocks.size() && blocks[last].entry == entry; last++)
+		{
+			compressed_size += blocks[last].dst.size();
+			okay &= blocks[last].okay;
+		}
+
+		if (okay)
+		{
+			std::unique_ptr<PrecompressedZipSource> src = std::make_unique<PrecompressedZipSource>();
+			src->data.reserve(compressed_size);
+			uLong crc = crc32(0, nullptr, 0);
+			for (size_t i = first; i < last; i++)
+			{
+				src->data.insert(src->data.end(), blocks[i].dst.begin(), blocks[i].dst.end());
+				crc = crc32_combine(crc, blocks[i].crc, blocks[i].size);
+			}
+
+			src->uncompressed_size = srclist[entry].GetDataSize();
+			src->crc = static_cast<u32>(crc);
+			zip_error_init(&src->error);
+			ret[entry] = std::move(src);
+		}
+
+		first = last;
+	}
+
+	return ret;
+}
+
+namespace
+{
+	struct BlockCompressedEntry
+	{
+		struct Frame
+		{
+			size_t src_offset;
+			size_t src_size;
+			size_t dst_offset;
+			size_t dst_size;
+		};
+
+		std::vector<u8> data;
+		std::vector<Frame> frames;
+		u32 size = 0;
+	};
+} // namespace
+
+/// Reads the raw frames of an entry which was written by CompressLargeEntries(). Returns false for
+/// entries which aren't split into frames (i.e. from older versions), those are read through libzip.
+static bool ReadBlockCompressedEntry(zip_t* zf, s64 index, BlockCompressedEntry* entry)
+{
+	zip_stat_t st;
+	if (index < 0 || zip_stat_index(zf, index, 0, &st) != 0 ||
+		(st.valid & (ZIP_STAT_COMP_METHOD | ZIP_STAT_SIZE | ZIP_STAT_COMP_SIZE)) !=
+			(ZIP_STAT_COMP_METHOD | ZIP_STAT_SIZE | ZIP_STAT_COMP_SIZE) ||
+		st.comp_method != ZIP_CM_ZSTD || st.size <= COMPRESSION_BLOCK_SIZE || st.size > std::numeric_limits<u32>::max())
+	{
+		return false;
+	}
+
+	auto zff = zip_fopen_index_managed(zf, index, ZIP_FL_COMPRESSED);
+	entry->data.resize(st.comp_size);
+	if (!zff || zip_fread(zff.get(), entry->data.data(), st.comp_size) != static_cast<zip_int64_t>(st.comp_size))
+		return false;
+
+	entry->frames.clear();
+	size_t offset = 0;
+	size_t total_size = 0;
+	while (offset < entry->data.size())
+	{
+		const u8* src = entry->data.data() + offset;
+		const size_t remaining = entry->data.size() - offset;
+		const size_t frame_size = ZSTD_findFrameCompressedSize(src, remaining);
+		const unsigned long long content_size = ZSTD_getFrameContentSize(src, remaining);
+		if (ZSTD_isError(frame_size) || content_size == ZSTD_CONTENTSIZE_UNKNOWN || content_size == ZSTD_CONTENTSIZE_ERROR)
+			return false;
+
+		entry->frames.push_back({offset, frame_size, total_size, static_cast<size_t>(content_size)});
+		total_size += static_cast<size_t>(content_size);
+		offset += frame_size;
+	}
+
+	entry->size = static_cast<u32>(st.size);
+	return (total_size == st.size && entry->frames.size() >= 2);
+}
+
+/// Decompresses the frames of an entry in parallel, straight into dst, which must hold entry.size bytes.
+static bool DecompressBlockCompressedEntry(const BlockCompressedEntry& entry, u8* dst)
+{
+	const u32 num_workers = GetCompressionThreadCount(entry.frames.size());
+	std::vector<ZSTD_DCtx*> contexts(num_workers);
+	std::atomic_bool okay{true};
+	RunParallel(entry.frames.size(), num_workers, [&entry, &contexts, &okay, dst](size_t index, u32 worker) {
+		const BlockCompressedEntry::Frame& frame = entry.frames[index];
+		ZSTD_DCtx*& dctx = contexts[worker];
+		if (!dctx && !(dctx = ZSTD_createDCtx()))
+		{
+			okay.store(false, std::memory_order_relaxed);
+			return;
+		}
+
+		const size_t size = ZSTD_decompressDCtx(dctx, dst + frame.dst_offset, frame.dst_size,
+			entry.data.data() + frame.src_offset, frame.src_size);
+		if (ZSTD_isError(size) || size != frame.dst_size)
+			okay.store(false, std::memory_order_relaxed);
+	});
+
+	for (ZSTD_DCtx* dctx : contexts)
+		ZSTD_freeDCtx(dctx);
+
+	return okay.load(std::memory_order_relaxed);
+}
+
 // --------------------------------------------------------------------------------------
 //  CompressThread_VmState
 // --------------------------------------------------------------------------------------
@@ -958,16 +1565,27 @@ static bool SaveState_AddToZip(zip_t* zf, ArchiveEntryList* srclist, SaveStateSc
 	}
 
 	const uint listlen = srclist->GetLength();
+	std::vector<std::unique_ptr<PrecompressedZipSource>> precompressed;
+	if (compression == ZIP_CM_ZSTD)
+		precompressed = CompressLargeEntries(*srclist);
+
 	for (uint i = 0; i < listlen; ++i)
 	{
 		const ArchiveEntry& entry = (*srclist)[i];
 		if (!entry.GetDataSize())
 			continue;
 
-		zip_source_t* const zs = zip_source_buffer(zf, srclist->GetPtr(entry.GetDataIndex()), entry.GetDataSize(), 0);
+		const bool is_precompressed = (!precompressed.empty() && precompressed[i]);
+		zip_source_t* const zs = is_precompressed ?
+									 zip_source_function(zf, PrecompressedZipSourceCallback, precompressed[i].get()) :
+									 zip_source_buffer(zf, srclist->GetPtr(entry.GetDataIndex()), entry.GetDataSize(), 0);
 		if (!zs)
 			return false;
 
+		// Source now owns the compressed data.
+		if (is_precompressed)
+			precompressed[i].release();
+
 		const s64 fi = zip_file_add(zf, entry.GetFilename().c_str(), zs, ZIP_FL_ENC_UTF_8);
 		if (fi < 0)
 		{
@@ -975,7 +1593,8 @@ static bool SaveState_AddToZip(zip_t* zf, ArchiveEntryList* srclist, SaveStateSc
 			return false;
 		}
 
-		zip_set_file_compression(zf, fi, compression, compression_level);
+		if (!is_precompressed)
+			zip_set_file_compression(zf, fi, compression, compression_level);
 	}
 
 	if (screenshot)
@@ -1102,7 +1721,76 @@ static bool LoadInternalStructuresState(zip_t* zf, s64 index)
 	return true;
 }
 
-bool SaveState_UnzipFromDisk(const std::string& filename, Error* error)
+static bool LoadIncrementalEEMemory(const BaseSavestateEntry& entry, std::span<const std::string> chain,
+	zip_t* newest_zf, s64 newest_index, Error* error)
+{
+	// The first state in the chain holds all of EE memory, every later state the pages written since.
+	for (size_t i = 0; i < chain.size(); i++)
+	{
+		zip_error_t ze = {};
+		auto zf = zip_open_managed(chain[i].c_str(), ZIP_RDONLY, &ze);
+		if (!zf)
+		{
+			Error::SetString(error, fmt::format("Failed to open {}: {}", Path::GetFileName(chain[i]), zip_error_strerror(&ze)));
+			return false;
+		}
+
+		if (!CheckVersion(chain[i], zf.get(), error))
+			return false;
+
+		bool result;
+		if (i == 0)
+		{
+			auto zff = zip_fopen_managed(zf.get(), entry.GetFilename(), 0);
+			result = (zff && entry.FreezeIn(zff.get()));
+		}
+		else
+		{
+			const std::optional<std::vector<u8>> data = ReadBinaryFileInZip(zf.get(), EntryFilename_EEMemoryPages);
+			result = (data.has_value() && ApplyEEMemoryPages(data.value()));
+		}
+
+		if (!result)
+		{
+			Error::SetString(error, fmt::format("Save state corruption in EE memory of {}.", Path::GetFileName(chain[i])));
+			return false;
+		}
+	}
+
+	auto zff = zip_fopen_index_managed(newest_zf, newest_index, 0);
+	const std::optional<std::vector<u8>> data = zff ? ReadBinaryFileInZip(zff.get()) : std::nullopt;
+	if (!data.has_value() || !ApplyEEMemoryPages(data.value()))
+	{
+		Error::SetString(error, "Save state corruption in EE memory pages.");
+		return false;
+	}
+
+	return true;
+}
+
+/// Loads a regular (not incremental) entry. Guest memory is decompressed in place, everything else
+/// needs a staging buffer for its freeze function.
+static bool LoadEntry(zip_t* zf, s64 index, const BaseSavestateEntry& entry, BlockCompressedEntry* block_entry,
+	std::vector<u8>* staging)
+{
+	if (ReadBlockCompressedEntry(zf, index, block_entry))
+	{
+		u8* dst = entry.GetDirectLoadPtr(block_entry->size);
+		const bool staged = !dst;
+		if (staged)
+		{
+			staging->resize(block_entry->size);
+			dst = staging->data();
+		}
+
+		return (DecompressBlockCompressedEntry(*block_entry, dst) && (!staged || entry.FreezeInMemory(dst, block_entry->size)));
+	}
+
+	auto zff = zip_fopen_index_managed(zf, index, 0);
+	return (zff && entry.FreezeIn(zff.get()));
+}
+
+static bool UnzipFromDisk(const std::string& filename, std::span<const std::string> chain, Error* error)
 {
 	zip_error_t ze = {};
 	auto zf = zip_open_managed(filename.c_str(), ZIP_RDONLY, &ze);
@@ -1125,12 +1813,21 @@ bool SaveState_UnzipFromDisk(const std::string& filename, Error* error)
 	const s64 internal_index = CheckFileExistsInState(zf.get(), EntryFilename_InternalStructures, true);
 	s64 entryIndices[std::size(SavestateEntries)];
 
+	// Incremental states carry dirty EE memory pages instead of the full memory.
+	const s64 ee_pages_index = zip_name_locate(zf.get(), EntryFilename_EEMemoryPages, 0);
+	if (ee_pages_index >= 0 && chain.empty())
+	{
+		Error::SetString(error, "This is an incremental save state, and can only be loaded along with its base state.");
+		return false;
+	}
+
 	// Log any parts and pieces that are missing, and then generate an exception.
 	bool allPresent = (internal_index >= 0);
 	for (u32 i = 0; i < std::size(SavestateEntries); i++)
 	{
-		const bool required = SavestateEntries[i]->IsRequired();
-		entryIndices[i] = CheckFileExistsInState(zf.get(), SavestateEntries[i]->GetFilename(), required);
+		const bool incremental = (ee_pages_index >= 0 && std::strcmp(SavestateEntries[i]->GetFilename(), EntryFilename_EEMemory) == 0);
+		const bool required = SavestateEntries[i]->IsRequired() && !incremental;
+		entryIndices[i] = incremental ? ee_pages_index : CheckFileExistsInState(zf.get(), SavestateEntries[i]->GetFilename(), required);
 		if (entryIndices[i] < 0 && required)
 		{
 			allPresent = false;
@@ -1151,6 +1848,8 @@ bool SaveState_UnzipFromDisk(const std::string& filename, Error* error)
 		return false;
 	}
 
+	BlockCompressedEntry block_entry;
+	std::vector<u8> entry_data;
 	for (u32 i = 0; i < std::size(SavestateEntries); ++i)
 	{
 		if (entryIndices[i] < 0)
@@ -1159,8 +1858,123 @@ bool SaveState_UnzipFromDisk(const std::string& filename, Error* error)
 			continue;
 		}
 
-		auto zff = zip_fopen_index_managed(zf.get(), entryIndices[i], 0);
-		if (!zff || !SavestateEntries[i]->FreezeIn(zff.get()))
+		if (entryIndices[i] == ee_pages_index)
+		{
+			if (!LoadIncrementalEEMemory(*SavestateEntries[i], chain, zf.get(), ee_pages_index, error))
+				return false;
+
+			continue;
+		}
+
+		if (!LoadEntry(zf.get(), entryIndices[i], *SavestateEntries[i], &block_entry, &entry_data))
+		{
+			Error::SetString(error, fmt::format("Save state corruption in {}.", SavestateEntries[i]->GetFilename()));
+			return false;
+		}
+	}
+
+	PostLoadPrep();
+	return true;
+}
+
+bool SaveState_UnzipFromDisk(const std::string& filename, Error* error)
+{
+	return UnzipFromDisk(filename, {}, error);
+}
+
+bool SaveState_UnzipMemoryEntriesFromDisk(const std::string& filename, std::span<const SaveStateMemoryEntry> entries, Error* error)
+{
+	zip_error_t ze = {};
+	auto zf = zip_open_managed(filename.c_str(), ZIP_RDONLY, &ze);
+	if (!zf)
+	{
+		Error::SetString(error, fmt::format("Savestate zip error: {}", zip_error_strerror(&ze)));
+		return false;
+	}
+
+	if (!CheckVersion(filename, zf.get(), error))
+		return false;
+
+	BlockCompressedEntry block_entry;
+	std::vector<u8> entry_data;
+	for (const SaveStateMemoryEntry& entry : entries)
+	{
+		const s64 index = CheckFileExistsInState(zf.get(), entry.name, true);
+		if (index < 0)
+		{
+			Error::SetString(error, fmt::format("{} not found in save state.", entry.name));
+			return false;
+		}
+
+		if (!LoadEntry(zf.get(), index, SavestateEntry_External(entry), &block_entry, &entry_data))
+		{
+			Error::SetString(error, fmt::format("Save state corruption in {}.", entry.name));
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool SaveState_UnzipChainFromDisk(const std::vector<std::string>& filenames, Error* error)
+{
+	if (filenames.empty())
+	{
+		Error::SetString(error, "No save states to load.");
+		return false;
+	}
+
+	return UnzipFromDisk(filenames.back(), std::span<const std::string>(filenames.data(), filenames.size() - 1), error);
+}
+
+bool SaveState_LoadFromMemory(const ArchiveEntryList& srclist, Error* error)
+{
+	// Entries are matched by name, so the list doesn't have to come from this exact build of
+	// SaveState_DownloadState(). Internal structures are always at the start of the buffer.
+	const ArchiveEntry* internals = nullptr;
+	const ArchiveEntry* entries[std::size(SavestateEntries)] = {};
+	for (uint i = 0; i < srclist.GetLength(); i++)
+	{
+		const ArchiveEntry& entry = srclist[i];
+		if (entry.GetFilename() == EntryFilename_InternalStructures)
+		{
+			internals = &entry;
+			continue;
+		}
+
+		for (u32 j = 0; j < std::size(SavestateEntries); j++)
+		{
+			if (entry.GetFilename() == SavestateEntries[j]->GetFilename())
+			{
+				entries[j] = &entry;
+				break;
+			}
+		}
+	}
+
+	bool allPresent = (internals && internals->GetDataIndex() == 0);
+	for (u32 i = 0; i < std::size(SavestateEntries) && allPresent; i++)
+		allPresent = (entries[i] || !SavestateEntries[i]->IsRequired());
+	if (!allPresent)
+	{
+		Error::SetString(error, "Some required components were not found or are incomplete.");
+		return false;
+	}
+
+	PreLoadPrep();
+
+	memLoadingState state(srclist.GetBuffer());
+	if (!state.FreezeBios() || !state.FreezeInternals())
+	{
+		Error::SetString(error, "Save state corruption in internal structures.");
+		return false;
+	}
+
+	for (u32 i = 0; i < std::size(SavestateEntries); ++i)
+	{
+		const u32 size = entries[i] ? entries[i]->GetDataSize() : 0;
+		const u8* data = (size > 0) ? srclist.GetPtr(entries[i]->GetDataIndex()) : nullptr;
+		if (!SavestateEntries[i]->FreezeInMemory(data, size))
 		{
 			Error::SetString(error, fmt::format("Save state corruption in {}.", SavestateEntries[i]->GetFilename()));
 			return false;
@@ -5,6 +5,7 @@
 
 #include <deque>
 #include <memory>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -52,11 +53,34 @@ class ArchiveEntryList;
 // Wrappers to generate a save state compatible across all frontends.
 // These functions assume that the caller has paused the core thread.
 extern std::unique_ptr<ArchiveEntryList> SaveState_DownloadState(Error* error);
+/// Same as above, but writes into the storage of `buffer` instead of allocating a new one.
+/// The storage is taken on success, and left in `buffer` if the download fails.
+extern std::unique_ptr<ArchiveEntryList> SaveState_DownloadState(std::vector<u8>* buffer, Error* error);
 extern std::unique_ptr<SaveStateScreenshotData> SaveState_SaveScreenshot();
 extern bool SaveState_ZipToDisk(std::unique_ptr<ArchiveEntryList> srclist, std::unique_ptr<SaveStateScreenshotData> screenshot, const char* filename);
 extern bool SaveState_ReadScreenshot(const std::string& filename, u32* out_width, u32* out_height, std::vector<u32>* out_pixels);
 extern bool SaveState_UnzipFromDisk(const std::string& filename, Error* error);
 
+/// Incremental states only store the EE memory pages written since the previous state, the first
+/// state after a base is requested is a full one. Loading requires the whole chain, oldest first.
+extern std::unique_ptr<ArchiveEntryList> SaveState_DownloadIncrementalState(bool base, Error* error);
+extern bool SaveState_UnzipChainFromDisk(const std::vector<std::string>& filenames, Error* error);
+extern void SaveState_StopIncrementalTracking();
+extern bool SaveState_LoadFromMemory(const ArchiveEntryList& srclist, Error* error);
+
+/// Memory outside of the VM to load a save state entry into, see SaveState_UnzipMemoryEntriesFromDisk().
+struct SaveStateMemoryEntry
+{
+	const char* name;
+	u8* data;
+	u32 size;
+};
+
+/// Loads the given entries of a save state on disk into caller-owned memory, through the same path
+/// SaveState_UnzipFromDisk() loads guest memory with, but without needing a VM. Block-compressed
+/// entries of the right size are decompressed in place, everything else goes through a buffer.
+extern bool SaveState_UnzipMemoryEntriesFromDisk(const std::string& filename, std::span<const SaveStateMemoryEntry> entries, Error* error);
+
 // --------------------------------------------------------------------------------------
 //  SaveStateBase class
 // --------------------------------------------------------------------------------------
@@ -31,6 +31,7 @@
 #include "R5900.h"
 #include "Recording/InputRecording.h"
 #include "Recording/InputRecordingControls.h"
+#include "Rewind.h"
 #include "SIO/Memcard/MemoryCardFile.h"
 #include "SIO/Pad/Pad.h"
 #include "SIO/Sio.h"
@@ -117,12 +118,15 @@ namespace VMManager
 	static std::string GetCurrentSaveStateFileName(s32 slot);
 	static bool DoLoadState(const char* filename);
 	static bool DoSaveState(const char* filename, s32 slot_for_message, bool zip_on_thread, bool backup_old_state);
-	static void ZipSaveState(std::unique_ptr<ArchiveEntryList> elist,
+	static bool ZipSaveState(std::unique_ptr<ArchiveEntryList> elist,
 		std::unique_ptr<SaveStateScreenshotData> screenshot, std::string osd_key, const char* filename,
-		s32 slot_for_message);
+		s32 slot_for_message, Common::Timer::Value start_time);
 	static void ZipSaveStateOnThread(std::unique_ptr<ArchiveEntryList> elist,
 		std::unique_ptr<SaveStateScreenshotData> screenshot, std::string osd_key, std::string filename,
-		s32 slot_for_message);
+		s32 slot_for_message, Common::Timer::Value start_time);
+	static std::string GetAutosaveFileName(s32 index);
+	static void PollIncrementalAutosave();
+	static bool DoIncrementalAutosave();
 
 	static void LoadSettings();
 	static void LoadCoreSettings(SettingsInterface* si);
@@ -163,6 +167,13 @@ static Threading::ThreadHandle s_vm_thread_handle;
 static std::deque<std::thread> s_save_state_threads;
 static std::mutex s_save_state_threads_mutex;
 
+// Index of the last state written to the current incremental autosave chain, -1 if there is none.
+static s32 s_autosave_index = -1;
+static Common::Timer s_autosave_timer;
+
+// Set by the save thread when writing an autosave fails, so the next one starts a new chain from a full base.
+static std::atomic_bool s_autosave_write_failed{false};
+
 static std::recursive_mutex s_info_mutex;
 static std::string s_disc_serial;
 static std::string s_disc_elf;
@@ -1522,6 +1533,10 @@ void VMManager::Shutdown(bool save_resume_state)
 	if (g_InputRecording.isActive())
 		g_InputRecording.stop();
 
+	Rewind::Shutdown();
+	SaveState_StopIncrementalTracking();
+	s_autosave_index = -1;
+
 	SaveSessionTime(s_disc_serial);
 	s_elf_override = {};
 	ClearELFInfo();
@@ -1621,6 +1636,8 @@ void VMManager::Reset()
 	SysMemory::Reset();
 	cpuReset();
 	hwReset();
+	Rewind::Clear();
+	s_autosave_index = -1;
 
 	if (g_InputRecording.isActive())
 	{
@@ -1732,6 +1749,9 @@ bool VMManager::DoLoadState(const char* filename)
 		MTGS::PresentCurrentFrame();
 	}
 
+	// Snapshots from before the load would rewind into a different timeline.
+	Rewind::Clear();
+	s_autosave_index = -1;
 	return true;
 }
 
@@ -1741,6 +1761,7 @@ bool VMManager::DoSaveState(const char* filename, s32 slot_for_message, bool zip
 		return false;
 
 	std::string osd_key(fmt::format("SaveStateSlot{}", slot_for_message));
+	const Common::Timer::Value start_time = Common::Timer::GetCurrentValue();
 	Error error;
 
 	std::unique_ptr<ArchiveEntryList> elist = SaveState_DownloadState(&error);
@@ -1772,29 +1793,33 @@ bool VMManager::DoSaveState(const char* filename, s32 slot_for_message, bool zip
 		// lock order here is important; the thread could exit before we resume here.
 		std::unique_lock lock(s_save_state_threads_mutex);
 		s_save_state_threads.emplace_back(&VMManager::ZipSaveStateOnThread, std::move(elist), std::move(screenshot),
-			std::move(osd_key), std::string(filename), slot_for_message);
+			std::move(osd_key), std::string(filename), slot_for_message, start_time);
 	}
 	else
 	{
-		ZipSaveState(std::move(elist), std::move(screenshot), std::move(osd_key), filename, slot_for_message);
+		ZipSaveState(std::move(elist), std::move(screenshot), std::move(osd_key), filename, slot_for_message, start_time);
 	}
 
 	Host::OnSaveStateSaved(filename);
 	return true;
 }
 
-void VMManager::ZipSaveState(std::unique_ptr<ArchiveEntryList> elist,
+bool VMManager::ZipSaveState(std::unique_ptr<ArchiveEntryList> elist,
 	std::unique_ptr<SaveStateScreenshotData> screenshot, std::string osd_key, const char* filename,
-	s32 slot_for_message)
+	s32 slot_for_message, Common::Timer::Value start_time)
 {
 	Common::Timer timer;
 
-	if (SaveState_ZipToDisk(std::move(elist), std::move(screenshot), filename))
+	const bool result = SaveState_ZipToDisk(std::move(elist), std::move(screenshot), filename);
+	if (result)
 	{
 		if (slot_for_message >= 0 && VMManager::HasValidVM())
 		{
+			const double total_time_ms =
+				Common::Timer::ConvertValueToMilliseconds(Common::Timer::GetCurrentValue() - start_time);
 			Host::AddIconOSDMessage(std::move(osd_key), ICON_FA_SAVE,
-				fmt::format(TRANSLATE_FS("VMManager", "State saved to slot {}."), slot_for_message),
+				fmt::format(TRANSLATE_FS("VMManager", "State saved to slot {} ({:.0f} ms)."), slot_for_message,
+					total_time_ms),
 				Host::OSD_QUICK_DURATION);
 		}
 	}
@@ -1806,13 +1831,21 @@ void VMManager::ZipSaveState(std::unique_ptr<ArchiveEntryList> elist,
 	}
 
 	DevCon.WriteLn("Zipping save state to '%s' took %.2f ms", filename, timer.GetTimeMilliseconds());
+	return result;
 }
 
 void VMManager::ZipSaveStateOnThread(std::unique_ptr<ArchiveEntryList> elist,
 	std::unique_ptr<SaveStateScreenshotData> screenshot, std::string osd_key, std::string filename,
-	s32 slot_for_message)
+	s32 slot_for_message, Common::Timer::Value start_time)
 {
-	ZipSaveState(std::move(elist), std::move(screenshot), std::move(osd_key), filename.c_str(), slot_for_message);
+	// A missing delta would break the chain for every state queued after it.
+	const bool is_autosave = (osd_key == "IncrementalAutosave");
+	if (!ZipSaveState(std::move(elist), std::move(screenshot), std::move(osd_key), filename.c_str(),
+			slot_for_message, start_time) &&
+		is_autosave)
+	{
+		s_autosave_write_failed.store(true, std::memory_order_release);
+	}
 
 	// remove ourselves from the thread list. if we're joining, we might not be in there.
 	const auto this_id = std::this_thread::get_id();
@@ -1924,7 +1957,207 @@ bool VMManager::LoadStateFromSlot(s32 slot)
 
 	Host::AddIconOSDMessage("LoadStateFromSlot", ICON_FA_FOLDER_OPEN,
 		fmt::format(TRANSLATE_FS("VMManager", "Loading state from slot {}..."), slot), Host::OSD_QUICK_DURATION);
-	return DoLoadState(filename.c_str());
+
+	Common::Timer timer;
+	if (!DoLoadState(filename.c_str()))
+		return false;
+
+	Host::AddIconOSDMessage("LoadStateFromSlot", ICON_FA_FOLDER_OPEN,
+		fmt::format(TRANSLATE_FS("VMManager", "State loaded from slot {} ({:.0f} ms)."), slot, timer.GetTimeMilliseconds()),
+		Host::OSD_QUICK_DURATION);
+	return true;
+}
+
+std::string VMManager::GetAutosaveFileName(s32 index)
+{
+	std::unique_lock lock(s_info_mutex);
+	if (s_disc_serial.empty())
+		return {};
+
+	return Path::Combine(EmuFolders::Savestates, (index == 0) ?
+													 fmt::format("{} ({:08X}).autosave.p2s", s_disc_serial, s_disc_crc) :
+													 fmt::format("{} ({:08X}).autosave.{:03d}.p2s", s_disc_serial, s_disc_crc, index));
+}
+
+void VMManager::PollIncrementalAutosave()
+{
+	if (EmuConfig.IncrementalAutosaveInterval == 0 ||
+		s_autosave_timer.GetTimeSeconds() < static_cast<double>(EmuConfig.IncrementalAutosaveInterval))
+	{
+		return;
+	}
+
+	s_autosave_timer.Reset();
+	if (!GSDumpReplayer::IsReplayingDump())
+		DoIncrementalAutosave();
+}
+
+bool VMManager::DoIncrementalAutosave()
+{
+	const bool write_failed = s_autosave_write_failed.exchange(false, std::memory_order_acq_rel);
+	if (write_failed)
+		Console.Warning("Previous autosave failed to write, starting a new chain.");
+
+	const bool base = (write_failed || s_autosave_index < 0 ||
+					   static_cast<u32>(s_autosave_index) >= EmuConfig.IncrementalAutosaveChainLength);
+	const s32 index = base ? 0 : (s_autosave_index + 1);
+	const std::string filename = GetAutosaveFileName(index);
+	if (filename.empty())
+		return false;
+
+	if (base)
+	{
+		// States from the previous chain don't apply on top of the new base. Remove every one of them rather than
+		// stopping at the first gap, otherwise anything past it would be picked up again once the gap is refilled.
+		WaitForSaveStateFlush();
+
+		std::string pattern;
+		{
+			std::unique_lock lock(s_info_mutex);
+			pattern = fmt::format("{} ({:08X}).autosave.*.p2s", s_disc_serial, s_disc_crc);
+		}
+
+		FileSystem::FindResultsArray deltas;
+		FileSystem::FindFiles(EmuFolders::Savestates.c_str(), pattern.c_str(), FILESYSTEM_FIND_FILES | FILESYSTEM_FIND_HIDDEN_FILES, &deltas);
+		for (const FILESYSTEM_FIND_DATA& fd : deltas)
+		{
+			// A leftover delta would be loaded on top of the new base, so don't write one until they're all gone.
+			if (!FileSystem::DeleteFilePath(fd.FileName.c_str()))
+			{
+				Console.Error(fmt::format("Failed to delete old autosave '{}'", fd.FileName));
+				s_autosave_index = -1;
+				return false;
+			}
+		}
+	}
+
+	Common::Timer timer;
+	Error error;
+	std::unique_ptr<ArchiveEntryList> elist = SaveState_DownloadIncrementalState(base, &error);
+	if (!elist)
+	{
+		Console.Error(fmt::format("Failed to create autosave: {}", error.GetDescription()));
+		s_autosave_index = -1;
+		return false;
+	}
+
+	DevCon.WriteLn(fmt::format("Captured {} autosave {} ({} KB) in {:.2f} ms", base ? "full" : "incremental", index,
+		elist->GetBuffer().size() / 1024, timer.GetTimeMilliseconds()));
+
+	std::unique_lock lock(s_save_state_threads_mutex);
+	s_save_state_threads.emplace_back(&VMManager::ZipSaveStateOnThread, std::move(elist),
+		std::unique_ptr<SaveStateScreenshotData>(), std::string("IncrementalAutosave"), filename, -1,
+		timer.GetStartValue());
+	s_autosave_index = index;
+	return true;
+}
+
+bool VMManager::LoadIncrementalAutosave()
+{
+	if (!HasValidVM() || GSDumpReplayer::IsReplayingDump())
+		return false;
+
+	if (Achievements::IsHardcoreModeActive())
+	{
+		Achievements::ConfirmHardcoreModeDisableAsync(TRANSLATE("VMManager", "Loading state"),
+			[](bool approved) {
+				if (approved)
+					LoadIncrementalAutosave();
+			});
+		return false;
+	}
+
+	if (MemcardBusy::IsBusy())
+	{
+		Host::AddIconOSDMessage("LoadIncrementalAutosave", ICON_FA_EXCLAMATION_TRIANGLE,
+			TRANSLATE_STR("VMManager", "Failed to load autosave (Memory card is busy)"), Host::OSD_QUICK_DURATION);
+		return false;
+	}
+
+	// Make sure the newest states have been written out before collecting the chain.
+	WaitForSaveStateFlush();
+
+	std::vector<std::string> chain;
+	for (s32 i = 0;; i++)
+	{
+		std::string filename = GetAutosaveFileName(i);
+		if (filename.empty() || !FileSystem::FileExists(filename.c_str()))
+			break;
+
+		chain.push_back(std::move(filename));
+	}
+
+	if (chain.empty())
+	{
+		Host::AddIconOSDMessage("LoadIncrementalAutosave", ICON_FA_EXCLAMATION_TRIANGLE,
+			TRANSLATE_STR("VMManager", "There is no autosave for this game."), Host::OSD_QUICK_DURATION);
+		return false;
+	}
+
+	Host::OnSaveStateLoading(chain.back());
+
+	Error error;
+	if (!SaveState_UnzipChainFromDisk(chain, &error))
+	{
+		Host::ReportErrorAsync(TRANSLATE_SV("VMManager", "Failed to load save state"), error.GetDescription());
+		Reset();
+		return false;
+	}
+
+	Host::OnSaveStateLoaded(chain.back(), true);
+	if (g_InputRecording.isActive())
+	{
+		g_InputRecording.handleLoadingSavestate();
+		MTGS::PresentCurrentFrame();
+	}
+
+	Rewind::Clear();
+	s_autosave_index = -1;
+	s_autosave_timer.Reset();
+
+	Host::AddIconOSDMessage("LoadIncrementalAutosave", ICON_FA_FOLDER_OPEN,
+		fmt::format(TRANSLATE_FS("VMManager", "Loaded autosave ({} incremental states)."), chain.size() - 1),
+		Host::OSD_QUICK_DURATION);
+	return true;
+}
+
+bool VMManager::RewindFrames(u32 frames)
+{
+	if (!HasValidVM() || GSDumpReplayer::IsReplayingDump() || !EmuConfig.EnableRewind)
+		return false;
+
+	if (Achievements::IsHardcoreModeActive())
+	{
+		Achievements::ConfirmHardcoreModeDisableAsync(TRANSLATE("VMManager", "Rewinding"),
+			[frames](bool approved) {
+				if (approved)
+					RewindFrames(frames);
+			});
+		return false;
+	}
+
+	if (!Rewind::CanStepBack())
+	{
+		Host::AddIconOSDMessage("Rewind", ICON_FA_EXCLAMATION_TRIANGLE,
+			TRANSLATE_STR("VMManager", "No rewind snapshots are available yet."), Host::OSD_QUICK_DURATION);
+		return false;
+	}
+
+	Error error;
+	if (!Rewind::StepBack(frames, &error))
+	{
+		Host::ReportErrorAsync(TRANSLATE_SV("VMManager", "Failed to rewind"), error.GetDescription());
+		Rewind::Clear();
+		Reset();
+		return false;
+	}
+
+	if (g_InputRecording.isActive())
+		g_InputRecording.handleLoadingSavestate();
+
+	// Show the restored frame even when paused.
+	MTGS::PresentCurrentFrame();
+	return true;
 }
 
 bool VMManager::SaveState(const char* filename, bool zip_on_thread, bool backup_old_state)
@@ -2100,7 +2333,11 @@ void VMManager::Internal::Throttle()
 	// further testing suggests instead that this was utter bullshit.
 	if (msec > 1)
 	{
+		// Nothing runs on the EE thread while it sleeps, so the recompiler can get ahead in the meantime.
+		const bool idle_compile = (Cpu == &recCpu) && recBeginIdleCompile();
 		Threading::Sleep(msec - 1);
+		if (idle_compile)
+			recEndIdleCompile();
 	}
 
 	// Conversion to milliseconds loses some precision; after sleeping off whole milliseconds,
@@ -2233,7 +2470,7 @@ bool VMManager::IsBlockDumpFileName(const std::string_view& path)
 bool VMManager::IsGSDumpFileName(const std::string_view& path)
 {
 	return (StringUtil::EndsWithNoCase(path, ".gs") || StringUtil::EndsWithNoCase(path, ".gs.xz") ||
-			StringUtil::EndsWithNoCase(path, ".gs.zst"));
+			StringUtil::EndsWithNoCase(path, ".gs.zst") || StringUtil::EndsWithNoCase(path, ".gs.zsc"));
 }
 
 bool VMManager::IsSaveStateFileName(const std::string_view& path)
@@ -2243,7 +2480,7 @@ bool VMManager::IsSaveStateFileName(const std::string_view& path)
 
 bool VMManager::IsDiscFileName(const std::string_view& path)
 {
-	static const char* extensions[] = {".iso", ".bin", ".img", ".mdf", ".gz", ".cso", ".zso", ".chd"};
+	static const char* extensions[] = {".iso", ".bin", ".img", ".mdf", ".gz", ".cso", ".zso", ".chd", ".iso.zst"};
 
 	for (const char* test_extension : extensions)
 	{
@@ -2663,6 +2900,12 @@ void VMManager::Internal::VSyncOnCPUThread()
 
 	Achievements::FrameUpdate();
 
+	if (Cpu == &recCpu)
+		recPublishTierStatistics();
+
+	Rewind::OnVSync();
+	PollIncrementalAutosave();
+
 	PollDiscordPresence();
 }
 
@@ -2847,6 +3090,15 @@ void VMManager::CheckForMiscConfigChanges(const Pcsx2Config& old_config)
 		else
 			ShutdownDiscordPresence();
 	}
+
+	if (!EmuConfig.EnableRewind && old_config.EnableRewind)
+		Rewind::Shutdown();
+
+	if (EmuConfig.IncrementalAutosaveInterval == 0 && old_config.IncrementalAutosaveInterval != 0)
+	{
+		SaveState_StopIncrementalTracking();
+		s_autosave_index = -1;
+	}
 }
 
 void VMManager::CheckForConfigChanges(const Pcsx2Config& old_config)
@@ -125,6 +125,12 @@ namespace VMManager
 	/// Loads state from the specified slot.
 	bool LoadStateFromSlot(s32 slot);
 
+	/// Loads the most recent incremental autosave chain for the running game.
+	bool LoadIncrementalAutosave();
+
+	/// Steps back the specified number of frames using the in-memory rewind buffer.
+	bool RewindFrames(u32 frames);
+
 	/// Saves state to the specified filename.
 	bool SaveState(const char* filename, bool zip_on_thread = true, bool backup_old_state = false);
 
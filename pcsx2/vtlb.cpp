@@ -28,6 +28,7 @@
 
 #include "fmt/core.h"
 
+#include <bit>
 #include <map>
 #include <unordered_set>
 #include <unordered_map>
@@ -59,20 +60,6 @@ struct FastmemVirtualMapping
 	u32 size;
 };
 
-struct LoadstoreBackpatchInfo
-{
-	u32 guest_pc;
-	u32 gpr_bitmask;
-	u32 fpr_bitmask;
-	u8 code_size;
-	u8 address_register;
-	u8 data_register;
-	u8 size_in_bits;
-	bool is_signed;
-	bool is_load;
-	bool is_fpr;
-};
-
 static constexpr size_t FASTMEM_AREA_SIZE = 0x100000000ULL;
 static constexpr u32 FASTMEM_PAGE_COUNT = FASTMEM_AREA_SIZE / VTLB_PAGE_SIZE;
 static constexpr u32 NO_FASTMEM_MAPPING = 0xFFFFFFFFu;
@@ -80,7 +67,7 @@ static constexpr u32 NO_FASTMEM_MAPPING = 0xFFFFFFFFu;
 static std::unique_ptr<SharedMemoryMappingArea> s_fastmem_area;
 static std::vector<u32> s_fastmem_virtual_mapping; // maps vaddr -> mainmem offset
 static std::unordered_multimap<u32, u32> s_fastmem_physical_mapping; // maps mainmem offset -> vaddr
-static std::unordered_map<uptr, LoadstoreBackpatchInfo> s_fastmem_backpatch_info;
+static std::map<uptr, LoadstoreBackpatchInfo> s_fastmem_backpatch_info; // ordered for range lookups
 static std::unordered_set<u32> s_fastmem_faulting_pcs;
 
 vtlb_private::VTLBPhysical vtlb_private::VTLBPhysical::fromPointer(sptr ptr)
@@ -1072,6 +1059,23 @@ void vtlb_AddLoadStoreInfo(uptr code_address, u32 code_size, u32 guest_pc, u32 g
 	s_fastmem_backpatch_info.emplace(code_address, info);
 }
 
+void vtlb_AddLoadStoreInfo(uptr code_address, const LoadstoreBackpatchInfo& info)
+{
+	s_fastmem_backpatch_info.insert_or_assign(code_address, info);
+}
+
+void vtlb_GetLoadStoreInfo(uptr code_start, u32 code_size, std::vector<std::pair<uptr, LoadstoreBackpatchInfo>>* infos)
+{
+	infos->clear();
+
+	const uptr code_end = code_start + code_size;
+	for (auto iter = s_fastmem_backpatch_info.lower_bound(code_start);
+		 iter != s_fastmem_backpatch_info.end() && iter->first < code_end; ++iter)
+	{
+		infos->emplace_back(iter->first, iter->second);
+	}
+}
+
 bool vtlb_BackpatchLoadStore(uptr code_address, uptr fault_address)
 {
 	uptr fastmem_start = (uptr)vtlbdata.fastmem_base;
@@ -1386,6 +1390,9 @@ struct vtlb_PageProtectionInfo
 
 alignas(16) static vtlb_PageProtectionInfo m_PageProtectInfo[Ps2MemSize::MainRam >> __pageshift];
 
+static bool s_dirty_tracking_enabled = false;
+alignas(16) static u64 s_dirty_ram_pages[MMAP_DIRTY_BITMAP_WORDS];
+
 
 // returns:
 //  ProtMode_NotRequired - unchecked block (resides in ROM, thus is integrity is constant)
@@ -1456,6 +1463,87 @@ static __fi void mmap_ClearCpuBlock(uint offset)
 	Cpu->Clear(m_PageProtectInfo[rampage].ReverseRamMap, __pagesize);
 }
 
+static __fi void mmap_ProtectRamPage(u32 rampage, const PageProtectionMode& mode)
+{
+	HostSys::MemProtect(&eeMem->Main[rampage << __pageshift], __pagesize, mode);
+	vtlb_UpdateFastmemProtection(rampage << __pageshift, __pagesize, mode);
+}
+
+// offset - offset of address relative to psM.
+// Returns true if the fault was only caused by dirty tracking, and the write can be retried.
+static bool mmap_HandleDirtyPageFault(uptr offset)
+{
+	if (!s_dirty_tracking_enabled || offset >= Ps2MemSize::MainRam)
+		return false;
+
+	const u32 rampage = static_cast<u32>(offset >> __pageshift);
+	u64& word = s_dirty_ram_pages[rampage / 64];
+	const u64 bit = u64(1) << (rampage % 64);
+	if (word & bit)
+		return false;
+
+	word |= bit;
+
+	// Code pages still need their blocks cleared, which also unprotects them.
+	if (m_PageProtectInfo[rampage].Mode == ProtMode_Write)
+		return false;
+
+	mmap_ProtectRamPage(rampage, PageAccess_ReadWrite());
+	return true;
+}
+
+void mmap_SetDirtyTracking(bool enabled)
+{
+	pxAssert(eeMem);
+
+	if (s_dirty_tracking_enabled == enabled)
+		return;
+
+	s_dirty_tracking_enabled = enabled;
+	std::memset(s_dirty_ram_pages, 0, sizeof(s_dirty_ram_pages));
+
+	if (enabled)
+	{
+		HostSys::MemProtect(eeMem->Main, Ps2MemSize::MainRam, PageAccess_ReadOnly());
+		vtlb_UpdateFastmemProtection(0, Ps2MemSize::MainRam, PageAccess_ReadOnly());
+	}
+	else
+	{
+		// Leave pages which the recompiler is watching protected.
+		for (u32 rampage = 0; rampage < (Ps2MemSize::MainRam >> __pageshift); rampage++)
+		{
+			if (m_PageProtectInfo[rampage].Mode != ProtMode_Write)
+				mmap_ProtectRamPage(rampage, PageAccess_ReadWrite());
+		}
+	}
+}
+
+bool mmap_IsDirtyTrackingEnabled()
+{
+	return s_dirty_tracking_enabled;
+}
+
+void mmap_GetAndResetDirtyRamPages(u64* bitmap)
+{
+	pxAssert(s_dirty_tracking_enabled);
+
+	std::memcpy(bitmap, s_dirty_ram_pages, sizeof(s_dirty_ram_pages));
+
+	for (u32 i = 0; i < MMAP_DIRTY_BITMAP_WORDS; i++)
+	{
+		u64 word = s_dirty_ram_pages[i];
+		s_dirty_ram_pages[i] = 0;
+		while (word != 0)
+		{
+			const u32 rampage = i * 64 + static_cast<u32>(std::countr_zero(word));
+			word &= word - 1;
+
+			if (m_PageProtectInfo[rampage].Mode != ProtMode_Write)
+				mmap_ProtectRamPage(rampage, PageAccess_ReadOnly());
+		}
+	}
+}
+
 bool vtlb_private::PageFaultHandler(const PageFaultInfo& info)
 {
 	pxAssert(eeMem);
@@ -1468,6 +1556,9 @@ bool vtlb_private::PageFaultHandler(const PageFaultInfo& info)
 
 		uptr ptr = (uptr)PSM(vaddr);
 		uptr offset = (ptr - (uptr)eeMem->Main);
+		if (ptr && mmap_HandleDirtyPageFault(offset))
+			return true;
+
 		if (ptr && m_PageProtectInfo[offset >> __pageshift].Mode == ProtMode_Write)
 		{
 			// fprintf(stderr, "Not backpatching code write at %08X\n", vaddr);
@@ -1487,6 +1578,9 @@ bool vtlb_private::PageFaultHandler(const PageFaultInfo& info)
 		if (offset >= Ps2MemSize::MainRam)
 			return false;
 
+		if (mmap_HandleDirtyPageFault(offset))
+			return true;
+
 		mmap_ClearCpuBlock(offset);
 		return true;
 	}
@@ -1503,4 +1597,8 @@ void mmap_ResetBlockTracking()
 	if (eeMem)
 		HostSys::MemProtect(eeMem->Main, Ps2MemSize::MainRam, PageAccess_ReadWrite());
 	vtlb_UpdateFastmemProtection(0, Ps2MemSize::MainRam, PageAccess_ReadWrite());
+
+	// Everything is writable again, so we can't tell what changes from here on.
+	if (s_dirty_tracking_enabled)
+		std::memset(s_dirty_ram_pages, 0xFF, sizeof(s_dirty_ram_pages));
 }
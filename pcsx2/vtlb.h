@@ -8,6 +8,9 @@
 #include "common/HostSys.h"
 #include "common/SingleRegisterTypes.h"
 
+#include <utility>
+#include <vector>
+
 static const uptr VTLB_AllocUpperBounds = _1gb * 2;
 
 // Specialized function pointers for each read type
@@ -67,6 +70,20 @@ extern void* vtlb_GetPhyPtr(u32 paddr);
 extern u32  vtlb_V2P(u32 vaddr);
 extern void vtlb_DynV2P();
 
+struct LoadstoreBackpatchInfo
+{
+	u32 guest_pc;
+	u32 gpr_bitmask;
+	u32 fpr_bitmask;
+	u8 code_size;
+	u8 address_register;
+	u8 data_register;
+	u8 size_in_bits;
+	bool is_signed;
+	bool is_load;
+	bool is_fpr;
+};
+
 //virtual mappings
 extern void vtlb_VMap(u32 vaddr,u32 paddr,u32 sz);
 extern void vtlb_VMapBuffer(u32 vaddr,void* buffer,u32 sz);
@@ -78,6 +95,8 @@ extern bool vtlb_BackpatchLoadStore(uptr code_address, uptr fault_address);
 
 extern void vtlb_ClearLoadStoreInfo();
 extern void vtlb_AddLoadStoreInfo(uptr code_address, u32 code_size, u32 guest_pc, u32 gpr_bitmask, u32 fpr_bitmask, u8 address_register, u8 data_register, u8 size_in_bits, bool is_signed, bool is_load, bool is_fpr);
+extern void vtlb_AddLoadStoreInfo(uptr code_address, const LoadstoreBackpatchInfo& info);
+extern void vtlb_GetLoadStoreInfo(uptr code_start, u32 code_size, std::vector<std::pair<uptr, LoadstoreBackpatchInfo>>* infos);
 extern void vtlb_DynBackpatchLoadStore(uptr code_address, u32 code_size, u32 guest_pc, u32 guest_addr, u32 gpr_bitmask, u32 fpr_bitmask, u8 address_register, u8 data_register, u8 size_in_bits, bool is_signed, bool is_load, bool is_fpr);
 extern bool vtlb_IsFaultingPC(u32 guest_pc);
 
@@ -232,6 +251,13 @@ extern vtlb_ProtectionMode mmap_GetRamPageInfo(u32 paddr);
 extern void mmap_MarkCountedRamPage(u32 paddr);
 extern void mmap_ResetBlockTracking();
 
+// Dirty page tracking of EE main memory, for incremental save states. While enabled, clean pages
+// are write-protected, and the first write to each page marks it as dirty.
+static constexpr u32 MMAP_DIRTY_BITMAP_WORDS = (Ps2MemSize::MainRam >> __pageshift) / 64;
+extern void mmap_SetDirtyTracking(bool enabled);
+extern bool mmap_IsDirtyTrackingEnabled();
+extern void mmap_GetAndResetDirtyRamPages(u64* bitmap);
+
 // --------------------------------------------------------------------------------------
 //  Goemon game fix
 // --------------------------------------------------------------------------------------
@@ -5,6 +5,7 @@
 
 #include <cstring>
 #include <map>
+#include <vector>
 
 #include "common/Assertions.h"
 
@@ -26,6 +27,7 @@ struct BASEBLOCKEX
 	u32 startpc;
 	u32 size;    // The size in dwords (equivalent to the number of instructions)
 	u32 x86size; // The size in byte of the translated x86 instructions
+	u32* tierCounter; // Execution counter for tiered compilation, if the block has one
 
 #ifdef PCSX2_DEVBUILD
 	// Could be useful to instrument the block
@@ -148,10 +150,25 @@ protected:
 	uptr recompiler;
 	BaseBlockArray blocks;
 
+	// Generated code refers to tier counters by address, so they come from a fixed array, and
+	// go back to the pool when the block which owns them is removed.
+	u32* tierCounters;
+	u32 tierCounterCount;
+	std::vector<u32*> freeTierCounters;
+
+	void ResetTierCounters()
+	{
+		freeTierCounters.clear();
+		for (u32 i = tierCounterCount; i > 0; i--)
+			freeTierCounters.push_back(&tierCounters[i - 1]);
+	}
+
 public:
 	BaseBlocks()
 		: recompiler(0)
 		, blocks(0x4000)
+		, tierCounters(nullptr)
+		, tierCounterCount(0)
 	{
 	}
 
@@ -160,6 +177,30 @@ public:
 		recompiler = reinterpret_cast<uptr>(recompiler_);
 	}
 
+	void SetTierCounters(u32* counters, u32 count)
+	{
+		tierCounters = counters;
+		tierCounterCount = count;
+		ResetTierCounters();
+	}
+
+	// Gives the block a counter starting at `initial`, returns null if they're all in use.
+	// A block which is recompiled in place keeps the counter it already has.
+	u32* AllocTierCounter(BASEBLOCKEX* block, u32 initial)
+	{
+		if (!block->tierCounter)
+		{
+			if (freeTierCounters.empty())
+				return nullptr;
+
+			block->tierCounter = freeTierCounters.back();
+			freeTierCounters.pop_back();
+		}
+
+		*block->tierCounter = initial;
+		return block->tierCounter;
+	}
+
 	BASEBLOCKEX* New(u32 startpc, uptr fnptr);
 	int LastIndex(u32 startpc) const;
 	//BASEBLOCKEX* GetByX86(uptr ip);
@@ -211,6 +252,9 @@ public:
 				BASEBLOCKEX effu(blocks[idx]);
 				memset((void*)effu.fnptr, 0xcc, 1);
 			}
+
+			if (blocks[idx].tierCounter)
+				freeTierCounters.push_back(blocks[idx].tierCounter);
 		} while (idx++ < last);
 
 		// TODO: remove links from this block?
@@ -223,6 +267,7 @@ public:
 	{
 		blocks.clear();
 		links.clear();
+		ResetTierCounters();
 	}
 };
 
@@ -0,0 +1,1053 @@
+// SPDX-FileCopyrightText: 2002-2024 PCSX2 Dev Team
+// SPDX-License-Identifier: LGPL-3.0+
+
+#include "x86/RecCodeCache.h"
+#include "Config.h"
+#include "Memory.h"
+#include "vtlb.h"
+#include "svnrev.h"
+
+#include "common/Console.h"
+#include "common/FileSystem.h"
+#include "common/Path.h"
+#include "common/Threading.h"
+
+#include "cpuinfo.h"
+#include "fmt/format.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#if defined(_WIN32)
+#include "common/RedtapeWindows.h"
+#elif defined(__APPLE__)
+#include <dlfcn.h>
+#include <mach-o/loader.h>
+#else
+#include <link.h>
+#endif
+
+#define XXH_STATIC_LINKING_ONLY 1
+#define XXH_INLINE_ALL 1
+#include "xxhash.h"
+
+// Bump when the index/blob layout changes. Changes to the contents of the blobs should be
+// reflected in the layout hash passed by the recompiler instead.
+static constexpr u32 REC_CODE_CACHE_VERSION = 2;
+
+// When evicting, shrink to this fraction of the cap, so we're not rewriting the files on every store.
+static constexpr u32 EVICT_TARGET_NUMERATOR = 3;
+static constexpr u32 EVICT_TARGET_DENOMINATOR = 4;
+
+// New entries are written out once this much has built up, or after WRITE_INTERVAL. Stores are
+// dropped if the writer falls behind by more than MAX_PENDING_SIZE.
+static constexpr u32 WRITE_BATCH_SIZE = 1024 * 1024;
+static constexpr auto WRITE_INTERVAL = std::chrono::seconds(1);
+static constexpr u32 MAX_PENDING_SIZE = 16 * 1024 * 1024;
+
+// Same as in vtlb.cpp.
+static constexpr uptr FASTMEM_AREA_SIZE = 0x100000000ULL;
+
+// Bounds for read-ahead. Entries which are never asked for are dropped oldest first.
+static constexpr size_t MAX_PREFETCH_QUEUE = 64;
+static constexpr size_t MAX_PREFETCHED_ENTRIES = 256;
+
+namespace {
+#pragma pack(push, 1)
+struct CacheIndexHeader
+{
+	u32 version;
+	u64 layout_hash;
+	u32 generation;
+};
+
+struct CacheIndexEntry
+{
+	u32 address;
+	u32 guest_size;
+	u64 guest_hash;
+	u32 file_offset;
+	u32 blob_size;
+	u32 last_used;
+};
+#pragma pack(pop)
+} // namespace
+
+bool RecCodeCache::Key::operator==(const Key& key) const
+{
+	return (address == key.address && guest_size == key.guest_size && guest_hash == key.guest_hash);
+}
+
+bool RecCodeCache::Key::operator!=(const Key& key) const
+{
+	return (address != key.address || guest_size != key.guest_size || guest_hash != key.guest_hash);
+}
+
+RecCodeCache::RecCodeCache(const char* name)
+	: m_name(name)
+{
+}
+
+RecCodeCache::~RecCodeCache()
+{
+	Close();
+}
+
+u64 RecCodeCache::HashGuestCode(const void* data, size_t size, u64 seed)
+{
+	return XXH3_64bits_withSeed(data, size, seed);
+}
+
+static std::pair<uptr, uptr> GetImageRange()
+{
+	static const std::pair<uptr, uptr> range = []() {
+		// Any global will do to find the image we're in.
+		const void* anchor = &EmuConfig;
+		std::pair<uptr, uptr> ret = {};
+
+#if defined(_WIN32)
+		HMODULE module;
+		if (GetModuleHandleExW(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+				static_cast<LPCWSTR>(anchor), &module))
+		{
+			const u8* base = reinterpret_cast<const u8*>(module);
+			const IMAGE_DOS_HEADER* dos = reinterpret_cast<const IMAGE_DOS_HEADER*>(base);
+			const IMAGE_NT_HEADERS* nt = reinterpret_cast<const IMAGE_NT_HEADERS*>(base + dos->e_lfanew);
+			ret = {reinterpret_cast<uptr>(base), nt->OptionalHeader.SizeOfImage};
+		}
+#elif defined(__APPLE__)
+		Dl_info info;
+		if (dladdr(anchor, &info) && info.dli_fbase)
+		{
+			const mach_header_64* header = static_cast<const mach_header_64*>(info.dli_fbase);
+			const u8* cmd_ptr = reinterpret_cast<const u8*>(header + 1);
+			uptr text_vmaddr = 0, start = UINTPTR_MAX, end = 0;
+			for (u32 i = 0; i < header->ncmds; i++)
+			{
+				const load_command* cmd = reinterpret_cast<const load_command*>(cmd_ptr);
+				cmd_ptr += cmd->cmdsize;
+				if (cmd->cmd != LC_SEGMENT_64)
+					continue;
+
+				const segment_command_64* seg = reinterpret_cast<const segment_command_64*>(cmd);
+				if (std::strcmp(seg->segname, "__PAGEZERO") == 0)
+					continue;
+				if (std::strcmp(seg->segname, "__TEXT") == 0)
+					text_vmaddr = seg->vmaddr;
+				start = std::min<uptr>(start, seg->vmaddr);
+				end = std::max<uptr>(end, seg->vmaddr + seg->vmsize);
+			}
+
+			const uptr slide = reinterpret_cast<uptr>(header) - text_vmaddr;
+			if (start < end)
+				ret = {start + slide, end - start};
+		}
+#else
+		struct Search
+		{
+			uptr anchor;
+			std::pair<uptr, uptr> range;
+		} search = {reinterpret_cast<uptr>(anchor), {}};
+		dl_iterate_phdr(
+			[](dl_phdr_info* info, size_t, void* param) -> int {
+				Search* search = static_cast<Search*>(param);
+				uptr start = UINTPTR_MAX, end = 0;
+				for (ElfW(Half) i = 0; i < info->dlpi_phnum; i++)
+				{
+					const ElfW(Phdr)& phdr = info->dlpi_phdr[i];
+					if (phdr.p_type != PT_LOAD)
+						continue;
+
+					start = std::min<uptr>(start, info->dlpi_addr + phdr.p_vaddr);
+					end = std::max<uptr>(end, info->dlpi_addr + phdr.p_vaddr + phdr.p_memsz);
+				}
+
+				if (search->anchor < start || search->anchor >= end)
+					return 0;
+
+				search->range = {start, end - start};
+				return 1;
+			},
+			&search);
+		ret = search.range;
+#endif
+
+		if (ret.second == 0)
+			Console.Error("RecCodeCache: Failed to find executable image, cached code will not be relocatable.");
+
+		return ret;
+	}();
+
+	return range;
+}
+
+static std::pair<uptr, uptr> GetHostRegionRange(RecCodeCache::HostRegion region)
+{
+	switch (region)
+	{
+		case RecCodeCache::HostRegion::Image:
+			return GetImageRange();
+
+		case RecCodeCache::HostRegion::Data:
+			return {reinterpret_cast<uptr>(SysMemory::GetDataPtr(0)), HostMemoryMap::MainSize};
+
+		case RecCodeCache::HostRegion::Code:
+			return {reinterpret_cast<uptr>(SysMemory::GetCodePtr(0)), HostMemoryMap::CodeSize};
+
+		case RecCodeCache::HostRegion::Fastmem:
+			return {vtlb_private::vtlbdata.fastmem_base, vtlb_private::vtlbdata.fastmem_base ? FASTMEM_AREA_SIZE : 0};
+
+		default:
+			return {};
+	}
+}
+
+u64 RecCodeCache::GetHostLayoutHash()
+{
+	// References to the host regions are relocated, so their addresses don't matter, with one
+	// exception: the emitter encodes addresses in the low 2GB as plain 32-bit displacements,
+	// which aren't recorded. Code referring to a region down there only works in the same place.
+	// The instruction set extensions in use can also change what gets emitted.
+	u64 layout[static_cast<u32>(HostRegion::Count) + 1];
+	for (u32 i = 0; i < static_cast<u32>(HostRegion::Count); i++)
+	{
+		const uptr start = GetHostRegionRange(static_cast<HostRegion>(i)).first;
+		layout[i] = (start < 0x80000000u) ? start : 0;
+	}
+	layout[static_cast<u32>(HostRegion::Count)] =
+		static_cast<u64>(cpuinfo_has_x86_avx()) | (static_cast<u64>(cpuinfo_has_x86_avx2()) << 1);
+
+	return HashGuestCode(layout, sizeof(layout), HashGuestCode(GIT_REV, std::strlen(GIT_REV)));
+}
+
+bool RecCodeCache::MakeRelocation(const u8* code, const x86Emitter::xRelativeRef& ref, Relocation* reloc)
+{
+	const uptr target = reinterpret_cast<uptr>(ref.target);
+	for (u32 i = 0; i < static_cast<u32>(HostRegion::Count); i++)
+	{
+		const auto [start, size] = GetHostRegionRange(static_cast<HostRegion>(i));
+		if (target < start || (target - start) >= size)
+			continue;
+
+		reloc->offset = static_cast<u32>(ref.field - code);
+		reloc->region = static_cast<u8>(i);
+		reloc->size = ref.size;
+		reloc->disp_end = 0;
+		reloc->pad = 0;
+		reloc->target = target - start;
+
+		if (ref.absolute)
+			return (ref.size == sizeof(u64));
+
+		// Displacements are relative to the end of the instruction, which isn't necessarily the
+		// end of the field (e.g. when an immediate follows).
+		if (ref.size != sizeof(s32))
+			return false;
+
+		s32 disp;
+		std::memcpy(&disp, ref.field, sizeof(disp));
+		const sptr disp_end = static_cast<sptr>(target) - disp - reinterpret_cast<sptr>(ref.field);
+		if (disp_end < static_cast<sptr>(sizeof(s32)) || disp_end > 15)
+			return false;
+
+		reloc->disp_end = static_cast<u8>(disp_end);
+		return true;
+	}
+
+	return false;
+}
+
+bool RecCodeCache::ApplyRelocation(u8* code, u32 code_size, const Relocation& reloc)
+{
+	if (reloc.region >= static_cast<u8>(HostRegion::Count) || reloc.size > code_size ||
+		reloc.offset > (code_size - reloc.size))
+	{
+		return false;
+	}
+
+	const auto [start, size] = GetHostRegionRange(static_cast<HostRegion>(reloc.region));
+	if (reloc.target >= size)
+		return false;
+
+	const uptr target = start + static_cast<uptr>(reloc.target);
+	if (reloc.size == sizeof(u64))
+	{
+		const u64 value = target;
+		std::memcpy(code + reloc.offset, &value, sizeof(value));
+		return true;
+	}
+	else if (reloc.size == sizeof(s32))
+	{
+		const sptr disp = static_cast<sptr>(target) - reinterpret_cast<sptr>(code + reloc.offset + reloc.disp_end);
+		if (disp != static_cast<s32>(disp))
+			return false;
+
+		const s32 disp32 = static_cast<s32>(disp);
+		std::memcpy(code + reloc.offset, &disp32, sizeof(disp32));
+		return true;
+	}
+
+	return false;
+}
+
+std::string RecCodeCache::GetIndexFileName() const
+{
+	return Path::Combine(EmuFolders::Cache, fmt::format("{}.idx", m_name));
+}
+
+std::string RecCodeCache::GetBlobFileName() const
+{
+	return Path::Combine(EmuFolders::Cache, fmt::format("{}.bin", m_name));
+}
+
+bool RecCodeCache::Open(u64 layout_hash, u32 max_blob_size, bool prefetch)
+{
+	Close();
+
+	std::unique_lock file_lock(m_file_mutex);
+	std::unique_lock lock(m_mutex);
+
+	m_layout_hash = layout_hash;
+	m_max_blob_size = max_blob_size;
+	m_generation = 0;
+	m_index_dirty = false;
+
+	const std::string index_filename = GetIndexFileName();
+	const std::string blob_filename = GetBlobFileName();
+
+	if (!ReadExisting(index_filename, blob_filename) && !CreateNew(index_filename, blob_filename))
+		return false;
+
+	m_open = true;
+	lock.unlock();
+	file_lock.unlock();
+
+	StartWriterThread();
+	if (prefetch)
+		StartPrefetchThread();
+
+	return true;
+}
+
+bool RecCodeCache::CreateNew(const std::string& index_filename, const std::string& blob_filename)
+{
+	if (FileSystem::FileExists(index_filename.c_str()))
+	{
+		Console.Warning("Removing existing index file '%s'", index_filename.c_str());
+		FileSystem::DeleteFilePath(index_filename.c_str());
+	}
+	if (FileSystem::FileExists(blob_filename.c_str()))
+	{
+		Console.Warning("Removing existing blob file '%s'", blob_filename.c_str());
+		FileSystem::DeleteFilePath(blob_filename.c_str());
+	}
+
+	m_index_file = FileSystem::OpenCFile(index_filename.c_str(), "wb");
+	if (!m_index_file)
+	{
+		Console.Error("Failed to open index file '%s' for writing", index_filename.c_str());
+		return false;
+	}
+
+	const CacheIndexHeader header = {REC_CODE_CACHE_VERSION, m_layout_hash, m_generation};
+	if (std::fwrite(&header, sizeof(header), 1, m_index_file) != 1 || std::fflush(m_index_file) != 0)
+	{
+		Console.Error("Failed to write header to index file '%s'", index_filename.c_str());
+		std::fclose(m_index_file);
+		m_index_file = nullptr;
+		FileSystem::DeleteFilePath(index_filename.c_str());
+		return false;
+	}
+
+	m_blob_file = FileSystem::OpenCFile(blob_filename.c_str(), "w+b");
+	if (!m_blob_file)
+	{
+		Console.Error("Failed to open blob file '%s' for writing", blob_filename.c_str());
+		std::fclose(m_index_file);
+		m_index_file = nullptr;
+		FileSystem::DeleteFilePath(index_filename.c_str());
+		return false;
+	}
+
+	m_blob_file_size = 0;
+	return true;
+}
+
+bool RecCodeCache::ReadExisting(const std::string& index_filename, const std::string& blob_filename)
+{
+	m_index_file = FileSystem::OpenCFile(index_filename.c_str(), "r+b");
+	if (!m_index_file)
+		return false;
+
+	CacheIndexHeader header;
+	if (std::fread(&header, sizeof(header), 1, m_index_file) != 1 || header.version != REC_CODE_CACHE_VERSION)
+	{
+		Console.Error("Bad file/data version in '%s'", index_filename.c_str());
+		std::fclose(m_index_file);
+		m_index_file = nullptr;
+		return false;
+	}
+
+	if (header.layout_hash != m_layout_hash)
+	{
+		Console.WriteLn("Host layout or configuration changed, discarding '%s'", index_filename.c_str());
+		std::fclose(m_index_file);
+		m_index_file = nullptr;
+		return false;
+	}
+
+	m_blob_file = FileSystem::OpenCFile(blob_filename.c_str(), "a+b");
+	if (!m_blob_file)
+	{
+		Console.Error("Blob file '%s' is missing", blob_filename.c_str());
+		std::fclose(m_index_file);
+		m_index_file = nullptr;
+		return false;
+	}
+
+	// Offsets are stored as 32-bit, anything bigger didn't come from us.
+	const s64 blob_file_size = FileSystem::FSize64(m_blob_file);
+	if (blob_file_size < 0 || static_cast<u64>(blob_file_size) > UINT32_MAX)
+	{
+		Console.Error("Blob file '%s' has a bad size, corrupt file?", blob_filename.c_str());
+		CloseLocked();
+		return false;
+	}
+
+	m_blob_file_size = static_cast<u32>(blob_file_size);
+	m_generation = header.generation + 1;
+
+	for (;;)
+	{
+		CacheIndexEntry entry;
+		if (std::fread(&entry, sizeof(entry), 1, m_index_file) != 1 ||
+			(static_cast<u64>(entry.file_offset) + entry.blob_size) > m_blob_file_size)
+		{
+			if (std::feof(m_index_file))
+				break;
+
+			Console.Error("Failed to read entry from '%s', corrupt file?", index_filename.c_str());
+			CloseLocked();
+			return false;
+		}
+
+		// Later entries replace earlier ones with the same key.
+		const Key key = {entry.address, entry.guest_size, entry.guest_hash};
+		const CacheIndexData data = {key, entry.file_offset, entry.blob_size, entry.last_used, false};
+		auto range = m_index.equal_range(entry.address);
+		auto it = range.first;
+		for (; it != range.second; ++it)
+		{
+			if (it->second.key == key)
+			{
+				it->second = data;
+				break;
+			}
+		}
+		if (it == range.second)
+			m_index.emplace(entry.address, data);
+	}
+
+	// Bump the session counter, appends go after whatever we read.
+	header.generation = m_generation;
+	if (std::fseek(m_index_file, 0, SEEK_SET) != 0 || std::fwrite(&header, sizeof(header), 1, m_index_file) != 1 ||
+		std::fseek(m_index_file, 0, SEEK_END) != 0)
+	{
+		Console.Error("Failed to update header of '%s'", index_filename.c_str());
+		CloseLocked();
+		return false;
+	}
+
+	// The cap may have been lowered since the files were written, the writer thread deals with that.
+	Console.WriteLn("Read %zu entries from '%s'", m_index.size(), index_filename.c_str());
+	return true;
+}
+
+bool RecCodeCache::WriteIndex(std::FILE* fp) const
+{
+	const CacheIndexHeader header = {REC_CODE_CACHE_VERSION, m_layout_hash, m_generation};
+	if (std::fwrite(&header, sizeof(header), 1, fp) != 1)
+		return false;
+
+	for (const auto& it : m_index)
+	{
+		const CacheIndexData& data = it.second;
+		if (data.pending)
+			continue;
+
+		const CacheIndexEntry entry = {
+			data.key.address, data.key.guest_size, data.key.guest_hash, data.file_offset, data.blob_size, data.last_used};
+		if (std::fwrite(&entry, sizeof(entry), 1, fp) != 1)
+			return false;
+	}
+
+	return (std::fflush(fp) == 0);
+}
+
+bool RecCodeCache::NeedsEviction() const
+{
+	return (m_blob_file && (static_cast<u64>(m_blob_file_size) + m_pending_size) > m_max_blob_size);
+}
+
+bool RecCodeCache::Evict(u32 target_size)
+{
+	const std::string index_filename = GetIndexFileName();
+	const std::string blob_filename = GetBlobFileName();
+	const std::string temp_index_filename = index_filename + ".tmp";
+	const std::string temp_blob_filename = blob_filename + ".tmp";
+
+	// Keep the most recently used entries which fit. Only the writer thread appends to the blob
+	// file, so what's on disk can't change while we're copying it. The lock is only needed to
+	// look at the index.
+	std::vector<CacheIndexData> entries;
+	{
+		std::unique_lock lock(m_mutex);
+		entries.reserve(m_index.size());
+		for (const auto& it : m_index)
+		{
+			if (!it.second.pending)
+				entries.push_back(it.second);
+		}
+	}
+	std::sort(entries.begin(), entries.end(),
+		[](const CacheIndexData& lhs, const CacheIndexData& rhs) { return (lhs.last_used > rhs.last_used); });
+
+	std::FILE* blob = FileSystem::OpenCFile(blob_filename.c_str(), "rb");
+	std::FILE* temp_blob = blob ? FileSystem::OpenCFile(temp_blob_filename.c_str(), "wb") : nullptr;
+	if (!temp_blob)
+	{
+		Console.Error("Failed to open '%s' for writing", temp_blob_filename.c_str());
+		if (blob)
+			std::fclose(blob);
+		return false;
+	}
+
+	std::unordered_map<u32, u32> new_offsets;
+	std::vector<u8> buffer;
+	u32 new_size = 0;
+	bool blob_ok = true;
+	for (const CacheIndexData& data : entries)
+	{
+		if ((static_cast<u64>(new_size) + data.blob_size) > target_size)
+			continue;
+
+		buffer.resize(data.blob_size);
+		if (std::fseek(blob, data.file_offset, SEEK_SET) != 0 || std::fread(buffer.data(), data.blob_size, 1, blob) != 1 ||
+			std::fwrite(buffer.data(), data.blob_size, 1, temp_blob) != 1)
+		{
+			blob_ok = false;
+			break;
+		}
+
+		new_offsets.emplace(data.file_offset, new_size);
+		new_size += data.blob_size;
+	}
+
+	blob_ok = blob_ok && (std::fflush(temp_blob) == 0);
+	std::fclose(temp_blob);
+	std::fclose(blob);
+	if (!blob_ok)
+	{
+		Console.Error("Failed to copy blobs while evicting from '%s'", blob_filename.c_str());
+		FileSystem::DeleteFilePath(temp_blob_filename.c_str());
+		return false;
+	}
+
+	// Readers take the file lock first, so they'll wait until the new files are in place.
+	std::unique_lock file_lock(m_file_mutex);
+	std::unique_lock lock(m_mutex);
+
+	// Entries which were replaced while we were copying are pending now, and stay that way.
+	const size_t old_count = m_index.size();
+	for (auto it = m_index.begin(); it != m_index.end();)
+	{
+		if (it->second.pending)
+		{
+			++it;
+			continue;
+		}
+
+		const auto nit = new_offsets.find(it->second.file_offset);
+		if (nit == new_offsets.end())
+		{
+			it = m_index.erase(it);
+			continue;
+		}
+
+		it->second.file_offset = nit->second;
+		++it;
+	}
+
+	std::FILE* temp_index = FileSystem::OpenCFile(temp_index_filename.c_str(), "wb");
+	const bool index_ok = temp_index && WriteIndex(temp_index);
+	if (temp_index)
+		std::fclose(temp_index);
+
+	std::fclose(m_index_file);
+	m_index_file = nullptr;
+	std::fclose(m_blob_file);
+	m_blob_file = nullptr;
+
+	if (!index_ok || !FileSystem::RenamePath(temp_blob_filename.c_str(), blob_filename.c_str()) ||
+		!FileSystem::RenamePath(temp_index_filename.c_str(), index_filename.c_str()))
+	{
+		Console.Error("Failed to replace '%s' after eviction", index_filename.c_str());
+		FileSystem::DeleteFilePath(temp_blob_filename.c_str());
+		FileSystem::DeleteFilePath(temp_index_filename.c_str());
+		for (auto it = m_index.begin(); it != m_index.end();)
+			it = it->second.pending ? std::next(it) : m_index.erase(it);
+		return CreateNew(index_filename, blob_filename);
+	}
+
+	m_index_file = FileSystem::OpenCFile(index_filename.c_str(), "r+b");
+	m_blob_file = FileSystem::OpenCFile(blob_filename.c_str(), "a+b");
+	if (!m_index_file || !m_blob_file || std::fseek(m_index_file, 0, SEEK_END) != 0)
+	{
+		Console.Error("Failed to reopen '%s' after eviction", index_filename.c_str());
+		return false;
+	}
+
+	m_blob_file_size = new_size;
+	m_index_dirty = false;
+
+	DevCon.WriteLn("Evicted %zu entries from '%s', %u bytes remaining", old_count - m_index.size(), m_name, new_size);
+	return true;
+}
+
+void RecCodeCache::FlushPendingWrites()
+{
+	std::unique_lock file_lock(m_file_mutex);
+	std::unique_lock lock(m_mutex);
+
+	std::deque<PendingWrite> batch;
+	batch.swap(m_pending);
+	m_pending_size = 0;
+
+	// Anything which doesn't fit after eviction is dropped.
+	std::vector<u32> offsets(batch.size(), UINT32_MAX);
+	u32 new_size = m_blob_file_size;
+	for (size_t i = 0; i < batch.size(); i++)
+	{
+		const u32 size = static_cast<u32>(batch[i].data.size());
+		if (!m_blob_file || (static_cast<u64>(new_size) + size) > m_max_blob_size)
+			continue;
+
+		offsets[i] = new_size;
+		new_size += size;
+	}
+
+	// Readers can't get at the blob file while we hold the file lock, so the batch doesn't need to
+	// stay visible to them. Write() only needs the index lock and can carry on.
+	bool ok = true;
+	if (new_size != m_blob_file_size)
+	{
+		lock.unlock();
+
+		ok = (std::fseek(m_blob_file, m_blob_file_size, SEEK_SET) == 0);
+		for (size_t i = 0; i < batch.size() && ok; i++)
+		{
+			if (offsets[i] != UINT32_MAX)
+				ok = (std::fwrite(batch[i].data.data(), batch[i].data.size(), 1, m_blob_file) == 1);
+		}
+		ok = ok && (std::fflush(m_blob_file) == 0);
+
+		for (size_t i = 0; i < batch.size() && ok; i++)
+		{
+			if (offsets[i] == UINT32_MAX)
+				continue;
+
+			const Key& key = batch[i].key;
+			const CacheIndexEntry entry = {
+				key.address, key.guest_size, key.guest_hash, offsets[i], static_cast<u32>(batch[i].data.size()), m_generation};
+			ok = (std::fwrite(&entry, sizeof(entry), 1, m_index_file) == 1);
+		}
+		ok = ok && (std::fflush(m_index_file) == 0);
+
+		lock.lock();
+	}
+
+	for (size_t i = 0; i < batch.size(); i++)
+	{
+		// Leave entries which were replaced in the meantime alone.
+		const Key& key = batch[i].key;
+		if (std::any_of(m_pending.begin(), m_pending.end(), [&key](const PendingWrite& pw) { return (pw.key == key); }))
+			continue;
+
+		auto range = m_index.equal_range(key.address);
+		for (auto it = range.first; it != range.second; ++it)
+		{
+			if (it->second.key != key)
+				continue;
+
+			if (ok && offsets[i] != UINT32_MAX)
+			{
+				it->second.file_offset = offsets[i];
+				it->second.pending = false;
+			}
+			else
+			{
+				m_index.erase(it);
+			}
+			break;
+		}
+	}
+
+	if (!ok)
+	{
+		// We don't know what made it to disk, so stop using the files.
+		Console.Error("Failed to write %zu entries to '%s'", batch.size(), m_name);
+		CloseLocked();
+		return;
+	}
+
+	m_blob_file_size = new_size;
+}
+
+void RecCodeCache::StartWriterThread()
+{
+	m_writer_shutdown = false;
+	m_writer_thread = std::thread(&RecCodeCache::WriterThread, this);
+}
+
+void RecCodeCache::StopWriterThread()
+{
+	if (!m_writer_thread.joinable())
+		return;
+
+	{
+		std::unique_lock lock(m_mutex);
+		m_writer_shutdown = true;
+	}
+	m_writer_cv.notify_one();
+	m_writer_thread.join();
+}
+
+void RecCodeCache::WriterThread()
+{
+	Threading::SetNameOfCurrentThread(fmt::format("{} Writer", m_name).c_str());
+
+	std::unique_lock lock(m_mutex);
+	for (;;)
+	{
+		// Whatever is pending gets written out at least every WRITE_INTERVAL, and on shutdown.
+		m_writer_cv.wait_for(lock, WRITE_INTERVAL,
+			[this]() { return (m_writer_shutdown || m_pending_size >= WRITE_BATCH_SIZE || NeedsEviction()); });
+
+		const bool shutdown = m_writer_shutdown;
+		const bool evict = NeedsEviction();
+		const bool flush = !m_pending.empty();
+		if (evict || flush)
+		{
+			lock.unlock();
+
+			if (evict && !Evict(m_max_blob_size / EVICT_TARGET_DENOMINATOR * EVICT_TARGET_NUMERATOR))
+			{
+				std::unique_lock file_lock(m_file_mutex);
+				std::unique_lock evict_lock(m_mutex);
+				Console.Error("Failed to evict entries from '%s', no longer caching.", m_name);
+				CloseLocked();
+			}
+
+			if (flush)
+				FlushPendingWrites();
+
+			lock.lock();
+		}
+
+		if (shutdown)
+			break;
+	}
+}
+
+void RecCodeCache::Close()
+{
+	StopPrefetchThread();
+	StopWriterThread();
+
+	std::unique_lock file_lock(m_file_mutex);
+	std::unique_lock lock(m_mutex);
+	CloseLocked();
+	m_open = false;
+}
+
+void RecCodeCache::CloseLocked()
+{
+	if (m_stat_prefetched > 0)
+	{
+		DevCon.WriteLn("%s: %u of %u reads served by read-ahead, %u entries read ahead", m_name, m_stat_prefetch_hits,
+			m_stat_reads, m_stat_prefetched);
+	}
+	m_stat_reads = 0;
+	m_stat_prefetched = 0;
+	m_stat_prefetch_hits = 0;
+	m_prefetch_queue.clear();
+	m_prefetched.clear();
+	m_pending.clear();
+	m_pending_size = 0;
+
+	if (m_index_file)
+	{
+		// Usage information is only written back here, appending an entry for every hit isn't worth it.
+		if (m_index_dirty)
+		{
+			std::fclose(m_index_file);
+			m_index_file = FileSystem::OpenCFile(GetIndexFileName().c_str(), "wb");
+			if (!m_index_file || !WriteIndex(m_index_file))
+				Console.Error("Failed to write back index of '%s'", m_name);
+		}
+
+		if (m_index_file)
+			std::fclose(m_index_file);
+		m_index_file = nullptr;
+	}
+	m_index.clear();
+	m_index_dirty = false;
+	if (m_blob_file)
+	{
+		std::fclose(m_blob_file);
+		m_blob_file = nullptr;
+	}
+	m_blob_file_size = 0;
+}
+
+bool RecCodeCache::Clear()
+{
+	StopWriterThread();
+
+	{
+		std::unique_lock file_lock(m_file_mutex);
+		std::unique_lock lock(m_mutex);
+		CloseLocked();
+		if (!CreateNew(GetIndexFileName(), GetBlobFileName()))
+			return false;
+	}
+
+	StartWriterThread();
+	return true;
+}
+
+void RecCodeCache::GetKeys(u32 address, std::vector<Key>* keys) const
+{
+	std::unique_lock lock(m_mutex);
+	keys->clear();
+
+	auto range = m_index.equal_range(address);
+	for (auto it = range.first; it != range.second; ++it)
+		keys->push_back(it->second.key);
+}
+
+RecCodeCache::CacheIndexData* RecCodeCache::FindEntry(const Key& key)
+{
+	auto range = m_index.equal_range(key.address);
+	for (auto it = range.first; it != range.second; ++it)
+	{
+		if (it->second.key == key)
+			return &it->second;
+	}
+
+	return nullptr;
+}
+
+bool RecCodeCache::ReadBlob(const CacheIndexData& data, std::vector<u8>* out)
+{
+	out->resize(data.blob_size);
+	if (std::fseek(m_blob_file, data.file_offset, SEEK_SET) != 0 ||
+		std::fread(out->data(), data.blob_size, 1, m_blob_file) != 1)
+	{
+		Console.Error("Read blob from file failed");
+		return false;
+	}
+
+	return true;
+}
+
+bool RecCodeCache::Read(const Key& key, std::vector<u8>* data)
+{
+	std::unique_lock file_lock(m_file_mutex);
+	std::unique_lock lock(m_mutex);
+
+	CacheIndexData* entry = FindEntry(key);
+	if (!entry)
+		return false;
+
+	m_stat_reads++;
+
+	auto pit = std::find_if(m_prefetched.begin(), m_prefetched.end(),
+		[&key](const std::pair<Key, std::vector<u8>>& entry) { return (entry.first == key); });
+	if (pit != m_prefetched.end())
+	{
+		data->swap(pit->second);
+		m_prefetched.erase(pit);
+		m_stat_prefetch_hits++;
+	}
+	else if (entry->pending)
+	{
+		auto wit = std::find_if(m_pending.begin(), m_pending.end(), [&key](const PendingWrite& pw) { return (pw.key == key); });
+		if (wit == m_pending.end())
+			return false;
+
+		*data = wit->data;
+	}
+	else
+	{
+		// Entry offsets only change under the file lock, so the index lock can be dropped for the read.
+		const CacheIndexData idata = *entry;
+		lock.unlock();
+		if (!ReadBlob(idata, data))
+			return false;
+
+		lock.lock();
+		entry = FindEntry(key);
+		if (!entry)
+			return true;
+	}
+
+	if (entry->last_used != m_generation)
+	{
+		entry->last_used = m_generation;
+		m_index_dirty = true;
+	}
+
+	return true;
+}
+
+bool RecCodeCache::Write(const Key& key, const void* data, u32 size)
+{
+	std::unique_lock lock(m_mutex);
+
+	if (!m_blob_file || size > m_max_blob_size)
+		return false;
+
+	// Replacing an entry which hasn't been written yet just swaps the data.
+	auto pit = std::find_if(m_pending.begin(), m_pending.end(), [&key](const PendingWrite& pw) { return (pw.key == key); });
+	const u32 old_size = (pit != m_pending.end()) ? static_cast<u32>(pit->data.size()) : 0;
+	if ((m_pending_size - old_size + size) > MAX_PENDING_SIZE)
+		return false;
+
+	const u8* bytes = static_cast<const u8*>(data);
+	if (pit != m_pending.end())
+		pit->data.assign(bytes, bytes + size);
+	else
+		m_pending.push_back(PendingWrite{key, std::vector<u8>(bytes, bytes + size)});
+	m_pending_size = m_pending_size - old_size + size;
+
+	// Don't hand out a stale copy if the entry is being replaced.
+	m_prefetched.erase(std::remove_if(m_prefetched.begin(), m_prefetched.end(),
+						   [&key](const std::pair<Key, std::vector<u8>>& entry) { return (entry.first == key); }),
+		m_prefetched.end());
+
+	const CacheIndexData idata = {key, 0, size, m_generation, true};
+	if (CacheIndexData* entry = FindEntry(key))
+		*entry = idata;
+	else
+		m_index.emplace(key.address, idata);
+
+	const bool wake = (m_pending_size >= WRITE_BATCH_SIZE || NeedsEviction());
+	lock.unlock();
+	if (wake)
+		m_writer_cv.notify_one();
+
+	return true;
+}
+
+RecCodeCache::Statistics RecCodeCache::GetStatistics() const
+{
+	std::unique_lock lock(m_mutex);
+	return Statistics{m_stat_reads, m_stat_prefetched, m_stat_prefetch_hits};
+}
+
+void RecCodeCache::Prefetch(u32 address)
+{
+	std::unique_lock lock(m_mutex);
+	if (!m_prefetch_thread.joinable() || m_prefetch_queue.size() >= MAX_PREFETCH_QUEUE ||
+		m_index.find(address) == m_index.end() ||
+		std::find(m_prefetch_queue.begin(), m_prefetch_queue.end(), address) != m_prefetch_queue.end())
+	{
+		return;
+	}
+
+	m_prefetch_queue.push_back(address);
+	lock.unlock();
+	m_prefetch_cv.notify_one();
+}
+
+void RecCodeCache::StartPrefetchThread()
+{
+	m_prefetch_shutdown = false;
+	m_prefetch_thread = std::thread(&RecCodeCache::PrefetchThread, this);
+}
+
+void RecCodeCache::StopPrefetchThread()
+{
+	if (!m_prefetch_thread.joinable())
+		return;
+
+	{
+		std::unique_lock lock(m_mutex);
+		m_prefetch_shutdown = true;
+	}
+	m_prefetch_cv.notify_one();
+	m_prefetch_thread.join();
+}
+
+void RecCodeCache::PrefetchThread()
+{
+	Threading::SetNameOfCurrentThread(fmt::format("{} Read-Ahead", m_name).c_str());
+
+	std::vector<Key> keys;
+	std::unique_lock lock(m_mutex);
+	for (;;)
+	{
+		m_prefetch_cv.wait(lock, [this]() { return (m_prefetch_shutdown || !m_prefetch_queue.empty()); });
+		if (m_prefetch_shutdown)
+			break;
+
+		const u32 address = m_prefetch_queue.front();
+		m_prefetch_queue.pop_front();
+
+		keys.clear();
+		auto range = m_index.equal_range(address);
+		for (auto it = range.first; it != range.second; ++it)
+			keys.push_back(it->second.key);
+		lock.unlock();
+
+		// Entries are read one at a time, holding only the file lock, which keeps the index usable
+		// and means a Read() on the compiling thread waits for at most one blob.
+		for (const Key& key : keys)
+		{
+			std::unique_lock file_lock(m_file_mutex);
+			lock.lock();
+
+			const CacheIndexData* entry = FindEntry(key);
+			if (m_prefetch_shutdown || !m_blob_file || !entry || entry->pending ||
+				std::any_of(m_prefetched.begin(), m_prefetched.end(),
+					[&key](const std::pair<Key, std::vector<u8>>& entry) { return (entry.first == key); }))
+			{
+				lock.unlock();
+				continue;
+			}
+
+			const CacheIndexData idata = *entry;
+			lock.unlock();
+
+			std::vector<u8> data;
+			if (!ReadBlob(idata, &data))
+				break;
+
+			// Write() may have replaced the entry while we were reading it.
+			lock.lock();
+			entry = FindEntry(key);
+			if (entry && !entry->pending)
+			{
+				if (m_prefetched.size() >= MAX_PREFETCHED_ENTRIES)
+					m_prefetched.pop_front();
+				m_prefetched.emplace_back(key, std::move(data));
+				m_stat_prefetched++;
+			}
+			lock.unlock();
+		}
+
+		lock.lock();
+	}
+}
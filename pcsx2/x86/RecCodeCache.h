@@ -0,0 +1,203 @@
+// SPDX-FileCopyrightText: 2002-2024 PCSX2 Dev Team
+// SPDX-License-Identifier: LGPL-3.0+
+
+#pragma once
+
+#include "common/Pcsx2Defs.h"
+#include "common/emitter/x86types.h"
+
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Persistent on-disk store for translated guest code, shared by the recompilers.
+//
+// Entries are addressed by guest address plus the size and hash of the guest code they were
+// translated from. The contents of each entry are opaque to the store, the recompiler which
+// created it owns the format. The whole store is tagged with a "layout hash" supplied by the
+// recompiler, and thrown away when it changes (new executable, different recompiler
+// configuration). Host addresses are not part of it: translated code refers to the executable
+// image and the reserved memory regions, which move between runs, so recompilers store those
+// references as relocations against the regions and fix them up when loading.
+//
+// The store is made up of an index file, which is read in full on open, and a blob file,
+// which is only read on demand when a recompiler asks for an entry. New entries are collected
+// in memory and appended in batches by a writer thread. Each entry remembers the last session
+// it was used in; when the blob file would grow past its size cap, the writer thread drops the
+// least recently used entries and rewrites both files.
+//
+// Recompilers can ask for the entries of addresses they expect to need soon to be read ahead on
+// a worker thread, so the compiling thread doesn't wait for the disk when it gets there. This
+// only moves disk reads off the compiling thread; loading and fixing up the entry, or compiling
+// the code when there is none, still happens there. All methods may be called while the worker
+// is running.
+class RecCodeCache
+{
+public:
+	struct Key
+	{
+		u32 address;
+		u32 guest_size;
+		u64 guest_hash;
+
+		bool operator==(const Key& key) const;
+		bool operator!=(const Key& key) const;
+	};
+
+	/// Host memory which translated code can refer to outside of itself.
+	enum class HostRegion : u8
+	{
+		Image, // executable image, i.e. globals and helper functions
+		Data, // SysMemory data reserve (guest memory, vtlb maps)
+		Code, // SysMemory code reserve (dispatchers, other blocks)
+		Fastmem, // fastmem arena
+		Count
+	};
+
+#pragma pack(push, 1)
+	/// A reference from translated code to a host region, stored relative to the start of the
+	/// region so it stays valid when the region moves.
+	struct Relocation
+	{
+		u32 offset; // offset of the field in the code
+		u8 region; // HostRegion
+		u8 size; // 4 for displacements, 8 for absolute addresses
+		u8 disp_end; // distance from the start of the field to the end of the instruction
+		u8 pad;
+		u64 target; // offset of the target in the region
+	};
+#pragma pack(pop)
+
+	/// Reads since the store was opened, and how many of them were served by read-ahead.
+	struct Statistics
+	{
+		u32 reads;
+		u32 read_ahead;
+		u32 read_ahead_hits;
+	};
+
+	explicit RecCodeCache(const char* name);
+	~RecCodeCache();
+
+	/// Hashes guest code for use in a key.
+	static u64 HashGuestCode(const void* data, size_t size, u64 seed = 0);
+
+	/// Returns a hash of the build and the host features generated code depends on. Recompilers
+	/// should combine this with any configuration which affects the code they emit.
+	static u64 GetHostLayoutHash();
+
+	/// Creates a relocation for a reference recorded by the emitter in code starting at code.
+	/// Returns false if the reference points somewhere which can't be relocated (e.g. the heap).
+	static bool MakeRelocation(const u8* code, const x86Emitter::xRelativeRef& ref, Relocation* reloc);
+
+	/// Applies a relocation to code copied out of the store. Returns false if the target is out of
+	/// range of the field from the new location.
+	static bool ApplyRelocation(u8* code, u32 code_size, const Relocation& reloc);
+
+	__fi bool IsOpen() const { return m_open; }
+	__fi u64 GetLayoutHash() const { return m_layout_hash; }
+
+	/// Opens (or creates) the store for the given layout. Existing data is discarded if it was
+	/// written for a different layout. max_blob_size caps the size of the blob file. If prefetch
+	/// is set, a worker thread is started to service Prefetch() requests.
+	bool Open(u64 layout_hash, u32 max_blob_size, bool prefetch = false);
+
+	/// Closes the store, writing back the usage information of entries if it changed.
+	void Close();
+
+	/// Returns the keys of all entries for the specified guest address.
+	void GetKeys(u32 address, std::vector<Key>* keys) const;
+
+	/// Reads the data for an entry. Returns false if it does not exist or could not be read.
+	bool Read(const Key& key, std::vector<u8>* data);
+
+	/// Reads the entries for the specified guest address in the background, if there are any.
+	void Prefetch(u32 address);
+
+	/// Adds or replaces an entry. The data is written out later by the writer thread, which also
+	/// evicts least recently used entries if the store is full.
+	bool Write(const Key& key, const void* data, u32 size);
+
+	/// Removes all entries, e.g. when the data in the store is known to be bad.
+	bool Clear();
+
+	Statistics GetStatistics() const;
+
+private:
+	struct CacheIndexData
+	{
+		Key key;
+		u32 file_offset;
+		u32 blob_size;
+		u32 last_used;
+		bool pending; // not written yet, data is in m_pending
+	};
+
+	struct PendingWrite
+	{
+		Key key;
+		std::vector<u8> data;
+	};
+
+	using CacheIndex = std::unordered_multimap<u32, CacheIndexData>;
+
+	std::string GetIndexFileName() const;
+	std::string GetBlobFileName() const;
+
+	bool CreateNew(const std::string& index_filename, const std::string& blob_filename);
+	bool ReadExisting(const std::string& index_filename, const std::string& blob_filename);
+	bool WriteIndex(std::FILE* fp) const;
+	bool ReadBlob(const CacheIndexData& data, std::vector<u8>* out);
+	CacheIndexData* FindEntry(const Key& key);
+	void CloseLocked();
+
+	bool NeedsEviction() const;
+	bool Evict(u32 target_size);
+	void FlushPendingWrites();
+	void StartWriterThread();
+	void StopWriterThread();
+	void WriterThread();
+
+	void StartPrefetchThread();
+	void StopPrefetchThread();
+	void PrefetchThread();
+
+	const char* m_name;
+
+	std::FILE* m_index_file = nullptr;
+	std::FILE* m_blob_file = nullptr;
+
+	CacheIndex m_index;
+	u64 m_layout_hash = 0;
+	u32 m_generation = 0;
+	u32 m_blob_file_size = 0;
+	u32 m_max_blob_size = 0;
+	bool m_index_dirty = false;
+	bool m_open = false;
+
+	// Lock order is m_file_mutex, then m_mutex. m_file_mutex covers the files, m_mutex everything else.
+	std::mutex m_file_mutex;
+	mutable std::mutex m_mutex;
+
+	std::condition_variable m_writer_cv;
+	std::thread m_writer_thread;
+	std::deque<PendingWrite> m_pending;
+	u32 m_pending_size = 0;
+	bool m_writer_shutdown = false;
+
+	std::condition_variable m_prefetch_cv;
+	std::thread m_prefetch_thread;
+	std::deque<u32> m_prefetch_queue;
+	std::deque<std::pair<Key, std::vector<u8>>> m_prefetched;
+	bool m_prefetch_shutdown = false;
+
+	u32 m_stat_reads = 0;
+	u32 m_stat_prefetched = 0;
+	u32 m_stat_prefetch_hits = 0;
+};
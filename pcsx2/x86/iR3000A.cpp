@@ -24,6 +24,7 @@
 #include "common/FileSystem.h"
 #include "common/Path.h"
 #include "common/Perf.h"
+#include "common/Timer.h"
 #include "DebugTools/Breakpoints.h"
 
 #include "fmt/core.h"
@@ -41,6 +42,8 @@
 #include <zlib.h>
 #endif
 
+#include <unordered_set>
+
 using namespace x86Emitter;
 
 extern void psxBREAK();
@@ -81,6 +84,29 @@ u32 s_psxBlockCycles = 0; // cycles of current block recompiling
 static u32 s_savenBlockCycles = 0;
 static bool s_recompilingDelaySlot = false;
 
+// Superblocks. Blocks which were cut short because they ran into another block count down their
+// executions at entry. Once a block is hot it is thrown away, and recompiled straight through the
+// blocks it ran into, so the path is compiled as one unit without the link and branch test.
+// Counters belong to the block, and are reused once it's cleared.
+static constexpr u32 TIER_UP_THRESHOLD = 2048;
+static constexpr u32 TIER_COUNTER_COUNT = 4096;
+alignas(64) static u32 s_tierCounters[TIER_COUNTER_COUNT];
+static std::unordered_set<u32> s_tierHotBlocks;
+
+// Dispatcher benchmark. Counts how often compiled code goes through the dispatcher, how often
+// register jumps looked up their target inline instead, and how many blocks were entered, and logs
+// the rates once per second. Both kinds of dispatch are a recLUT lookup, so their sum is what
+// superblocks bring down; inline dispatches only move the lookup out of the dispatcher.
+struct DispatchStats
+{
+	u32 dispatcher_entries;
+	u32 inline_dispatches;
+	u32 block_entries;
+	u32 tier_ups;
+};
+static DispatchStats s_dispatchStats = {};
+static Common::Timer s_dispatchStatsTimer;
+
 static void iPsxBranchTest(u32 newpc, u32 cpuBranch);
 void psxRecompileNextInstruction(int delayslot);
 
@@ -151,6 +177,7 @@ static ZyanStatus ZydisFormatterPrintAddressAbsolute(const ZydisFormatter* forma
 // =====================================================================================================
 
 static void iopRecRecompile(u32 startpc);
+static void iopTierUp(u32 start, u32 sz);
 
 static const void* iopDispatcherEvent = nullptr;
 static const void* iopDispatcherReg = nullptr;
@@ -158,6 +185,7 @@ static const void* iopJITCompile = nullptr;
 static const void* iopJITCompileInBlock = nullptr;
 static const void* iopEnterRecompiledCode = nullptr;
 static const void* iopExitRecompiledCode = nullptr;
+static const void* iopDispatchTierUp = nullptr;
 
 static void recEventTest()
 {
@@ -190,20 +218,37 @@ static const void* _DynGen_JITCompileInBlock()
 	return retval;
 }
 
-// called when jumping to variable pc address
-static const void* _DynGen_DispatcherReg()
+// Jumps to the block for psxRegs.pc. Clobbers eax, ebx and ecx.
+static void _DynGen_JumpToPC()
 {
-	u8* retval = xGetPtr();
-
 	xMOV(eax, ptr[&psxRegs.pc]);
 	xMOV(ebx, eax);
 	xSHR(eax, 16);
 	xMOV(rcx, ptrNative[xComplexAddress(rcx, psxRecLUT, rax * wordsize)]);
 	xJMP(ptrNative[rbx * (wordsize / 4) + rcx]);
+}
+
+// called when jumping to variable pc address
+static const void* _DynGen_DispatcherReg()
+{
+	u8* retval = xGetPtr();
+
+	if (EmuConfig.Cpu.Recompiler.IOPDispatcherBenchmark)
+		xADD(ptr32[&s_dispatchStats.dispatcher_entries], 1);
+
+	_DynGen_JumpToPC();
 
 	return retval;
 }
 
+static const void* _DynGen_DispatchTierUp()
+{
+	u8* retval = xGetPtr();
+	xFastCall((void*)iopTierUp);
+	xJMP((void*)iopDispatcherReg);
+	return retval;
+}
+
 // --------------------------------------------------------------------------------------
 //  EnterRecompiledCode  - dynamic compilation stub!
 // --------------------------------------------------------------------------------------
@@ -246,8 +291,10 @@ static void _DynGen_Dispatchers()
 	iopJITCompile = _DynGen_JITCompile();
 	iopJITCompileInBlock = _DynGen_JITCompileInBlock();
 	iopEnterRecompiledCode = _DynGen_EnterRecompiledCode();
+	iopDispatchTierUp = _DynGen_DispatchTierUp();
 
 	recBlocks.SetJITCompile(iopJITCompile);
+	recBlocks.SetTierCounters(s_tierCounters, TIER_COUNTER_COUNT);
 
 	Perf::any.Register(start, xGetPtr() - start, "IOP Dispatcher");
 }
@@ -946,6 +993,10 @@ void recResetIOP()
 	recBlocks.Reset();
 	g_psxMaxRecMem = 0;
 
+	s_tierHotBlocks.clear();
+	s_dispatchStats = {};
+	s_dispatchStatsTimer.Reset();
+
 	psxbranch = 0;
 }
 
@@ -956,10 +1007,30 @@ static void recShutdown()
 	safe_free(s_pInstCache);
 	s_nInstCacheSize = 0;
 
+	s_tierHotBlocks.clear();
+
 	recPtr = nullptr;
 	recPtrEnd = nullptr;
 }
 
+static void recLogDispatchStats()
+{
+	const double seconds = s_dispatchStatsTimer.GetTimeSeconds();
+	if (seconds < 1.0)
+		return;
+
+	const u32 lookups = s_dispatchStats.dispatcher_entries + s_dispatchStats.inline_dispatches;
+	Console.WriteLn("IOP dispatcher: %.0f block lookups/sec (%.0f dispatcher, %.0f inline), %.0f blocks entered/sec, "
+					"%.1f%% of blocks looked up, %u superblocks",
+		lookups / seconds, s_dispatchStats.dispatcher_entries / seconds, s_dispatchStats.inline_dispatches / seconds,
+		s_dispatchStats.block_entries / seconds,
+		(s_dispatchStats.block_entries > 0) ? (100.0 * lookups / s_dispatchStats.block_entries) : 0.0,
+		s_dispatchStats.tier_ups);
+
+	s_dispatchStats = {};
+	s_dispatchStatsTimer.Reset();
+}
+
 static void iopClearRecLUT(BASEBLOCK* base, int count)
 {
 	for (int i = 0; i < count; i++)
@@ -994,6 +1065,9 @@ static __noinline s32 recExecuteBlock(s32 eeCycles)
 
 	((void(*)())iopEnterRecompiledCode)();
 
+	if (EmuConfig.Cpu.Recompiler.IOPDispatcherBenchmark) [[unlikely]]
+		recLogDispatchStats();
+
 	return psxRegs.iopBreak + psxRegs.iopCycleEE;
 }
 
@@ -1062,6 +1136,15 @@ static __fi void recClearIOP(u32 Addr, u32 Size)
 		pc += PSXREC_CLEARM(pc);
 }
 
+// Called when a block has run often enough to be worth recompiling along with the blocks it
+// runs into. The next compile of the block will see it in the hot set.
+static void iopTierUp(u32 start, u32 sz)
+{
+	s_tierHotBlocks.insert(HWADDR(start));
+	s_dispatchStats.tier_ups++;
+	recClearIOP(start, sz);
+}
+
 void psxSetBranchReg(u32 reg)
 {
 	psxbranch = 1;
@@ -1105,7 +1188,19 @@ void psxSetBranchReg(u32 reg)
 	_psxFlushCall(FLUSH_EVERYTHING);
 	iPsxBranchTest(0xffffffff, 1);
 
-	JMP32((uptr)iopDispatcherReg - ((uptr)x86Ptr + 5));
+	if (EmuConfig.Cpu.Recompiler.EnableIOPTiering)
+	{
+		// Look the target up here rather than in the dispatcher, which saves a jump, and gives
+		// the host's branch predictor a separate indirect jump to learn for each site.
+		if (EmuConfig.Cpu.Recompiler.IOPDispatcherBenchmark)
+			xADD(ptr32[&s_dispatchStats.inline_dispatches], 1);
+
+		_DynGen_JumpToPC();
+	}
+	else
+	{
+		JMP32((uptr)iopDispatcherReg - ((uptr)x86Ptr + 5));
+	}
 }
 
 void psxSetBranchImm(u32 imm)
@@ -1547,6 +1642,9 @@ static void iopRecRecompile(const u32 startpc)
 	xSetPtr(recPtr);
 	recPtr = xGetAlignedCallTarget();
 
+	const bool tier_up = !s_tierHotBlocks.empty() && s_tierHotBlocks.erase(HWADDR(startpc)) > 0;
+	bool ran_into_block = false;
+
 	s_pCurBlock = PSX_GETBLOCK(startpc);
 
 	pxAssert(s_pCurBlock->GetFnptr() == (uptr)iopJITCompile || s_pCurBlock->GetFnptr() == (uptr)iopJITCompileInBlock);
@@ -1586,11 +1684,13 @@ static void iopRecRecompile(const u32 startpc)
 	while (1)
 	{
 		BASEBLOCK* pblock = PSX_GETBLOCK(i);
-		if (i != startpc && pblock->GetFnptr() != (uptr)iopJITCompile && pblock->GetFnptr() != (uptr)iopJITCompileInBlock)
+		// Hot blocks carry on through the start of the next block.
+		if (i != startpc && !tier_up && pblock->GetFnptr() != (uptr)iopJITCompile && pblock->GetFnptr() != (uptr)iopJITCompileInBlock)
 		{
 			// branch = 3
 			willbranch3 = 1;
 			s_nEndBlock = i;
+			ran_into_block = EmuConfig.Cpu.Recompiler.EnableIOPTiering;
 			break;
 		}
 
@@ -1642,6 +1742,21 @@ static void iopRecRecompile(const u32 startpc)
 
 StartRecomp:
 
+	if (EmuConfig.Cpu.Recompiler.IOPDispatcherBenchmark)
+		xADD(ptr32[&s_dispatchStats.block_entries], 1);
+
+	// Count down executions of blocks which could be extended, and recompile them once they're hot.
+	u32* const counter = ran_into_block ? recBlocks.AllocTierCounter(s_pCurBlockEx, TIER_UP_THRESHOLD) : nullptr;
+	if (counter)
+	{
+		xSUB(ptr32[counter], 1);
+		xForwardJNZ8 not_hot;
+		xMOV(arg1regd, startpc);
+		xMOV(arg2regd, (s_nEndBlock - startpc) >> 2);
+		xJMP(iopDispatchTierUp);
+		not_hot.SetTarget();
+	}
+
 	s_nBlockFF = false;
 	if (s_branchTo == startpc)
 	{
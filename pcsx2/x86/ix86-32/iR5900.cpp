@@ -13,12 +13,15 @@
 #include "VMManager.h"
 #include "vtlb.h"
 #include "x86/BaseblockEx.h"
+#include "x86/RecCodeCache.h"
 #include "x86/iR5900.h"
 #include "x86/iR5900Analysis.h"
 
 #include "common/AlignedMalloc.h"
 #include "common/FastJmp.h"
 #include "common/Perf.h"
+#include "common/Threading.h"
+#include "common/Timer.h"
 
 // Only for MOVQ workaround.
 #include "common/emitter/internal.h"
@@ -36,6 +39,13 @@
 #include <zlib.h>
 #endif
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+
 using namespace x86Emitter;
 using namespace R5900;
 
@@ -85,6 +95,84 @@ static u32 s_nInstCacheSize = 0;
 
 static BASEBLOCK* s_pCurBlock = nullptr;
 static BASEBLOCKEX* s_pCurBlockEx = nullptr;
+
+// Persistent block cache. While a block is being captured, the emitter records every
+// displacement which refers to code outside the block, and we record the block links.
+// Link targets which haven't been compiled yet are read ahead on the cache's worker thread.
+static constexpr u32 BLOCK_CACHE_MAX_SIZE = 256 * _1mb;
+static RecCodeCache s_blockCache("ee_rec");
+static std::vector<xRelativeRef> s_blockCacheRefs;
+static std::vector<std::pair<s32*, u32>> s_blockCacheLinks;
+static std::vector<std::pair<uptr, LoadstoreBackpatchInfo>> s_blockCacheLoadStores;
+static std::vector<RecCodeCache::Key> s_blockCacheKeys;
+static std::vector<u8> s_blockCacheData;
+static bool s_blockCacheCapture = false;
+
+// Tiered compilation. Blocks which were cut short because they ran into another block count
+// down their executions at entry. Once a block is hot it is thrown away, and recompiled straight
+// through the blocks it ran into, so constants and allocated registers carry across and the link
+// and event test in between go away. Counters belong to the block, and are reused once it's cleared.
+static constexpr u32 TIER_UP_THRESHOLD = 2048;
+static constexpr u32 TIER_COUNTER_COUNT = 16384;
+alignas(64) static u32 s_tierCounters[TIER_COUNTER_COUNT];
+static std::unordered_set<u32> s_tierHotBlocks;
+
+struct TierStats
+{
+	u32 blocks;
+	Common::Timer::Value compile_time;
+};
+static TierStats s_tierStats[2] = {};
+static u32 s_tierUps = 0;
+
+// Copy of the counters above for the performance overlay, which reads them from the GS thread.
+// Written by the EE thread once per vsync, and whenever the counters are reset.
+static std::atomic<u32> s_tierUpsPublished{0};
+static std::atomic<u32> s_tierBlocksPublished[2] = {};
+static std::atomic<Common::Timer::Value> s_tierCompileTimePublished[2] = {};
+
+// Speculative compilation. The static successors of compiled blocks are queued, and compiled on a
+// worker thread while the EE thread sleeps in the frame limiter, so they're already in recLUT when
+// execution gets there. The recompiler's state (register allocation, constant propagation, cpuRegs.code,
+// the block lists and the code buffer) is shared, so the worker only runs while the EE thread is parked
+// waiting for it, never alongside guest code. Each speculative block sets a flag when it's first entered.
+static constexpr u32 SPECULATION_QUEUE_SIZE = 1024;
+static constexpr u32 SPECULATION_MAX_DEPTH = 2;
+static constexpr u32 SPECULATION_FLAG_COUNT = 16384;
+// Speculation stops this close to the end of the code buffer, it never causes a reset.
+static constexpr u32 SPECULATION_CODE_RESERVE = 4 * _1mb;
+
+struct SpeculationTarget
+{
+	u32 pc;
+	u32 depth;
+};
+static std::deque<SpeculationTarget> s_speculationQueue;
+// How many speculative blocks deep the block being compiled is, 0 if execution actually got there.
+static u32 s_speculationDepth = 0;
+alignas(64) static u8 s_speculationEntered[SPECULATION_FLAG_COUNT];
+static u32 s_speculationFlagsUsed = 0;
+
+struct SpeculationStats
+{
+	u32 queued;
+	u32 compiled;
+	Common::Timer::Value compile_time;
+};
+static SpeculationStats s_speculationStats = {};
+static std::atomic<u32> s_speculationQueuedPublished{0};
+static std::atomic<u32> s_speculationCompiledPublished{0};
+static std::atomic<u32> s_speculationEnteredPublished{0};
+static std::atomic<Common::Timer::Value> s_speculationCompileTimePublished{0};
+
+static std::thread s_speculationThread;
+static std::mutex s_speculationMutex;
+static std::condition_variable s_speculationCondition;
+static bool s_speculationWindowOpen = false;
+static bool s_speculationCompiling = false;
+static bool s_speculationQuit = false;
+static u32 s_speculationSavedCode = 0;
+
 u32 s_nEndBlock = 0; // what pc the current block ends
 u32 s_branchTo;
 static bool s_nBlockFF;
@@ -98,6 +186,9 @@ static u32 s_savenBlockCycles = 0;
 
 static void iBranchTest(u32 newpc = 0xffffffff);
 static void ClearRecLUT(BASEBLOCK* base, int count);
+static void recOpenBlockCache();
+static void recResetSpeculation();
+static void recStopSpeculationThread();
 static u32 scaleblockcycles();
 static void recExitExecution();
 
@@ -343,6 +434,7 @@ void recCall(void (*func)())
 
 static void recRecompile(const u32 startpc);
 static void dyna_block_discard(u32 start, u32 sz);
+static void dyna_tier_up(u32 start, u32 sz);
 static void dyna_page_reset(u32 start, u32 sz);
 
 static const void* DispatcherEvent = nullptr;
@@ -351,6 +443,7 @@ static const void* JITCompile = nullptr;
 static const void* JITCompileInBlock = nullptr;
 static const void* EnterRecompiledCode = nullptr;
 static const void* DispatchBlockDiscard = nullptr;
+static const void* DispatchTierUp = nullptr;
 static const void* DispatchPageReset = nullptr;
 
 static void recEventTest()
@@ -459,6 +552,14 @@ static const void* _DynGen_DispatchBlockDiscard()
 	return retval;
 }
 
+static const void* _DynGen_DispatchTierUp()
+{
+	u8* retval = xGetPtr();
+	xFastCall((const void*)dyna_tier_up);
+	xJMP(DispatcherReg);
+	return retval;
+}
+
 static const void* _DynGen_DispatchPageReset()
 {
 	u8* retval = xGetPtr();
@@ -480,9 +581,11 @@ static void _DynGen_Dispatchers()
 	JITCompileInBlock = _DynGen_JITCompileInBlock();
 	EnterRecompiledCode = _DynGen_EnterRecompiledCode();
 	DispatchBlockDiscard = _DynGen_DispatchBlockDiscard();
+	DispatchTierUp = _DynGen_DispatchTierUp();
 	DispatchPageReset = _DynGen_DispatchPageReset();
 
 	recBlocks.SetJITCompile(JITCompile);
+	recBlocks.SetTierCounters(s_tierCounters, TIER_COUNTER_COUNT);
 
 	Perf::any.Register(start, static_cast<u32>(xGetPtr() - start), "EE Dispatcher");
 }
@@ -568,6 +671,66 @@ static void recReserve()
 alignas(16) static u16 manual_page[Ps2MemSize::MainRam >> 12];
 alignas(16) static u8 manual_counter[Ps2MemSize::MainRam >> 12];
 
+static void recLogTierStats()
+{
+	if (s_tierUps > 0)
+	{
+		DevCon.WriteLn("EE tiering: %u tier-ups, tier 0: %u blocks in %.2f ms, tier 1: %u blocks in %.2f ms", s_tierUps,
+			s_tierStats[0].blocks, Common::Timer::ConvertValueToMilliseconds(s_tierStats[0].compile_time),
+			s_tierStats[1].blocks, Common::Timer::ConvertValueToMilliseconds(s_tierStats[1].compile_time));
+	}
+
+	s_tierStats[0] = {};
+	s_tierStats[1] = {};
+	s_tierUps = 0;
+	recPublishTierStatistics();
+}
+
+static u32 recCountSpeculativeBlocksEntered()
+{
+	return static_cast<u32>(std::count_if(s_speculationEntered, s_speculationEntered + s_speculationFlagsUsed,
+		[](u8 entered) { return entered != 0; }));
+}
+
+void recPublishTierStatistics()
+{
+	s_tierUpsPublished.store(s_tierUps, std::memory_order_relaxed);
+	for (u32 i = 0; i < std::size(s_tierStats); i++)
+	{
+		s_tierBlocksPublished[i].store(s_tierStats[i].blocks, std::memory_order_relaxed);
+		s_tierCompileTimePublished[i].store(s_tierStats[i].compile_time, std::memory_order_relaxed);
+	}
+
+	s_speculationQueuedPublished.store(s_speculationStats.queued, std::memory_order_relaxed);
+	s_speculationCompiledPublished.store(s_speculationStats.compiled, std::memory_order_relaxed);
+	s_speculationEnteredPublished.store(recCountSpeculativeBlocksEntered(), std::memory_order_relaxed);
+	s_speculationCompileTimePublished.store(s_speculationStats.compile_time, std::memory_order_relaxed);
+}
+
+R5900TierStatistics recGetTierStatistics()
+{
+	R5900TierStatistics stats;
+	stats.tier_ups = s_tierUpsPublished.load(std::memory_order_relaxed);
+	for (u32 i = 0; i < std::size(s_tierStats); i++)
+	{
+		stats.blocks[i] = s_tierBlocksPublished[i].load(std::memory_order_relaxed);
+		stats.compile_ms[i] = static_cast<float>(
+			Common::Timer::ConvertValueToMilliseconds(s_tierCompileTimePublished[i].load(std::memory_order_relaxed)));
+	}
+	return stats;
+}
+
+R5900SpeculationStatistics recGetSpeculationStatistics()
+{
+	R5900SpeculationStatistics stats;
+	stats.queued = s_speculationQueuedPublished.load(std::memory_order_relaxed);
+	stats.compiled = s_speculationCompiledPublished.load(std::memory_order_relaxed);
+	stats.entered = s_speculationEnteredPublished.load(std::memory_order_relaxed);
+	stats.compile_ms = static_cast<float>(
+		Common::Timer::ConvertValueToMilliseconds(s_speculationCompileTimePublished.load(std::memory_order_relaxed)));
+	return stats;
+}
+
 ////////////////////////////////////////////////////
 static void recResetRaw()
 {
@@ -592,16 +755,28 @@ static void recResetRaw()
 	mmap_ResetBlockTracking();
 	vtlb_ClearLoadStoreInfo();
 
+	recResetSpeculation();
+	recLogTierStats();
+	s_tierHotBlocks.clear();
+
+	recOpenBlockCache();
+
 	g_branch = 0;
 	g_resetEeScalingStats = true;
 }
 
 void recShutdown()
 {
+	recStopSpeculationThread();
+
 	safe_aligned_free(recRAMCopy);
 	safe_aligned_free(recLutReserve_RAM);
 
 	recBlocks.Reset();
+	s_blockCache.Close();
+	recResetSpeculation();
+	recLogTierStats();
+	s_tierHotBlocks.clear();
 
 	recRAM = recROM = recROM1 = recROM2 = nullptr;
 
@@ -1339,6 +1514,23 @@ u32 scaleblockcycles_clear()
 	return scaled;
 }
 
+static void recPrefetchCachedBlock(u32 pc);
+static void recQueueSpeculativeBlock(u32 pc);
+
+// Links a jump to the block at the specified (virtual) pc, remembering it if the block is
+// being captured for the block cache, since links have to be redone when the block is loaded.
+static void recLinkBlock(u32 pc, s32* jumpptr)
+{
+	if (s_blockCacheCapture)
+	{
+		s_blockCacheLinks.emplace_back(jumpptr, pc);
+		recPrefetchCachedBlock(pc);
+	}
+
+	recQueueSpeculativeBlock(pc);
+	recBlocks.Link(HWADDR(pc), jumpptr);
+}
+
 // Generates dynarec code for Event tests followed by a block dispatch (branch).
 // Parameters:
 //   newpc - address to jump to at the end of the block.  If newpc == 0xffffffff then
@@ -1376,7 +1568,7 @@ static void iBranchTest(u32 newpc)
 		if (newpc == 0xffffffff)
 			xJS(DispatcherReg);
 		else
-			recBlocks.Link(HWADDR(newpc), xJcc32(Jcc_Signed));
+			recLinkBlock(newpc, xJcc32(Jcc_Signed));
 
 		xJMP((void*)DispatcherEvent);
 	}
@@ -2003,6 +2195,16 @@ void dyna_block_discard(u32 start, u32 sz)
 	recClear(start, sz);
 }
 
+// Called when a block has run often enough to be worth recompiling along with the blocks it
+// runs into. The next compile of the block will see it in the hot set.
+void dyna_tier_up(u32 start, u32 sz)
+{
+	eeRecPerfLog.Write(Color_StrongGray, "Tiering up block @ 0x%08X  [size=%d]", start, sz * 4);
+	s_tierHotBlocks.insert(start);
+	s_tierUps++;
+	recClear(start, sz);
+}
+
 // called when a page under manual protection has been run enough times to be a candidate
 // for being reset under the faster vtlb write protection.  All blocks in the page are cleared
 // and the block is re-assigned for write protection.
@@ -2013,6 +2215,29 @@ void dyna_page_reset(u32 start, u32 sz)
 	mmap_MarkCountedRamPage(start);
 }
 
+enum class BlockProtection : u8
+{
+	Unchecked, // protected by the vtlb, or not in RAM
+	ManualCounted,
+	ManualUncounted,
+};
+
+// Returns the kind of self-modifying code check memory_protect_recompiled_code() will emit.
+static BlockProtection GetBlockProtection(u32 startpc)
+{
+	const u32 inpage_ptr = HWADDR(startpc);
+	const bool contains_thread_stack = ((startpc >> 12) == 0x81) || ((startpc >> 12) == 0x80001);
+
+	if (contains_thread_stack)
+		return BlockProtection::ManualUncounted;
+	else if (mmap_GetRamPageInfo(inpage_ptr) != ProtMode_Manual)
+		return BlockProtection::Unchecked;
+	else if (manual_counter[inpage_ptr >> 12] <= 3)
+		return BlockProtection::ManualCounted;
+	else
+		return BlockProtection::ManualUncounted;
+}
+
 static void memory_protect_recompiled_code(u32 startpc, u32 size)
 {
 	u32 inpage_ptr = HWADDR(startpc);
@@ -2167,7 +2392,7 @@ static bool recSkipTimeoutLoop(s32 reg, bool is_timeout_loop)
 	xMOV(ptr32[&cpuRegs.GPR.r[reg].UL[0]], edx); // write back new value of v0
 	xJNZ((void*)DispatcherEvent); // jump to dispatcher if new v0 is not zero (i.e. an event)
 	xMOV(ptr32[&cpuRegs.pc], s_nEndBlock); // otherwise end of loop
-	recBlocks.Link(HWADDR(s_nEndBlock), xJcc32());
+	recLinkBlock(s_nEndBlock, xJcc32());
 
 	g_branch = 1;
 	pc = s_nEndBlock;
@@ -2175,6 +2400,491 @@ static bool recSkipTimeoutLoop(s32 reg, bool is_timeout_loop)
 	return true;
 }
 
+////////////////////////////////////////////////////
+// Block Cache
+//
+// Blocks are stored with relocations for all references to code or data outside the block, and
+// the block links and fastmem loadstores contained in them. Loading a block copies it to recPtr
+// and fixes those up against wherever the executable and memory regions are in this run. Blocks
+// which refer to anything else (e.g. heap allocations) aren't stored.
+
+#pragma pack(push, 1)
+struct BlockCacheHeader
+{
+	u32 code_size;
+	u32 num_relocs;
+	u32 num_links;
+	u32 num_loadstores;
+	BlockProtection protection;
+};
+
+struct BlockCacheLink
+{
+	u32 offset;
+	u32 pc;
+};
+
+struct BlockCacheLoadStore
+{
+	u32 offset;
+	LoadstoreBackpatchInfo info;
+};
+#pragma pack(pop)
+
+static u64 recGetBlockCacheLayoutHash()
+{
+	const u64 layout[] = {
+		EmuConfig.Cpu.Recompiler.bitset,
+		EmuConfig.Cpu.FPUFPCR.bitmask,
+		EmuConfig.Speedhacks.bitset,
+		static_cast<u64>(static_cast<s64>(EmuConfig.Speedhacks.EECycleRate)),
+		EmuConfig.Speedhacks.EECycleSkip,
+		EmuConfig.Gamefixes.bitset,
+	};
+
+	return RecCodeCache::HashGuestCode(layout, sizeof(layout), RecCodeCache::GetHostLayoutHash());
+}
+
+static void recOpenBlockCache()
+{
+	// The Goemon hack resets the recompiler when the TLB changes behind our back, so don't bother.
+	if (!EmuConfig.Cpu.Recompiler.EnableEEBlockCache || EmuConfig.Gamefixes.GoemonTlbHack)
+	{
+		s_blockCache.Close();
+		return;
+	}
+
+	const u64 layout_hash = recGetBlockCacheLayoutHash();
+	if (s_blockCache.IsOpen() && s_blockCache.GetLayoutHash() == layout_hash)
+		return;
+
+	if (!s_blockCache.Open(layout_hash, BLOCK_CACHE_MAX_SIZE, true))
+		Console.Error("Failed to open EE block cache, blocks will not be cached.");
+}
+
+// size is in instructions.
+static RecCodeCache::Key recGetBlockCacheKey(u32 startpc, u32 size)
+{
+	// Constant addresses are translated through the TLB at compile time, so it's part of the key.
+	const u64 tlb_hash = RecCodeCache::HashGuestCode(tlb, sizeof(tlb));
+	return RecCodeCache::Key{startpc, size, RecCodeCache::HashGuestCode(PSM(startpc), size * 4, tlb_hash)};
+}
+
+R5900BlockCacheStatistics recGetBlockCacheStatistics()
+{
+	const RecCodeCache::Statistics stats = s_blockCache.GetStatistics();
+	return R5900BlockCacheStatistics{stats.reads, stats.read_ahead, stats.read_ahead_hits};
+}
+
+// Gets the cached versions of a block we're likely to run soon off the disk in the background.
+// Only the disk read happens there, the block is still loaded on the EE thread when it's reached.
+static void recPrefetchCachedBlock(u32 pc)
+{
+	if (!s_blockCache.IsOpen())
+		return;
+
+	const BASEBLOCKEX* block = recBlocks.Get(HWADDR(pc));
+	if (block && block->startpc == HWADDR(pc))
+		return;
+
+	s_blockCache.Prefetch(pc);
+}
+
+// Queues a successor of the block being compiled, unless it's already been compiled.
+// The most recent successors are the likeliest to run next, so they're taken first, and the
+// oldest are dropped when the queue is full.
+static void recQueueSpeculativeBlock(u32 pc)
+{
+	if (!EmuConfig.Cpu.Recompiler.EnableEESpeculativeCompile || s_speculationDepth >= SPECULATION_MAX_DEPTH)
+		return;
+
+	const BASEBLOCKEX* block = recBlocks.Get(HWADDR(pc));
+	if (block && block->startpc == HWADDR(pc))
+		return;
+
+	if (s_speculationQueue.size() >= SPECULATION_QUEUE_SIZE)
+		s_speculationQueue.pop_front();
+	s_speculationQueue.push_back({pc, s_speculationDepth + 1});
+	s_speculationStats.queued++;
+}
+
+// Whether a queued pc can be compiled without the EE having got there.
+static bool recCanCompileSpeculatively(u32 pc)
+{
+	if (pc & 3)
+		return false;
+
+	// Only RAM and ROM have blocks, anything else was a bogus branch target.
+	const uptr block = reinterpret_cast<uptr>(PC_GETBLOCK(pc));
+	if (block < reinterpret_cast<uptr>(recLutReserve_RAM) || block >= reinterpret_cast<uptr>(recLutReserve_RAM + recLutSize) ||
+		reinterpret_cast<const BASEBLOCK*>(block)->GetFnptr() != (uptr)JITCompile)
+	{
+		return false;
+	}
+
+	// Blocks may run on into the delay slot at the start of the next page.
+	if (!PSM(pc) || !PSM((pc & ~0xfffu) + 0x1000))
+		return false;
+
+	// Compiling these has side effects, or depends on the debugger, so leave them to the EE thread.
+	const u32 hwpc = HWADDR(pc);
+	if (hwpc == VMManager::Internal::GetCurrentELFEntryPoint() || hwpc == EELOAD_START ||
+		(g_eeloadMain && hwpc == HWADDR(g_eeloadMain)) || (g_eeloadExec && hwpc == HWADDR(g_eeloadExec)) ||
+		EmuConfig.Gamefixes.GoemonTlbHack || isBreakpointNeeded(pc) != 0 || isMemcheckNeeded(pc) != 0)
+	{
+		return false;
+	}
+
+	return true;
+}
+
+// Compiles the next queued block which still isn't there. Returns false once there's nothing left
+// which is worth doing. Only called on the speculation thread, while the EE thread is parked.
+static bool recCompileSpeculativeBlock()
+{
+	while (!s_speculationQueue.empty())
+	{
+		if (eeRecNeedsReset || (recPtr + SPECULATION_CODE_RESERVE) >= recPtrEnd ||
+			s_speculationFlagsUsed >= SPECULATION_FLAG_COUNT)
+		{
+			s_speculationQueue.clear();
+			break;
+		}
+
+		const SpeculationTarget target = s_speculationQueue.back();
+		s_speculationQueue.pop_back();
+		if (!recCanCompileSpeculatively(target.pc))
+			continue;
+
+		const Common::Timer timer;
+		s_speculationDepth = target.depth;
+		recRecompile(target.pc);
+		s_speculationDepth = 0;
+
+		s_speculationStats.compiled++;
+		s_speculationStats.compile_time += Common::Timer::GetCurrentValue() - timer.GetStartValue();
+		return !s_speculationQueue.empty();
+	}
+
+	return false;
+}
+
+static void recSpeculationThread()
+{
+	Threading::SetNameOfCurrentThread("EE Speculative Compile");
+
+	std::unique_lock<std::mutex> lock(s_speculationMutex);
+	for (;;)
+	{
+		s_speculationCondition.wait(lock, []() { return s_speculationQuit || s_speculationWindowOpen; });
+		if (s_speculationQuit)
+			break;
+
+		// The EE thread won't come back until we've finished the block, so the lock isn't needed for it.
+		s_speculationCompiling = true;
+		lock.unlock();
+		const bool more = recCompileSpeculativeBlock();
+		lock.lock();
+		s_speculationCompiling = false;
+		if (!more)
+			s_speculationWindowOpen = false;
+		s_speculationCondition.notify_all();
+	}
+}
+
+static void recStopSpeculationThread()
+{
+	if (!s_speculationThread.joinable())
+		return;
+
+	{
+		std::unique_lock<std::mutex> lock(s_speculationMutex);
+		s_speculationQuit = true;
+	}
+	s_speculationCondition.notify_all();
+	s_speculationThread.join();
+	s_speculationQuit = false;
+}
+
+// Called on the EE thread, with the speculation thread idle.
+static void recResetSpeculation()
+{
+	if (s_speculationStats.compiled > 0)
+	{
+		DevCon.WriteLn("EE speculation: %u queued, %u compiled in %.2f ms, %u entered", s_speculationStats.queued,
+			s_speculationStats.compiled, Common::Timer::ConvertValueToMilliseconds(s_speculationStats.compile_time),
+			recCountSpeculativeBlocksEntered());
+	}
+
+	s_speculationQueue.clear();
+	std::memset(s_speculationEntered, 0, s_speculationFlagsUsed);
+	s_speculationFlagsUsed = 0;
+	s_speculationStats = {};
+}
+
+bool recBeginIdleCompile()
+{
+	if (!EmuConfig.Cpu.Recompiler.EnableEESpeculativeCompile || s_speculationQueue.empty() || eeRecNeedsReset)
+		return false;
+
+	if (!s_speculationThread.joinable())
+		s_speculationThread = std::thread(recSpeculationThread);
+
+	// Compiling overwrites the opcode, which the EE thread could still be using.
+	s_speculationSavedCode = cpuRegs.code;
+	{
+		std::unique_lock<std::mutex> lock(s_speculationMutex);
+		s_speculationWindowOpen = true;
+	}
+	s_speculationCondition.notify_all();
+	return true;
+}
+
+void recEndIdleCompile()
+{
+	{
+		std::unique_lock<std::mutex> lock(s_speculationMutex);
+		s_speculationWindowOpen = false;
+		s_speculationCondition.wait(lock, []() { return !s_speculationCompiling; });
+	}
+	cpuRegs.code = s_speculationSavedCode;
+}
+
+static void recCommitBlockRange(u32 startpc, u32 endpc);
+static void recFinishBlock();
+
+static bool recLoadCachedBlock(u32 startpc)
+{
+	s_blockCache.GetKeys(startpc, &s_blockCacheKeys);
+	if (s_blockCacheKeys.empty())
+		return false;
+
+	const BlockProtection protection = GetBlockProtection(startpc);
+	for (const RecCodeCache::Key& key : s_blockCacheKeys)
+	{
+		// Same rules as recRecompile(): blocks can't cross pages, or run into compiled blocks or breakpoints.
+		const u32 endpc = startpc + key.guest_size * 4;
+		if (key.guest_size == 0 || ((startpc ^ (endpc - 4)) & ~0xfffu) != 0)
+			continue;
+
+		bool usable = true;
+		for (u32 i = startpc; i < endpc && usable; i += 4)
+		{
+			if (i != startpc)
+			{
+				const uptr fnptr = PC_GETBLOCK(i)->GetFnptr();
+				usable = (fnptr == (uptr)JITCompile || fnptr == (uptr)JITCompileInBlock);
+			}
+
+			usable = usable && isBreakpointNeeded(i) == 0 && isMemcheckNeeded(i) == 0;
+		}
+		if (!usable)
+			continue;
+
+		// Patches are applied while compiling, so the stored hash is of the patched code.
+		if (EmuConfig.EnablePatches)
+		{
+			for (u32 i = startpc; i < endpc; i += 4)
+				Patch::ApplyDynamicPatches(i);
+		}
+
+		if (recGetBlockCacheKey(startpc, key.guest_size) != key || !s_blockCache.Read(key, &s_blockCacheData))
+			continue;
+
+		BlockCacheHeader header;
+		if (s_blockCacheData.size() < sizeof(header))
+			continue;
+
+		std::memcpy(&header, s_blockCacheData.data(), sizeof(header));
+		const size_t expected_size = sizeof(header) + header.code_size +
+									 header.num_relocs * sizeof(RecCodeCache::Relocation) +
+									 header.num_links * sizeof(BlockCacheLink) +
+									 header.num_loadstores * sizeof(BlockCacheLoadStore);
+		if (s_blockCacheData.size() != expected_size || header.protection != protection ||
+			(recPtr + header.code_size) >= recPtrEnd)
+		{
+			continue;
+		}
+
+		const u8* relocs = s_blockCacheData.data() + sizeof(header) + header.code_size;
+		const u8* links = relocs + header.num_relocs * sizeof(RecCodeCache::Relocation);
+		const u8* loadstores = links + header.num_links * sizeof(BlockCacheLink);
+
+		// Don't bring back fastmem accesses which have since faulted.
+		for (u32 i = 0; i < header.num_loadstores && usable; i++)
+		{
+			BlockCacheLoadStore ls;
+			std::memcpy(&ls, loadstores + i * sizeof(ls), sizeof(ls));
+			usable = !vtlb_IsFaultingPC(ls.info.guest_pc);
+		}
+		if (!usable)
+			continue;
+
+		u8* code = recPtr;
+		std::memcpy(code, s_blockCacheData.data() + sizeof(header), header.code_size);
+
+		for (u32 i = 0; i < header.num_relocs && usable; i++)
+		{
+			RecCodeCache::Relocation reloc;
+			std::memcpy(&reloc, relocs + i * sizeof(reloc), sizeof(reloc));
+			usable = RecCodeCache::ApplyRelocation(code, header.code_size, reloc);
+		}
+		if (!usable)
+			continue;
+
+		for (u32 i = 0; i < header.num_links; i++)
+		{
+			BlockCacheLink link;
+			std::memcpy(&link, links + i * sizeof(link), sizeof(link));
+			recBlocks.Link(HWADDR(link.pc), reinterpret_cast<s32*>(code + link.offset));
+			recPrefetchCachedBlock(link.pc);
+			recQueueSpeculativeBlock(link.pc);
+		}
+
+		for (u32 i = 0; i < header.num_loadstores; i++)
+		{
+			BlockCacheLoadStore ls;
+			std::memcpy(&ls, loadstores + i * sizeof(ls), sizeof(ls));
+			vtlb_AddLoadStoreInfo(reinterpret_cast<uptr>(code + ls.offset), ls.info);
+		}
+
+		// Manual checks are part of the code, but vtlb protection still has to be set up.
+		if (protection == BlockProtection::Unchecked)
+			memory_protect_recompiled_code(startpc, key.guest_size);
+
+		xSetPtr(code + header.code_size);
+		pc = endpc;
+		recCommitBlockRange(startpc, endpc);
+		recFinishBlock();
+		return true;
+	}
+
+	return false;
+}
+
+static void recStoreCachedBlock(u32 startpc, const u8* code, u32 code_size, BlockProtection protection)
+{
+	const uptr code_start = reinterpret_cast<uptr>(code);
+	const uptr code_end = code_start + code_size;
+
+	BlockCacheHeader header = {};
+	header.code_size = code_size;
+	header.protection = protection;
+
+	s_blockCacheData.resize(sizeof(header));
+	s_blockCacheData.insert(s_blockCacheData.end(), code, code + code_size);
+
+	for (const xRelativeRef& ref : s_blockCacheRefs)
+	{
+		// Displacements within the block stay valid when it's moved, absolute addresses don't.
+		const uptr target = reinterpret_cast<uptr>(ref.target);
+		if (target >= code_start && target < code_end)
+		{
+			if (ref.absolute)
+				return;
+
+			continue;
+		}
+
+		// Short jumps out of the block can't be relocated, but we never emit those anyway.
+		RecCodeCache::Relocation reloc;
+		if (!RecCodeCache::MakeRelocation(code, ref, &reloc))
+			return;
+
+		s_blockCacheData.insert(s_blockCacheData.end(), reinterpret_cast<const u8*>(&reloc),
+			reinterpret_cast<const u8*>(&reloc) + sizeof(reloc));
+		header.num_relocs++;
+	}
+
+	for (const auto& [jumpptr, pc] : s_blockCacheLinks)
+	{
+		const BlockCacheLink link = {static_cast<u32>(reinterpret_cast<u8*>(jumpptr) - code), pc};
+		s_blockCacheData.insert(s_blockCacheData.end(), reinterpret_cast<const u8*>(&link),
+			reinterpret_cast<const u8*>(&link) + sizeof(link));
+		header.num_links++;
+	}
+
+	vtlb_GetLoadStoreInfo(code_start, code_size, &s_blockCacheLoadStores);
+	for (const auto& [code_address, info] : s_blockCacheLoadStores)
+	{
+		const BlockCacheLoadStore ls = {static_cast<u32>(code_address - code_start), info};
+		s_blockCacheData.insert(s_blockCacheData.end(), reinterpret_cast<const u8*>(&ls),
+			reinterpret_cast<const u8*>(&ls) + sizeof(ls));
+		header.num_loadstores++;
+	}
+
+	std::memcpy(s_blockCacheData.data(), &header, sizeof(header));
+	s_blockCache.Write(recGetBlockCacheKey(startpc, s_pCurBlockEx->size), s_blockCacheData.data(),
+		static_cast<u32>(s_blockCacheData.size()));
+}
+
+// Updates block tracking once the guest range of the current block is known.
+static void recCommitBlockRange(u32 startpc, u32 endpc)
+{
+	pxAssert((endpc - startpc) >> 2 <= 0xffff);
+	s_pCurBlockEx->size = (endpc - startpc) >> 2;
+
+	if (HWADDR(endpc) <= Ps2MemSize::MainRam)
+	{
+		BASEBLOCKEX* oldBlock;
+		int i;
+
+		i = recBlocks.LastIndex(HWADDR(endpc) - 4);
+		while ((oldBlock = recBlocks[i--]))
+		{
+			if (oldBlock == s_pCurBlockEx)
+				continue;
+			if (oldBlock->startpc >= HWADDR(endpc))
+				continue;
+			if ((oldBlock->startpc + oldBlock->size * 4) <= HWADDR(startpc))
+				break;
+
+			if (memcmp(&recRAMCopy[oldBlock->startpc / 4], PSM(oldBlock->startpc),
+					oldBlock->size * 4))
+			{
+				recClear(startpc, (endpc - startpc) / 4);
+				s_pCurBlockEx = recBlocks.Get(HWADDR(startpc));
+				pxAssert(s_pCurBlockEx->startpc == HWADDR(startpc));
+				break;
+			}
+		}
+
+		memcpy(&recRAMCopy[HWADDR(startpc) / 4], PSM(startpc), endpc - startpc);
+	}
+
+	s_pCurBlock->SetFnptr((uptr)recPtr);
+
+	for (u32 i = 1; i < static_cast<u32>(s_pCurBlockEx->size); i++)
+	{
+		if ((uptr)JITCompile == s_pCurBlock[i].GetFnptr())
+			s_pCurBlock[i].SetFnptr((uptr)JITCompileInBlock);
+	}
+
+	if (!(endpc & 0x10000000))
+		maxrecmem = std::max((endpc & ~0xa0000000), maxrecmem);
+}
+
+// Finishes off the current block once all its code has been emitted.
+static void recFinishBlock()
+{
+	pxAssert(xGetPtr() < recPtrEnd);
+
+	s_pCurBlockEx->x86size = static_cast<u32>(xGetPtr() - recPtr);
+
+#if 0
+	// Example: Dump both x86/EE code
+	if (s_pCurBlockEx->startpc == 0x456630) {
+		iDumpBlock(s_pCurBlockEx->startpc, s_pCurBlockEx->size*4, s_pCurBlockEx->fnptr, s_pCurBlockEx->x86size);
+	}
+#endif
+	Perf::ee.RegisterPC((void*)s_pCurBlockEx->fnptr, s_pCurBlockEx->x86size, s_pCurBlockEx->startpc);
+
+	recPtr = xGetPtr();
+
+	s_pCurBlock = nullptr;
+	s_pCurBlockEx = nullptr;
+}
+
 static void recRecompile(const u32 startpc)
 {
 	u32 i = 0;
@@ -2198,6 +2908,10 @@ static void recRecompile(const u32 startpc)
 	xSetPtr(recPtr);
 	recPtr = xGetAlignedCallTarget();
 
+	const Common::Timer compile_timer;
+	const bool tier_up = !s_tierHotBlocks.empty() && s_tierHotBlocks.erase(HWADDR(startpc)) > 0;
+	bool ran_into_block = false;
+
 	s_pCurBlock = PC_GETBLOCK(startpc);
 
 	pxAssert(s_pCurBlock->GetFnptr() == (uptr)JITCompile || s_pCurBlock->GetFnptr() == (uptr)JITCompileInBlock);
@@ -2217,6 +2931,24 @@ static void recRecompile(const u32 startpc)
 			g_eeloadMain = ((EELOAD_START + 0xa0) & 0xf0000000U) | (mainjump << 2 & 0x0fffffffU);
 	}
 
+	// Hooked blocks depend on more than the guest code, and breakpoints are compiled individually.
+	// Hot blocks overlap the blocks they ran into, which cached blocks are not allowed to do.
+	// Speculative blocks set a flag belonging to this session.
+	const bool use_block_cache = s_blockCache.IsOpen() && !tier_up && s_speculationDepth == 0 &&
+								 !(g_eeloadMain && HWADDR(startpc) == HWADDR(g_eeloadMain)) &&
+								 !(g_eeloadExec && HWADDR(startpc) == HWADDR(g_eeloadExec)) &&
+								 isBreakpointNeeded(startpc) == 0 && isMemcheckNeeded(startpc) == 0;
+	if (use_block_cache)
+	{
+		if (recLoadCachedBlock(startpc))
+			return;
+
+		s_blockCacheRefs.clear();
+		s_blockCacheLinks.clear();
+		xRelativeRefs = &s_blockCacheRefs;
+		s_blockCacheCapture = true;
+	}
+
 	if (g_eeloadMain && HWADDR(startpc) == HWADDR(g_eeloadMain))
 	{
 		xFastCall((void*)eeloadHook);
@@ -2329,10 +3061,12 @@ static void recRecompile(const u32 startpc)
 				break;
 			}
 
-			if (pblock->GetFnptr() != (uptr)JITCompile && pblock->GetFnptr() != (uptr)JITCompileInBlock)
+			// Hot blocks carry on through the start of the next block.
+			if (!tier_up && pblock->GetFnptr() != (uptr)JITCompile && pblock->GetFnptr() != (uptr)JITCompileInBlock)
 			{
 				willbranch3 = 1;
 				s_nEndBlock = i;
+				ran_into_block = EmuConfig.Cpu.Recompiler.EnableEETiering;
 				break;
 			}
 		}
@@ -2592,8 +3326,31 @@ StartRecomp:
 #endif
 
 	// Detect and handle self-modified code
+	const BlockProtection protection = GetBlockProtection(startpc);
 	memory_protect_recompiled_code(startpc, (s_nEndBlock - startpc) >> 2);
 
+	// Count down executions of blocks which could be extended, and recompile them once they're hot.
+	// The counter lives outside the block and belongs to this session, so the block can't be cached.
+	u32* const counter = ran_into_block ? recBlocks.AllocTierCounter(s_pCurBlockEx, TIER_UP_THRESHOLD) : nullptr;
+	if (counter)
+	{
+		if (s_blockCacheCapture)
+		{
+			xRelativeRefs = nullptr;
+			s_blockCacheCapture = false;
+		}
+
+		xSUB(ptr32[counter], 1);
+		xForwardJNZ8 not_hot;
+		xMOV(arg1regd, HWADDR(startpc));
+		xMOV(arg2regd, (s_nEndBlock - startpc) >> 2);
+		xJMP(DispatchTierUp);
+		not_hot.SetTarget();
+	}
+
+	if (s_speculationDepth > 0)
+		xMOV(ptr8[&s_speculationEntered[s_speculationFlagsUsed++]], 1);
+
 	// Skip Recompilation if sceMpegIsEnd Pattern detected
 	const bool doRecompilation = !skipMPEG_By_Pattern(startpc) && !recSkipTimeoutLoop(timeout_reg, is_timeout_loop);
 
@@ -2635,47 +3392,7 @@ StartRecomp:
 		}
 	}
 
-	pxAssert((pc - startpc) >> 2 <= 0xffff);
-	s_pCurBlockEx->size = (pc - startpc) >> 2;
-
-	if (HWADDR(pc) <= Ps2MemSize::MainRam)
-	{
-		BASEBLOCKEX* oldBlock;
-		int i;
-
-		i = recBlocks.LastIndex(HWADDR(pc) - 4);
-		while ((oldBlock = recBlocks[i--]))
-		{
-			if (oldBlock == s_pCurBlockEx)
-				continue;
-			if (oldBlock->startpc >= HWADDR(pc))
-				continue;
-			if ((oldBlock->startpc + oldBlock->size * 4) <= HWADDR(startpc))
-				break;
-
-			if (memcmp(&recRAMCopy[oldBlock->startpc / 4], PSM(oldBlock->startpc),
-					oldBlock->size * 4))
-			{
-				recClear(startpc, (pc - startpc) / 4);
-				s_pCurBlockEx = recBlocks.Get(HWADDR(startpc));
-				pxAssert(s_pCurBlockEx->startpc == HWADDR(startpc));
-				break;
-			}
-		}
-
-		memcpy(&recRAMCopy[HWADDR(startpc) / 4], PSM(startpc), pc - startpc);
-	}
-
-	s_pCurBlock->SetFnptr((uptr)recPtr);
-
-	for (i = 1; i < static_cast<u32>(s_pCurBlockEx->size); i++)
-	{
-		if ((uptr)JITCompile == s_pCurBlock[i].GetFnptr())
-			s_pCurBlock[i].SetFnptr((uptr)JITCompileInBlock);
-	}
-
-	if (!(pc & 0x10000000))
-		maxrecmem = std::max((pc & ~0xa0000000), maxrecmem);
+	recCommitBlockRange(startpc, pc);
 
 	if (g_branch == 2)
 	{
@@ -2711,29 +3428,25 @@ StartRecomp:
 			{
 				xMOV(ptr32[&cpuRegs.pc], pc);
 				xADD(ptr32[&cpuRegs.cycle], scaleblockcycles());
-				recBlocks.Link(HWADDR(pc), xJcc32());
+				recLinkBlock(pc, xJcc32());
 			}
 		}
 	}
 
-	pxAssert(xGetPtr() < recPtrEnd);
-
-	s_pCurBlockEx->x86size = static_cast<u32>(xGetPtr() - recPtr);
-
-#if 0
-	// Example: Dump both x86/EE code
-	if (startpc == 0x456630) {
-		iDumpBlock(s_pCurBlockEx->startpc, s_pCurBlockEx->size*4, s_pCurBlockEx->fnptr, s_pCurBlockEx->x86size);
+	if (s_blockCacheCapture)
+	{
+		xRelativeRefs = nullptr;
+		s_blockCacheCapture = false;
+		recStoreCachedBlock(startpc, recPtr, static_cast<u32>(xGetPtr() - recPtr), protection);
 	}
-#endif
-	Perf::ee.RegisterPC((void*)s_pCurBlockEx->fnptr, s_pCurBlockEx->x86size, s_pCurBlockEx->startpc);
-
-	recPtr = xGetPtr();
 
 	pxAssert((g_cpuHasConstReg & g_cpuFlushedConstReg) == g_cpuHasConstReg);
 
-	s_pCurBlock = nullptr;
-	s_pCurBlockEx = nullptr;
+	TierStats& stats = s_tierStats[tier_up ? 1 : 0];
+	stats.blocks++;
+	stats.compile_time += Common::Timer::GetCurrentValue() - compile_timer.GetStartValue();
+
+	recFinishBlock();
 }
 
 R5900cpu recCpu = {
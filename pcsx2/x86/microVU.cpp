@@ -64,6 +64,10 @@ void mVUreset(microVU& mVU, bool resetReserve)
 	mVU.prog.x86start = xGetAlignedCallTarget();
 	mVU.prog.x86ptr   = mVU.prog.x86start;
 
+	// Config isn't final at reserve time, so the program cache is (re)opened here
+	if (resetReserve)
+		mVUopenDiskCache(mVU);
+
 	for (u32 i = 0; i < (mVU.progSize / 2); i++)
 	{
 		if (!mVU.prog.prog[i])
@@ -85,6 +89,8 @@ void mVUreset(microVU& mVU, bool resetReserve)
 // Free Allocated Resources
 void mVUclose(microVU& mVU)
 {
+	mVUcloseDiskCache(mVU);
+
 	// Delete Programs and Block Managers
 	for (u32 i = 0; i < (mVU.progSize / 2); i++)
 	{
@@ -17,6 +17,7 @@
 #include "iR5900.h"
 #include "R5900OpcodeTables.h"
 #include "common/emitter/x86emitter.h"
+#include "x86/RecCodeCache.h"
 #include "microVU_Misc.h"
 #include "microVU_IR.h"
 #include "microVU_Profiler.h"
@@ -77,6 +78,44 @@ struct microProgManager
 };
 
 static const uint mVUcacheSafeZone =  3; // Safe-Zone for program recompilation (in megabytes)
+static const uint mVUdiskCacheSize = 64; // Size limit of the on-disk program cache (in megabytes)
+
+// Things recorded while compiling a block (and the blocks compiled along with it) for the
+// on-disk program cache, see microVU_DiskCache.inl
+struct microDiskCapture
+{
+	struct Block
+	{
+		microBlock* pBlock; // Block in the block manager
+		u32 pc;             // Start PC of the block
+	};
+	struct Link
+	{
+		u8* field;             // rel32 field of a jump to another block
+		const void* target;    // Where it jumped to at the time
+		u32 pc;                // Start PC of the target block
+		microRegInfo pState;   // Pipeline state the target block was looked up with
+	};
+	struct Ptr
+	{
+		u8* field;       // imm64 field holding a microBlock address
+		const void* ptr; // The address
+	};
+	struct Range
+	{
+		s32 pc;
+		bool isStartPC;
+	};
+
+	bool active;    // Currently recording
+	bool cacheable; // Nothing was emitted which can't be stored
+	std::vector<x86Emitter::xRelativeRef> refs;
+	std::vector<Block> blocks;
+	std::vector<Link> links;
+	std::vector<Ptr> ptrs;
+	std::vector<Range> ranges; // Calls to mVUsetupRange(), replayed on load
+	std::vector<u8> data;
+};
 
 struct microVU
 {
@@ -99,6 +138,8 @@ struct microVU
 	microProfiler                  profiler; // Opcode Profiler
 	std::unique_ptr<microRegAlloc> regAlloc; // Reg Alloc Class
 	std::FILE*                     logFile;  // Log File Pointer
+	std::unique_ptr<RecCodeCache>  diskCache; // On-disk Program Cache
+	microDiskCapture               capture;   // Recording state for the on-disk Program Cache
 
 	u8* cache;        // Dynarec Cache Start (where we will start writing the recompiled code to)
 	u8* startFunct;   // Function Ptr to the recompiler dispatcher (start)
@@ -318,6 +359,7 @@ void sortVector(T& v)
 #include "microVU_Lower.inl"
 #include "microVU_Tables.inl"
 #include "microVU_Flags.inl"
+#include "microVU_DiskCache.inl"
 #include "microVU_Branch.inl"
 #include "microVU_Compile.inl"
 #include "microVU_Execute.inl"
@@ -280,7 +280,10 @@ void normBranchCompile(microVU& mVU, u32 branchPC)
 	blockCreate(branchPC / 8);
 	pBlock = mVUblocks[branchPC / 8]->search(mVU, (microRegInfo*)&mVUregs);
 	if (pBlock)
+	{
 		xJMP(pBlock->x86ptrStart);
+		mVUrecordLastLink(mVU, branchPC, mVUregs);
+	}
 	else
 		mVUcompile(mVU, branchPC, (uptr)&mVUregs);
 }
@@ -305,9 +308,9 @@ void normJumpCompile(mV, microFlagCycles& mFC, bool isEvilJump)
 	else
 		xMOV(arg1regd, ptr32[&mVU.branch]);
 	if (doJumpCaching)
-		xLoadFarAddr(arg2reg, mVUpBlock);
+		mVUloadBlockAddr(mVU, arg2reg, mVUpBlock);
 	else
-		xLoadFarAddr(arg2reg, &mVUpBlock->pStateEnd);
+		mVUloadBlockAddr(mVU, arg2reg, &mVUpBlock->pStateEnd);
 
 	if (mVUup.eBit && isEvilJump) // E-bit EvilJump
 	{
@@ -380,7 +383,7 @@ void normBranch(mV, microFlagCycles& mFC)
 		u32 tempPC = iPC;
 
 		memcpy(&mVUpBlock->pStateEnd, &mVUregs, sizeof(microRegInfo));
-		xLoadFarAddr(rax, &mVUpBlock->pStateEnd);
+		mVUloadBlockAddr(mVU, rax, &mVUpBlock->pStateEnd);
 		xCALL((void*)mVU.copyPLState);
 
 		mVUsetupBranch(mVU, mFC);
@@ -475,7 +478,7 @@ void condBranch(mV, microFlagCycles& mFC, int JMPcc)
 		u32 tempPC = iPC;
 
 		memcpy(&mVUpBlock->pStateEnd, &mVUregs, sizeof(microRegInfo));
-		xLoadFarAddr(rax, &mVUpBlock->pStateEnd);
+		mVUloadBlockAddr(mVU, rax, &mVUpBlock->pStateEnd);
 		xCALL((void*)mVU.copyPLState);
 
 		mVUendProgram(mVU, &mFC, 3);
@@ -527,12 +530,14 @@ void condBranch(mV, microFlagCycles& mFC, int JMPcc)
 		incPC(3);
 		microBlock* bBlock;
 		incPC2(1); // Check if Branch Non-Taken Side has already been recompiled
+		const u32 nonTakenPC = xPC;
 		blockCreate(iPC / 2);
 		bBlock = mVUblocks[iPC / 2]->search(mVU, (microRegInfo*)&mVUregs);
 		incPC2(-1);
 		if (bBlock) // Branch non-taken has already been compiled
 		{
 			xJcc(xInvertCond((JccComparisonType)JMPcc), bBlock->x86ptrStart);
+			mVUrecordLastLink(mVU, nonTakenPC, mVUregs);
 			incPC(-3); // Go back to branch opcode (to get branch imm addr)
 			normBranchCompile(mVU, branchAddr(mVU));
 		}
@@ -549,8 +554,10 @@ void condBranch(mV, microFlagCycles& mFC, int JMPcc)
 
 			iPC = bPC;
 			incPC(-3); // Go back to branch opcode (to get branch imm addr)
-			uptr jumpAddr = (uptr)mVUblockFetch(mVU, branchAddr(mVU), (uptr)&regBackup);
+			const u32 takenPC = branchAddr(mVU);
+			uptr jumpAddr = (uptr)mVUblockFetch(mVU, takenPC, (uptr)&regBackup);
 			*ajmp = (jumpAddr - ((uptr)ajmp + 4));
+			mVUrecordLink(mVU, (u8*)ajmp, (void*)jumpAddr, takenPC, regBackup);
 		}
 	}
 }
@@ -36,6 +36,8 @@ __fi void mVUcheckIsSame(mV)
 void mVUsetupRange(microVU& mVU, s32 pc, bool isStartPC)
 {
 	std::deque<microRange>*& ranges = mVUcurProg.ranges;
+	if (mVU.capture.active)
+		mVU.capture.ranges.push_back({pc, isStartPC});
 	if (pc > (s64)mVU.microMemSize)
 	{
 		Console.Error("microVU%d: PC outside of VU memory PC=0x%04x", mVU.index, pc);
@@ -245,6 +247,7 @@ __fi void handleBadOp(mV, int count)
 #ifdef PCSX2_DEVBUILD
 	if (mVUinfo.isBadOp)
 	{
+		mVU.capture.cacheable = false; // Program index is embedded
 		mVUbackupRegs(mVU, true);
 		if (!isVU1) xFastCall(mVUbadOp0, mVU.prog.cur->idx, xPC);
 		else        xFastCall(mVUbadOp1, mVU.prog.cur->idx, xPC);
@@ -487,7 +490,7 @@ void mVUtestCycles(microVU& mVU, microFlagCycles& mFC)
 
 	xForwardJNS32 skip;
 
-	xLoadFarAddr(rax, &mVUpBlock->pState);
+	mVUloadBlockAddr(mVU, rax, &mVUpBlock->pState);
 	xCALL((void*)mVU.copyPLState);
 
 	if (EmuConfig.Gamefixes.VUSyncHack || EmuConfig.Gamefixes.FullVU0SyncHack)
@@ -547,6 +550,8 @@ __fi void mVUinitFirstPass(microVU& mVU, uptr pState, u8* thisPtr)
 	}
 	mVUblock.x86ptrStart = thisPtr;
 	mVUpBlock = mVUblocks[mVUstartPC / 2]->add(mVU, &mVUblock); // Add this block to block manager
+	if (mVU.capture.active)
+		mVU.capture.blocks.push_back({mVUpBlock, (mVUstartPC / 2) * 8});
 	mVUregs.needExactMatch = (mVUpBlock->pState.blockType) ? 7 : 0; // ToDo: Fix 1-Op block flag linking (MGS2:Demo/Sly Cooper)
 	mVUregs.blockType = 0;
 	mVUregs.viBackUp  = 0;
@@ -1006,6 +1011,8 @@ __fi void* mVUentryGet(microVU& mVU, microBlockManager* block, u32 startPC, uptr
 	microBlock* pBlock = block->search(mVU, (microRegInfo*)pState);
 	if (pBlock)
 		return pBlock->x86ptrStart;
+	else if (mVU.diskCache && !mVU.capture.active)
+		return mVUcompileCached(mVU, startPC, pState);
 	else
 		return mVUcompile(mVU, startPC, pState);
 }
@@ -0,0 +1,416 @@
+// SPDX-FileCopyrightText: 2002-2024 PCSX2 Dev Team
+// SPDX-License-Identifier: LGPL-3.0+
+
+#pragma once
+
+//------------------------------------------------------------------
+// On-disk Program Cache
+//------------------------------------------------------------------
+// The unit of caching is everything emitted by one top-level mVUcompile() call, i.e. a block
+// together with the blocks it compiled along the way (branch targets, the non-taken side of
+// conditional branches). It is keyed by the start PC, the pipeline state it was entered with
+// and a hash of the whole micro memory, so it can be loaded back into any program instance
+// which has the same code.
+//
+// While compiling, the emitter reports every displacement, and the hooks below record the
+// blocks added to the block managers, the jumps to blocks outside the unit, the microBlock
+// addresses embedded in the code and the program range updates. Loading replays all of those
+// against the current program instead of running the recompiler. References to the dispatchers,
+// VU state and other host data are stored as relocations against their host region, so a unit
+// can be loaded anywhere in the code cache, in any run.
+
+extern void* mVUcompile(microVU& mVU, u32 startPC, uptr pState);
+extern void mVUsetupRange(microVU& mVU, s32 pc, bool isStartPC);
+
+struct microDiskCacheHeader
+{
+	u32 code_size;
+	u32 num_relocs;
+	u32 num_blocks;
+	u32 num_links;
+	u32 num_ptrs;
+	u32 num_ranges;
+};
+
+struct microDiskCacheBlock
+{
+	u32 offset;
+	u32 pc;
+	u32 hasJumpCache;
+	microRegInfo pState;
+	microRegInfo pStateEnd;
+};
+
+struct microDiskCacheLink
+{
+	u32 offset;
+	u32 pc;
+	microRegInfo pState;
+};
+
+struct microDiskCachePtr
+{
+	u32 offset;
+	u32 block;
+	u32 blockOffset;
+};
+
+struct microDiskCacheRange
+{
+	s32 pc;
+	u32 isStartPC;
+};
+
+template <typename T>
+static void mVUdiskCacheAppend(std::vector<u8>& data, const T& value)
+{
+	const u8* ptr = reinterpret_cast<const u8*>(&value);
+	data.insert(data.end(), ptr, ptr + sizeof(T));
+}
+
+template <typename T>
+static T mVUdiskCacheGet(const u8* data, u32 index)
+{
+	T value;
+	std::memcpy(&value, data + index * sizeof(T), sizeof(T));
+	return value;
+}
+
+// Loads the address of a microBlock (or one of its members) into reg. When recording, the
+// address is always written as a full imm64, so it can be replaced when the code is loaded.
+static void mVUloadBlockAddr(microVU& mVU, const xAddressReg& reg, void* addr)
+{
+	if (!mVU.capture.active)
+	{
+		xLoadFarAddr(reg, addr);
+		return;
+	}
+
+	xWrite8(0x48 | (reg.Id >> 3));
+	xWrite8(0xb8 | (reg.Id & 7));
+	mVU.capture.ptrs.push_back({x86Ptr, addr});
+	xWrite64(reinterpret_cast<uptr>(addr));
+}
+
+// Records a rel32 jump to an existing block, which has to be looked up again on load.
+static void mVUrecordLink(microVU& mVU, u8* field, const void* target, u32 pc, const microRegInfo& pState)
+{
+	if (!mVU.capture.active)
+		return;
+
+	microDiskCapture::Link& link = mVU.capture.links.emplace_back();
+	link.field = field;
+	link.target = target;
+	link.pc = pc & (mVU.microMemSize - 8);
+	std::memcpy(&link.pState, &pState, sizeof(link.pState));
+}
+
+// Same as above, for a jump which was emitted through the x86 emitter.
+static void mVUrecordLastLink(microVU& mVU, u32 pc, const microRegInfo& pState)
+{
+	if (!mVU.capture.active)
+		return;
+
+	const xRelativeRef& ref = mVU.capture.refs.back();
+	if (ref.size != sizeof(s32))
+	{
+		mVU.capture.cacheable = false;
+		return;
+	}
+
+	mVUrecordLink(mVU, ref.field, ref.target, pc, pState);
+}
+
+static RecCodeCache::Key mVUgetDiskCacheKey(microVU& mVU, u32 startPC, uptr pState)
+{
+	const u64 state_hash = RecCodeCache::HashGuestCode(reinterpret_cast<const void*>(pState), sizeof(microRegInfo));
+	return RecCodeCache::Key{startPC, mVU.microMemSize,
+		RecCodeCache::HashGuestCode(mVU.regs().Micro, mVU.microMemSize, state_hash)};
+}
+
+static void mVUopenDiskCache(microVU& mVU)
+{
+	if (!EmuConfig.Cpu.Recompiler.EnableVUProgramCache)
+	{
+		mVU.diskCache.reset();
+		return;
+	}
+
+	const u64 layout[] = {
+		EmuConfig.Cpu.Recompiler.bitset,
+		(mVU.index ? EmuConfig.Cpu.VU1FPCR : EmuConfig.Cpu.VU0FPCR).bitmask,
+		EmuConfig.Speedhacks.bitset,
+		static_cast<u64>(static_cast<s64>(EmuConfig.Speedhacks.EECycleRate)),
+		EmuConfig.Gamefixes.bitset,
+	};
+	const u64 layout_hash = RecCodeCache::HashGuestCode(layout, sizeof(layout), RecCodeCache::GetHostLayoutHash());
+
+	if (!mVU.diskCache)
+		mVU.diskCache = std::make_unique<RecCodeCache>(mVU.index ? "vu1_rec" : "vu0_rec");
+	else if (mVU.diskCache->IsOpen() && mVU.diskCache->GetLayoutHash() == layout_hash)
+		return;
+
+	if (!mVU.diskCache->Open(layout_hash, mVUdiskCacheSize * _1mb))
+	{
+		Console.Error("microVU%d: Failed to open program cache, programs will not be cached.", mVU.index);
+		mVU.diskCache.reset();
+	}
+}
+
+static void mVUcloseDiskCache(microVU& mVU)
+{
+	mVU.diskCache.reset();
+}
+
+// Tries to load a cached unit for startPC/pState to x86Ptr. Returns nullptr if there is none,
+// or it can't be used with the current state of the block managers.
+static void* mVUloadCachedProg(microVU& mVU, const RecCodeCache::Key& key, u32 startPC)
+{
+	std::vector<u8>& data = mVU.capture.data;
+	if (!mVU.diskCache->Read(key, &data))
+		return nullptr;
+
+	microDiskCacheHeader header;
+	if (data.size() < sizeof(header))
+		return nullptr;
+
+	std::memcpy(&header, data.data(), sizeof(header));
+	const size_t expected_size = sizeof(header) + header.code_size + header.num_relocs * sizeof(RecCodeCache::Relocation) +
+								 header.num_blocks * sizeof(microDiskCacheBlock) +
+								 header.num_links * sizeof(microDiskCacheLink) + header.num_ptrs * sizeof(microDiskCachePtr) +
+								 header.num_ranges * sizeof(microDiskCacheRange);
+	if (data.size() != expected_size || header.num_blocks == 0 || (x86Ptr + header.code_size) >= mVU.prog.x86end)
+		return nullptr;
+
+	const u8* relocs = data.data() + sizeof(header) + header.code_size;
+	const u8* blocks = relocs + header.num_relocs * sizeof(RecCodeCache::Relocation);
+	const u8* links = blocks + header.num_blocks * sizeof(microDiskCacheBlock);
+	const u8* ptrs = links + header.num_links * sizeof(microDiskCacheLink);
+	const u8* ranges = ptrs + header.num_ptrs * sizeof(microDiskCachePtr);
+
+	// None of the blocks can exist yet, and every block we jump to has to.
+	for (u32 i = 0; i < header.num_blocks; i++)
+	{
+		microDiskCacheBlock block = mVUdiskCacheGet<microDiskCacheBlock>(blocks, i);
+		if (block.offset >= header.code_size || block.pc >= mVU.microMemSize ||
+			(mVUblocks[block.pc / 8] && mVUblocks[block.pc / 8]->search(mVU, &block.pState)))
+		{
+			return nullptr;
+		}
+	}
+
+	std::vector<microBlock*> targets(header.num_links);
+	for (u32 i = 0; i < header.num_links; i++)
+	{
+		microDiskCacheLink link = mVUdiskCacheGet<microDiskCacheLink>(links, i);
+		if (link.offset > (header.code_size - sizeof(s32)) || link.pc >= mVU.microMemSize || !mVUblocks[link.pc / 8] ||
+			!(targets[i] = mVUblocks[link.pc / 8]->search(mVU, &link.pState)))
+		{
+			return nullptr;
+		}
+	}
+
+	for (u32 i = 0; i < header.num_ptrs; i++)
+	{
+		const microDiskCachePtr ptr = mVUdiskCacheGet<microDiskCachePtr>(ptrs, i);
+		if (ptr.offset > (header.code_size - sizeof(u64)) || ptr.block >= header.num_blocks ||
+			ptr.blockOffset >= sizeof(microBlock))
+		{
+			return nullptr;
+		}
+	}
+
+	// Nothing is committed until the code has been fixed up, so we can still bail out here.
+	u8* code = x86Ptr;
+	std::memcpy(code, data.data() + sizeof(header), header.code_size);
+
+	for (u32 i = 0; i < header.num_relocs; i++)
+	{
+		if (!RecCodeCache::ApplyRelocation(code, header.code_size, mVUdiskCacheGet<RecCodeCache::Relocation>(relocs, i)))
+			return nullptr;
+	}
+
+	for (u32 i = 0; i < header.num_links; i++)
+	{
+		const microDiskCacheLink link = mVUdiskCacheGet<microDiskCacheLink>(links, i);
+		const sptr disp = reinterpret_cast<sptr>(targets[i]->x86ptrStart) - reinterpret_cast<sptr>(code + link.offset + 4);
+		if (disp != static_cast<s32>(disp))
+			return nullptr;
+
+		const s32 disp32 = static_cast<s32>(disp);
+		std::memcpy(code + link.offset, &disp32, sizeof(disp32));
+	}
+
+	for (u32 i = 0; i < header.num_ranges; i++)
+	{
+		const microDiskCacheRange range = mVUdiskCacheGet<microDiskCacheRange>(ranges, i);
+		mVUsetupRange(mVU, range.pc, range.isStartPC != 0);
+	}
+
+	std::vector<microBlock*> added(header.num_blocks);
+	for (u32 i = 0; i < header.num_blocks; i++)
+	{
+		const microDiskCacheBlock block = mVUdiskCacheGet<microDiskCacheBlock>(blocks, i);
+		microBlock mBlock;
+		std::memcpy(&mBlock.pState, &block.pState, sizeof(mBlock.pState));
+		std::memcpy(&mBlock.pStateEnd, &block.pStateEnd, sizeof(mBlock.pStateEnd));
+		mBlock.x86ptrStart = code + block.offset;
+		mBlock.jumpCache = nullptr;
+
+		blockCreate(block.pc / 8);
+		added[i] = mVUblocks[block.pc / 8]->add(mVU, &mBlock);
+		if (block.hasJumpCache && !added[i]->jumpCache)
+			added[i]->jumpCache = new microJumpCache[mProgSize / 2];
+	}
+
+	for (u32 i = 0; i < header.num_ptrs; i++)
+	{
+		const microDiskCachePtr ptr = mVUdiskCacheGet<microDiskCachePtr>(ptrs, i);
+		const u64 addr = reinterpret_cast<uptr>(added[ptr.block]) + ptr.blockOffset;
+		std::memcpy(code + ptr.offset, &addr, sizeof(addr));
+	}
+
+	// mVUinitFirstPass() leaves the entry state of the last block compiled here.
+	std::memcpy(&mVU.prog.lpState, &added.back()->pState, sizeof(mVU.prog.lpState));
+
+	xSetPtr(code + header.code_size);
+
+	if (mVU.regs().start_pc == startPC)
+	{
+		if (mVU.index)
+			Perf::vu1.RegisterPC(code, header.code_size, startPC);
+		else
+			Perf::vu0.RegisterPC(code, header.code_size, startPC);
+	}
+
+	return code;
+}
+
+static void mVUstoreCachedProg(microVU& mVU, const RecCodeCache::Key& key, const u8* code, u32 code_size)
+{
+	microDiskCapture& capture = mVU.capture;
+	const uptr code_start = reinterpret_cast<uptr>(code);
+	const uptr code_end = code_start + code_size;
+	const uptr cache_start = reinterpret_cast<uptr>(mVU.prog.x86start);
+	const uptr cache_end = reinterpret_cast<uptr>(mVU.prog.x86end) + mVUcacheSafeZone * _1mb;
+
+	microDiskCacheHeader header = {};
+	header.code_size = code_size;
+
+	std::vector<u8>& data = capture.data;
+	data.resize(sizeof(header));
+	data.insert(data.end(), code, code + code_size);
+
+	for (const xRelativeRef& ref : capture.refs)
+	{
+		// Displacements within the unit stay valid when it's moved, absolute addresses don't.
+		const uptr target = reinterpret_cast<uptr>(ref.target);
+		if (target >= code_start && target < code_end)
+		{
+			if (ref.absolute)
+				return;
+
+			continue;
+		}
+
+		if (std::any_of(capture.links.begin(), capture.links.end(),
+				[&ref](const microDiskCapture::Link& link) { return (link.field == ref.field); }))
+		{
+			continue;
+		}
+
+		// Anything referring to blocks we don't know about, short jumps out of the unit, and
+		// references outside of the host regions.
+		RecCodeCache::Relocation reloc;
+		if ((target >= cache_start && target < cache_end) || !RecCodeCache::MakeRelocation(code, ref, &reloc))
+			return;
+
+		mVUdiskCacheAppend(data, reloc);
+		header.num_relocs++;
+	}
+
+	for (const microDiskCapture::Block& block : capture.blocks)
+	{
+		microDiskCacheBlock cblock = {};
+		cblock.offset = static_cast<u32>(block.pBlock->x86ptrStart - code);
+		cblock.pc = block.pc;
+		cblock.hasJumpCache = (block.pBlock->jumpCache != nullptr);
+		std::memcpy(&cblock.pState, &block.pBlock->pState, sizeof(cblock.pState));
+		std::memcpy(&cblock.pStateEnd, &block.pBlock->pStateEnd, sizeof(cblock.pStateEnd));
+		if (cblock.offset >= code_size)
+			return;
+
+		mVUdiskCacheAppend(data, cblock);
+		header.num_blocks++;
+	}
+
+	for (const microDiskCapture::Link& link : capture.links)
+	{
+		// Jumps within the unit stay valid when it's moved.
+		const uptr target = reinterpret_cast<uptr>(link.target);
+		if (target >= code_start && target < code_end)
+			continue;
+
+		microDiskCacheLink clink = {};
+		clink.offset = static_cast<u32>(link.field - code);
+		clink.pc = link.pc;
+		std::memcpy(&clink.pState, &link.pState, sizeof(clink.pState));
+		mVUdiskCacheAppend(data, clink);
+		header.num_links++;
+	}
+
+	for (const microDiskCapture::Ptr& ptr : capture.ptrs)
+	{
+		const u8* addr = static_cast<const u8*>(ptr.ptr);
+		const auto it = std::find_if(capture.blocks.begin(), capture.blocks.end(), [addr](const microDiskCapture::Block& block) {
+			return (addr >= reinterpret_cast<const u8*>(block.pBlock) && addr < reinterpret_cast<const u8*>(block.pBlock + 1));
+		});
+		if (it == capture.blocks.end())
+			return;
+
+		const microDiskCachePtr cptr = {static_cast<u32>(ptr.field - code), static_cast<u32>(it - capture.blocks.begin()),
+			static_cast<u32>(addr - reinterpret_cast<const u8*>(it->pBlock))};
+		mVUdiskCacheAppend(data, cptr);
+		header.num_ptrs++;
+	}
+
+	for (const microDiskCapture::Range& range : capture.ranges)
+	{
+		mVUdiskCacheAppend(data, microDiskCacheRange{range.pc, range.isStartPC});
+		header.num_ranges++;
+	}
+
+	std::memcpy(data.data(), &header, sizeof(header));
+	mVU.diskCache->Write(key, data.data(), static_cast<u32>(data.size()));
+}
+
+// Compiles a block through the on-disk program cache (top-level compiles only)
+static void* mVUcompileCached(microVU& mVU, u32 startPC, uptr pState)
+{
+	const RecCodeCache::Key key = mVUgetDiskCacheKey(mVU, startPC, pState);
+	if (void* ptr = mVUloadCachedProg(mVU, key, startPC))
+		return ptr;
+
+	microDiskCapture& capture = mVU.capture;
+	capture.active = true;
+	capture.cacheable = true;
+	capture.refs.clear();
+	capture.blocks.clear();
+	capture.links.clear();
+	capture.ptrs.clear();
+	capture.ranges.clear();
+
+	std::vector<xRelativeRef>* const prev_refs = xRelativeRefs;
+	xRelativeRefs = &capture.refs;
+
+	u8* code = x86Ptr;
+	void* entryPoint = mVUcompile(mVU, startPC, pState);
+
+	xRelativeRefs = prev_refs;
+	capture.active = false;
+
+	if (capture.cacheable && x86Ptr > code && x86Ptr < mVU.prog.x86end)
+		mVUstoreCachedProg(mVU, key, code, static_cast<u32>(x86Ptr - code));
+
+	return entryPoint;
+}
@@ -0,0 +1,130 @@
+// SPDX-FileCopyrightText: 2002-2024 PCSX2 Dev Team
+// SPDX-License-Identifier: LGPL-3.0+
+
+// Compares load time and peak memory of decompressing savestate entries straight into guest memory,
+// against inflating them into a temporary buffer first. Not a test, run it by hand:
+//   savestate_load_benchmark [iterations]
+
+#include "savestate_test_utils.h"
+
+#include "pcsx2/Config.h"
+#include "common/Error.h"
+#include "common/FileSystem.h"
+#include "common/ScopedGuard.h"
+#include "common/Timer.h"
+#include "common/ZipHelpers.h"
+#include "fmt/format.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+#if defined(_WIN32)
+#include "common/RedtapeWindows.h"
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+static u64 GetPeakRSS()
+{
+#if defined(_WIN32)
+	PROCESS_MEMORY_COUNTERS pmc = {};
+	if (!GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+		return 0;
+	return static_cast<u64>(pmc.PeakWorkingSetSize);
+#else
+	struct rusage usage = {};
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+		return 0;
+#if defined(__APPLE__)
+	return static_cast<u64>(usage.ru_maxrss);
+#else
+	// Linux reports kilobytes.
+	return static_cast<u64>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+/// What loading looked like before entries were decompressed in place: each one is inflated into a
+/// temporary buffer and copied.
+static bool LoadSyntheticStateBuffered(const std::string& filename, u8* dst, Error* error)
+{
+	zip_error_t ze = {};
+	auto zf = zip_open_managed(filename.c_str(), ZIP_RDONLY, &ze);
+	if (!zf)
+	{
+		Error::SetString(error, fmt::format("Failed to open '{}'", filename));
+		return false;
+	}
+
+	size_t offset = 0;
+	for (const SaveStateTestUtils::SyntheticEntry& entry : SaveStateTestUtils::ENTRIES)
+	{
+		std::optional<std::vector<u8>> data = ReadBinaryFileInZip(zf.get(), entry.name);
+		if (!data.has_value() || data->size() != entry.size)
+		{
+			Error::SetString(error, fmt::format("Failed to read entry '{}'", entry.name));
+			return false;
+		}
+
+		std::memcpy(dst + offset, data->data(), entry.size);
+		offset += entry.size;
+	}
+
+	return true;
+}
+
+int main(int argc, char* argv[])
+{
+	const u32 iterations = (argc > 1) ? static_cast<u32>(std::max(std::atoi(argv[1]), 1)) : 4;
+	const std::string filename = (std::filesystem::temp_directory_path() / "pcsx2_savestate_load_benchmark.p2s").string();
+	ScopedGuard cleanup([&filename]() { FileSystem::DeleteFilePath(filename.c_str()); });
+
+	std::unique_ptr<ArchiveEntryList> state = SaveStateTestUtils::CreateSyntheticState();
+	const std::vector<u8> expected = state->GetBuffer();
+	EmuConfig.SavestateZstdCompression = true;
+	if (!SaveState_ZipToDisk(std::move(state), nullptr, filename.c_str()))
+	{
+		fmt::print(stderr, "Failed to write '{}'\n", filename);
+		return EXIT_FAILURE;
+	}
+
+	// Destination "guest memory" is allocated and touched up front, so only staging buffers show up in the peak.
+	std::vector<u8> memory(expected.size(), 0xFF);
+
+	// The peak never goes down, so the direct loads have to go first.
+	for (const bool direct : {true, false})
+	{
+		const u64 rss_before = GetPeakRSS();
+		double total_ms = 0.0;
+		for (u32 i = 0; i < iterations; i++)
+		{
+			std::memset(memory.data(), 0xFF, memory.size());
+
+			Error error;
+			Common::Timer timer;
+			const bool result = direct ? SaveStateTestUtils::LoadSyntheticState(filename, memory.data(), &error) :
+										 LoadSyntheticStateBuffered(filename, memory.data(), &error);
+			if (!result)
+			{
+				fmt::print(stderr, "Load failed: {}\n", error.GetDescription());
+				return EXIT_FAILURE;
+			}
+			total_ms += timer.GetTimeMilliseconds();
+
+			if (std::memcmp(memory.data(), expected.data(), expected.size()) != 0)
+			{
+				fmt::print(stderr, "{} load doesn't match the saved state\n", direct ? "Direct" : "Buffered");
+				return EXIT_FAILURE;
+			}
+		}
+
+		fmt::print("{} load of {} MB: {:.2f} ms average over {} runs, peak RSS +{} KB\n", direct ? "Direct" : "Buffered",
+			expected.size() / (1024 * 1024), total_ms / iterations, iterations, (GetPeakRSS() - rss_before) / 1024);
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,50 @@
+// SPDX-FileCopyrightText: 2002-2024 PCSX2 Dev Team
+// SPDX-License-Identifier: LGPL-3.0+
+
+#include "savestate_test_utils.h"
+
+#include "pcsx2/Config.h"
+#include "common/Error.h"
+#include "common/FileSystem.h"
+#include "common/ScopedGuard.h"
+#include "fmt/format.h"
+#include <cstring>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <vector>
+
+static std::vector<u8> SaveAndLoadSyntheticState(bool zstd, const std::vector<u8>& expected, u8 fill)
+{
+	const bool old_zstd = EmuConfig.SavestateZstdCompression;
+	const std::string filename = (std::filesystem::temp_directory_path() /
+		fmt::format("pcsx2_savestate_load_test_{}.p2s", zstd ? "zstd" : "deflate")).string();
+	ScopedGuard cleanup([&filename, old_zstd]() {
+		EmuConfig.SavestateZstdCompression = old_zstd;
+		FileSystem::DeleteFilePath(filename.c_str());
+	});
+
+	std::unique_ptr<ArchiveEntryList> state = SaveStateTestUtils::CreateSyntheticState();
+	EXPECT_EQ(state->GetBuffer(), expected);
+	EmuConfig.SavestateZstdCompression = zstd;
+	EXPECT_TRUE(SaveState_ZipToDisk(std::move(state), nullptr, filename.c_str()));
+
+	// Start from garbage, so a load can't pass by leaving memory untouched.
+	std::vector<u8> loaded(expected.size(), fill);
+	Error error;
+	EXPECT_TRUE(SaveStateTestUtils::LoadSyntheticState(filename, loaded.data(), &error)) << error.GetDescription();
+	return loaded;
+}
+
+// zstd states are block-compressed and decompressed straight into the destination, deflate states
+// go through the zip_fread() path. Both are the loader SaveState_UnzipFromDisk() uses for guest memory.
+TEST(SaveState, DirectLoadMatchesBuffered)
+{
+	const std::vector<u8> expected = SaveStateTestUtils::CreateSyntheticState()->GetBuffer();
+	const std::vector<u8> direct = SaveAndLoadSyntheticState(true, expected, 0xFF);
+	const std::vector<u8> buffered = SaveAndLoadSyntheticState(false, expected, 0x00);
+
+	ASSERT_EQ(direct.size(), expected.size());
+	ASSERT_EQ(buffered.size(), expected.size());
+	EXPECT_EQ(std::memcmp(direct.data(), buffered.data(), expected.size()), 0);
+	EXPECT_EQ(std::memcmp(direct.data(), expected.data(), expected.size()), 0);
+}
@@ -0,0 +1,72 @@
+// SPDX-FileCopyrightText: 2002-2024 PCSX2 Dev Team
+// SPDX-License-Identifier: LGPL-3.0+
+
+#include "savestate_test_utils.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+/// Fills a buffer with something resembling guest memory: zero pages, repeated structures and
+/// incompressible data, so the compressor has a realistic amount of work.
+static void FillSyntheticMemory(u8* data, u32 size, u32 seed)
+{
+	u32 state = seed * 2654435761u + 1;
+	for (u32 offset = 0; offset < size; offset += 4096)
+	{
+		const u32 count = std::min<u32>(size - offset, 4096);
+		state = state * 1664525u + 1013904223u;
+		switch ((state >> 24) % 4)
+		{
+			case 0:
+				std::memset(data + offset, 0, count);
+				break;
+
+			case 1:
+				for (u32 i = 0; i < count; i++)
+					data[offset + i] = static_cast<u8>(i * 7);
+				break;
+
+			default:
+				for (u32 i = 0; i < count; i++)
+				{
+					state = state * 1664525u + 1013904223u;
+					data[offset + i] = static_cast<u8>(state >> ((state >> 30) * 8));
+				}
+				break;
+		}
+	}
+}
+
+std::unique_ptr<ArchiveEntryList> SaveStateTestUtils::CreateSyntheticState()
+{
+	std::unique_ptr<ArchiveEntryList> list = std::make_unique<ArchiveEntryList>();
+	size_t total_size = 0;
+	for (const SyntheticEntry& entry : ENTRIES)
+		total_size += entry.size;
+
+	list->GetBuffer().resize(total_size);
+
+	size_t offset = 0;
+	for (u32 i = 0; i < std::size(ENTRIES); i++)
+	{
+		FillSyntheticMemory(list->GetPtr(static_cast<uint>(offset)), ENTRIES[i].size, i);
+		list->Add(ArchiveEntry(ENTRIES[i].name).SetDataIndex(offset).SetDataSize(ENTRIES[i].size));
+		offset += ENTRIES[i].size;
+	}
+
+	return list;
+}
+
+bool SaveStateTestUtils::LoadSyntheticState(const std::string& filename, u8* dst, Error* error)
+{
+	std::vector<SaveStateMemoryEntry> entries;
+	size_t offset = 0;
+	for (const SyntheticEntry& entry : ENTRIES)
+	{
+		entries.push_back(SaveStateMemoryEntry{entry.name, dst + offset, entry.size});
+		offset += entry.size;
+	}
+
+	return SaveState_UnzipMemoryEntriesFromDisk(filename, entries, error);
+}
@@ -0,0 +1,32 @@
+// SPDX-FileCopyrightText: 2002-2024 PCSX2 Dev Team
+// SPDX-License-Identifier: LGPL-3.0+
+
+#pragma once
+
+#include "pcsx2/SaveState.h"
+
+#include <memory>
+#include <string>
+
+namespace SaveStateTestUtils
+{
+	struct SyntheticEntry
+	{
+		const char* name;
+		u32 size;
+	};
+
+	// Roughly the shape of a real state: the memory entries dominate, and are loaded in place.
+	static constexpr SyntheticEntry ENTRIES[] = {
+		{"eeMemory.bin", 32 * 1024 * 1024},
+		{"iopMemory.bin", 2 * 1024 * 1024},
+		{"GS.bin", 4 * 1024 * 1024 + 0x2000},
+		{"Scratchpad.bin", 16 * 1024},
+	};
+
+	/// Builds a state out of ENTRIES, stored back to back in the list's buffer.
+	std::unique_ptr<ArchiveEntryList> CreateSyntheticState();
+
+	/// Loads every entry into `dst`, laid out like the state's buffer, with SaveState_UnzipMemoryEntriesFromDisk().
+	bool LoadSyntheticState(const std::string& filename, u8* dst, Error* error);
+} // namespace SaveStateTestUtils
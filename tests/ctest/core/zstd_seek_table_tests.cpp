@@ -0,0 +1,184 @@
+// SPDX-FileCopyrightText: 2002-2024 PCSX2 Dev Team
+// SPDX-License-Identifier: LGPL-3.0+
+
+#include "pcsx2/CDVD/ZstdFileReader.h"
+#include "common/Error.h"
+#include <cstdio>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace
+{
+	struct TestFrame
+	{
+		u32 compressed_size;
+		u32 decompressed_size;
+		u32 checksum;
+	};
+
+	static constexpr u32 SKIPPABLE_MAGIC = 0x184D2A5E;
+	static constexpr u32 SEEKABLE_MAGIC = 0x8F92EAB1;
+	static constexpr u8 CHECKSUM_FLAG = 0x80;
+
+	static void Append32(std::vector<u8>& out, u32 value)
+	{
+		const size_t pos = out.size();
+		out.resize(pos + sizeof(value));
+		std::memcpy(&out[pos], &value, sizeof(value));
+	}
+
+	/// Builds an image with placeholder frame data followed by a seek table for `frames`.
+	static std::vector<u8> BuildImage(const std::vector<TestFrame>& frames, bool checksums)
+	{
+		std::vector<u8> out;
+		for (const TestFrame& frame : frames)
+			out.resize(out.size() + frame.compressed_size, 0xCD);
+
+		const u32 entry_size = checksums ? 12 : 8;
+		Append32(out, SKIPPABLE_MAGIC);
+		Append32(out, static_cast<u32>(frames.size()) * entry_size + 9);
+		for (const TestFrame& frame : frames)
+		{
+			Append32(out, frame.compressed_size);
+			Append32(out, frame.decompressed_size);
+			if (checksums)
+				Append32(out, frame.checksum);
+		}
+		Append32(out, static_cast<u32>(frames.size()));
+		out.push_back(checksums ? CHECKSUM_FLAG : 0);
+		Append32(out, SEEKABLE_MAGIC);
+		return out;
+	}
+
+	static bool ParseImage(const std::vector<u8>& image, ZstdFileReader::SeekTable* table)
+	{
+		std::FILE* fp = std::tmpfile();
+		EXPECT_NE(fp, nullptr);
+		if (!fp)
+			return false;
+
+		if (!image.empty())
+			EXPECT_EQ(std::fwrite(image.data(), image.size(), 1, fp), 1u);
+		std::fflush(fp);
+
+		Error error;
+		const bool result = ZstdFileReader::ReadSeekTable(fp, table, &error);
+		std::fclose(fp);
+		return result;
+	}
+
+	static const std::vector<TestFrame> s_frames = {
+		{100, 65536, 0x11111111},
+		{200, 65536, 0x22222222},
+		{50, 4096, 0x33333333},
+	};
+} // namespace
+
+TEST(ZstdSeekTable, ParsesFrames)
+{
+	ZstdFileReader::SeekTable table;
+	ASSERT_TRUE(ParseImage(BuildImage(s_frames, false), &table));
+
+	ASSERT_EQ(table.frames.size(), 3u);
+	EXPECT_FALSE(table.hasChecksums);
+	EXPECT_EQ(table.totalSize, 65536u * 2 + 4096);
+	EXPECT_EQ(table.maxCompressedSize, 200u);
+
+	EXPECT_EQ(table.frames[0].compressedOffset, 0u);
+	EXPECT_EQ(table.frames[1].compressedOffset, 100u);
+	EXPECT_EQ(table.frames[2].compressedOffset, 300u);
+	EXPECT_EQ(table.frames[1].decompressedOffset, 65536u);
+	EXPECT_EQ(table.frames[2].decompressedOffset, 131072u);
+	EXPECT_EQ(table.frames[2].decompressedSize, 4096u);
+	EXPECT_EQ(table.frames[2].checksum, 0u);
+}
+
+TEST(ZstdSeekTable, ParsesChecksumsAndSkipsEmptyFrames)
+{
+	std::vector<TestFrame> frames = s_frames;
+	frames.insert(frames.begin() + 1, TestFrame{9, 0, 0x44444444});
+
+	ZstdFileReader::SeekTable table;
+	ASSERT_TRUE(ParseImage(BuildImage(frames, true), &table));
+
+	ASSERT_EQ(table.frames.size(), 3u);
+	EXPECT_TRUE(table.hasChecksums);
+	EXPECT_EQ(table.frames[0].checksum, 0x11111111u);
+	EXPECT_EQ(table.frames[1].checksum, 0x22222222u);
+	// The empty frame still takes up space in the file.
+	EXPECT_EQ(table.frames[1].compressedOffset, 109u);
+	EXPECT_EQ(table.frames[1].decompressedOffset, 65536u);
+	EXPECT_EQ(table.totalSize, 65536u * 2 + 4096);
+}
+
+TEST(ZstdSeekTable, RejectsTruncatedFooter)
+{
+	std::vector<u8> image = BuildImage(s_frames, false);
+	image.resize(image.size() - 3);
+
+	ZstdFileReader::SeekTable table;
+	EXPECT_FALSE(ParseImage(image, &table));
+	EXPECT_TRUE(table.frames.empty());
+
+	EXPECT_FALSE(ParseImage({}, &table));
+	EXPECT_FALSE(ParseImage(std::vector<u8>(image.end() - 12, image.end()), &table));
+}
+
+TEST(ZstdSeekTable, RejectsBadMagic)
+{
+	std::vector<u8> image = BuildImage(s_frames, false);
+	image.back() ^= 0xFF;
+
+	ZstdFileReader::SeekTable table;
+	EXPECT_FALSE(ParseImage(image, &table));
+}
+
+TEST(ZstdSeekTable, RejectsReservedDescriptorBits)
+{
+	std::vector<u8> image = BuildImage(s_frames, false);
+	image[image.size() - 5] |= 0x04;
+
+	ZstdFileReader::SeekTable table;
+	EXPECT_FALSE(ParseImage(image, &table));
+}
+
+TEST(ZstdSeekTable, RejectsCorruptFrameCount)
+{
+	std::vector<u8> image = BuildImage(s_frames, false);
+
+	// More frames than the file has room for.
+	const u32 huge_count = 0x10000000;
+	std::memcpy(&image[image.size() - 9], &huge_count, sizeof(huge_count));
+	ZstdFileReader::SeekTable table;
+	EXPECT_FALSE(ParseImage(image, &table));
+
+	// Still fits in the file, but the skippable header no longer matches the table.
+	const u32 wrong_count = 2;
+	std::memcpy(&image[image.size() - 9], &wrong_count, sizeof(wrong_count));
+	EXPECT_FALSE(ParseImage(image, &table));
+
+	const u32 no_frames = 0;
+	std::memcpy(&image[image.size() - 9], &no_frames, sizeof(no_frames));
+	EXPECT_FALSE(ParseImage(image, &table));
+}
+
+TEST(ZstdSeekTable, RejectsFramesPastEndOfData)
+{
+	std::vector<u8> image = BuildImage(s_frames, false);
+
+	// Drop the last frame's data, so the table describes more than is there.
+	image.erase(image.begin(), image.begin() + 10);
+
+	ZstdFileReader::SeekTable table;
+	EXPECT_FALSE(ParseImage(image, &table));
+}
+
+TEST(ZstdSeekTable, RejectsOversizedFrames)
+{
+	std::vector<TestFrame> frames = s_frames;
+	frames[1].decompressed_size = 64 * 1024 * 1024;
+
+	ZstdFileReader::SeekTable table;
+	EXPECT_FALSE(ParseImage(BuildImage(frames, false), &table));
+}